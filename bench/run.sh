@@ -0,0 +1,20 @@
+#!/bin/sh
+# usage: bench/run.sh [sabr executable] [engines...]
+SABR=${1:-build/sabr}
+[ $# -gt 0 ] && shift
+ENGINES=${*:-classic threaded tos register}
+DIR=$(dirname "$0")
+TMP=$(mktemp -d)
+
+for src in "$DIR"/*.sabrc; do
+	name=$(basename "$src" .sabrc)
+	"$SABR" -c "$src" -o "$TMP/$name.sbc" || exit 1
+	for engine in $ENGINES; do
+		start=$(date +%s.%N)
+		"$SABR" -e "$TMP/$name.sbc" --engine="$engine" > /dev/null || exit 1
+		end=$(date +%s.%N)
+		printf '%-16s %-10s %.3fs\n' "$name" "$engine" "$(awk "BEGIN { print $end - $start }")"
+	done
+done
+
+rm -rf "$TMP"
\ No newline at end of file
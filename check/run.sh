@@ -0,0 +1,27 @@
+#!/bin/sh
+# usage: check/run.sh [sabr executable] [levels...]
+SABR=${1:-build/sabr}
+[ $# -gt 0 ] && shift
+LEVELS=${*:-1 2 3}
+DIR=$(dirname "$0")
+TMP=$(mktemp -d)
+FAILED=0
+
+for src in "$DIR"/*.sabrc; do
+	name=$(basename "$src" .sabrc)
+	"$SABR" -c "$src" -o "$TMP/$name.sbc" -O 0 || exit 1
+	timeout 10 "$SABR" -e "$TMP/$name.sbc" > "$TMP/$name.expected" 2>&1
+	for level in $LEVELS; do
+		"$SABR" -c "$src" -o "$TMP/$name.sbc" -O "$level" || exit 1
+		timeout 10 "$SABR" -e "$TMP/$name.sbc" > "$TMP/$name.out" 2>&1
+		if cmp -s "$TMP/$name.expected" "$TMP/$name.out"; then
+			printf '%-16s -O%s ok\n' "$name" "$level"
+		else
+			printf '%-16s -O%s FAILED\n' "$name" "$level"
+			FAILED=1
+		fi
+	done
+done
+
+rm -rf "$TMP"
+exit $FAILED
\ No newline at end of file
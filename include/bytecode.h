@@ -4,6 +4,12 @@
 #include <stdarg.h>
 #include <stdbool.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if !defined(_WIN32)
+	#include <sys/mman.h>
+#endif
 
 #include "cctl_define.h"
 
@@ -11,17 +17,91 @@
 
 #include "bcop.h"
 
+#define SABR_BYTECODE_MAGIC "\0sbf"
+#define SABR_BYTECODE_MAGIC_SIZE 4
+#define SABR_BYTECODE_VERSION 1
+#define SABR_BYTECODE_HEADER_SIZE 5
+
 typedef struct sabr_bytecode_struct {
 	vector(sabr_bcop_t) bcop_vec;
 	size_t current_index;
 	size_t current_pos;
+	uint8_t* compact;
+	size_t compact_size;
+	uint8_t* image;
+	size_t image_size;
+	bool mapped;
+	uint8_t* ocs;
+	size_t ocs_size;
+	uint32_t* operand_indices;
+	sabr_value_t* operands;
 } sabr_bytecode_t;
 
+typedef struct sabr_bytecode_options_struct {
+	uint32_t level;
+	char print_after[32];
+	struct sabr_profile_struct* profile;
+} sabr_bytecode_options_t;
+
+typedef struct sabr_bytecode_link_data_struct {
+	uint64_t identifier;
+	size_t entry;
+	bool bindable;
+} sabr_bytecode_link_data_t;
+
+typedef struct sabr_bytecode_case_data_struct {
+	sabr_value_t value;
+	size_t head;
+	size_t target;
+} sabr_bytecode_case_data_t;
+
+extern const char* sabr_bytecode_pass_names[];
+
+inline size_t sabr_bytecode_read(const uint8_t* code, size_t size, size_t pos, sabr_bcop_t* bcop) {
+	if (pos >= size || code[pos] >= SABR_OP_COUNT) return 0;
+	bcop->oc = code[pos++];
+	bcop->operand.u = 0;
+	if (!sabr_opcode_has_operand(bcop->oc)) return pos;
+	if (size - pos < 8) return 0;
+	memcpy(bcop->operand.bytes, code + pos, 8);
+	return pos + 8;
+}
+
 void sabr_bytecode_print(sabr_bytecode_t* bc);
 void sabr_bytecode_init(sabr_bytecode_t* bc);
 void sabr_bytecode_free(sabr_bytecode_t* bc);
-sabr_bytecode_t* sabr_bytecode_concat(sabr_bytecode_t* a, sabr_bytecode_t* b);
+bool sabr_bytecode_check_header(const uint8_t* code, size_t size);
+bool sabr_bytecode_check_image(const uint8_t* code, size_t size);
+bool sabr_bytecode_check_image_switch(const uint8_t* code, size_t size, const size_t* offsets, size_t count, sabr_bcop_t bcop);
+bool sabr_bytecode_expand(sabr_bytecode_t* bc);
+void sabr_bytecode_release(sabr_bytecode_t* bc);
+sabr_bytecode_t* sabr_bytecode_concat(sabr_bytecode_t* a, sabr_bytecode_t* b, sabr_bytecode_options_t* options);
 bool sabr_bytecode_join(sabr_bytecode_t* dest, sabr_bytecode_t* src);
+bool sabr_bytecode_split(sabr_bytecode_t* bc);
+bool sabr_bytecode_split_image(sabr_bytecode_t* bc);
+void sabr_bytecode_unsplit(sabr_bytecode_t* bc);
+bool sabr_bytecode_link(sabr_bytecode_t* bc, sabr_bytecode_options_t* options);
+bool sabr_bytecode_print_after(sabr_bytecode_t* bc, sabr_bytecode_options_t* options, const char* pass);
+bool sabr_bytecode_is_pass(const char* name);
+bool sabr_bytecode_link_calls(sabr_bytecode_t* bc, bool* targets);
+bool sabr_bytecode_link_owners(sabr_bytecode_t* bc, size_t* owners);
+bool sabr_bytecode_link_locals(sabr_bytecode_t* bc, bool* targets, size_t* owners);
+bool sabr_bytecode_link_globals(sabr_bytecode_t* bc, bool* targets, size_t* owners);
+void sabr_bytecode_link_loops(sabr_bytecode_t* bc, size_t* owners);
+bool sabr_bytecode_link_loop(sabr_bytecode_t* bc, size_t index, uint64_t record);
+void sabr_bytecode_link_tails(sabr_bytecode_t* bc, size_t* owners);
+bool sabr_bytecode_link_is_frame_safe(sabr_bytecode_t* bc, size_t* owners, size_t lambda);
+size_t sabr_bytecode_link_follow(sabr_bytecode_t* bc, size_t index, bool scoped);
+bool sabr_bytecode_link_switches(sabr_bytecode_t* bc);
+bool sabr_bytecode_link_switch(sabr_bytecode_t* bc, size_t index, size_t size, sabr_bytecode_case_data_t* cases, bool* tabled);
+bool sabr_bytecode_link_literal(sabr_bytecode_t* bc, size_t begin, size_t end, sabr_value_t* value);
+bool sabr_bytecode_link_is_function(sabr_bytecode_t* bc, size_t lambda);
+bool sabr_bytecode_link_is_dynamic(sabr_bytecode_t* bc, bool* targets, size_t index);
+bool sabr_bytecode_link_is_plain_call(sabr_bytecode_t* bc, size_t* owners, size_t entry);
+sabr_bytecode_link_data_t* sabr_bytecode_link_data_find(sabr_bytecode_link_data_t* data, size_t count, uint64_t identifier);
+int sabr_bytecode_link_data_compare(const void* a, const void* b);
+int sabr_bytecode_case_data_compare(const void* a, const void* b);
+bool sabr_bytecode_check_switch(sabr_bytecode_t* bc, sabr_bcop_t bcop);
 
 bool sabr_bytecode_write_bcop(sabr_bytecode_t* bc_data, sabr_opcode_t oc);
 bool sabr_bytecode_write_bcop_with_null(sabr_bytecode_t* bc_data, sabr_opcode_t oc);
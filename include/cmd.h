@@ -10,6 +10,8 @@
 
 #include "compiler.h"
 #include "interpreter.h"
+#include "emitter.h"
+#include "profile.h"
 #include "cmake_config.h"
 
 typedef struct sabr_cmd_flag_struct {
@@ -17,22 +19,40 @@ typedef struct sabr_cmd_flag_struct {
 	bool execute;
 	bool out;
 	bool memory;
+	bool stack;
 	bool run;
 	bool bytecode;
 	bool preprocess;
 	bool version;
 	bool help;
+	bool count_pairs;
+	bool level;
+	bool perf_map;
+	bool emit_c;
+	bool profile_out;
+	bool profile_use;
+	bool compact;
+	bool engine;
+	bool wrong_arg;
 } sabr_cmd_flag_t;
 
 typedef struct option option_t;
 typedef struct sabr_cmd_struct {
 	sabr_cmd_flag_t flags;
-	option_t long_opts[9];
-	char opts[13];
+	option_t long_opts[21];
+	char opts[20];
 	char src_filename[PATH_MAX];
 	char out_filename[PATH_MAX];
 	char bc_filename[PATH_MAX];
+	char profile_out_filename[PATH_MAX];
+	char profile_use_filename[PATH_MAX];
 	size_t memory_pool_size;
+	size_t data_stack_size;
+	sabr_interpreter_engine_t engine;
+	sabr_interpreter_jit_t jit;
+	uint64_t jit_threshold;
+	sabr_bytecode_options_t options;
+	sabr_profile_t profile;
 } sabr_cmd_t;
 
 extern sabr_cmd_t cmd;
@@ -50,6 +70,18 @@ void sabr_cmd_get_opt_bytecode(sabr_cmd_t* cmd);
 void sabr_cmd_get_opt_preprocess(sabr_cmd_t* cmd);
 void sabr_cmd_get_opt_version(sabr_cmd_t* cmd);
 void sabr_cmd_get_opt_help(sabr_cmd_t* cmd);
+void sabr_cmd_get_opt_engine(sabr_cmd_t* cmd);
+void sabr_cmd_get_opt_stack(sabr_cmd_t* cmd);
+void sabr_cmd_get_opt_count_pairs(sabr_cmd_t* cmd);
+void sabr_cmd_get_opt_print_after(sabr_cmd_t* cmd);
+void sabr_cmd_get_opt_level(sabr_cmd_t* cmd);
+void sabr_cmd_get_opt_jit(sabr_cmd_t* cmd);
+void sabr_cmd_get_opt_jit_threshold(sabr_cmd_t* cmd);
+void sabr_cmd_get_opt_perf_map(sabr_cmd_t* cmd);
+void sabr_cmd_get_opt_emit_c(sabr_cmd_t* cmd);
+void sabr_cmd_get_opt_profile_out(sabr_cmd_t* cmd);
+void sabr_cmd_get_opt_profile_use(sabr_cmd_t* cmd);
+void sabr_cmd_get_opt_compact(sabr_cmd_t* cmd);
 
 extern void (*opt_functions[])(sabr_cmd_t* cmd);
 
@@ -0,0 +1,92 @@
+#ifndef __COMPACT_H__
+#define __COMPACT_H__
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "cctl_define.h"
+
+#include "error_message.h"
+
+#include "bcop.h"
+#include "bytecode.h"
+
+#define SABR_COMPACT_MAGIC "\0sbc"
+#define SABR_COMPACT_MAGIC_SIZE 4
+#define SABR_COMPACT_VERSION 1
+#define SABR_COMPACT_HEADER_SIZE 5
+#define SABR_COMPACT_OPERAND_SIZE 10
+
+inline uint64_t sabr_compact_zigzag(uint64_t v) {
+	return (v << 1) ^ (0 - (v >> 63));
+}
+
+inline uint64_t sabr_compact_unzigzag(uint64_t v) {
+	return (v >> 1) ^ (0 - (v & 1));
+}
+
+typedef enum sabr_compact_kind_enum {
+	SABR_COMPACT_KIND_NONE,
+	SABR_COMPACT_KIND_VALUE,
+	SABR_COMPACT_KIND_INDEX
+} sabr_compact_kind_t;
+
+inline size_t sabr_compact_decode(const uint8_t* code, size_t size, size_t pos, const uint8_t* kinds, sabr_bcop_t* bcop) {
+	if (pos >= size) return 0;
+	uint8_t kind = kinds[code[pos]];
+	bcop->oc = code[pos++];
+	bcop->operand.u = 0;
+	if (kind == SABR_COMPACT_KIND_NONE) return pos;
+	uint64_t v = 0;
+	for (unsigned shift = 0; pos < size && shift < SABR_COMPACT_OPERAND_SIZE * 7; shift += 7) {
+		uint8_t byte = code[pos++];
+		v |= (uint64_t) (byte & 0x7f) << shift;
+		if (byte & 0x80) continue;
+		bcop->operand.u = (kind == SABR_COMPACT_KIND_INDEX) ? v : sabr_compact_unzigzag(v);
+		return pos;
+	}
+	return 0;
+}
+
+inline const uint8_t* sabr_compact_operand(const uint8_t* code, uint64_t* v) {
+	uint64_t byte = *code++;
+	*v = byte & 0x7f;
+	for (unsigned shift = 7; byte & 0x80; shift += 7) {
+		byte = *code++;
+		*v |= (byte & 0x7f) << shift;
+	}
+	return code;
+}
+
+inline size_t sabr_compact_read(const uint8_t* code, size_t size, size_t pos, sabr_bcop_t* bcop) {
+	if (pos >= size) return 0;
+	bcop->oc = code[pos++];
+	bcop->operand.u = 0;
+	if (!sabr_opcode_has_operand(bcop->oc)) return pos;
+	uint64_t v = 0;
+	for (unsigned shift = 0; pos < size && shift < SABR_COMPACT_OPERAND_SIZE * 7; shift += 7) {
+		uint8_t byte = code[pos++];
+		v |= (uint64_t) (byte & 0x7f) << shift;
+		if (byte & 0x80) continue;
+		bcop->operand.u = sabr_opcode_has_index_operand(bcop->oc) ? v : sabr_compact_unzigzag(v);
+		return pos;
+	}
+	return 0;
+}
+
+void sabr_compact_kinds(uint8_t* kinds);
+bool sabr_compact_is_compact(const uint8_t* code, size_t size);
+bool sabr_compact_check(const uint8_t* code, size_t size);
+bool sabr_compact_check_switch(const uint8_t* code, size_t size, sabr_bcop_t bcop);
+bool sabr_compact_encode(sabr_bytecode_t* bc);
+bool sabr_compact_expand(sabr_bytecode_t* bc);
+size_t sabr_compact_begin(sabr_bytecode_t* bc);
+bool sabr_compact_next(sabr_bytecode_t* bc, size_t* pos, sabr_bcop_t* bcop);
+size_t sabr_compact_size(uint64_t v);
+size_t sabr_compact_write(uint8_t* out, uint64_t v, size_t width);
+
+#endif
\ No newline at end of file
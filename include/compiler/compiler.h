@@ -71,6 +71,9 @@ struct sabr_compiler_struct {
 	size_t identifier_count;
 	vector(cctl_ptr(vector(sabr_keyword_data_t))) keyword_data_stack;
 
+	vector(sabr_datagroup_data_t) datagroup_vector;
+	vector(sabr_value_t) member_vector;
+
 	size_t tab_size;
 
 	mbstate_t convert_state;
@@ -105,6 +108,10 @@ bool sabr_compiler_parse_string_escape_hex(char** ch_addr, char* num_parse_stop,
 bool sabr_compiler_parse_struct_member(sabr_compiler_t* const comp, const char* str, sabr_value_t* struct_v, sabr_value_t* member_v);
 
 bool sabr_compiler_compile_keyword(sabr_compiler_t* const comp, sabr_bytecode_t* bc_data, sabr_keyword_t kwrd);
+bool sabr_compiler_compile_datagroup_exec(sabr_compiler_t* const comp, sabr_bytecode_t* bc_data, sabr_value_t struct_v, sabr_value_t member_v);
+
+sabr_datagroup_data_t* sabr_compiler_find_datagroup(sabr_compiler_t* const comp, uint64_t identifier);
+bool sabr_compiler_find_member(sabr_compiler_t* const comp, sabr_datagroup_data_t* dg_data, uint64_t identifier, size_t* index);
 
 sabr_bcop_t* sabr_compiler_get_bcop(sabr_bytecode_t* bc_data, size_t index);
 
@@ -35,6 +35,9 @@ vector_imp_h(size_t);
 vector_fd(sabr_preproc_stop_flag_t);
 vector_imp_h(sabr_preproc_stop_flag_t);
 
+vector_fd(sabr_datagroup_data_t);
+vector_imp_h(sabr_datagroup_data_t);
+
 vector_fd(sabr_keyword_data_t);
 vector_imp_h(sabr_keyword_data_t);
 
@@ -3,6 +3,7 @@
 
 #define sabr_errmsg_open "error : Failed to open file\n"
 #define sabr_errmsg_read "error : Failed to read file\n"
+#define sabr_errmsg_write "error : Failed to write file\n"
 #define sabr_errmsg_fullpath "error : Failed to get full path\n"
 #define sabr_errmsg_alloc "error : Memory allocation failure\n"
 
@@ -10,6 +11,7 @@
 #define sabr_errmsg_preprocess "error : Preprocessing failure\n"
 
 #define sabr_errmsg_stackunderflow "error : Stack underflow occurred\n"
+#define sabr_errmsg_stackoverflow "error : Stack overflow occurred\n"
 
 #define sabr_errmsg_invalid_ident_fmt "error : Invalid identifier format\n"
 
@@ -32,4 +34,12 @@
 
 #define sabr_errmsg_unused_preproc_token "error : Unused preprocessor tokens remain\n"
 
+#define sabr_errmsg_invalid_bytecode "error : Invalid bytecode\n"
+#define sabr_errmsg_bytecode_format "error : Not a bytecode file\n"
+#define sabr_errmsg_bytecode_version "error : Unsupported bytecode version\n"
+#define sabr_errmsg_profile "error : Invalid profile\n"
+#define sabr_errmsg_profile_mismatch "warning : Profile does not match the bytecode and is ignored\n"
+
+#define sabr_errmsg_wrong_option_arg "error : Wrong option argument\n"
+
 #endif
\ No newline at end of file
@@ -25,6 +25,8 @@ typedef enum sabr_keyword_enum {
 	SABR_KWRD_MACRO,
 	SABR_KWRD_DEFER,
 	SABR_KWRD_RETURN,
+	SABR_KWRD_INLINE,
+	SABR_KWRD_NOINLINE,
 	SABR_KWRD_STRUCT,
 	SABR_KWRD_ENUM,
 	SABR_KWRD_MEMBER,
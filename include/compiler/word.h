@@ -31,6 +31,15 @@ union sabr_word_data_union {
 	sabr_opcode_t oc;
 };
 
+typedef struct sabr_datagroup_data_struct sabr_datagroup_data_t;
+struct sabr_datagroup_data_struct {
+	uint64_t identifier;
+	size_t member_index;
+	size_t member_count;
+	bool is_enum;
+	bool is_constant;
+};
+
 typedef struct sabr_word_struct sabr_word_t;
 struct sabr_word_struct {
 	sabr_word_type_t type;
@@ -0,0 +1,26 @@
+#ifndef __EMITTER_H__
+#define __EMITTER_H__
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <inttypes.h>
+
+#include "cctl_define.h"
+
+#include "error_message.h"
+
+#include "bcop.h"
+#include "bytecode.h"
+#include "interpreter_verifier.h"
+
+bool sabr_emitter_emit_c(sabr_bytecode_t* bc, const char* filename, size_t memory_pool_size, size_t data_stack_size);
+bool sabr_emitter_check(sabr_bytecode_t* bc);
+size_t sabr_emitter_write_image(sabr_bytecode_t* bc, FILE* file);
+void sabr_emitter_write_op(sabr_bytecode_t* bc, FILE* file, size_t index);
+bool sabr_emitter_write_switch(sabr_bytecode_t* bc, FILE* file, size_t index);
+void sabr_emitter_write_dispatch(sabr_bytecode_t* bc, FILE* file);
+size_t sabr_emitter_target(sabr_bytecode_t* bc, size_t index);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,28 @@
+#ifndef __FOLDER_H__
+#define __FOLDER_H__
+
+#include <math.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "cctl_define.h"
+
+#include "error_message.h"
+
+#include "bcop.h"
+#include "bytecode.h"
+
+#define SABR_FOLDER_STACK 64
+#define SABR_FOLDER_FRAME 32
+#define SABR_FOLDER_DEPTH 16
+#define SABR_FOLDER_STEPS 65536
+
+bool sabr_folder_run(sabr_bytecode_t* bc);
+bool sabr_folder_fold(sabr_bytecode_t* bc, size_t* run, size_t* count, size_t index);
+bool sabr_folder_call(sabr_bytecode_t* bc, size_t entry, sabr_value_t* stack, size_t* top, size_t* low, size_t depth, size_t* steps);
+bool sabr_folder_eval(sabr_bcop_t bcop, sabr_value_t* stack, size_t* top, size_t* low);
+bool sabr_folder_fits_int(double f);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,34 @@
+#ifndef __INLINER_H__
+#define __INLINER_H__
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "cctl_define.h"
+
+#include "error_message.h"
+
+#include "bcop.h"
+#include "bytecode.h"
+
+#define SABR_INLINER_THRESHOLD 16
+#define SABR_INLINER_HOT_THRESHOLD 64
+#define SABR_INLINER_DEPTH 4
+
+typedef enum sabr_inliner_hint_enum {
+	SABR_INLINER_HINT_NONE,
+	SABR_INLINER_HINT_INLINE,
+	SABR_INLINER_HINT_NOINLINE,
+	SABR_INLINER_HINT_HOT
+} sabr_inliner_hint_t;
+
+bool sabr_inliner_run(sabr_bytecode_t* bc, size_t* owners, bool* hot);
+bool sabr_inliner_is_inlinable(sabr_bcop_t* source, size_t* owners, size_t lambda, sabr_inliner_hint_t hint);
+bool sabr_inliner_is_site(sabr_bcop_t* source, size_t size, size_t* owners, bool* callees, size_t index);
+bool sabr_inliner_needs_zero(sabr_bcop_t* source, size_t entry, uint64_t slot);
+size_t sabr_inliner_zero_count(sabr_bcop_t* source, size_t entry);
+bool sabr_inliner_emit(sabr_bytecode_t* bc, sabr_bcop_t* source, size_t size, size_t* map, size_t* offsets, size_t site, uint64_t base);
+
+#endif
\ No newline at end of file
@@ -14,7 +14,10 @@
 	#include <io.h>
 	#include <windows.h>
 #else
+	#include <fcntl.h>
 	#include <unistd.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
 	#include <sys/types.h>
 #endif
 
@@ -22,6 +25,8 @@
 #include "rbt.h"
 #include "value.h"
 #include "bytecode.h"
+#include "compact.h"
+#include "profile.h"
 #include "error_message.h"
 // #include "encoding.h"
 #include "utils.h"
@@ -36,22 +41,58 @@ struct sabr_memory_pool_struct {
 	size_t index;
 };
 
+#define SABR_DATA_STACK_GUARD 2
+
+typedef struct sabr_data_stack_struct sabr_data_stack_t;
+struct sabr_data_stack_struct {
+	sabr_value_t* data;
+	size_t size;
+	size_t capacity;
+};
+
+typedef enum sabr_interpreter_engine_enum {
+	SABR_ENGINE_CLASSIC,
+	SABR_ENGINE_THREADED,
+	SABR_ENGINE_TOS,
+	SABR_ENGINE_REGISTER,
+	SABR_ENGINE_COMPACT
+} sabr_interpreter_engine_t;
+
+typedef enum sabr_interpreter_jit_enum {
+	SABR_JIT_OFF,
+	SABR_JIT_ON,
+	SABR_JIT_ALWAYS
+} sabr_interpreter_jit_t;
+
+#define SABR_JIT_THRESHOLD 1000
+
 typedef struct sabr_interpreter_struct sabr_interpreter_t;
 struct sabr_interpreter_struct {
 	sabr_bytecode_t* bc;
 
+	sabr_interpreter_engine_t engine;
+	sabr_interpreter_jit_t jit;
+	uint64_t jit_threshold;
+	bool perf_map;
+
 	mbstate_t convert_state;
 
-	deque(sabr_value_t) data_stack;
+	sabr_data_stack_t data_stack;
 
 	deque(sabr_value_t) switch_stack;
 	deque(sabr_for_data_t) for_data_stack;
+	sabr_for_record_t* for_record;
 	deque(sabr_local_data_t) local_data_stack;
+	sabr_value_t* frame;
 
 	deque(sabr_cs_data_t) call_stack;
 
 	sabr_memory_pool_t memory_pool;
 	sabr_memory_pool_t global_memory_pool;
+	sabr_value_t* globals;
+
+	uint64_t* pair_counts;
+	sabr_profile_t* profile;
 
 	rbt(sabr_def_data_t) global_words;
 
@@ -81,9 +122,23 @@ typedef enum sabr_interpreter_op_errcode_enum {
 bool sabr_interpreter_init(sabr_interpreter_t* inter);
 bool sabr_interpreter_del(sabr_interpreter_t* inter);
 bool sabr_interpreter_memory_pool_init(sabr_interpreter_t* inter, size_t size, size_t global_size);
+bool sabr_interpreter_data_stack_init(sabr_interpreter_t* inter, size_t size);
+bool sabr_interpreter_pair_counts_init(sabr_interpreter_t* inter);
+bool sabr_interpreter_profile_init(sabr_interpreter_t* inter, sabr_bytecode_t* bc);
+void sabr_interpreter_print_pair_counts(sabr_interpreter_t* inter, size_t limit);
+int sabr_interpreter_pair_count_compare(const void* a, const void* b);
 
 sabr_bytecode_t* sabr_interpreter_load_bytecode(sabr_interpreter_t* inter, const char* filename);
+sabr_bytecode_t* sabr_interpreter_load_bytecode_data(sabr_interpreter_t* inter, const uint8_t* code, size_t size);
 bool sabr_interpreter_run_bytecode(sabr_interpreter_t* inter, sabr_bytecode_t* bc);
+bool sabr_interpreter_bind_globals(sabr_interpreter_t* inter, sabr_bytecode_t* bc);
+bool sabr_interpreter_run_bytecode_classic(sabr_interpreter_t* inter, sabr_bytecode_t* bc);
+uint32_t sabr_interpreter_split_switch(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
+bool sabr_interpreter_run_bytecode_threaded(sabr_interpreter_t* inter, sabr_bytecode_t* bc);
+bool sabr_interpreter_run_bytecode_tos(sabr_interpreter_t* inter, sabr_bytecode_t* bc);
+bool sabr_interpreter_run_bytecode_register(sabr_interpreter_t* inter, sabr_bytecode_t* bc);
+bool sabr_interpreter_run_bytecode_compact(sabr_interpreter_t* inter, sabr_bytecode_t* bc);
+uint32_t sabr_interpreter_compact_switch(sabr_interpreter_t* inter, sabr_bcop_t bcop, const uint8_t* kinds, size_t* index);
 
 bool sabr_memory_pool_init(sabr_memory_pool_t* pool, size_t size);
 void sabr_memory_pool_del(sabr_memory_pool_t* pool);
@@ -93,13 +148,32 @@ inline sabr_value_t* sabr_memory_pool_top(sabr_memory_pool_t* pool) {
 	return pool->data + pool->index;
 }
 
-bool sabr_interpreter_pop(sabr_interpreter_t* inter, sabr_value_t* v);
-bool sabr_interpreter_push(sabr_interpreter_t* inter, sabr_value_t v);
+void sabr_interpreter_stack_underflow(void);
+void sabr_interpreter_stack_overflow(void);
+
+inline bool sabr_interpreter_pop(sabr_interpreter_t* inter, sabr_value_t* v) {
+	if (!inter->data_stack.size) {
+		sabr_interpreter_stack_underflow();
+		return false;
+	}
+	*v = inter->data_stack.data[--inter->data_stack.size];
+	return true;
+}
+
+inline bool sabr_interpreter_push(sabr_interpreter_t* inter, sabr_value_t v) {
+	if (inter->data_stack.size >= inter->data_stack.capacity) {
+		sabr_interpreter_stack_overflow();
+		return false;
+	}
+	inter->data_stack.data[inter->data_stack.size++] = v;
+	return true;
+}
 
 uint32_t sabr_interpreter_exec_identifier(sabr_interpreter_t* inter, sabr_value_t identifier, size_t* index);
 uint32_t sabr_interpreter_set_variable(sabr_interpreter_t* inter, sabr_value_t identifier, sabr_value_t v);
 uint32_t sabr_interpreter_ref_variable(sabr_interpreter_t* inter, sabr_value_t identifier, sabr_value_t* addr);
 sabr_value_t* sabr_interpreter_get_variable_addr(sabr_interpreter_t* inter, sabr_value_t identifier);
+rbt(sabr_def_data_t)* sabr_interpreter_get_local_words(sabr_interpreter_t* inter, bool create);
 
 bool sabr_interpreter_putc(sabr_interpreter_t* inter, sabr_value_t character);
 
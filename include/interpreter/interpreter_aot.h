@@ -0,0 +1,364 @@
+#ifndef __INTERPRETER_AOT_H__
+#define __INTERPRETER_AOT_H__
+
+#include "interpreter.h"
+#include "interpreter_op.h"
+
+#if defined(__GNUC__)
+	#define sabr_aot_unlikely(X) __builtin_expect(!!(X), 0)
+#else
+	#define sabr_aot_unlikely(X) (X)
+#endif
+
+typedef bool (*sabr_aot_program_t)(sabr_interpreter_t* inter, sabr_bytecode_t* bc);
+
+int sabr_interpreter_aot_main(const uint8_t* image, size_t size, sabr_aot_program_t program, size_t memory_pool_size, size_t data_stack_size);
+
+#define SABR_AOT_ENTER() \
+	bool succeed = false; \
+	uint32_t result = SABR_OPERR_NONE; \
+	size_t index = 0; \
+	size_t end = 0; \
+	sabr_value_t* base = inter->data_stack.data; \
+	sabr_value_t* sp = base + inter->data_stack.size; \
+	size_t capacity = inter->data_stack.capacity; \
+	(void) capacity;
+
+#define SABR_AOT_LEAVE() \
+CHECKED: { \
+		inter->data_stack.size = sp - base; \
+		while (index < end) { \
+			sabr_bcop_t bcop = *vector_at(sabr_bcop_t, &bc->bcop_vec, index); \
+			size_t current = index; \
+			if (bcop.oc == SABR_OP_EXIT) { \
+				sp = base + inter->data_stack.size; \
+				SABR_AOT_END(); \
+			} \
+			if (bcop.oc != SABR_OP_NONE) { \
+				result = sabr_interpreter_op_functions[bcop.oc - 1](inter, bcop, &index); \
+				if (result) { \
+					sp = base + inter->data_stack.size; \
+					goto FAILURE; \
+				} \
+			} \
+			index++; \
+			if (index != current + 1) break; \
+		} \
+		sp = base + inter->data_stack.size; \
+		goto DISPATCH; \
+	} \
+FAILURE: \
+	fprintf(stderr, "result: %u, index: %zu\n", result, index); \
+FREE_ALL: \
+	inter->data_stack.size = sp - base; \
+	return succeed;
+
+#define SABR_AOT_END() do { succeed = true; goto FREE_ALL; } while (0)
+#define SABR_AOT_FAIL(I, ERRCODE) do { index = (I); result = (ERRCODE); goto FAILURE; } while (0)
+
+#define SABR_AOT_BLOCK(I, END, NEED, GROW) { \
+	size_t depth = sp - base; \
+	if (sabr_aot_unlikely(depth < (NEED) || (GROW) > capacity - depth)) { \
+		index = (I); \
+		end = (END); \
+		goto CHECKED; \
+	} \
+}
+
+#define SABR_AOT_GENERIC(I) { \
+	sabr_bcop_t bcop = *vector_at(sabr_bcop_t, &bc->bcop_vec, I); \
+	index = (I); \
+	inter->data_stack.size = sp - base; \
+	result = sabr_interpreter_op_functions[bcop.oc - 1](inter, bcop, &index); \
+	sp = base + inter->data_stack.size; \
+	if (sabr_aot_unlikely(result)) goto FAILURE; \
+	if (index != (I)) { \
+		index++; \
+		goto DISPATCH; \
+	} \
+}
+
+#define SABR_AOT_GENERIC_BRANCH(I, TARGET) { \
+	sabr_bcop_t bcop = *vector_at(sabr_bcop_t, &bc->bcop_vec, I); \
+	index = (I); \
+	inter->data_stack.size = sp - base; \
+	result = sabr_interpreter_op_functions[bcop.oc - 1](inter, bcop, &index); \
+	sp = base + inter->data_stack.size; \
+	if (sabr_aot_unlikely(result)) goto FAILURE; \
+	if (index != (I)) goto TARGET; \
+}
+
+#define SABR_AOT_UNARY(EXPR) { \
+	sabr_value_t a = sp[-1]; \
+	EXPR; \
+	sp[-1] = a; \
+}
+
+#define SABR_AOT_BINARY(EXPR) { \
+	sabr_value_t a = sp[-2]; \
+	sabr_value_t b = sp[-1]; \
+	EXPR; \
+	sp[-2] = a; \
+	sp--; \
+}
+
+#define SABR_AOT_DIVISION(I, CHECK, EXPR) { \
+	sabr_value_t a = sp[-2]; \
+	sabr_value_t b = sp[-1]; \
+	if (sabr_aot_unlikely(CHECK)) SABR_AOT_FAIL(I, SABR_OPERR_DIV_BY_ZERO); \
+	EXPR; \
+	sp[-2] = a; \
+	sp--; \
+}
+
+#define SABR_AOT_BRANCH(COND, TARGET) { \
+	sabr_value_t a = sp[-2]; \
+	sabr_value_t b = sp[-1]; \
+	sp -= 2; \
+	if (!(COND)) goto TARGET; \
+}
+
+#define SABR_AOT_MEMORY_UNARY(EXPR) { \
+	sabr_value_t a = { .u = *sp[-1].p }; \
+	EXPR; \
+	*sp[-1].p = a.u; \
+	sp--; \
+}
+
+#define SABR_AOT_MEMORY_BINARY(EXPR) { \
+	sabr_value_t a = { .u = *sp[-1].p }; \
+	sabr_value_t b = sp[-2]; \
+	EXPR; \
+	*sp[-1].p = a.u; \
+	sp -= 2; \
+}
+
+#define SABR_AOT_MEMORY_DIVISION(I, CHECK, EXPR) { \
+	sabr_value_t a = { .u = *sp[-1].p }; \
+	sabr_value_t b = sp[-2]; \
+	if (sabr_aot_unlikely(CHECK)) SABR_AOT_FAIL(I, SABR_OPERR_DIV_BY_ZERO); \
+	EXPR; \
+	*sp[-1].p = a.u; \
+	sp -= 2; \
+}
+
+#define SABR_AOT_FOR(I, FIELD, COND, TARGET) { \
+	sabr_for_record_t* record = inter->for_record; \
+	if (sabr_aot_unlikely(!record)) SABR_AOT_FAIL(I, SABR_OPERR_FOR); \
+	sabr_value_t* v = record->variable; \
+	v->FIELD += record->step.FIELD; \
+	if (COND) goto TARGET; \
+	v->FIELD -= record->step.FIELD; \
+}
+
+#define SABR_AOT_OP_NONE(I, OPERAND)
+#define SABR_AOT_OP_EXIT(I, OPERAND) SABR_AOT_END()
+#define SABR_AOT_OP_VALUE(I, OPERAND) { sp->u = OPERAND; sp++; }
+#define SABR_AOT_OP_IF(I, OPERAND, TARGET) { sp--; if (!sp->u) goto TARGET; }
+#define SABR_AOT_OP_JUMP(I, OPERAND, TARGET) goto TARGET
+#define SABR_AOT_OP_FOR(I, OPERAND) SABR_AOT_GENERIC(I)
+#define SABR_AOT_OP_FOR_ADDR(I, OPERAND) SABR_AOT_GENERIC(I)
+#define SABR_AOT_OP_FOR_FROM(I, OPERAND) SABR_AOT_GENERIC(I)
+#define SABR_AOT_OP_FOR_TO(I, OPERAND) SABR_AOT_GENERIC(I)
+#define SABR_AOT_OP_FOR_STEP(I, OPERAND) SABR_AOT_GENERIC(I)
+#define SABR_AOT_OP_FOR_CHECK(I, OPERAND, TARGET) SABR_AOT_GENERIC(I)
+#define SABR_AOT_OP_FOR_NEXT(I, OPERAND, TARGET) SABR_AOT_GENERIC(I)
+#define SABR_AOT_OP_FOR_END(I, OPERAND) SABR_AOT_GENERIC(I)
+#define SABR_AOT_OP_FOR_INIT(I, OPERAND) SABR_AOT_GENERIC(I)
+#define SABR_AOT_OP_FOR_TO_I(I, OPERAND) SABR_AOT_GENERIC(I)
+#define SABR_AOT_OP_FOR_TO_U(I, OPERAND) SABR_AOT_GENERIC(I)
+#define SABR_AOT_OP_FOR_TO_F(I, OPERAND) SABR_AOT_GENERIC(I)
+#define SABR_AOT_OP_FOR_ENTER_I(I, OPERAND, TARGET) SABR_AOT_GENERIC_BRANCH(I, TARGET)
+#define SABR_AOT_OP_FOR_ENTER_U(I, OPERAND, TARGET) SABR_AOT_GENERIC_BRANCH(I, TARGET)
+#define SABR_AOT_OP_FOR_ENTER_F(I, OPERAND, TARGET) SABR_AOT_GENERIC_BRANCH(I, TARGET)
+#define SABR_AOT_OP_FOR_LOOP_I(I, OPERAND, TARGET) SABR_AOT_FOR(I, i, (record->step.i > 0) ? v->i < record->end.i : v->i > record->end.i, TARGET)
+#define SABR_AOT_OP_FOR_LOOP_U(I, OPERAND, TARGET) SABR_AOT_FOR(I, u, (record->step.u > 0) ? v->u < record->end.u : v->u > record->end.u, TARGET)
+#define SABR_AOT_OP_FOR_LOOP_F(I, OPERAND, TARGET) SABR_AOT_FOR(I, f, (record->step.f > 0.0) ? v->f < record->end.f : v->f > record->end.f, TARGET)
+#define SABR_AOT_OP_FOR_UP_I(I, OPERAND, TARGET) SABR_AOT_FOR(I, i, v->i < record->end.i, TARGET)
+#define SABR_AOT_OP_FOR_UP_U(I, OPERAND, TARGET) SABR_AOT_FOR(I, u, v->u < record->end.u, TARGET)
+#define SABR_AOT_OP_FOR_UP_F(I, OPERAND, TARGET) SABR_AOT_FOR(I, f, v->f < record->end.f, TARGET)
+#define SABR_AOT_OP_FOR_DOWN_I(I, OPERAND, TARGET) SABR_AOT_FOR(I, i, v->i > record->end.i, TARGET)
+#define SABR_AOT_OP_FOR_DOWN_U(I, OPERAND, TARGET) SABR_AOT_FOR(I, u, v->u > record->end.u, TARGET)
+#define SABR_AOT_OP_FOR_DOWN_F(I, OPERAND, TARGET) SABR_AOT_FOR(I, f, v->f > record->end.f, TARGET)
+#define SABR_AOT_OP_FOR_LEAVE(I, OPERAND) SABR_AOT_GENERIC(I)
+#define SABR_AOT_OP_SWITCH(I, OPERAND) SABR_AOT_GENERIC(I)
+#define SABR_AOT_OP_SWITCH_CASE(I, OPERAND) SABR_AOT_GENERIC(I)
+#define SABR_AOT_OP_SWITCH_END(I, OPERAND) SABR_AOT_GENERIC(I)
+#define SABR_AOT_OP_CASE_IF(I, OPERAND, TARGET) { \
+	sabr_value_t* switch_value = deque_back(sabr_value_t, &inter->switch_stack); \
+	if (sabr_aot_unlikely(!switch_value)) SABR_AOT_FAIL(I, SABR_OPERR_SWITCH); \
+	sp--; \
+	if (switch_value->u != sp->u) goto TARGET; \
+}
+#define SABR_AOT_OP_SWITCH_TABLE(I, OPERAND, TARGET) SABR_AOT_GENERIC(I)
+#define SABR_AOT_OP_SWITCH_SEARCH(I, OPERAND, TARGET) SABR_AOT_GENERIC(I)
+#define SABR_AOT_OP_LAMBDA(I, OPERAND, TARGET) SABR_AOT_GENERIC_BRANCH(I, TARGET)
+#define SABR_AOT_OP_RETURN(I, OPERAND) { \
+	if (sabr_aot_unlikely(!inter->call_stack.size)) SABR_AOT_FAIL(I, SABR_OPERR_EXEC); \
+	index = deque_back(sabr_cs_data_t, &inter->call_stack)->pos; \
+	deque_pop_back(sabr_cs_data_t, &inter->call_stack); \
+	goto DISPATCH; \
+}
+#define SABR_AOT_OP_LOCAL(I, OPERAND) SABR_AOT_GENERIC(I)
+#define SABR_AOT_OP_LOCAL_END(I, OPERAND) SABR_AOT_GENERIC(I)
+#define SABR_AOT_OP_DEFINE(I, OPERAND) SABR_AOT_GENERIC(I)
+#define SABR_AOT_OP_INLINE(I, OPERAND) SABR_AOT_GENERIC(I)
+#define SABR_AOT_OP_NOINLINE(I, OPERAND) SABR_AOT_GENERIC(I)
+#define SABR_AOT_OP_DATAGROUP(I, OPERAND) SABR_AOT_GENERIC(I)
+#define SABR_AOT_OP_MEMBER(I, OPERAND) SABR_AOT_GENERIC(I)
+#define SABR_AOT_OP_DATAGROUP_END(I, OPERAND) SABR_AOT_GENERIC(I)
+#define SABR_AOT_OP_DATAGROUP_EXEC(I, OPERAND) SABR_AOT_GENERIC(I)
+#define SABR_AOT_OP_SET(I, OPERAND) SABR_AOT_GENERIC(I)
+#define SABR_AOT_OP_EXEC(I, OPERAND) SABR_AOT_GENERIC(I)
+#define SABR_AOT_OP_CALL(I, OPERAND, TARGET) { \
+	sabr_cs_data_t csd; \
+	csd.pos = (I) + 1; \
+	if (sabr_aot_unlikely(!deque_push_back(sabr_cs_data_t, &inter->call_stack, csd))) SABR_AOT_FAIL(I, SABR_OPERR_WHAT); \
+	goto TARGET; \
+}
+#define SABR_AOT_OP_TAILCALL(I, OPERAND, TARGET) SABR_AOT_GENERIC_BRANCH(I, TARGET)
+#define SABR_AOT_OP_ADDR(I, OPERAND) SABR_AOT_GENERIC(I)
+#define SABR_AOT_OP_REF(I, OPERAND) SABR_AOT_GENERIC(I)
+#define SABR_AOT_OP_LOAD_LOCAL(I, OPERAND) { *sp++ = inter->frame[OPERAND]; }
+#define SABR_AOT_OP_STORE_LOCAL(I, OPERAND) { inter->frame[OPERAND] = *--sp; }
+#define SABR_AOT_OP_ADDR_LOCAL(I, OPERAND) { sp->p = (uint64_t*) (inter->frame + (OPERAND)); sp++; }
+#define SABR_AOT_OP_INC_LOCAL(I, OPERAND) { inter->frame[OPERAND].i++; }
+#define SABR_AOT_OP_DEC_LOCAL(I, OPERAND) { inter->frame[OPERAND].i--; }
+#define SABR_AOT_OP_ADD_LOCAL(I, OPERAND) { inter->frame[OPERAND].i += (--sp)->i; }
+#define SABR_AOT_OP_FADD_LOCAL(I, OPERAND) { inter->frame[OPERAND].f += (--sp)->f; }
+#define SABR_AOT_OP_LOAD_GLOBAL(I, OPERAND) { *sp++ = inter->globals[OPERAND]; }
+#define SABR_AOT_OP_STORE_GLOBAL(I, OPERAND) { inter->globals[OPERAND] = *--sp; }
+#define SABR_AOT_OP_ADDR_GLOBAL(I, OPERAND) { sp->p = (uint64_t*) (inter->globals + (OPERAND)); sp++; }
+#define SABR_AOT_OP_INC_GLOBAL(I, OPERAND) { inter->globals[OPERAND].i++; }
+#define SABR_AOT_OP_DEC_GLOBAL(I, OPERAND) { inter->globals[OPERAND].i--; }
+#define SABR_AOT_OP_ADD_GLOBAL(I, OPERAND) { inter->globals[OPERAND].i += (--sp)->i; }
+#define SABR_AOT_OP_FADD_GLOBAL(I, OPERAND) { inter->globals[OPERAND].f += (--sp)->f; }
+#define SABR_AOT_OP_CALL_BIF(I, OPERAND) SABR_AOT_GENERIC(I)
+#define SABR_AOT_OP_ADD(I, OPERAND) SABR_AOT_BINARY(a.i = a.i + b.i)
+#define SABR_AOT_OP_SUB(I, OPERAND) SABR_AOT_BINARY(a.i = a.i - b.i)
+#define SABR_AOT_OP_MUL(I, OPERAND) SABR_AOT_BINARY(a.i = a.i * b.i)
+#define SABR_AOT_OP_DIV(I, OPERAND) SABR_AOT_DIVISION(I, b.i == 0, a.i = a.i / b.i)
+#define SABR_AOT_OP_MOD(I, OPERAND) SABR_AOT_DIVISION(I, b.i == 0, a.i = a.i % b.i)
+#define SABR_AOT_OP_UDIV(I, OPERAND) SABR_AOT_DIVISION(I, b.u == 0, a.u = a.u / b.u)
+#define SABR_AOT_OP_UMOD(I, OPERAND) SABR_AOT_DIVISION(I, b.u == 0, a.u = a.u % b.u)
+#define SABR_AOT_OP_NEG(I, OPERAND) SABR_AOT_UNARY(a.i = -a.i)
+#define SABR_AOT_OP_INC(I, OPERAND) SABR_AOT_UNARY(a.i++)
+#define SABR_AOT_OP_DEC(I, OPERAND) SABR_AOT_UNARY(a.i--)
+#define SABR_AOT_OP_ADD_IMM(I, OPERAND) SABR_AOT_UNARY(a.i = a.i + (int64_t) (OPERAND))
+#define SABR_AOT_OP_MUL_IMM(I, OPERAND) SABR_AOT_UNARY(a.i = a.i * (int64_t) (OPERAND))
+#define SABR_AOT_OP_EQU(I, OPERAND) SABR_AOT_BINARY(a.u = (a.i == b.i) ? -1 : 0)
+#define SABR_AOT_OP_NEQ(I, OPERAND) SABR_AOT_BINARY(a.u = (a.i != b.i) ? -1 : 0)
+#define SABR_AOT_OP_GRT(I, OPERAND) SABR_AOT_BINARY(a.u = (a.i > b.i) ? -1 : 0)
+#define SABR_AOT_OP_GEQ(I, OPERAND) SABR_AOT_BINARY(a.u = (a.i >= b.i) ? -1 : 0)
+#define SABR_AOT_OP_LST(I, OPERAND) SABR_AOT_BINARY(a.u = (a.i < b.i) ? -1 : 0)
+#define SABR_AOT_OP_LEQ(I, OPERAND) SABR_AOT_BINARY(a.u = (a.i <= b.i) ? -1 : 0)
+#define SABR_AOT_OP_UGRT(I, OPERAND) SABR_AOT_BINARY(a.u = (a.u > b.u) ? -1 : 0)
+#define SABR_AOT_OP_UGEQ(I, OPERAND) SABR_AOT_BINARY(a.u = (a.u >= b.u) ? -1 : 0)
+#define SABR_AOT_OP_ULST(I, OPERAND) SABR_AOT_BINARY(a.u = (a.u < b.u) ? -1 : 0)
+#define SABR_AOT_OP_ULEQ(I, OPERAND) SABR_AOT_BINARY(a.u = (a.u <= b.u) ? -1 : 0)
+#define SABR_AOT_OP_LST_IF(I, OPERAND, TARGET) SABR_AOT_BRANCH(a.i < b.i, TARGET)
+#define SABR_AOT_OP_EQU_IF(I, OPERAND, TARGET) SABR_AOT_BRANCH(a.i == b.i, TARGET)
+#define SABR_AOT_OP_NEQ_IF(I, OPERAND, TARGET) SABR_AOT_BRANCH(a.i != b.i, TARGET)
+#define SABR_AOT_OP_GRT_IF(I, OPERAND, TARGET) SABR_AOT_BRANCH(a.i > b.i, TARGET)
+#define SABR_AOT_OP_GEQ_IF(I, OPERAND, TARGET) SABR_AOT_BRANCH(a.i >= b.i, TARGET)
+#define SABR_AOT_OP_LEQ_IF(I, OPERAND, TARGET) SABR_AOT_BRANCH(a.i <= b.i, TARGET)
+#define SABR_AOT_OP_UGRT_IF(I, OPERAND, TARGET) SABR_AOT_BRANCH(a.u > b.u, TARGET)
+#define SABR_AOT_OP_UGEQ_IF(I, OPERAND, TARGET) SABR_AOT_BRANCH(a.u >= b.u, TARGET)
+#define SABR_AOT_OP_ULST_IF(I, OPERAND, TARGET) SABR_AOT_BRANCH(a.u < b.u, TARGET)
+#define SABR_AOT_OP_ULEQ_IF(I, OPERAND, TARGET) SABR_AOT_BRANCH(a.u <= b.u, TARGET)
+#define SABR_AOT_OP_EQU_IMM(I, OPERAND) SABR_AOT_UNARY(a.u = (a.i == (int64_t) (OPERAND)) ? -1 : 0)
+#define SABR_AOT_OP_NEQ_IMM(I, OPERAND) SABR_AOT_UNARY(a.u = (a.i != (int64_t) (OPERAND)) ? -1 : 0)
+#define SABR_AOT_OP_GRT_IMM(I, OPERAND) SABR_AOT_UNARY(a.u = (a.i > (int64_t) (OPERAND)) ? -1 : 0)
+#define SABR_AOT_OP_GEQ_IMM(I, OPERAND) SABR_AOT_UNARY(a.u = (a.i >= (int64_t) (OPERAND)) ? -1 : 0)
+#define SABR_AOT_OP_LST_IMM(I, OPERAND) SABR_AOT_UNARY(a.u = (a.i < (int64_t) (OPERAND)) ? -1 : 0)
+#define SABR_AOT_OP_LEQ_IMM(I, OPERAND) SABR_AOT_UNARY(a.u = (a.i <= (int64_t) (OPERAND)) ? -1 : 0)
+#define SABR_AOT_OP_FADD(I, OPERAND) SABR_AOT_BINARY(a.f = a.f + b.f)
+#define SABR_AOT_OP_FSUB(I, OPERAND) SABR_AOT_BINARY(a.f = a.f - b.f)
+#define SABR_AOT_OP_FMUL(I, OPERAND) SABR_AOT_BINARY(a.f = a.f * b.f)
+#define SABR_AOT_OP_FDIV(I, OPERAND) SABR_AOT_DIVISION(I, b.f == 0.0f, a.f = a.f / b.f)
+#define SABR_AOT_OP_FMOD(I, OPERAND) SABR_AOT_DIVISION(I, b.f == 0.0f, a.f = fmod(a.f, b.f))
+#define SABR_AOT_OP_FNEG(I, OPERAND) SABR_AOT_UNARY(a.f = -a.f)
+#define SABR_AOT_OP_FEQU(I, OPERAND) SABR_AOT_BINARY(a.u = (a.f == b.f) ? -1 : 0)
+#define SABR_AOT_OP_FNEQ(I, OPERAND) SABR_AOT_BINARY(a.u = (a.f != b.f) ? -1 : 0)
+#define SABR_AOT_OP_FGRT(I, OPERAND) SABR_AOT_BINARY(a.u = (a.f > b.f) ? -1 : 0)
+#define SABR_AOT_OP_FGEQ(I, OPERAND) SABR_AOT_BINARY(a.u = (a.f >= b.f) ? -1 : 0)
+#define SABR_AOT_OP_FLST(I, OPERAND) SABR_AOT_BINARY(a.u = (a.f < b.f) ? -1 : 0)
+#define SABR_AOT_OP_FLEQ(I, OPERAND) SABR_AOT_BINARY(a.u = (a.f <= b.f) ? -1 : 0)
+#define SABR_AOT_OP_FEQU_IF(I, OPERAND, TARGET) SABR_AOT_BRANCH(a.f == b.f, TARGET)
+#define SABR_AOT_OP_FNEQ_IF(I, OPERAND, TARGET) SABR_AOT_BRANCH(a.f != b.f, TARGET)
+#define SABR_AOT_OP_FGRT_IF(I, OPERAND, TARGET) SABR_AOT_BRANCH(a.f > b.f, TARGET)
+#define SABR_AOT_OP_FGEQ_IF(I, OPERAND, TARGET) SABR_AOT_BRANCH(a.f >= b.f, TARGET)
+#define SABR_AOT_OP_FLST_IF(I, OPERAND, TARGET) SABR_AOT_BRANCH(a.f < b.f, TARGET)
+#define SABR_AOT_OP_FLEQ_IF(I, OPERAND, TARGET) SABR_AOT_BRANCH(a.f <= b.f, TARGET)
+#define SABR_AOT_OP_BAND(I, OPERAND) SABR_AOT_BINARY(a.u = a.u & b.u)
+#define SABR_AOT_OP_BOR(I, OPERAND) SABR_AOT_BINARY(a.u = a.u | b.u)
+#define SABR_AOT_OP_BXOR(I, OPERAND) SABR_AOT_BINARY(a.u = a.u ^ b.u)
+#define SABR_AOT_OP_BNOT(I, OPERAND) SABR_AOT_UNARY(a.u = ~a.u)
+#define SABR_AOT_OP_BLSFT(I, OPERAND) SABR_AOT_BINARY(a.u = a.u << b.u)
+#define SABR_AOT_OP_BRSFT(I, OPERAND) SABR_AOT_BINARY(a.u = a.u >> b.u)
+#define SABR_AOT_OP_BAND_IMM(I, OPERAND) SABR_AOT_UNARY(a.u = a.u & (OPERAND))
+#define SABR_AOT_OP_BLSFT_IMM(I, OPERAND) SABR_AOT_UNARY(a.u = a.u << (OPERAND))
+#define SABR_AOT_OP_BRSFT_IMM(I, OPERAND) SABR_AOT_UNARY(a.u = a.u >> (OPERAND))
+#define SABR_AOT_OP_DROP(I, OPERAND) { sp--; }
+#define SABR_AOT_OP_NIP(I, OPERAND) { sp--; }
+#define SABR_AOT_OP_DUP(I, OPERAND) { sp[0] = sp[-1]; sp++; }
+#define SABR_AOT_OP_OVER(I, OPERAND) { sp[0] = sp[-2]; sp++; }
+#define SABR_AOT_OP_TUCK(I, OPERAND) { sabr_value_t b = sp[-1]; sp[-1] = sp[-2]; sp[-2] = b; sp[0] = b; sp++; }
+#define SABR_AOT_OP_SWAP(I, OPERAND) { sabr_value_t b = sp[-1]; sp[-1] = sp[-2]; sp[-2] = b; }
+#define SABR_AOT_OP_ROT(I, OPERAND) { sabr_value_t a = sp[-3]; sp[-3] = sp[-2]; sp[-2] = sp[-1]; sp[-1] = a; }
+#define SABR_AOT_OP_TDROP(I, OPERAND) SABR_AOT_GENERIC(I)
+#define SABR_AOT_OP_TNIP(I, OPERAND) SABR_AOT_GENERIC(I)
+#define SABR_AOT_OP_TDUP(I, OPERAND) SABR_AOT_GENERIC(I)
+#define SABR_AOT_OP_TOVER(I, OPERAND) SABR_AOT_GENERIC(I)
+#define SABR_AOT_OP_TTUCK(I, OPERAND) SABR_AOT_GENERIC(I)
+#define SABR_AOT_OP_TSWAP(I, OPERAND) SABR_AOT_GENERIC(I)
+#define SABR_AOT_OP_TROT(I, OPERAND) SABR_AOT_GENERIC(I)
+#define SABR_AOT_OP_ALLOC(I, OPERAND) SABR_AOT_GENERIC(I)
+#define SABR_AOT_OP_RESIZE(I, OPERAND) SABR_AOT_GENERIC(I)
+#define SABR_AOT_OP_FREE(I, OPERAND) SABR_AOT_GENERIC(I)
+#define SABR_AOT_OP_ALLOT(I, OPERAND) SABR_AOT_GENERIC(I)
+#define SABR_AOT_OP_FETCH(I, OPERAND) SABR_AOT_UNARY(a.u = *a.p)
+#define SABR_AOT_OP_STORE(I, OPERAND) { sp -= 2; *sp[1].p = sp[0].u; }
+#define SABR_AOT_OP_INC_MEM(I, OPERAND) SABR_AOT_MEMORY_UNARY(a.i++)
+#define SABR_AOT_OP_DEC_MEM(I, OPERAND) SABR_AOT_MEMORY_UNARY(a.i--)
+#define SABR_AOT_OP_ADD_MEM(I, OPERAND) SABR_AOT_MEMORY_BINARY(a.i = a.i + b.i)
+#define SABR_AOT_OP_SUB_MEM(I, OPERAND) SABR_AOT_MEMORY_BINARY(a.i = a.i - b.i)
+#define SABR_AOT_OP_MUL_MEM(I, OPERAND) SABR_AOT_MEMORY_BINARY(a.i = a.i * b.i)
+#define SABR_AOT_OP_DIV_MEM(I, OPERAND) SABR_AOT_MEMORY_DIVISION(I, b.i == 0, a.i = a.i / b.i)
+#define SABR_AOT_OP_MOD_MEM(I, OPERAND) SABR_AOT_MEMORY_DIVISION(I, b.i == 0, a.i = a.i % b.i)
+#define SABR_AOT_OP_FADD_MEM(I, OPERAND) SABR_AOT_MEMORY_BINARY(a.f = a.f + b.f)
+#define SABR_AOT_OP_FSUB_MEM(I, OPERAND) SABR_AOT_MEMORY_BINARY(a.f = a.f - b.f)
+#define SABR_AOT_OP_FMUL_MEM(I, OPERAND) SABR_AOT_MEMORY_BINARY(a.f = a.f * b.f)
+#define SABR_AOT_OP_FDIV_MEM(I, OPERAND) SABR_AOT_MEMORY_DIVISION(I, b.f == 0.0f, a.f = a.f / b.f)
+#define SABR_AOT_OP_FMOD_MEM(I, OPERAND) SABR_AOT_MEMORY_DIVISION(I, b.f == 0.0f, a.f = fmod(a.f, b.f))
+#define SABR_AOT_OP_BAND_MEM(I, OPERAND) SABR_AOT_MEMORY_BINARY(a.u = a.u & b.u)
+#define SABR_AOT_OP_BOR_MEM(I, OPERAND) SABR_AOT_MEMORY_BINARY(a.u = a.u | b.u)
+#define SABR_AOT_OP_BXOR_MEM(I, OPERAND) SABR_AOT_MEMORY_BINARY(a.u = a.u ^ b.u)
+#define SABR_AOT_OP_BNOT_MEM(I, OPERAND) SABR_AOT_MEMORY_UNARY(a.u = ~a.u)
+#define SABR_AOT_OP_BLSFT_MEM(I, OPERAND) SABR_AOT_MEMORY_BINARY(a.u = a.u << b.u)
+#define SABR_AOT_OP_BRSFT_MEM(I, OPERAND) SABR_AOT_MEMORY_BINARY(a.u = a.u >> b.u)
+#define SABR_AOT_OP_INDEX_CELL(I, OPERAND) SABR_AOT_BINARY(a.u = b.u + a.u * sizeof(sabr_value_t))
+#define SABR_AOT_OP_FETCH_IDX(I, OPERAND) SABR_AOT_BINARY(a.u = b.p[a.u])
+#define SABR_AOT_OP_STORE_IDX(I, OPERAND) { sp -= 3; sp[2].p[sp[1].u] = sp[0].u; }
+#define SABR_AOT_OP_FETCH_OFF(I, OPERAND) SABR_AOT_UNARY(a.u = *(uint64_t*) (a.u + (OPERAND)))
+#define SABR_AOT_OP_STORE_OFF(I, OPERAND) { sp -= 2; *(uint64_t*) (sp[1].u + (OPERAND)) = sp[0].u; }
+#define SABR_AOT_OP_ARRAY(I, OPERAND) SABR_AOT_GENERIC(I)
+#define SABR_AOT_OP_ARRAY_COMMA(I, OPERAND) SABR_AOT_GENERIC(I)
+#define SABR_AOT_OP_ARRAY_END(I, OPERAND) SABR_AOT_GENERIC(I)
+#define SABR_AOT_OP_ITOF(I, OPERAND) SABR_AOT_UNARY(a.f = (double) a.i)
+#define SABR_AOT_OP_UTOF(I, OPERAND) SABR_AOT_UNARY(a.f = (double) a.u)
+#define SABR_AOT_OP_FTOI(I, OPERAND) SABR_AOT_UNARY(a.i = (int64_t) a.f)
+#define SABR_AOT_OP_FTOU(I, OPERAND) SABR_AOT_UNARY(a.u = (int64_t) a.f)
+#define SABR_AOT_OP_GETC(I, OPERAND) SABR_AOT_GENERIC(I)
+#define SABR_AOT_OP_GETI(I, OPERAND) SABR_AOT_GENERIC(I)
+#define SABR_AOT_OP_GETU(I, OPERAND) SABR_AOT_GENERIC(I)
+#define SABR_AOT_OP_GETF(I, OPERAND) SABR_AOT_GENERIC(I)
+#define SABR_AOT_OP_GETS(I, OPERAND) SABR_AOT_GENERIC(I)
+#define SABR_AOT_OP_PUTC(I, OPERAND) SABR_AOT_GENERIC(I)
+#define SABR_AOT_OP_PUTI(I, OPERAND) SABR_AOT_GENERIC(I)
+#define SABR_AOT_OP_PUTU(I, OPERAND) SABR_AOT_GENERIC(I)
+#define SABR_AOT_OP_PUTF(I, OPERAND) SABR_AOT_GENERIC(I)
+#define SABR_AOT_OP_PUTS(I, OPERAND) SABR_AOT_GENERIC(I)
+#define SABR_AOT_OP_SHOW(I, OPERAND) SABR_AOT_GENERIC(I)
+
+#endif
\ No newline at end of file
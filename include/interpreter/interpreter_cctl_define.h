@@ -20,6 +20,7 @@ deque_fd(sabr_cs_data_t);
 deque_fd(sabr_local_data_t);
 
 vector_fd(sabr_value_t);
+vector_fd(sabr_block_data_t);
 cctl_ptr_def(vector(sabr_value_t));
 vector_fd(cctl_ptr(vector(sabr_value_t)));
 
@@ -32,5 +33,6 @@ deque_imp_h(sabr_cs_data_t);
 deque_imp_h(sabr_local_data_t);
 
 vector_imp_h(cctl_ptr(vector(sabr_value_t)));
+vector_imp_h(sabr_block_data_t);
 
 #endif
\ No newline at end of file
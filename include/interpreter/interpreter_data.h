@@ -3,6 +3,7 @@
 
 #include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
 
 #include "value.h"
 
@@ -26,6 +27,14 @@ struct for_data_struct {
     bool is_infinite;
 };
 
+typedef struct for_record_struct sabr_for_record_t;
+struct for_record_struct {
+    sabr_value_t* variable;
+    sabr_value_t end;
+    sabr_value_t step;
+    sabr_for_record_t* prev;
+};
+
 typedef struct sabr_cs_data_struct sabr_cs_data_t;
 struct sabr_cs_data_struct {
     size_t pos;
@@ -50,8 +59,25 @@ typedef struct sabr_local_data_struct sabr_local_data_t;
 struct sabr_local_data_struct {
     size_t switch_stack_size;
     size_t for_data_stack_size;
+    sabr_for_record_t* for_record;
     size_t local_memory_size;
     void* local_words;
+    sabr_value_t* frame;
+    bool alloted;
+};
+
+typedef struct sabr_pair_count_struct sabr_pair_count_t;
+struct sabr_pair_count_struct {
+    size_t pair;
+    uint64_t count;
+};
+
+typedef struct sabr_block_data_struct sabr_block_data_t;
+struct sabr_block_data_struct {
+    size_t begin;
+    size_t end;
+    size_t need;
+    size_t grow;
 };
 
 sabr_for_data_t sabr_interpreter_for_data_new(void);
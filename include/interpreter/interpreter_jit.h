@@ -0,0 +1,170 @@
+#ifndef __INTERPRETER_JIT_H__
+#define __INTERPRETER_JIT_H__
+
+#include "interpreter.h"
+#include "interpreter_op.h"
+#include "interpreter_verifier.h"
+
+#if defined(__x86_64__) && defined(__linux__) && defined(__GNUC__)
+	#define SABR_JIT_X86_64
+	#include <sys/mman.h>
+#endif
+
+#define SABR_JIT_EXIT UINT32_MAX
+#define SABR_JIT_STACK_SIZE 268435456
+#define SABR_JIT_STACK_RESERVE 1048576
+#define SABR_JIT_REGION_LIMIT 1048576
+
+#define SABR_JIT_SP "0(%rbp)"
+#define SABR_JIT_FRAME "8(%rbp)"
+#define SABR_JIT_GLOBALS "16(%rbp)"
+#define SABR_JIT_FOR_RECORD "24(%rbp)"
+#define SABR_JIT_BASE "32(%rbp)"
+#define SABR_JIT_LIMIT "40(%rbp)"
+#define SABR_JIT_INDEX "48(%rbp)"
+#define SABR_JIT_DEPTH_LEFT "56(%rbp)"
+#define SABR_JIT_CALL_OP "64(%rbp)"
+#define SABR_JIT_CALL_BLOCK "72(%rbp)"
+#define SABR_JIT_SELECT "80(%rbp)"
+#define SABR_JIT_STACK "88(%rdi)"
+
+typedef struct sabr_jit_context_struct sabr_jit_context_t;
+struct sabr_jit_context_struct {
+	sabr_value_t* sp;
+	sabr_value_t* frame;
+	sabr_value_t* globals;
+	sabr_for_record_t* for_record;
+	sabr_value_t* base;
+	uint64_t limit;
+	uint64_t index;
+	int64_t depth;
+	uint32_t (*call_op)(sabr_jit_context_t* ctx, size_t index);
+	uint32_t (*call_block)(sabr_jit_context_t* ctx, size_t begin, size_t end);
+	uint64_t (*select)(sabr_jit_context_t* ctx, size_t index, uint64_t key);
+	uint8_t* stack;
+	sabr_interpreter_t* inter;
+	sabr_bytecode_t* bc;
+};
+
+typedef struct sabr_jit_template_struct sabr_jit_template_t;
+struct sabr_jit_template_struct {
+	const uint8_t* begin;
+	const uint8_t* end;
+	const uint8_t* holes[3];
+};
+
+typedef enum sabr_jit_patch_kind_enum {
+	SABR_JIT_PATCH_LABEL,
+	SABR_JIT_PATCH_EXIT,
+	SABR_JIT_PATCH_OFFSET
+} sabr_jit_patch_kind_t;
+
+typedef struct sabr_jit_patch_struct sabr_jit_patch_t;
+struct sabr_jit_patch_struct {
+	sabr_jit_patch_kind_t kind;
+	size_t pos;
+	size_t target;
+};
+
+typedef enum sabr_jit_stub_kind_enum {
+	SABR_JIT_STUB_FAIL,
+	SABR_JIT_STUB_BLOCK,
+	SABR_JIT_STUB_TABLE
+} sabr_jit_stub_kind_t;
+
+typedef struct sabr_jit_stub_struct sabr_jit_stub_t;
+struct sabr_jit_stub_struct {
+	sabr_jit_stub_kind_t kind;
+	size_t pos;
+	size_t index;
+	uint32_t result;
+};
+
+typedef struct sabr_jit_chunk_struct sabr_jit_chunk_t;
+struct sabr_jit_chunk_struct {
+	uint8_t* data;
+	size_t size;
+};
+
+typedef struct sabr_jit_struct sabr_jit_t;
+struct sabr_jit_struct {
+	bool enabled;
+	uint64_t threshold;
+	size_t size;
+	sabr_bytecode_t* bc;
+	sabr_jit_context_t ctx;
+
+	void** entries;
+	bool* failed;
+	bool* candidates;
+	bool* queued;
+	uint64_t* counts;
+	sabr_block_data_t** blocks;
+	vector(sabr_block_data_t) block_vec;
+
+	uint32_t* marks;
+	uint32_t stamp;
+	size_t* labels;
+	size_t* region;
+	size_t region_size;
+	size_t* roots;
+	size_t root_count;
+	size_t* offsets;
+
+	uint8_t* code;
+	size_t code_size;
+	size_t code_capacity;
+	size_t exit_pos;
+	sabr_jit_patch_t* patches;
+	size_t patch_count;
+	size_t patch_capacity;
+	sabr_jit_stub_t* stubs;
+	size_t stub_count;
+	size_t stub_capacity;
+
+	sabr_jit_chunk_t* chunks;
+	size_t chunk_count;
+	uint8_t* stack;
+
+	FILE* perf_map;
+};
+
+bool sabr_jit_init(sabr_jit_t* jit);
+bool sabr_jit_prepare(sabr_jit_t* jit, sabr_interpreter_t* inter, sabr_bytecode_t* bc);
+void sabr_jit_del(sabr_jit_t* jit);
+void* sabr_jit_lookup(sabr_jit_t* jit, size_t index);
+void* sabr_jit_compile(sabr_jit_t* jit, size_t root);
+uint32_t sabr_jit_run(sabr_jit_t* jit, void* code);
+
+bool sabr_jit_discover(sabr_jit_t* jit, size_t root);
+bool sabr_jit_is_supported(sabr_jit_t* jit, size_t index);
+size_t sabr_jit_successors(sabr_jit_t* jit, size_t index, size_t* succs);
+bool sabr_jit_falls_through(sabr_opcode_t oc);
+void sabr_jit_switch_layout(sabr_jit_t* jit, sabr_bcop_t bcop, size_t* first, size_t* count, size_t* stride);
+
+bool sabr_jit_template(sabr_opcode_t oc, sabr_jit_template_t* t);
+bool sabr_jit_template_immediate(sabr_opcode_t oc, sabr_jit_template_t* t);
+bool sabr_jit_template_branch(sabr_opcode_t oc, sabr_jit_template_t* t);
+bool sabr_jit_template_slot(sabr_opcode_t oc, sabr_jit_template_t* t);
+bool sabr_jit_emit_region(sabr_jit_t* jit, size_t root);
+bool sabr_jit_emit_op(sabr_jit_t* jit, size_t index);
+bool sabr_jit_emit_generic(sabr_jit_t* jit, size_t index);
+bool sabr_jit_emit_stubs(sabr_jit_t* jit);
+bool sabr_jit_publish(sabr_jit_t* jit);
+
+bool sabr_jit_reserve(sabr_jit_t* jit, size_t length);
+bool sabr_jit_emit(sabr_jit_t* jit, sabr_jit_template_t t, size_t* at);
+bool sabr_jit_emit_jump(sabr_jit_t* jit, size_t target);
+void sabr_jit_set_u64(sabr_jit_t* jit, sabr_jit_template_t t, size_t at, size_t hole, uint64_t v);
+void sabr_jit_set_u32(sabr_jit_t* jit, sabr_jit_template_t t, size_t at, size_t hole, uint32_t v);
+bool sabr_jit_set_patch(sabr_jit_t* jit, sabr_jit_template_t t, size_t at, size_t hole, sabr_jit_patch_kind_t kind, size_t target);
+bool sabr_jit_set_stub(sabr_jit_t* jit, sabr_jit_template_t t, size_t at, size_t hole, sabr_jit_stub_kind_t kind, size_t index, uint32_t result);
+void sabr_jit_link(sabr_jit_t* jit, size_t pos, size_t target);
+void sabr_jit_resolve(sabr_jit_t* jit);
+int sabr_jit_index_compare(const void* a, const void* b);
+
+uint32_t sabr_jit_call_op(sabr_jit_context_t* ctx, size_t index);
+uint32_t sabr_jit_call_block(sabr_jit_context_t* ctx, size_t begin, size_t end);
+uint64_t sabr_jit_select(sabr_jit_context_t* ctx, size_t index, uint64_t key);
+
+#endif
\ No newline at end of file
@@ -15,28 +15,68 @@ const uint32_t sabr_interpreter_op(op_value)(sabr_interpreter_t* inter, sabr_bco
 const uint32_t sabr_interpreter_op(op_if)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
 const uint32_t sabr_interpreter_op(op_jump)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
 const uint32_t sabr_interpreter_op(op_for)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
+const uint32_t sabr_interpreter_op(op_for_addr)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
 const uint32_t sabr_interpreter_op(op_for_from)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
 const uint32_t sabr_interpreter_op(op_for_to)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
 const uint32_t sabr_interpreter_op(op_for_step)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
 const uint32_t sabr_interpreter_op(op_for_check)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
 const uint32_t sabr_interpreter_op(op_for_next)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
 const uint32_t sabr_interpreter_op(op_for_end)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
+const uint32_t sabr_interpreter_op(op_for_init)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
+const uint32_t sabr_interpreter_op(op_for_to_i)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
+const uint32_t sabr_interpreter_op(op_for_to_u)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
+const uint32_t sabr_interpreter_op(op_for_to_f)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
+const uint32_t sabr_interpreter_op(op_for_enter_i)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
+const uint32_t sabr_interpreter_op(op_for_enter_u)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
+const uint32_t sabr_interpreter_op(op_for_enter_f)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
+const uint32_t sabr_interpreter_op(op_for_loop_i)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
+const uint32_t sabr_interpreter_op(op_for_loop_u)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
+const uint32_t sabr_interpreter_op(op_for_loop_f)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
+const uint32_t sabr_interpreter_op(op_for_up_i)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
+const uint32_t sabr_interpreter_op(op_for_up_u)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
+const uint32_t sabr_interpreter_op(op_for_up_f)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
+const uint32_t sabr_interpreter_op(op_for_down_i)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
+const uint32_t sabr_interpreter_op(op_for_down_u)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
+const uint32_t sabr_interpreter_op(op_for_down_f)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
+const uint32_t sabr_interpreter_op(op_for_leave)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
 const uint32_t sabr_interpreter_op(op_switch)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
 const uint32_t sabr_interpreter_op(op_switch_case)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
 const uint32_t sabr_interpreter_op(op_switch_end)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
+const uint32_t sabr_interpreter_op(op_case_if)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
+const uint32_t sabr_interpreter_op(op_switch_table)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
+const uint32_t sabr_interpreter_op(op_switch_search)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
 const uint32_t sabr_interpreter_op(op_lambda)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
 const uint32_t sabr_interpreter_op(op_return)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
 const uint32_t sabr_interpreter_op(op_local)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
 const uint32_t sabr_interpreter_op(op_local_end)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
 const uint32_t sabr_interpreter_op(op_define)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
+const uint32_t sabr_interpreter_op(op_inline)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
+const uint32_t sabr_interpreter_op(op_noinline)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
 const uint32_t sabr_interpreter_op(op_datagroup)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
 const uint32_t sabr_interpreter_op(op_member)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
 const uint32_t sabr_interpreter_op(op_datagroup_end)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
 const uint32_t sabr_interpreter_op(op_datagroup_exec)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
 const uint32_t sabr_interpreter_op(op_set)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
 const uint32_t sabr_interpreter_op(op_exec)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
+const uint32_t sabr_interpreter_op(op_call)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
+const uint32_t sabr_interpreter_op(op_tailcall)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
 const uint32_t sabr_interpreter_op(op_addr)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
 const uint32_t sabr_interpreter_op(op_ref)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
+
+const uint32_t sabr_interpreter_op(op_load_local)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
+const uint32_t sabr_interpreter_op(op_store_local)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
+const uint32_t sabr_interpreter_op(op_addr_local)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
+const uint32_t sabr_interpreter_op(op_inc_local)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
+const uint32_t sabr_interpreter_op(op_dec_local)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
+const uint32_t sabr_interpreter_op(op_add_local)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
+const uint32_t sabr_interpreter_op(op_fadd_local)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
+const uint32_t sabr_interpreter_op(op_load_global)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
+const uint32_t sabr_interpreter_op(op_store_global)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
+const uint32_t sabr_interpreter_op(op_addr_global)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
+const uint32_t sabr_interpreter_op(op_inc_global)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
+const uint32_t sabr_interpreter_op(op_dec_global)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
+const uint32_t sabr_interpreter_op(op_add_global)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
+const uint32_t sabr_interpreter_op(op_fadd_global)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
 const uint32_t sabr_interpreter_op(op_call_bif)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
 const uint32_t sabr_interpreter_op(op_add)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
 const uint32_t sabr_interpreter_op(op_sub)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
@@ -48,6 +88,8 @@ const uint32_t sabr_interpreter_op(op_umod)(sabr_interpreter_t* inter, sabr_bcop
 const uint32_t sabr_interpreter_op(op_neg)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
 const uint32_t sabr_interpreter_op(op_inc)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
 const uint32_t sabr_interpreter_op(op_dec)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
+const uint32_t sabr_interpreter_op(op_add_imm)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
+const uint32_t sabr_interpreter_op(op_mul_imm)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
 const uint32_t sabr_interpreter_op(op_equ)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
 const uint32_t sabr_interpreter_op(op_neq)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
 const uint32_t sabr_interpreter_op(op_grt)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
@@ -58,6 +100,22 @@ const uint32_t sabr_interpreter_op(op_ugrt)(sabr_interpreter_t* inter, sabr_bcop
 const uint32_t sabr_interpreter_op(op_ugeq)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
 const uint32_t sabr_interpreter_op(op_ulst)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
 const uint32_t sabr_interpreter_op(op_uleq)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
+const uint32_t sabr_interpreter_op(op_lst_if)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
+const uint32_t sabr_interpreter_op(op_equ_if)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
+const uint32_t sabr_interpreter_op(op_neq_if)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
+const uint32_t sabr_interpreter_op(op_grt_if)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
+const uint32_t sabr_interpreter_op(op_geq_if)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
+const uint32_t sabr_interpreter_op(op_leq_if)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
+const uint32_t sabr_interpreter_op(op_ugrt_if)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
+const uint32_t sabr_interpreter_op(op_ugeq_if)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
+const uint32_t sabr_interpreter_op(op_ulst_if)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
+const uint32_t sabr_interpreter_op(op_uleq_if)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
+const uint32_t sabr_interpreter_op(op_equ_imm)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
+const uint32_t sabr_interpreter_op(op_neq_imm)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
+const uint32_t sabr_interpreter_op(op_grt_imm)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
+const uint32_t sabr_interpreter_op(op_geq_imm)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
+const uint32_t sabr_interpreter_op(op_lst_imm)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
+const uint32_t sabr_interpreter_op(op_leq_imm)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
 const uint32_t sabr_interpreter_op(op_fadd)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
 const uint32_t sabr_interpreter_op(op_fsub)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
 const uint32_t sabr_interpreter_op(op_fmul)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
@@ -70,12 +128,21 @@ const uint32_t sabr_interpreter_op(op_fgrt)(sabr_interpreter_t* inter, sabr_bcop
 const uint32_t sabr_interpreter_op(op_fgeq)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
 const uint32_t sabr_interpreter_op(op_flst)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
 const uint32_t sabr_interpreter_op(op_fleq)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
+const uint32_t sabr_interpreter_op(op_fequ_if)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
+const uint32_t sabr_interpreter_op(op_fneq_if)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
+const uint32_t sabr_interpreter_op(op_fgrt_if)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
+const uint32_t sabr_interpreter_op(op_fgeq_if)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
+const uint32_t sabr_interpreter_op(op_flst_if)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
+const uint32_t sabr_interpreter_op(op_fleq_if)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
 const uint32_t sabr_interpreter_op(op_band)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
 const uint32_t sabr_interpreter_op(op_bor)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
 const uint32_t sabr_interpreter_op(op_bxor)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
 const uint32_t sabr_interpreter_op(op_bnot)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
 const uint32_t sabr_interpreter_op(op_blsft)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
 const uint32_t sabr_interpreter_op(op_brsft)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
+const uint32_t sabr_interpreter_op(op_band_imm)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
+const uint32_t sabr_interpreter_op(op_blsft_imm)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
+const uint32_t sabr_interpreter_op(op_brsft_imm)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
 const uint32_t sabr_interpreter_op(op_drop)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
 const uint32_t sabr_interpreter_op(op_nip)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
 const uint32_t sabr_interpreter_op(op_dup)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
@@ -96,6 +163,29 @@ const uint32_t sabr_interpreter_op(op_free)(sabr_interpreter_t* inter, sabr_bcop
 const uint32_t sabr_interpreter_op(op_allot)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
 const uint32_t sabr_interpreter_op(op_fetch)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
 const uint32_t sabr_interpreter_op(op_store)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
+const uint32_t sabr_interpreter_op(op_inc_mem)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
+const uint32_t sabr_interpreter_op(op_dec_mem)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
+const uint32_t sabr_interpreter_op(op_add_mem)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
+const uint32_t sabr_interpreter_op(op_sub_mem)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
+const uint32_t sabr_interpreter_op(op_mul_mem)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
+const uint32_t sabr_interpreter_op(op_div_mem)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
+const uint32_t sabr_interpreter_op(op_mod_mem)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
+const uint32_t sabr_interpreter_op(op_fadd_mem)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
+const uint32_t sabr_interpreter_op(op_fsub_mem)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
+const uint32_t sabr_interpreter_op(op_fmul_mem)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
+const uint32_t sabr_interpreter_op(op_fdiv_mem)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
+const uint32_t sabr_interpreter_op(op_fmod_mem)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
+const uint32_t sabr_interpreter_op(op_band_mem)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
+const uint32_t sabr_interpreter_op(op_bor_mem)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
+const uint32_t sabr_interpreter_op(op_bxor_mem)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
+const uint32_t sabr_interpreter_op(op_bnot_mem)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
+const uint32_t sabr_interpreter_op(op_blsft_mem)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
+const uint32_t sabr_interpreter_op(op_brsft_mem)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
+const uint32_t sabr_interpreter_op(op_index_cell)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
+const uint32_t sabr_interpreter_op(op_fetch_idx)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
+const uint32_t sabr_interpreter_op(op_store_idx)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
+const uint32_t sabr_interpreter_op(op_fetch_off)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
+const uint32_t sabr_interpreter_op(op_store_off)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
 const uint32_t sabr_interpreter_op(op_array)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
 const uint32_t sabr_interpreter_op(op_array_comma)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
 const uint32_t sabr_interpreter_op(op_array_end)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index);
@@ -0,0 +1,218 @@
+#ifndef __INTERPRETER_REGISTER_H__
+#define __INTERPRETER_REGISTER_H__
+
+#include "interpreter_threaded.h"
+
+typedef enum sabr_register_base_enum {
+	SABR_REGISTER_BASE_STACK,
+	SABR_REGISTER_BASE_FRAME,
+	SABR_REGISTER_BASE_GLOBAL,
+	SABR_REGISTER_BASE_CONST,
+	SABR_REGISTER_BASE_COUNT
+} sabr_register_base_t;
+
+typedef enum sabr_register_opcode_enum {
+	SABR_REGISTER_OP_MOVE = SABR_OP_SHOW + 1,
+	SABR_REGISTER_OP_EXCHANGE,
+	SABR_REGISTER_OP_ADJUST,
+	SABR_REGISTER_OP_ENTER,
+	SABR_REGISTER_OP_GENERIC
+} sabr_register_opcode_t;
+
+typedef struct sabr_register_operand_struct sabr_register_operand_t;
+struct sabr_register_operand_struct {
+	uint32_t base;
+	int32_t offset;
+};
+
+typedef struct sabr_register_op_struct sabr_register_op_t;
+struct sabr_register_op_struct {
+	union {
+		const void* label;
+		uint32_t oc;
+	};
+	sabr_register_operand_t dst;
+	sabr_register_operand_t lhs;
+	sabr_register_operand_t rhs;
+	sabr_value_t operand;
+	size_t index;
+};
+
+typedef struct sabr_register_translator_struct sabr_register_translator_t;
+struct sabr_register_translator_struct {
+	sabr_bytecode_t* bc;
+	bool supported;
+
+	sabr_register_op_t* ops;
+	size_t op_count;
+	size_t op_capacity;
+
+	sabr_value_t* consts;
+	size_t const_count;
+	size_t const_capacity;
+
+	size_t* map;
+	vector(sabr_block_data_t) blocks;
+
+	sabr_register_operand_t* stack;
+	int64_t bias;
+	int64_t low;
+	int64_t depth;
+	int64_t shift;
+
+	size_t last;
+	int64_t last_pos;
+};
+
+#define SABR_REGISTER_AT(OPERAND) (bases[(OPERAND).base][(OPERAND).offset])
+
+#define SABR_REGISTER_BIND_ALL \
+	SABR_THREADED_BIND(SABR_OP_EXIT), \
+	SABR_THREADED_BIND(SABR_OP_IF), \
+	SABR_THREADED_BIND(SABR_OP_JUMP), \
+	SABR_THREADED_BIND(SABR_OP_FOR_LOOP_I), \
+	SABR_THREADED_BIND(SABR_OP_FOR_LOOP_U), \
+	SABR_THREADED_BIND(SABR_OP_FOR_LOOP_F), \
+	SABR_THREADED_BIND(SABR_OP_FOR_UP_I), \
+	SABR_THREADED_BIND(SABR_OP_FOR_UP_U), \
+	SABR_THREADED_BIND(SABR_OP_FOR_UP_F), \
+	SABR_THREADED_BIND(SABR_OP_FOR_DOWN_I), \
+	SABR_THREADED_BIND(SABR_OP_FOR_DOWN_U), \
+	SABR_THREADED_BIND(SABR_OP_FOR_DOWN_F), \
+	SABR_THREADED_BIND(SABR_OP_RETURN), \
+	SABR_THREADED_BIND(SABR_OP_CALL), \
+	SABR_THREADED_BIND(SABR_OP_SWITCH_TABLE), \
+	SABR_THREADED_BIND(SABR_OP_SWITCH_SEARCH), \
+	SABR_THREADED_BIND(SABR_OP_ADDR_LOCAL), \
+	SABR_THREADED_BIND(SABR_OP_ADD), \
+	SABR_THREADED_BIND(SABR_OP_SUB), \
+	SABR_THREADED_BIND(SABR_OP_MUL), \
+	SABR_THREADED_BIND(SABR_OP_ADD_IMM), \
+	SABR_THREADED_BIND(SABR_OP_MUL_IMM), \
+	SABR_THREADED_BIND(SABR_OP_DIV), \
+	SABR_THREADED_BIND(SABR_OP_MOD), \
+	SABR_THREADED_BIND(SABR_OP_UDIV), \
+	SABR_THREADED_BIND(SABR_OP_UMOD), \
+	SABR_THREADED_BIND(SABR_OP_NEG), \
+	SABR_THREADED_BIND(SABR_OP_INC), \
+	SABR_THREADED_BIND(SABR_OP_DEC), \
+	SABR_THREADED_BIND(SABR_OP_EQU), \
+	SABR_THREADED_BIND(SABR_OP_NEQ), \
+	SABR_THREADED_BIND(SABR_OP_GRT), \
+	SABR_THREADED_BIND(SABR_OP_GEQ), \
+	SABR_THREADED_BIND(SABR_OP_LST), \
+	SABR_THREADED_BIND(SABR_OP_LEQ), \
+	SABR_THREADED_BIND(SABR_OP_EQU_IMM), \
+	SABR_THREADED_BIND(SABR_OP_NEQ_IMM), \
+	SABR_THREADED_BIND(SABR_OP_GRT_IMM), \
+	SABR_THREADED_BIND(SABR_OP_GEQ_IMM), \
+	SABR_THREADED_BIND(SABR_OP_LST_IMM), \
+	SABR_THREADED_BIND(SABR_OP_LEQ_IMM), \
+	SABR_THREADED_BIND(SABR_OP_UGRT), \
+	SABR_THREADED_BIND(SABR_OP_UGEQ), \
+	SABR_THREADED_BIND(SABR_OP_ULST), \
+	SABR_THREADED_BIND(SABR_OP_ULEQ), \
+	SABR_THREADED_BIND(SABR_OP_LST_IF), \
+	SABR_THREADED_BIND(SABR_OP_EQU_IF), \
+	SABR_THREADED_BIND(SABR_OP_NEQ_IF), \
+	SABR_THREADED_BIND(SABR_OP_GRT_IF), \
+	SABR_THREADED_BIND(SABR_OP_GEQ_IF), \
+	SABR_THREADED_BIND(SABR_OP_LEQ_IF), \
+	SABR_THREADED_BIND(SABR_OP_UGRT_IF), \
+	SABR_THREADED_BIND(SABR_OP_UGEQ_IF), \
+	SABR_THREADED_BIND(SABR_OP_ULST_IF), \
+	SABR_THREADED_BIND(SABR_OP_ULEQ_IF), \
+	SABR_THREADED_BIND(SABR_OP_FADD), \
+	SABR_THREADED_BIND(SABR_OP_FSUB), \
+	SABR_THREADED_BIND(SABR_OP_FMUL), \
+	SABR_THREADED_BIND(SABR_OP_FDIV), \
+	SABR_THREADED_BIND(SABR_OP_FMOD), \
+	SABR_THREADED_BIND(SABR_OP_FNEG), \
+	SABR_THREADED_BIND(SABR_OP_FEQU), \
+	SABR_THREADED_BIND(SABR_OP_FNEQ), \
+	SABR_THREADED_BIND(SABR_OP_FGRT), \
+	SABR_THREADED_BIND(SABR_OP_FGEQ), \
+	SABR_THREADED_BIND(SABR_OP_FLST), \
+	SABR_THREADED_BIND(SABR_OP_FLEQ), \
+	SABR_THREADED_BIND(SABR_OP_FEQU_IF), \
+	SABR_THREADED_BIND(SABR_OP_FNEQ_IF), \
+	SABR_THREADED_BIND(SABR_OP_FGRT_IF), \
+	SABR_THREADED_BIND(SABR_OP_FGEQ_IF), \
+	SABR_THREADED_BIND(SABR_OP_FLST_IF), \
+	SABR_THREADED_BIND(SABR_OP_FLEQ_IF), \
+	SABR_THREADED_BIND(SABR_OP_BAND), \
+	SABR_THREADED_BIND(SABR_OP_BOR), \
+	SABR_THREADED_BIND(SABR_OP_BXOR), \
+	SABR_THREADED_BIND(SABR_OP_BNOT), \
+	SABR_THREADED_BIND(SABR_OP_BLSFT), \
+	SABR_THREADED_BIND(SABR_OP_BRSFT), \
+	SABR_THREADED_BIND(SABR_OP_BAND_IMM), \
+	SABR_THREADED_BIND(SABR_OP_BLSFT_IMM), \
+	SABR_THREADED_BIND(SABR_OP_BRSFT_IMM), \
+	SABR_THREADED_BIND(SABR_OP_FETCH), \
+	SABR_THREADED_BIND(SABR_OP_STORE), \
+	SABR_THREADED_BIND(SABR_OP_INC_MEM), \
+	SABR_THREADED_BIND(SABR_OP_DEC_MEM), \
+	SABR_THREADED_BIND(SABR_OP_ADD_MEM), \
+	SABR_THREADED_BIND(SABR_OP_SUB_MEM), \
+	SABR_THREADED_BIND(SABR_OP_MUL_MEM), \
+	SABR_THREADED_BIND(SABR_OP_DIV_MEM), \
+	SABR_THREADED_BIND(SABR_OP_MOD_MEM), \
+	SABR_THREADED_BIND(SABR_OP_FADD_MEM), \
+	SABR_THREADED_BIND(SABR_OP_FSUB_MEM), \
+	SABR_THREADED_BIND(SABR_OP_FMUL_MEM), \
+	SABR_THREADED_BIND(SABR_OP_FDIV_MEM), \
+	SABR_THREADED_BIND(SABR_OP_FMOD_MEM), \
+	SABR_THREADED_BIND(SABR_OP_BAND_MEM), \
+	SABR_THREADED_BIND(SABR_OP_BOR_MEM), \
+	SABR_THREADED_BIND(SABR_OP_BXOR_MEM), \
+	SABR_THREADED_BIND(SABR_OP_BNOT_MEM), \
+	SABR_THREADED_BIND(SABR_OP_BLSFT_MEM), \
+	SABR_THREADED_BIND(SABR_OP_BRSFT_MEM), \
+	SABR_THREADED_BIND(SABR_OP_INDEX_CELL), \
+	SABR_THREADED_BIND(SABR_OP_FETCH_IDX), \
+	SABR_THREADED_BIND(SABR_OP_STORE_IDX), \
+	SABR_THREADED_BIND(SABR_OP_FETCH_OFF), \
+	SABR_THREADED_BIND(SABR_OP_STORE_OFF), \
+	SABR_THREADED_BIND(SABR_OP_ITOF), \
+	SABR_THREADED_BIND(SABR_OP_UTOF), \
+	SABR_THREADED_BIND(SABR_OP_FTOI), \
+	SABR_THREADED_BIND(SABR_OP_FTOU), \
+	SABR_THREADED_BIND(SABR_REGISTER_OP_MOVE), \
+	SABR_THREADED_BIND(SABR_REGISTER_OP_EXCHANGE), \
+	SABR_THREADED_BIND(SABR_REGISTER_OP_ADJUST), \
+	SABR_THREADED_BIND(SABR_REGISTER_OP_ENTER), \
+	SABR_THREADED_BIND(SABR_REGISTER_OP_GENERIC)
+
+bool sabr_register_translate(sabr_register_translator_t* tr, sabr_bytecode_t* bc);
+void sabr_register_translator_free(sabr_register_translator_t* tr);
+bool sabr_register_translate_block(sabr_register_translator_t* tr, size_t block);
+bool sabr_register_translate_op(sabr_register_translator_t* tr, size_t index, sabr_bcop_t bcop);
+bool sabr_register_translate_shuffle(sabr_register_translator_t* tr, size_t pops, const uint8_t* order, size_t pushes);
+
+bool sabr_register_emit(sabr_register_translator_t* tr, sabr_register_op_t op);
+bool sabr_register_emit_result(sabr_register_translator_t* tr, sabr_register_op_t op);
+bool sabr_register_emit_generic(sabr_register_translator_t* tr, size_t index);
+bool sabr_register_emit_branch(sabr_register_translator_t* tr, sabr_register_op_t op, size_t keep);
+bool sabr_register_move(sabr_register_translator_t* tr, int64_t pos, sabr_register_operand_t src, size_t index);
+bool sabr_register_exchange(sabr_register_translator_t* tr, int64_t pos, int64_t other, int64_t top, size_t index);
+bool sabr_register_materialize(sabr_register_translator_t* tr, int64_t pos, size_t index);
+bool sabr_register_flush(sabr_register_translator_t* tr, sabr_register_operand_t operand, bool memory, size_t index);
+bool sabr_register_sync(sabr_register_translator_t* tr, size_t index, size_t keep);
+void sabr_register_reset(sabr_register_translator_t* tr);
+
+sabr_register_op_t sabr_register_new_op(uint32_t oc, size_t index);
+sabr_register_operand_t sabr_register_stack(int64_t pos);
+sabr_register_operand_t sabr_register_slot(sabr_register_translator_t* tr, uint32_t base, uint64_t slot);
+bool sabr_register_const(sabr_register_translator_t* tr, sabr_value_t v, sabr_register_operand_t* operand);
+void sabr_register_immediate(sabr_register_translator_t* tr, sabr_register_op_t* op);
+sabr_register_operand_t sabr_register_resolve(sabr_register_translator_t* tr, sabr_register_operand_t operand);
+sabr_register_operand_t sabr_register_pop(sabr_register_translator_t* tr);
+void sabr_register_push(sabr_register_translator_t* tr, sabr_register_operand_t operand);
+bool sabr_register_is_referenced(sabr_register_translator_t* tr, int64_t pos);
+bool sabr_register_is_clobbered(sabr_register_translator_t* tr, int64_t pos, int64_t lazy);
+int64_t sabr_register_free(sabr_register_translator_t* tr, int64_t pos);
+bool sabr_register_is_stack(sabr_register_operand_t operand, int64_t pos);
+bool sabr_register_has_target(uint32_t oc);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,248 @@
+#ifndef __INTERPRETER_THREADED_H__
+#define __INTERPRETER_THREADED_H__
+
+#include "interpreter.h"
+#include "interpreter_op.h"
+#include "interpreter_verifier.h"
+#include "interpreter_jit.h"
+
+#if defined(__GNUC__)
+	#define SABR_THREADED_COMPUTED_GOTO
+	#define sabr_threaded_unlikely(X) __builtin_expect(!!(X), 0)
+#else
+	#define sabr_threaded_unlikely(X) (X)
+#endif
+
+typedef struct sabr_threaded_op_struct sabr_threaded_op_t;
+struct sabr_threaded_op_struct {
+	union {
+		const void* label;
+		uint32_t oc;
+	};
+	sabr_value_t operand;
+};
+
+typedef struct sabr_threaded_block_struct sabr_threaded_block_t;
+struct sabr_threaded_block_struct {
+	union {
+		const void* label;
+		uint32_t oc;
+	};
+	size_t end;
+	size_t need;
+	size_t grow;
+};
+
+typedef struct sabr_threaded_hot_struct sabr_threaded_hot_t;
+struct sabr_threaded_hot_struct {
+	union {
+		const void* label;
+		uint32_t oc;
+	};
+};
+
+#define SABR_THREADED_OC_BLOCK UINT32_MAX
+#define SABR_THREADED_OC_HOT (UINT32_MAX - 1)
+
+#if defined(SABR_THREADED_COMPUTED_GOTO)
+	#define SABR_THREADED_CASE(OC) LABEL_##OC
+	#define SABR_THREADED_DEFAULT LABEL_DEFAULT
+	#define SABR_THREADED_BLOCK LABEL_BLOCK
+	#define SABR_THREADED_HOT LABEL_HOT
+	#define SABR_THREADED_MARK(I) do { hots[I].label = stream[I].label; stream[I].label = &&LABEL_HOT; } while (0)
+	#define SABR_THREADED_UNMARK(I) (stream[I].label = hots[I].label)
+	#define SABR_THREADED_RESUME(I) goto *hots[I].label
+	#define SABR_THREADED_DISPATCH() goto *ip->label
+	#define SABR_THREADED_BIND(OC) [OC] = &&LABEL_##OC
+	#define SABR_THREADED_LABEL(OC) (((OC) < labels_len && labels[OC]) ? labels[OC] : &&LABEL_DEFAULT)
+	#define SABR_THREADED_RESOLVE() \
+		for (size_t i = 0; i <= bc->bcop_vec.size; i++) { \
+			if (stream[i].oc == SABR_THREADED_OC_BLOCK) { \
+				blocks[i].label = SABR_THREADED_LABEL(blocks[i].oc); \
+				stream[i].label = &&LABEL_BLOCK; \
+			} \
+			else stream[i].label = SABR_THREADED_LABEL(stream[i].oc); \
+		}
+#else
+	#define SABR_THREADED_CASE(OC) case OC
+	#define SABR_THREADED_DEFAULT default
+	#define SABR_THREADED_BLOCK case SABR_THREADED_OC_BLOCK
+	#define SABR_THREADED_HOT case SABR_THREADED_OC_HOT
+	#define SABR_THREADED_MARK(I) do { hots[I].oc = stream[I].oc; stream[I].oc = SABR_THREADED_OC_HOT; } while (0)
+	#define SABR_THREADED_UNMARK(I) (stream[I].oc = hots[I].oc)
+	#define SABR_THREADED_RESUME(I) do { oc = hots[I].oc; goto SWITCH; } while (0)
+	#define SABR_THREADED_DISPATCH() goto DISPATCH
+	#define SABR_THREADED_RESOLVE()
+#endif
+
+#define SABR_THREADED_BIND_ALL \
+	SABR_THREADED_BIND(SABR_OP_NONE), \
+	SABR_THREADED_BIND(SABR_OP_EXIT), \
+	SABR_THREADED_BIND(SABR_OP_VALUE), \
+	SABR_THREADED_BIND(SABR_OP_IF), \
+	SABR_THREADED_BIND(SABR_OP_JUMP), \
+	SABR_THREADED_BIND(SABR_OP_FOR_LOOP_I), \
+	SABR_THREADED_BIND(SABR_OP_FOR_LOOP_U), \
+	SABR_THREADED_BIND(SABR_OP_FOR_LOOP_F), \
+	SABR_THREADED_BIND(SABR_OP_FOR_UP_I), \
+	SABR_THREADED_BIND(SABR_OP_FOR_UP_U), \
+	SABR_THREADED_BIND(SABR_OP_FOR_UP_F), \
+	SABR_THREADED_BIND(SABR_OP_FOR_DOWN_I), \
+	SABR_THREADED_BIND(SABR_OP_FOR_DOWN_U), \
+	SABR_THREADED_BIND(SABR_OP_FOR_DOWN_F), \
+	SABR_THREADED_BIND(SABR_OP_CASE_IF), \
+	SABR_THREADED_BIND(SABR_OP_SWITCH_TABLE), \
+	SABR_THREADED_BIND(SABR_OP_SWITCH_SEARCH), \
+	SABR_THREADED_BIND(SABR_OP_RETURN), \
+	SABR_THREADED_BIND(SABR_OP_CALL), \
+	SABR_THREADED_BIND(SABR_OP_LOAD_LOCAL), \
+	SABR_THREADED_BIND(SABR_OP_STORE_LOCAL), \
+	SABR_THREADED_BIND(SABR_OP_ADDR_LOCAL), \
+	SABR_THREADED_BIND(SABR_OP_INC_LOCAL), \
+	SABR_THREADED_BIND(SABR_OP_DEC_LOCAL), \
+	SABR_THREADED_BIND(SABR_OP_ADD_LOCAL), \
+	SABR_THREADED_BIND(SABR_OP_FADD_LOCAL), \
+	SABR_THREADED_BIND(SABR_OP_LOAD_GLOBAL), \
+	SABR_THREADED_BIND(SABR_OP_STORE_GLOBAL), \
+	SABR_THREADED_BIND(SABR_OP_ADDR_GLOBAL), \
+	SABR_THREADED_BIND(SABR_OP_INC_GLOBAL), \
+	SABR_THREADED_BIND(SABR_OP_DEC_GLOBAL), \
+	SABR_THREADED_BIND(SABR_OP_ADD_GLOBAL), \
+	SABR_THREADED_BIND(SABR_OP_FADD_GLOBAL), \
+	SABR_THREADED_BIND(SABR_OP_ADD), \
+	SABR_THREADED_BIND(SABR_OP_SUB), \
+	SABR_THREADED_BIND(SABR_OP_MUL), \
+	SABR_THREADED_BIND(SABR_OP_DIV), \
+	SABR_THREADED_BIND(SABR_OP_MOD), \
+	SABR_THREADED_BIND(SABR_OP_UDIV), \
+	SABR_THREADED_BIND(SABR_OP_UMOD), \
+	SABR_THREADED_BIND(SABR_OP_NEG), \
+	SABR_THREADED_BIND(SABR_OP_INC), \
+	SABR_THREADED_BIND(SABR_OP_DEC), \
+	SABR_THREADED_BIND(SABR_OP_ADD_IMM), \
+	SABR_THREADED_BIND(SABR_OP_MUL_IMM), \
+	SABR_THREADED_BIND(SABR_OP_EQU), \
+	SABR_THREADED_BIND(SABR_OP_NEQ), \
+	SABR_THREADED_BIND(SABR_OP_GRT), \
+	SABR_THREADED_BIND(SABR_OP_GEQ), \
+	SABR_THREADED_BIND(SABR_OP_LST), \
+	SABR_THREADED_BIND(SABR_OP_LEQ), \
+	SABR_THREADED_BIND(SABR_OP_UGRT), \
+	SABR_THREADED_BIND(SABR_OP_UGEQ), \
+	SABR_THREADED_BIND(SABR_OP_ULST), \
+	SABR_THREADED_BIND(SABR_OP_ULEQ), \
+	SABR_THREADED_BIND(SABR_OP_LST_IF), \
+	SABR_THREADED_BIND(SABR_OP_EQU_IF), \
+	SABR_THREADED_BIND(SABR_OP_NEQ_IF), \
+	SABR_THREADED_BIND(SABR_OP_GRT_IF), \
+	SABR_THREADED_BIND(SABR_OP_GEQ_IF), \
+	SABR_THREADED_BIND(SABR_OP_LEQ_IF), \
+	SABR_THREADED_BIND(SABR_OP_UGRT_IF), \
+	SABR_THREADED_BIND(SABR_OP_UGEQ_IF), \
+	SABR_THREADED_BIND(SABR_OP_ULST_IF), \
+	SABR_THREADED_BIND(SABR_OP_ULEQ_IF), \
+	SABR_THREADED_BIND(SABR_OP_EQU_IMM), \
+	SABR_THREADED_BIND(SABR_OP_NEQ_IMM), \
+	SABR_THREADED_BIND(SABR_OP_GRT_IMM), \
+	SABR_THREADED_BIND(SABR_OP_GEQ_IMM), \
+	SABR_THREADED_BIND(SABR_OP_LST_IMM), \
+	SABR_THREADED_BIND(SABR_OP_LEQ_IMM), \
+	SABR_THREADED_BIND(SABR_OP_FADD), \
+	SABR_THREADED_BIND(SABR_OP_FSUB), \
+	SABR_THREADED_BIND(SABR_OP_FMUL), \
+	SABR_THREADED_BIND(SABR_OP_FDIV), \
+	SABR_THREADED_BIND(SABR_OP_FMOD), \
+	SABR_THREADED_BIND(SABR_OP_FNEG), \
+	SABR_THREADED_BIND(SABR_OP_FEQU), \
+	SABR_THREADED_BIND(SABR_OP_FNEQ), \
+	SABR_THREADED_BIND(SABR_OP_FGRT), \
+	SABR_THREADED_BIND(SABR_OP_FGEQ), \
+	SABR_THREADED_BIND(SABR_OP_FLST), \
+	SABR_THREADED_BIND(SABR_OP_FLEQ), \
+	SABR_THREADED_BIND(SABR_OP_FEQU_IF), \
+	SABR_THREADED_BIND(SABR_OP_FNEQ_IF), \
+	SABR_THREADED_BIND(SABR_OP_FGRT_IF), \
+	SABR_THREADED_BIND(SABR_OP_FGEQ_IF), \
+	SABR_THREADED_BIND(SABR_OP_FLST_IF), \
+	SABR_THREADED_BIND(SABR_OP_FLEQ_IF), \
+	SABR_THREADED_BIND(SABR_OP_BAND), \
+	SABR_THREADED_BIND(SABR_OP_BOR), \
+	SABR_THREADED_BIND(SABR_OP_BXOR), \
+	SABR_THREADED_BIND(SABR_OP_BNOT), \
+	SABR_THREADED_BIND(SABR_OP_BLSFT), \
+	SABR_THREADED_BIND(SABR_OP_BRSFT), \
+	SABR_THREADED_BIND(SABR_OP_BAND_IMM), \
+	SABR_THREADED_BIND(SABR_OP_BLSFT_IMM), \
+	SABR_THREADED_BIND(SABR_OP_BRSFT_IMM), \
+	SABR_THREADED_BIND(SABR_OP_DROP), \
+	SABR_THREADED_BIND(SABR_OP_NIP), \
+	SABR_THREADED_BIND(SABR_OP_DUP), \
+	SABR_THREADED_BIND(SABR_OP_OVER), \
+	SABR_THREADED_BIND(SABR_OP_TUCK), \
+	SABR_THREADED_BIND(SABR_OP_SWAP), \
+	SABR_THREADED_BIND(SABR_OP_ROT), \
+	SABR_THREADED_BIND(SABR_OP_FETCH), \
+	SABR_THREADED_BIND(SABR_OP_STORE), \
+	SABR_THREADED_BIND(SABR_OP_INC_MEM), \
+	SABR_THREADED_BIND(SABR_OP_DEC_MEM), \
+	SABR_THREADED_BIND(SABR_OP_ADD_MEM), \
+	SABR_THREADED_BIND(SABR_OP_SUB_MEM), \
+	SABR_THREADED_BIND(SABR_OP_MUL_MEM), \
+	SABR_THREADED_BIND(SABR_OP_DIV_MEM), \
+	SABR_THREADED_BIND(SABR_OP_MOD_MEM), \
+	SABR_THREADED_BIND(SABR_OP_FADD_MEM), \
+	SABR_THREADED_BIND(SABR_OP_FSUB_MEM), \
+	SABR_THREADED_BIND(SABR_OP_FMUL_MEM), \
+	SABR_THREADED_BIND(SABR_OP_FDIV_MEM), \
+	SABR_THREADED_BIND(SABR_OP_FMOD_MEM), \
+	SABR_THREADED_BIND(SABR_OP_BAND_MEM), \
+	SABR_THREADED_BIND(SABR_OP_BOR_MEM), \
+	SABR_THREADED_BIND(SABR_OP_BXOR_MEM), \
+	SABR_THREADED_BIND(SABR_OP_BNOT_MEM), \
+	SABR_THREADED_BIND(SABR_OP_BLSFT_MEM), \
+	SABR_THREADED_BIND(SABR_OP_BRSFT_MEM), \
+	SABR_THREADED_BIND(SABR_OP_INDEX_CELL), \
+	SABR_THREADED_BIND(SABR_OP_FETCH_IDX), \
+	SABR_THREADED_BIND(SABR_OP_STORE_IDX), \
+	SABR_THREADED_BIND(SABR_OP_FETCH_OFF), \
+	SABR_THREADED_BIND(SABR_OP_STORE_OFF), \
+	SABR_THREADED_BIND(SABR_OP_ITOF), \
+	SABR_THREADED_BIND(SABR_OP_UTOF), \
+	SABR_THREADED_BIND(SABR_OP_FTOI), \
+	SABR_THREADED_BIND(SABR_OP_FTOU)
+
+#define SABR_THREADED_NEXT() do { ip++; SABR_THREADED_DISPATCH(); } while (0)
+#define SABR_THREADED_JUMP(TARGET) do { ip = stream + (TARGET); SABR_THREADED_DISPATCH(); } while (0)
+#define SABR_THREADED_FAIL(ERRCODE) do { result = (ERRCODE); goto FAILURE; } while (0)
+
+#define SABR_THREADED_FOR(FIELD, COND) { \
+	sabr_for_record_t* record = inter->for_record; \
+	if (sabr_threaded_unlikely(!record)) SABR_THREADED_FAIL(SABR_OPERR_FOR); \
+	sabr_value_t* v = record->variable; \
+	v->FIELD += record->step.FIELD; \
+	if (COND) SABR_THREADED_JUMP(ip->operand.u); \
+	v->FIELD -= record->step.FIELD; \
+} SABR_THREADED_NEXT()
+
+#define SABR_THREADED_SWITCH_TABLE(V) { \
+	sabr_value_t key = (V); \
+	sabr_threaded_op_t* table = stream + ip->operand.u; \
+	uint64_t slot = key.u - table[0].operand.u; \
+	SABR_THREADED_JUMP(table[(slot < table[1].operand.u) ? slot + 3 : 2].operand.u); \
+}
+
+#define SABR_THREADED_SWITCH_SEARCH(V) { \
+	sabr_value_t key = (V); \
+	sabr_threaded_op_t* table = stream + ip->operand.u; \
+	size_t count = table[0].operand.u, low = 0, high = count; \
+	while (low < high) { \
+		size_t mid = low + (high - low) / 2; \
+		if (table[mid * 2 + 2].operand.i < key.i) low = mid + 1; \
+		else high = mid; \
+	} \
+	SABR_THREADED_JUMP(table[(low < count && table[low * 2 + 2].operand.u == key.u) ? low * 2 + 3 : 1].operand.u); \
+}
+
+bool sabr_interpreter_threaded_prepare(sabr_bytecode_t* bc, sabr_threaded_op_t** stream, sabr_threaded_block_t** blocks);
+
+#endif
\ No newline at end of file
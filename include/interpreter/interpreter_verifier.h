@@ -0,0 +1,9 @@
+#ifndef __INTERPRETER_VERIFIER_H__
+#define __INTERPRETER_VERIFIER_H__
+
+#include "interpreter.h"
+
+bool sabr_interpreter_verify_bytecode(sabr_bytecode_t* bc, vector(sabr_block_data_t)* blocks);
+bool sabr_interpreter_verify_block(sabr_bytecode_t* bc, bool* leaders, size_t begin, sabr_block_data_t* block);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,145 @@
+#ifndef __IR_H__
+#define __IR_H__
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "cctl_define.h"
+
+#include "error_message.h"
+
+#include "bcop.h"
+#include "bytecode.h"
+
+#define SABR_IR_ROUNDS 64
+#define SABR_IR_LIMIT 1048576
+
+typedef enum sabr_ir_fact_kind_enum {
+	SABR_IR_FACT_NONE,
+	SABR_IR_FACT_CONST,
+	SABR_IR_FACT_COPY
+} sabr_ir_fact_kind_t;
+
+typedef struct sabr_ir_fact_struct {
+	sabr_ir_fact_kind_t kind;
+	sabr_value_t value;
+} sabr_ir_fact_t;
+
+typedef struct sabr_ir_value_struct {
+	sabr_opcode_t oc;
+	sabr_value_t operand;
+	size_t args[2];
+	size_t arg_count;
+	size_t def;
+	size_t block;
+	uint64_t slot;
+} sabr_ir_value_t;
+
+typedef struct sabr_ir_inst_struct {
+	size_t result;
+	size_t args[2];
+	size_t arg_count;
+	size_t producer;
+	size_t begin;
+	uint64_t alias;
+} sabr_ir_inst_t;
+
+typedef struct sabr_ir_block_struct {
+	size_t begin;
+	size_t end;
+	size_t succs[2];
+	size_t succ_count;
+} sabr_ir_block_t;
+
+typedef struct sabr_ir_entry_struct {
+	size_t value;
+	size_t producer;
+} sabr_ir_entry_t;
+
+typedef struct sabr_ir_function_struct {
+	sabr_bytecode_t* bc;
+	size_t* owners;
+	size_t lambda;
+	size_t begin;
+	size_t end;
+	uint64_t slot_count;
+	bool* escaped;
+	sabr_ir_block_t* blocks;
+	size_t block_count;
+	size_t* block_of;
+	sabr_ir_inst_t* insts;
+	sabr_ir_value_t* values;
+	size_t value_count;
+	size_t value_capacity;
+	sabr_ir_entry_t* stack;
+	size_t* slots;
+	sabr_ir_fact_t* facts;
+} sabr_ir_function_t;
+
+typedef struct sabr_ir_insert_struct {
+	size_t index;
+	bool after;
+	size_t order;
+	sabr_bcop_t bcop;
+} sabr_ir_insert_t;
+
+typedef struct sabr_ir_edit_struct {
+	sabr_ir_insert_t* inserts;
+	size_t insert_count;
+	size_t insert_capacity;
+	size_t* loops;
+} sabr_ir_edit_t;
+
+typedef bool (*sabr_ir_pass_func_t)(sabr_ir_function_t* fn, sabr_ir_edit_t* edit);
+
+typedef struct sabr_ir_pass_struct {
+	const char* name;
+	uint32_t level;
+	sabr_ir_pass_func_t func;
+} sabr_ir_pass_t;
+
+extern const sabr_ir_pass_t sabr_ir_passes[];
+extern const size_t sabr_ir_pass_count;
+
+bool sabr_ir_run(sabr_bytecode_t* bc, sabr_bytecode_options_t* options);
+bool sabr_ir_run_pass(sabr_bytecode_t* bc, const sabr_ir_pass_t* pass);
+bool sabr_ir_print_bytecode(sabr_bytecode_t* bc);
+
+bool sabr_ir_function_init(sabr_ir_function_t* fn, sabr_bytecode_t* bc, size_t* owners, size_t lambda);
+void sabr_ir_function_free(sabr_ir_function_t* fn);
+bool sabr_ir_function_blocks(sabr_ir_function_t* fn);
+bool sabr_ir_function_successors(sabr_ir_function_t* fn, sabr_ir_block_t* block);
+bool sabr_ir_lift(sabr_ir_function_t* fn, sabr_ir_fact_t* in, sabr_ir_fact_t* out);
+bool sabr_ir_lift_block(sabr_ir_function_t* fn, size_t block, sabr_ir_fact_t* in, sabr_ir_fact_t* out);
+bool sabr_ir_lift_facts(sabr_ir_function_t* fn, bool* converged);
+bool sabr_ir_fact_equals(sabr_ir_fact_t a, sabr_ir_fact_t b);
+size_t sabr_ir_value_new(sabr_ir_function_t* fn, sabr_ir_value_t value);
+size_t sabr_ir_value_find(sabr_ir_function_t* fn, size_t block, sabr_ir_value_t value);
+size_t sabr_ir_value_constant(sabr_ir_function_t* fn, size_t block, sabr_value_t v);
+void sabr_ir_print(sabr_ir_function_t* fn);
+void sabr_ir_print_value(sabr_ir_function_t* fn, size_t value, bool* printed);
+
+sabr_bcop_t* sabr_ir_bcop(sabr_ir_function_t* fn, size_t index);
+bool sabr_ir_is_owned(sabr_ir_function_t* fn, size_t index);
+size_t sabr_ir_prev(sabr_ir_function_t* fn, size_t index);
+size_t sabr_ir_range_length(sabr_ir_function_t* fn, size_t begin, size_t end);
+bool sabr_ir_range_equals(sabr_ir_function_t* fn, size_t a_begin, size_t a_end, size_t b_begin, size_t b_end);
+uint64_t sabr_ir_temp(sabr_ir_function_t* fn);
+bool sabr_ir_is_pure(sabr_opcode_t oc);
+bool sabr_ir_is_barrier(sabr_opcode_t oc);
+bool sabr_ir_is_branch(sabr_opcode_t oc);
+bool sabr_ir_is_update(sabr_opcode_t oc);
+bool sabr_ir_reads_slot(sabr_ir_function_t* fn, size_t index, uint64_t* slot);
+bool sabr_ir_writes_slot(sabr_ir_function_t* fn, size_t index, uint64_t* slot);
+
+bool sabr_ir_edit_init(sabr_ir_edit_t* edit, size_t size);
+void sabr_ir_edit_free(sabr_ir_edit_t* edit);
+bool sabr_ir_edit_insert(sabr_ir_edit_t* edit, size_t index, bool after, sabr_bcop_t bcop);
+bool sabr_ir_edit_lower(sabr_ir_edit_t* edit, sabr_bytecode_t* bc);
+int sabr_ir_insert_compare(const void* a, const void* b);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,34 @@
+#ifndef __IR_PASS_H__
+#define __IR_PASS_H__
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "cctl_define.h"
+
+#include "error_message.h"
+
+#include "bcop.h"
+#include "bytecode.h"
+#include "ir.h"
+
+typedef struct sabr_ir_range_struct {
+	size_t begin;
+	size_t end;
+	size_t length;
+} sabr_ir_range_t;
+
+bool sabr_ir_pass_copyprop(sabr_ir_function_t* fn, sabr_ir_edit_t* edit);
+bool sabr_ir_pass_licm(sabr_ir_function_t* fn, sabr_ir_edit_t* edit);
+bool sabr_ir_pass_licm_loop(sabr_ir_function_t* fn, sabr_ir_edit_t* edit, sabr_ir_range_t loop, bool* written, bool* deleted, sabr_ir_range_t* hoists, uint64_t* temps);
+bool sabr_ir_pass_licm_is_invariant(sabr_ir_function_t* fn, sabr_ir_range_t range, bool* written, bool* deleted);
+bool sabr_ir_pass_cse(sabr_ir_function_t* fn, sabr_ir_edit_t* edit);
+bool sabr_ir_pass_dse(sabr_ir_function_t* fn, sabr_ir_edit_t* edit);
+void sabr_ir_pass_dse_transfer(sabr_ir_function_t* fn, size_t block, bool* live);
+void sabr_ir_pass_dse_block(sabr_ir_function_t* fn, size_t block, bool* live);
+int sabr_ir_range_compare(const void* a, const void* b);
+
+#endif
\ No newline at end of file
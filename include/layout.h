@@ -0,0 +1,37 @@
+#ifndef __LAYOUT_H__
+#define __LAYOUT_H__
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "cctl_define.h"
+
+#include "error_message.h"
+
+#include "bcop.h"
+#include "bytecode.h"
+#include "profile.h"
+
+#define SABR_LAYOUT_MIN_COUNT 16
+#define SABR_LAYOUT_COLD_RATIO 16
+#define SABR_LAYOUT_HOT_SHARE 1000
+
+typedef struct sabr_layout_function_struct {
+	size_t head;
+	size_t end;
+	uint64_t count;
+} sabr_layout_function_t;
+
+bool sabr_layout_run(sabr_bytecode_t* bc, sabr_profile_t* profile);
+bool sabr_layout_place(sabr_bytecode_t* bc, sabr_profile_t* profile, bool* hot);
+bool sabr_layout_inline(sabr_bytecode_t* bc, bool* hot);
+bool sabr_layout_owners(sabr_bytecode_t* bc, size_t* owners);
+bool sabr_layout_tables(sabr_bytecode_t* bc, size_t* table_begins, size_t* table_ends);
+bool sabr_layout_is_movable(size_t* table_begins, size_t* table_ends, size_t begin, size_t end);
+bool sabr_layout_is_terminal(sabr_opcode_t oc);
+sabr_opcode_t sabr_layout_invert(sabr_opcode_t oc);
+int sabr_layout_function_compare(const void* a, const void* b);
+
+#endif
\ No newline at end of file
@@ -15,22 +15,45 @@ typedef enum sabr_opcode_enum {
 	SABR_OP_JUMP,
 
 	SABR_OP_FOR,
+	SABR_OP_FOR_ADDR,
 	SABR_OP_FOR_FROM,
 	SABR_OP_FOR_TO,
 	SABR_OP_FOR_STEP,
 	SABR_OP_FOR_CHECK,
 	SABR_OP_FOR_NEXT,
 	SABR_OP_FOR_END,
+	SABR_OP_FOR_INIT,
+	SABR_OP_FOR_TO_I,
+	SABR_OP_FOR_TO_U,
+	SABR_OP_FOR_TO_F,
+	SABR_OP_FOR_ENTER_I,
+	SABR_OP_FOR_ENTER_U,
+	SABR_OP_FOR_ENTER_F,
+	SABR_OP_FOR_LOOP_I,
+	SABR_OP_FOR_LOOP_U,
+	SABR_OP_FOR_LOOP_F,
+	SABR_OP_FOR_UP_I,
+	SABR_OP_FOR_UP_U,
+	SABR_OP_FOR_UP_F,
+	SABR_OP_FOR_DOWN_I,
+	SABR_OP_FOR_DOWN_U,
+	SABR_OP_FOR_DOWN_F,
+	SABR_OP_FOR_LEAVE,
 
 	SABR_OP_SWITCH,
 	SABR_OP_SWITCH_CASE,
 	SABR_OP_SWITCH_END,
+	SABR_OP_CASE_IF,
+	SABR_OP_SWITCH_TABLE,
+	SABR_OP_SWITCH_SEARCH,
 
 	SABR_OP_LAMBDA,
 	SABR_OP_RETURN,
 	SABR_OP_LOCAL,
 	SABR_OP_LOCAL_END,
 	SABR_OP_DEFINE,
+	SABR_OP_INLINE,
+	SABR_OP_NOINLINE,
 
 	SABR_OP_DATAGROUP,
 	SABR_OP_MEMBER,
@@ -39,9 +62,26 @@ typedef enum sabr_opcode_enum {
 	
 	SABR_OP_SET,
 	SABR_OP_EXEC,
+	SABR_OP_CALL,
+	SABR_OP_TAILCALL,
 	SABR_OP_ADDR,
 	SABR_OP_REF,
 
+	SABR_OP_LOAD_LOCAL,
+	SABR_OP_STORE_LOCAL,
+	SABR_OP_ADDR_LOCAL,
+	SABR_OP_INC_LOCAL,
+	SABR_OP_DEC_LOCAL,
+	SABR_OP_ADD_LOCAL,
+	SABR_OP_FADD_LOCAL,
+	SABR_OP_LOAD_GLOBAL,
+	SABR_OP_STORE_GLOBAL,
+	SABR_OP_ADDR_GLOBAL,
+	SABR_OP_INC_GLOBAL,
+	SABR_OP_DEC_GLOBAL,
+	SABR_OP_ADD_GLOBAL,
+	SABR_OP_FADD_GLOBAL,
+
 	SABR_OP_CALL_BIF,
 
 	SABR_OP_ADD,
@@ -54,6 +94,8 @@ typedef enum sabr_opcode_enum {
 	SABR_OP_NEG,
 	SABR_OP_INC,
 	SABR_OP_DEC,
+	SABR_OP_ADD_IMM,
+	SABR_OP_MUL_IMM,
 
 	SABR_OP_EQU,
 	SABR_OP_NEQ,
@@ -65,6 +107,22 @@ typedef enum sabr_opcode_enum {
 	SABR_OP_UGEQ,
 	SABR_OP_ULST,
 	SABR_OP_ULEQ,
+	SABR_OP_LST_IF,
+	SABR_OP_EQU_IF,
+	SABR_OP_NEQ_IF,
+	SABR_OP_GRT_IF,
+	SABR_OP_GEQ_IF,
+	SABR_OP_LEQ_IF,
+	SABR_OP_UGRT_IF,
+	SABR_OP_UGEQ_IF,
+	SABR_OP_ULST_IF,
+	SABR_OP_ULEQ_IF,
+	SABR_OP_EQU_IMM,
+	SABR_OP_NEQ_IMM,
+	SABR_OP_GRT_IMM,
+	SABR_OP_GEQ_IMM,
+	SABR_OP_LST_IMM,
+	SABR_OP_LEQ_IMM,
 
 	SABR_OP_FADD,
 	SABR_OP_FSUB,
@@ -79,6 +137,12 @@ typedef enum sabr_opcode_enum {
 	SABR_OP_FGEQ,
 	SABR_OP_FLST,
 	SABR_OP_FLEQ,
+	SABR_OP_FEQU_IF,
+	SABR_OP_FNEQ_IF,
+	SABR_OP_FGRT_IF,
+	SABR_OP_FGEQ_IF,
+	SABR_OP_FLST_IF,
+	SABR_OP_FLEQ_IF,
 
 	SABR_OP_BAND,
 	SABR_OP_BOR,
@@ -86,6 +150,9 @@ typedef enum sabr_opcode_enum {
 	SABR_OP_BNOT,
 	SABR_OP_BLSFT,
 	SABR_OP_BRSFT,
+	SABR_OP_BAND_IMM,
+	SABR_OP_BLSFT_IMM,
+	SABR_OP_BRSFT_IMM,
 
 	SABR_OP_DROP,
 	SABR_OP_NIP,
@@ -111,6 +178,29 @@ typedef enum sabr_opcode_enum {
 	
 	SABR_OP_FETCH,
 	SABR_OP_STORE,
+	SABR_OP_INC_MEM,
+	SABR_OP_DEC_MEM,
+	SABR_OP_ADD_MEM,
+	SABR_OP_SUB_MEM,
+	SABR_OP_MUL_MEM,
+	SABR_OP_DIV_MEM,
+	SABR_OP_MOD_MEM,
+	SABR_OP_FADD_MEM,
+	SABR_OP_FSUB_MEM,
+	SABR_OP_FMUL_MEM,
+	SABR_OP_FDIV_MEM,
+	SABR_OP_FMOD_MEM,
+	SABR_OP_BAND_MEM,
+	SABR_OP_BOR_MEM,
+	SABR_OP_BXOR_MEM,
+	SABR_OP_BNOT_MEM,
+	SABR_OP_BLSFT_MEM,
+	SABR_OP_BRSFT_MEM,
+	SABR_OP_INDEX_CELL,
+	SABR_OP_FETCH_IDX,
+	SABR_OP_STORE_IDX,
+	SABR_OP_FETCH_OFF,
+	SABR_OP_STORE_OFF,
 
 	SABR_OP_ARRAY,
 	SABR_OP_ARRAY_COMMA,
@@ -133,14 +223,22 @@ typedef enum sabr_opcode_enum {
 	SABR_OP_PUTF,
 	SABR_OP_PUTS,
 
-	SABR_OP_SHOW
+	SABR_OP_SHOW,
+
+	SABR_OP_COUNT
 } sabr_opcode_t;
 
+_Static_assert(SABR_OP_COUNT <= 256, "opcodes must fit in one byte");
+
+#define SABR_OP_FOR_RECORD_SIZE 4
 
 extern size_t sabr_opcode_names_len;
 extern const char* sabr_opcode_names[];
 
 bool sabr_opcode_has_operand(sabr_opcode_t oc);
 bool sabr_opcode_has_index_operand(sabr_opcode_t oc);
+bool sabr_opcode_is_control(sabr_opcode_t oc);
+bool sabr_opcode_is_global(sabr_opcode_t oc);
+bool sabr_opcode_stack_effect(sabr_opcode_t oc, size_t* pops, size_t* pushes);
 
 #endif
\ No newline at end of file
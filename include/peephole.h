@@ -0,0 +1,24 @@
+#ifndef __PEEPHOLE_H__
+#define __PEEPHOLE_H__
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdlib.h>
+
+#include "cctl_define.h"
+
+#include "error_message.h"
+
+#include "bcop.h"
+#include "bytecode.h"
+
+bool sabr_peephole_run(sabr_bytecode_t* bc);
+bool sabr_peephole_fuse(sabr_bytecode_t* bc, bool* targets, bool* changed);
+bool sabr_peephole_compact(sabr_bytecode_t* bc);
+bool sabr_peephole_match(sabr_bytecode_t* bc, bool* targets, size_t index, const sabr_opcode_t* pattern, size_t len);
+sabr_opcode_t sabr_peephole_branch(sabr_opcode_t oc);
+sabr_opcode_t sabr_peephole_immediate(sabr_opcode_t oc);
+sabr_opcode_t sabr_peephole_variable(sabr_opcode_t addr, sabr_opcode_t oc);
+bool* sabr_peephole_targets(sabr_bytecode_t* bc);
+
+#endif
\ No newline at end of file
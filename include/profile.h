@@ -0,0 +1,45 @@
+#ifndef __PROFILE_H__
+#define __PROFILE_H__
+
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "cctl_define.h"
+
+#include "error_message.h"
+
+#include "bcop.h"
+#include "bytecode.h"
+
+#define SABR_PROFILE_EDGE_CAPACITY 64
+
+typedef struct sabr_profile_edge_struct {
+	size_t from;
+	size_t to;
+	uint64_t count;
+} sabr_profile_edge_t;
+
+typedef struct sabr_profile_struct {
+	size_t size;
+	uint64_t checksum;
+	uint64_t* counts;
+	sabr_profile_edge_t* edges;
+	size_t edge_count;
+	size_t edge_capacity;
+} sabr_profile_t;
+
+bool sabr_profile_init(sabr_profile_t* profile, size_t size, uint64_t checksum);
+void sabr_profile_del(sabr_profile_t* profile);
+bool sabr_profile_add_edge(sabr_profile_t* profile, size_t from, size_t to, uint64_t count);
+uint64_t sabr_profile_edge(sabr_profile_t* profile, size_t from, size_t to);
+size_t sabr_profile_slot(sabr_profile_edge_t* edges, size_t capacity, size_t from, size_t to);
+bool sabr_profile_save(sabr_profile_t* profile, const char* filename);
+bool sabr_profile_load(sabr_profile_t* profile, const char* filename);
+uint64_t sabr_profile_checksum(sabr_bytecode_t* bc);
+bool sabr_profile_matches(sabr_profile_t* profile, sabr_bytecode_t* bc);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,21 @@
+#ifndef __SHAKER_H__
+#define __SHAKER_H__
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdlib.h>
+
+#include "cctl_define.h"
+
+#include "error_message.h"
+
+#include "bcop.h"
+#include "bytecode.h"
+
+bool sabr_shaker_run(sabr_bytecode_t* bc);
+bool sabr_shaker_droppables(sabr_bytecode_t* bc, bool* droppable);
+bool sabr_shaker_mark(sabr_bytecode_t* bc, bool* droppable, bool* reached);
+size_t sabr_shaker_group_end(sabr_bytecode_t* bc, size_t index);
+bool sabr_shaker_is_numeric(sabr_opcode_t oc);
+
+#endif
\ No newline at end of file
@@ -1,4 +1,29 @@
 #include "bytecode.h"
+#include "peephole.h"
+#include "inliner.h"
+#include "folder.h"
+#include "shaker.h"
+#include "ir.h"
+#include "layout.h"
+#include "compact.h"
+
+extern inline size_t sabr_bytecode_read(const uint8_t* code, size_t size, size_t pos, sabr_bcop_t* bcop);
+
+const char* sabr_bytecode_pass_names[] = {
+	"folder",
+	"inliner",
+	"loops",
+	"tails",
+	"switches",
+	"copyprop",
+	"licm",
+	"cse",
+	"dse",
+	"shaker",
+	"peephole",
+	"layout",
+	NULL
+};
 
 void sabr_bytecode_print(sabr_bytecode_t* bc) {
 	size_t j = 0;
@@ -18,14 +43,163 @@ void sabr_bytecode_init(sabr_bytecode_t* bc) {
 	vector_init(sabr_bcop_t, &bc->bcop_vec);
 	bc->current_index = 0;
 	bc->current_pos = 0;
+	bc->compact = NULL;
+	bc->compact_size = 0;
+	bc->image = NULL;
+	bc->image_size = 0;
+	bc->mapped = false;
+	bc->ocs = NULL;
+	bc->ocs_size = 0;
+	bc->operand_indices = NULL;
+	bc->operands = NULL;
 }
 
 void sabr_bytecode_free(sabr_bytecode_t* bc) {
 	if (!bc) return;
 	vector_free(sabr_bcop_t, &bc->bcop_vec);
+	sabr_bytecode_release(bc);
+#if !defined(_WIN32)
+	if (bc->mapped) munmap(bc->compact, bc->compact_size);
+	else free(bc->compact);
+#else
+	free(bc->compact);
+#endif
+	bc->compact = NULL;
+	bc->mapped = false;
+	sabr_bytecode_unsplit(bc);
+}
+
+void sabr_bytecode_release(sabr_bytecode_t* bc) {
+	if (!bc->image) return;
+#if !defined(_WIN32)
+	if (bc->mapped) munmap(bc->image, bc->image_size);
+	else free(bc->image);
+#else
+	free(bc->image);
+#endif
+	bc->image = NULL;
+	bc->image_size = 0;
+	bc->mapped = false;
+}
+
+bool sabr_bytecode_check_header(const uint8_t* code, size_t size) {
+	if (size < SABR_BYTECODE_HEADER_SIZE || memcmp(code, SABR_BYTECODE_MAGIC, SABR_BYTECODE_MAGIC_SIZE)) {
+		fputs(sabr_errmsg_bytecode_format, stderr);
+		return false;
+	}
+	if (code[SABR_BYTECODE_MAGIC_SIZE] != SABR_BYTECODE_VERSION) {
+		fputs(sabr_errmsg_bytecode_version, stderr);
+		return false;
+	}
+	return true;
+}
+
+bool sabr_bytecode_check_image(const uint8_t* code, size_t size) {
+	bool succeed = false;
+	bool switches = false;
+	size_t count = 0;
+	uint64_t target = 0;
+	size_t* offsets = NULL;
+	uint8_t kinds[256];
+
+	if (!sabr_bytecode_check_header(code, size)) return false;
+	sabr_compact_kinds(kinds);
+	for (size_t pos = SABR_BYTECODE_HEADER_SIZE; pos < size; count++) {
+		uint8_t oc = code[pos++];
+		if (oc >= SABR_OP_COUNT) goto INVALID;
+		if (kinds[oc] == SABR_COMPACT_KIND_NONE) continue;
+		if (size - pos < 8) goto INVALID;
+		if (kinds[oc] == SABR_COMPACT_KIND_INDEX) {
+			sabr_value_t v;
+			memcpy(v.bytes, code + pos, 8);
+			if (v.u > target) target = v.u;
+			if (oc == SABR_OP_SWITCH_TABLE || oc == SABR_OP_SWITCH_SEARCH) switches = true;
+		}
+		pos += 8;
+	}
+	if (count >= UINT32_MAX || target > count) goto INVALID;
+	if (!switches) return true;
+
+	offsets = (size_t*) malloc(sizeof(size_t) * (count + 1));
+	if (!offsets) {
+		fputs(sabr_errmsg_alloc, stderr);
+		return false;
+	}
+	count = 0;
+	for (size_t pos = SABR_BYTECODE_HEADER_SIZE; pos < size;) {
+		sabr_bcop_t bcop;
+		offsets[count++] = pos;
+		pos = sabr_bytecode_read(code, size, pos, &bcop);
+	}
+	offsets[count] = size;
+
+	for (size_t i = 0; i < count; i++) {
+		sabr_bcop_t bcop;
+		if (code[offsets[i]] != SABR_OP_SWITCH_TABLE && code[offsets[i]] != SABR_OP_SWITCH_SEARCH) continue;
+		sabr_bytecode_read(code, size, offsets[i], &bcop);
+		if (!sabr_bytecode_check_image_switch(code, size, offsets, count, bcop)) goto INVALID;
+	}
+	succeed = true;
+	goto FREE_ALL;
+
+INVALID:
+	fputs(sabr_errmsg_invalid_bytecode, stderr);
+FREE_ALL:
+	free(offsets);
+	return succeed;
+}
+
+bool sabr_bytecode_check_image_switch(const uint8_t* code, size_t size, const size_t* offsets, size_t count, sabr_bcop_t bcop) {
+	size_t table = bcop.operand.u;
+	size_t first, entries, stride;
+	sabr_bcop_t member;
+
+	if (bcop.oc == SABR_OP_SWITCH_TABLE) {
+		if (table >= count || count - table < 3) return false;
+		if (!sabr_bytecode_read(code, size, offsets[table + 1], &member)) return false;
+		entries = member.operand.u;
+		if (entries > count - table - 3) return false;
+		first = table + 2;
+		stride = 1;
+	}
+	else {
+		if (table >= count || count - table < 2) return false;
+		if (!sabr_bytecode_read(code, size, offsets[table], &member)) return false;
+		entries = member.operand.u;
+		if (entries > (count - table - 2) / 2) return false;
+		first = table + 1;
+		stride = 2;
+	}
+
+	for (size_t i = 0; i <= entries; i++) {
+		if (!sabr_bytecode_read(code, size, offsets[first + i * stride], &member)) return false;
+		if (member.oc != SABR_OP_JUMP || member.operand.u > count) return false;
+	}
+	return true;
+}
+
+bool sabr_bytecode_expand(sabr_bytecode_t* bc) {
+	const uint8_t* code = bc->image;
+	uint8_t kinds[256];
+
+	if (!code || bc->bcop_vec.size) return true;
+	sabr_compact_kinds(kinds);
+	for (size_t pos = SABR_BYTECODE_HEADER_SIZE; pos < bc->image_size;) {
+		sabr_opcode_t oc = code[pos++];
+		if (kinds[oc] == SABR_COMPACT_KIND_NONE) {
+			if (!sabr_bytecode_write_bcop(bc, oc)) return false;
+			continue;
+		}
+		sabr_value_t v;
+		memcpy(v.bytes, code + pos, 8);
+		pos += 8;
+		if (!sabr_bytecode_write_bcop_with_value(bc, oc, v)) return false;
+	}
+	sabr_bytecode_release(bc);
+	return true;
 }
 
-sabr_bytecode_t* sabr_bytecode_concat(sabr_bytecode_t* a, sabr_bytecode_t* b) {
+sabr_bytecode_t* sabr_bytecode_concat(sabr_bytecode_t* a, sabr_bytecode_t* b, sabr_bytecode_options_t* options) {
 	sabr_bytecode_t* concated_bc = NULL;
 	concated_bc = (sabr_bytecode_t*) malloc(sizeof(sabr_bytecode_t));
 	if (!concated_bc) return NULL;
@@ -33,6 +207,16 @@ sabr_bytecode_t* sabr_bytecode_concat(sabr_bytecode_t* a, sabr_bytecode_t* b) {
 
 	if (!sabr_bytecode_join(concated_bc, a)) return NULL;
 	if (!sabr_bytecode_join(concated_bc, b)) return NULL;
+	if (!sabr_bytecode_link(concated_bc, options)) return NULL;
+	if (options->level) {
+		if (!sabr_peephole_run(concated_bc)) return NULL;
+		if (!sabr_bytecode_print_after(concated_bc, options, "peephole")) return NULL;
+	}
+	else if (!sabr_peephole_compact(concated_bc)) return NULL;
+	if (options->profile) {
+		if (!sabr_layout_run(concated_bc, options->profile)) return NULL;
+		if (!sabr_bytecode_print_after(concated_bc, options, "layout")) return NULL;
+	}
 
 	return concated_bc;
 }
@@ -55,6 +239,883 @@ bool sabr_bytecode_join(sabr_bytecode_t* dest, sabr_bytecode_t* src) {
 	return true;
 }
 
+bool sabr_bytecode_split(sabr_bytecode_t* bc) {
+	size_t size = bc->bcop_vec.size;
+	size_t count = 1;
+
+	sabr_bytecode_unsplit(bc);
+	if (!size && bc->image) return sabr_bytecode_split_image(bc);
+	if (size >= UINT32_MAX) {
+		fputs(sabr_errmsg_invalid_bytecode, stderr);
+		return false;
+	}
+	for (size_t i = 0; i < size; i++)
+		if (sabr_opcode_has_operand(vector_at(sabr_bcop_t, &bc->bcop_vec, i)->oc)) count++;
+
+	bc->ocs = (uint8_t*) malloc(size + 1);
+	bc->operand_indices = (uint32_t*) malloc(sizeof(uint32_t) * (size + 1));
+	bc->operands = (sabr_value_t*) malloc(sizeof(sabr_value_t) * count);
+	if (!bc->ocs || !bc->operand_indices || !bc->operands) {
+		sabr_bytecode_unsplit(bc);
+		fputs(sabr_errmsg_alloc, stderr);
+		return false;
+	}
+
+	count = 1;
+	bc->operands[0].u = 0;
+	for (size_t i = 0; i < size; i++) {
+		sabr_bcop_t bcop = *vector_at(sabr_bcop_t, &bc->bcop_vec, i);
+		bc->ocs[i] = bcop.oc;
+		bc->operand_indices[i] = 0;
+		if (!sabr_opcode_has_operand(bcop.oc)) continue;
+		bc->operand_indices[i] = count;
+		bc->operands[count++] = bcop.operand;
+	}
+	bc->ocs[size] = SABR_OP_NONE;
+	bc->operand_indices[size] = 0;
+	bc->ocs_size = size;
+	return true;
+}
+
+bool sabr_bytecode_split_image(sabr_bytecode_t* bc) {
+	const uint8_t* code = bc->image;
+	size_t size = 0;
+	size_t count = 1;
+	uint8_t kinds[256];
+
+	sabr_compact_kinds(kinds);
+	for (size_t pos = SABR_BYTECODE_HEADER_SIZE; pos < bc->image_size; size++) {
+		if (kinds[code[pos]] == SABR_COMPACT_KIND_NONE) {
+			pos++;
+			continue;
+		}
+		pos += 9;
+		count++;
+	}
+
+	bc->ocs = (uint8_t*) malloc(size + 1);
+	bc->operand_indices = (uint32_t*) malloc(sizeof(uint32_t) * (size + 1));
+	bc->operands = (sabr_value_t*) malloc(sizeof(sabr_value_t) * count);
+	if (!bc->ocs || !bc->operand_indices || !bc->operands) {
+		sabr_bytecode_unsplit(bc);
+		fputs(sabr_errmsg_alloc, stderr);
+		return false;
+	}
+
+	count = 1;
+	bc->operands[0].u = 0;
+	for (size_t i = 0, pos = SABR_BYTECODE_HEADER_SIZE; i < size; i++) {
+		bc->ocs[i] = code[pos];
+		bc->operand_indices[i] = 0;
+		if (kinds[code[pos++]] == SABR_COMPACT_KIND_NONE) continue;
+		bc->operand_indices[i] = count;
+		memcpy(bc->operands[count++].bytes, code + pos, 8);
+		pos += 8;
+	}
+	bc->ocs[size] = SABR_OP_NONE;
+	bc->operand_indices[size] = 0;
+	bc->ocs_size = size;
+	return true;
+}
+
+void sabr_bytecode_unsplit(sabr_bytecode_t* bc) {
+	free(bc->ocs);
+	free(bc->operand_indices);
+	free(bc->operands);
+	bc->ocs = NULL;
+	bc->operand_indices = NULL;
+	bc->operands = NULL;
+	bc->ocs_size = 0;
+}
+
+bool sabr_bytecode_link(sabr_bytecode_t* bc, sabr_bytecode_options_t* options) {
+	bool succeed = false;
+	size_t size = bc->bcop_vec.size;
+	bool* targets = NULL;
+	size_t* owners = NULL;
+
+	targets = (bool*) calloc(size + 1, sizeof(bool));
+	owners = (size_t*) malloc(sizeof(size_t) * (size + 1));
+	if (!targets || !owners) {
+		fputs(sabr_errmsg_alloc, stderr);
+		goto FREE_ALL;
+	}
+
+	for (size_t i = 0; i < size; i++) {
+		sabr_bcop_t bcop = *vector_at(sabr_bcop_t, &bc->bcop_vec, i);
+		if (sabr_opcode_has_index_operand(bcop.oc) && bcop.operand.u <= size)
+			targets[bcop.operand.u] = true;
+	}
+
+	if (!sabr_bytecode_link_calls(bc, targets)) goto FREE_ALL;
+	if (!sabr_bytecode_link_owners(bc, owners)) {
+		succeed = true;
+		goto FREE_ALL;
+	}
+	if (!sabr_bytecode_link_locals(bc, targets, owners)) goto FREE_ALL;
+	if (!sabr_bytecode_link_globals(bc, targets, owners)) goto FREE_ALL;
+	if (options->level >= 1) {
+		if (!sabr_folder_run(bc)) goto FREE_ALL;
+		if (!sabr_bytecode_print_after(bc, options, "folder")) goto FREE_ALL;
+	}
+	for (size_t depth = 0; options->level >= 2 && depth < SABR_INLINER_DEPTH; depth++) {
+		if (!sabr_inliner_run(bc, owners, NULL)) goto FREE_ALL;
+		if (!sabr_bytecode_print_after(bc, options, "inliner")) goto FREE_ALL;
+		if (bc->bcop_vec.size == size) break;
+		size = bc->bcop_vec.size;
+		free(owners);
+		owners = (size_t*) malloc(sizeof(size_t) * (size + 1));
+		if (!owners) {
+			fputs(sabr_errmsg_alloc, stderr);
+			goto FREE_ALL;
+		}
+		if (!sabr_bytecode_link_owners(bc, owners)) {
+			succeed = true;
+			goto FREE_ALL;
+		}
+	}
+	if (options->level >= 1) {
+		if (!sabr_folder_run(bc)) goto FREE_ALL;
+		if (!sabr_bytecode_print_after(bc, options, "folder")) goto FREE_ALL;
+	}
+	sabr_bytecode_link_loops(bc, owners);
+	if (!sabr_bytecode_print_after(bc, options, "loops")) goto FREE_ALL;
+	sabr_bytecode_link_tails(bc, owners);
+	if (!sabr_bytecode_print_after(bc, options, "tails")) goto FREE_ALL;
+	if (!sabr_bytecode_link_switches(bc)) goto FREE_ALL;
+	if (!sabr_bytecode_print_after(bc, options, "switches")) goto FREE_ALL;
+	if (!sabr_ir_run(bc, options)) goto FREE_ALL;
+	if (options->level >= 1) {
+		if (!sabr_shaker_run(bc)) goto FREE_ALL;
+		if (!sabr_bytecode_print_after(bc, options, "shaker")) goto FREE_ALL;
+	}
+
+	succeed = true;
+
+FREE_ALL:
+	free(targets);
+	free(owners);
+	return succeed;
+}
+
+bool sabr_bytecode_print_after(sabr_bytecode_t* bc, sabr_bytecode_options_t* options, const char* pass) {
+	if (strcmp(options->print_after, pass)) return true;
+	printf("; after %s\n", pass);
+	sabr_bytecode_print(bc);
+	return sabr_ir_print_bytecode(bc);
+}
+
+bool sabr_bytecode_is_pass(const char* name) {
+	for (size_t i = 0; sabr_bytecode_pass_names[i]; i++)
+		if (!strcmp(sabr_bytecode_pass_names[i], name)) return true;
+	return false;
+}
+
+bool sabr_bytecode_link_calls(sabr_bytecode_t* bc, bool* targets) {
+	bool succeed = false;
+	size_t size = bc->bcop_vec.size;
+	size_t count = 0;
+	sabr_bytecode_link_data_t* defs = NULL;
+
+	defs = (sabr_bytecode_link_data_t*) malloc(sizeof(sabr_bytecode_link_data_t) * (size + 1));
+	if (!defs) {
+		fputs(sabr_errmsg_alloc, stderr);
+		goto FREE_ALL;
+	}
+
+	for (size_t i = 1; i < size; i++) {
+		sabr_bcop_t bcop = *vector_at(sabr_bcop_t, &bc->bcop_vec, i);
+		sabr_bcop_t prev = *vector_at(sabr_bcop_t, &bc->bcop_vec, i - 1);
+		if (bcop.oc != SABR_OP_LAMBDA || prev.oc != SABR_OP_VALUE || targets[i]) continue;
+		if (bcop.operand.u >= size || vector_at(sabr_bcop_t, &bc->bcop_vec, bcop.operand.u)->oc != SABR_OP_DEFINE) continue;
+		defs[count].identifier = prev.operand.u;
+		defs[count].entry = i + 1;
+		defs[count].bindable = true;
+		count++;
+	}
+	if (!count) {
+		succeed = true;
+		goto FREE_ALL;
+	}
+
+	qsort(defs, count, sizeof(sabr_bytecode_link_data_t), sabr_bytecode_link_data_compare);
+	for (size_t i = 1; i < count; i++) {
+		if (defs[i].identifier != defs[i - 1].identifier) continue;
+		defs[i].bindable = false;
+		defs[i - 1].bindable = false;
+	}
+
+	for (size_t i = 1; i < size; i++) {
+		sabr_bcop_t bcop = *vector_at(sabr_bcop_t, &bc->bcop_vec, i);
+		sabr_bcop_t prev = *vector_at(sabr_bcop_t, &bc->bcop_vec, i - 1);
+		if (prev.oc != SABR_OP_VALUE) continue;
+		switch (bcop.oc) {
+			case SABR_OP_SET:
+			case SABR_OP_REF:
+			case SABR_OP_FOR:
+			case SABR_OP_DATAGROUP: {
+				sabr_bytecode_link_data_t* def = sabr_bytecode_link_data_find(defs, count, prev.operand.u);
+				if (def) def->bindable = false;
+			} break;
+			default: break;
+		}
+	}
+
+	for (size_t i = 0; i < size; i++) {
+		sabr_bcop_t* bcop = vector_at(sabr_bcop_t, &bc->bcop_vec, i);
+		if (bcop->oc != SABR_OP_EXEC || !bcop->operand.u) continue;
+		sabr_bytecode_link_data_t* def = sabr_bytecode_link_data_find(defs, count, bcop->operand.u);
+		if (!def || !def->bindable) continue;
+		bcop->oc = SABR_OP_CALL;
+		bcop->operand.u = def->entry;
+	}
+
+	succeed = true;
+
+FREE_ALL:
+	free(defs);
+	return succeed;
+}
+
+bool sabr_bytecode_link_owners(sabr_bytecode_t* bc, size_t* owners) {
+	bool succeed = false;
+	size_t size = bc->bcop_vec.size;
+	size_t depth = 0;
+	size_t* lambdas = NULL;
+
+	lambdas = (size_t*) malloc(sizeof(size_t) * (size + 1));
+	if (!lambdas) goto FREE_ALL;
+
+	for (size_t i = 0; i < size; i++) {
+		sabr_bcop_t bcop = *vector_at(sabr_bcop_t, &bc->bcop_vec, i);
+		while (depth && i >= vector_at(sabr_bcop_t, &bc->bcop_vec, lambdas[depth - 1])->operand.u) depth--;
+		owners[i] = depth ? lambdas[depth - 1] : SIZE_MAX;
+		if (bcop.oc != SABR_OP_LAMBDA) continue;
+		if (bcop.operand.u <= i || bcop.operand.u > size) goto FREE_ALL;
+		if (depth && bcop.operand.u > vector_at(sabr_bcop_t, &bc->bcop_vec, lambdas[depth - 1])->operand.u) goto FREE_ALL;
+		lambdas[depth++] = i;
+	}
+	succeed = true;
+
+FREE_ALL:
+	free(lambdas);
+	return succeed;
+}
+
+bool sabr_bytecode_link_locals(sabr_bytecode_t* bc, bool* targets, size_t* owners) {
+	bool succeed = false;
+	size_t size = bc->bcop_vec.size;
+	size_t global_count = 0;
+	bool global_dynamic = false;
+	sabr_bytecode_link_data_t* globals = NULL;
+	sabr_bytecode_link_data_t* slots = NULL;
+
+	globals = (sabr_bytecode_link_data_t*) malloc(sizeof(sabr_bytecode_link_data_t) * (size + 1));
+	slots = (sabr_bytecode_link_data_t*) malloc(sizeof(sabr_bytecode_link_data_t) * (size + 1));
+	if (!globals || !slots) {
+		fputs(sabr_errmsg_alloc, stderr);
+		goto FREE_ALL;
+	}
+
+	for (size_t i = 1; i < size; i++) {
+		sabr_bcop_t bcop = *vector_at(sabr_bcop_t, &bc->bcop_vec, i);
+		sabr_bcop_t prev = *vector_at(sabr_bcop_t, &bc->bcop_vec, i - 1);
+		bool is_global = !sabr_bytecode_link_is_function(bc, owners[i]);
+		switch (bcop.oc) {
+			case SABR_OP_LAMBDA:
+			case SABR_OP_DATAGROUP:
+				if (prev.oc == SABR_OP_VALUE) globals[global_count++].identifier = prev.operand.u;
+				break;
+			case SABR_OP_SET:
+			case SABR_OP_REF:
+			case SABR_OP_FOR:
+				if (!is_global) break;
+				if (sabr_bytecode_link_is_dynamic(bc, targets, i)) global_dynamic = true;
+				else globals[global_count++].identifier = prev.operand.u;
+				break;
+			default: break;
+		}
+	}
+	if (global_dynamic) {
+		for (size_t i = 0; i < size; i++) {
+			sabr_bcop_t bcop = *vector_at(sabr_bcop_t, &bc->bcop_vec, i);
+			if (bcop.oc != SABR_OP_VALUE || sabr_bytecode_link_is_function(bc, owners[i])) continue;
+			globals[global_count++].identifier = bcop.operand.u;
+		}
+	}
+	qsort(globals, global_count, sizeof(sabr_bytecode_link_data_t), sabr_bytecode_link_data_compare);
+
+	for (size_t l = 0; l < size; l++) {
+		if (!sabr_bytecode_link_is_function(bc, l)) continue;
+		size_t end = vector_at(sabr_bcop_t, &bc->bcop_vec, l)->operand.u;
+		size_t slot_count = 0;
+		bool slottable = true;
+
+		for (size_t i = l + 2; i < end && slottable; i++) {
+			if (owners[i] != l) continue;
+			sabr_bcop_t bcop = *vector_at(sabr_bcop_t, &bc->bcop_vec, i);
+			if (sabr_bytecode_link_is_dynamic(bc, targets, i)) slottable = false;
+			else if (bcop.oc == SABR_OP_CALL && !sabr_bytecode_link_is_plain_call(bc, owners, bcop.operand.u)) slottable = false;
+		}
+		if (!slottable) continue;
+
+		for (size_t i = l + 2; i < end; i++) {
+			if (owners[i] != l) continue;
+			sabr_bcop_t bcop = *vector_at(sabr_bcop_t, &bc->bcop_vec, i);
+			sabr_bcop_t prev = *vector_at(sabr_bcop_t, &bc->bcop_vec, i - 1);
+			if (bcop.oc != SABR_OP_SET && bcop.oc != SABR_OP_FOR) continue;
+			if (sabr_bytecode_link_data_find(globals, global_count, prev.operand.u)) continue;
+			bool exists = false;
+			for (size_t j = 0; j < slot_count && !exists; j++)
+				exists = slots[j].identifier == prev.operand.u;
+			if (exists) continue;
+			slots[slot_count].identifier = prev.operand.u;
+			slots[slot_count].entry = slot_count;
+			slots[slot_count].bindable = true;
+			slot_count++;
+		}
+		for (size_t i = l + 2; i < end; i++) {
+			if (owners[i] != l) continue;
+			sabr_bcop_t bcop = *vector_at(sabr_bcop_t, &bc->bcop_vec, i);
+			sabr_bcop_t prev = *vector_at(sabr_bcop_t, &bc->bcop_vec, i - 1);
+			if (bcop.oc != SABR_OP_REF) continue;
+			for (size_t j = 0; j < slot_count; j++)
+				if (slots[j].identifier == prev.operand.u) slots[j].bindable = false;
+		}
+
+		for (size_t i = l + 2; i < end; i++) {
+			if (owners[i] != l) continue;
+			sabr_bcop_t* bcop = vector_at(sabr_bcop_t, &bc->bcop_vec, i);
+			sabr_bcop_t* prev = vector_at(sabr_bcop_t, &bc->bcop_vec, i - 1);
+			uint64_t identifier = (bcop->oc == SABR_OP_EXEC) ? bcop->operand.u : prev->operand.u;
+			sabr_bytecode_link_data_t* slot = NULL;
+			switch (bcop->oc) {
+				case SABR_OP_EXEC:
+				case SABR_OP_SET:
+				case SABR_OP_FOR:
+				case SABR_OP_ADDR:
+					for (size_t j = 0; j < slot_count && !slot; j++)
+						if (slots[j].identifier == identifier && slots[j].bindable) slot = slots + j;
+					break;
+				default: break;
+			}
+			if (!slot) continue;
+			switch (bcop->oc) {
+				case SABR_OP_EXEC:
+					*bcop = sabr_new_bcop_with_value(SABR_OP_LOAD_LOCAL, (sabr_value_t) { .u = slot->entry });
+					break;
+				case SABR_OP_SET:
+					*prev = sabr_new_bcop(SABR_OP_NONE);
+					*bcop = sabr_new_bcop_with_value(SABR_OP_STORE_LOCAL, (sabr_value_t) { .u = slot->entry });
+					break;
+				case SABR_OP_FOR:
+					*prev = sabr_new_bcop_with_value(SABR_OP_ADDR_LOCAL, (sabr_value_t) { .u = slot->entry });
+					bcop->oc = SABR_OP_FOR_ADDR;
+					break;
+				case SABR_OP_ADDR:
+					*prev = sabr_new_bcop(SABR_OP_NONE);
+					*bcop = sabr_new_bcop_with_value(SABR_OP_ADDR_LOCAL, (sabr_value_t) { .u = slot->entry });
+					break;
+				default: break;
+			}
+		}
+		vector_at(sabr_bcop_t, &bc->bcop_vec, l + 1)->operand.u = slot_count;
+	}
+
+	succeed = true;
+
+FREE_ALL:
+	free(globals);
+	free(slots);
+	return succeed;
+}
+
+bool sabr_bytecode_link_globals(sabr_bytecode_t* bc, bool* targets, size_t* owners) {
+	bool succeed = false;
+	size_t size = bc->bcop_vec.size;
+	size_t count = 0;
+	sabr_bytecode_link_data_t* globals = NULL;
+
+	globals = (sabr_bytecode_link_data_t*) malloc(sizeof(sabr_bytecode_link_data_t) * (size + 1));
+	if (!globals) {
+		fputs(sabr_errmsg_alloc, stderr);
+		goto FREE_ALL;
+	}
+
+	for (size_t i = 1; i < size; i++) {
+		sabr_bcop_t bcop = *vector_at(sabr_bcop_t, &bc->bcop_vec, i);
+		sabr_bcop_t prev = *vector_at(sabr_bcop_t, &bc->bcop_vec, i - 1);
+		if (bcop.oc != SABR_OP_SET && bcop.oc != SABR_OP_FOR) continue;
+		if (owners[i] != SIZE_MAX || sabr_bytecode_link_is_dynamic(bc, targets, i)) continue;
+		globals[count].identifier = prev.operand.u;
+		globals[count].entry = 0;
+		globals[count].bindable = true;
+		count++;
+	}
+	if (!count) {
+		succeed = true;
+		goto FREE_ALL;
+	}
+
+	qsort(globals, count, sizeof(sabr_bytecode_link_data_t), sabr_bytecode_link_data_compare);
+	for (size_t i = 0; i < size; i++) {
+		sabr_bcop_t bcop = *vector_at(sabr_bcop_t, &bc->bcop_vec, i);
+		switch (bcop.oc) {
+			case SABR_OP_REF:
+				if (sabr_bytecode_link_is_dynamic(bc, targets, i)) {
+					succeed = true;
+					goto FREE_ALL;
+				}
+			case SABR_OP_LAMBDA:
+			case SABR_OP_DATAGROUP: {
+				if (!i || vector_at(sabr_bcop_t, &bc->bcop_vec, i - 1)->oc != SABR_OP_VALUE) break;
+				sabr_bytecode_link_data_t* global = sabr_bytecode_link_data_find(globals, count, vector_at(sabr_bcop_t, &bc->bcop_vec, i - 1)->operand.u);
+				if (global) global->bindable = false;
+			} break;
+			default: break;
+		}
+	}
+
+	for (size_t i = 0; i < size; i++) {
+		sabr_bcop_t* bcop = vector_at(sabr_bcop_t, &bc->bcop_vec, i);
+		sabr_bcop_t* prev = i ? vector_at(sabr_bcop_t, &bc->bcop_vec, i - 1) : NULL;
+		sabr_bytecode_link_data_t* global = NULL;
+		switch (bcop->oc) {
+			case SABR_OP_EXEC:
+				if (bcop->operand.u) global = sabr_bytecode_link_data_find(globals, count, bcop->operand.u);
+				break;
+			case SABR_OP_SET:
+			case SABR_OP_FOR:
+			case SABR_OP_ADDR:
+				if (!sabr_bytecode_link_is_dynamic(bc, targets, i)) global = sabr_bytecode_link_data_find(globals, count, prev->operand.u);
+				break;
+			default: break;
+		}
+		if (!global || !global->bindable) continue;
+		switch (bcop->oc) {
+			case SABR_OP_EXEC:
+				bcop->oc = SABR_OP_LOAD_GLOBAL;
+				break;
+			case SABR_OP_SET:
+				*bcop = sabr_new_bcop_with_value(SABR_OP_STORE_GLOBAL, prev->operand);
+				*prev = sabr_new_bcop(SABR_OP_NONE);
+				break;
+			case SABR_OP_FOR:
+				prev->oc = SABR_OP_ADDR_GLOBAL;
+				bcop->oc = SABR_OP_FOR_ADDR;
+				break;
+			case SABR_OP_ADDR:
+				*bcop = sabr_new_bcop_with_value(SABR_OP_ADDR_GLOBAL, prev->operand);
+				*prev = sabr_new_bcop(SABR_OP_NONE);
+				break;
+			default: break;
+		}
+	}
+
+	succeed = true;
+
+FREE_ALL:
+	free(globals);
+	return succeed;
+}
+
+void sabr_bytecode_link_loops(sabr_bytecode_t* bc, size_t* owners) {
+	size_t size = bc->bcop_vec.size;
+	uint64_t top_frame = 0;
+
+	for (size_t i = 0; i < size; i++) {
+		sabr_bcop_t bcop = *vector_at(sabr_bcop_t, &bc->bcop_vec, i);
+		switch (bcop.oc) {
+			case SABR_OP_LOAD_GLOBAL:
+			case SABR_OP_STORE_GLOBAL:
+			case SABR_OP_ADDR_GLOBAL:
+				if (bcop.operand.u >= top_frame) top_frame = bcop.operand.u + 1;
+				break;
+			default: break;
+		}
+	}
+
+	for (size_t i = 1; i < size; i++) {
+		uint64_t* frame = NULL;
+		if (vector_at(sabr_bcop_t, &bc->bcop_vec, i)->oc != SABR_OP_FOR_ADDR) continue;
+		if (owners[i] == SIZE_MAX) frame = &top_frame;
+		else if (sabr_bytecode_link_is_function(bc, owners[i])) frame = &vector_at(sabr_bcop_t, &bc->bcop_vec, owners[i] + 1)->operand.u;
+		else continue;
+		if (sabr_bytecode_link_loop(bc, i, *frame)) *frame += SABR_OP_FOR_RECORD_SIZE;
+	}
+}
+
+bool sabr_bytecode_link_loop(sabr_bytecode_t* bc, size_t index, uint64_t record) {
+	size_t size = bc->bcop_vec.size;
+	size_t depth = 0;
+	size_t from = 0, to = 0, step = 0, check = 0, end = 0;
+	sabr_bcop_t* counter = vector_at(sabr_bcop_t, &bc->bcop_vec, index - 1);
+	uint64_t foty = vector_at(sabr_bcop_t, &bc->bcop_vec, index)->operand.u;
+	sabr_opcode_t next_oc = SABR_OP_FOR_LOOP_I + foty;
+	sabr_value_t start = { .u = 0 }, limit, stride;
+
+	if (counter->oc != SABR_OP_ADDR_LOCAL && counter->oc != SABR_OP_ADDR_GLOBAL) return false;
+	if (foty > 2) return false;
+
+	for (size_t i = index + 1; i < size && !check; i++) {
+		switch (vector_at(sabr_bcop_t, &bc->bcop_vec, i)->oc) {
+			case SABR_OP_FOR:
+			case SABR_OP_FOR_ADDR:
+				depth++;
+				break;
+			case SABR_OP_FOR_END:
+				if (!depth) return false;
+				depth--;
+				break;
+			case SABR_OP_FOR_FROM:
+				if (depth) break;
+				if (from || to || step) return false;
+				from = i;
+				break;
+			case SABR_OP_FOR_TO:
+				if (depth) break;
+				if (to || step) return false;
+				to = i;
+				break;
+			case SABR_OP_FOR_STEP:
+				if (depth) break;
+				if (step) return false;
+				step = i;
+				break;
+			case SABR_OP_FOR_CHECK:
+				if (!depth) check = i;
+				break;
+			default: break;
+		}
+	}
+	if (!to || !check || check != (step ? step : to) + 1) return false;
+
+	end = vector_at(sabr_bcop_t, &bc->bcop_vec, check)->operand.u;
+	if (end <= check + 1 || end >= size) return false;
+	if (vector_at(sabr_bcop_t, &bc->bcop_vec, end)->oc != SABR_OP_FOR_END) return false;
+	if (vector_at(sabr_bcop_t, &bc->bcop_vec, end - 1)->oc != SABR_OP_FOR_NEXT) return false;
+	if (vector_at(sabr_bcop_t, &bc->bcop_vec, end - 1)->operand.u != check) return false;
+
+	if (step) {
+		if (sabr_bytecode_link_literal(bc, to + 1, step, &stride)) {
+			switch (foty) {
+				case 0: next_oc = (stride.i > 0) ? SABR_OP_FOR_UP_I : SABR_OP_FOR_DOWN_I; break;
+				case 1: next_oc = (stride.u > 0) ? SABR_OP_FOR_UP_U : SABR_OP_FOR_DOWN_U; break;
+				case 2: next_oc = (stride.f > 0.0) ? SABR_OP_FOR_UP_F : SABR_OP_FOR_DOWN_F; break;
+			}
+		}
+	}
+	else if ((!from || sabr_bytecode_link_literal(bc, index + 1, from, &start)) && sabr_bytecode_link_literal(bc, from ? from + 1 : index + 1, to, &limit)) {
+		switch (foty) {
+			case 0: next_oc = (start.i > limit.i) ? SABR_OP_FOR_DOWN_I : SABR_OP_FOR_UP_I; break;
+			case 1: next_oc = (start.u > limit.u) ? SABR_OP_FOR_DOWN_U : SABR_OP_FOR_UP_U; break;
+			case 2: next_oc = (start.f > limit.f) ? SABR_OP_FOR_DOWN_F : SABR_OP_FOR_UP_F; break;
+		}
+	}
+
+	*vector_at(sabr_bcop_t, &bc->bcop_vec, index) = sabr_new_bcop_with_value(SABR_OP_FOR_INIT, (sabr_value_t) { .u = record });
+	if (from) *vector_at(sabr_bcop_t, &bc->bcop_vec, from) = sabr_new_bcop_with_value((counter->oc == SABR_OP_ADDR_LOCAL) ? SABR_OP_STORE_LOCAL : SABR_OP_STORE_GLOBAL, counter->operand);
+	if (step) {
+		*vector_at(sabr_bcop_t, &bc->bcop_vec, to) = sabr_new_bcop_with_value(SABR_OP_STORE_LOCAL, (sabr_value_t) { .u = record + 1 });
+		*vector_at(sabr_bcop_t, &bc->bcop_vec, step) = sabr_new_bcop_with_value(SABR_OP_STORE_LOCAL, (sabr_value_t) { .u = record + 2 });
+	}
+	else *vector_at(sabr_bcop_t, &bc->bcop_vec, to) = sabr_new_bcop(SABR_OP_FOR_TO_I + foty);
+	vector_at(sabr_bcop_t, &bc->bcop_vec, check)->oc = SABR_OP_FOR_ENTER_I + foty;
+
+	for (size_t i = check + 1; i < end - 1; i++) {
+		sabr_bcop_t* bcop = vector_at(sabr_bcop_t, &bc->bcop_vec, i);
+		if (bcop->oc == SABR_OP_FOR_NEXT && bcop->operand.u == check)
+			*bcop = sabr_new_bcop_with_value(SABR_OP_JUMP, (sabr_value_t) { .u = end - 1 });
+	}
+	*vector_at(sabr_bcop_t, &bc->bcop_vec, end - 1) = sabr_new_bcop_with_value(next_oc, (sabr_value_t) { .u = check + 1 });
+	*vector_at(sabr_bcop_t, &bc->bcop_vec, end) = sabr_new_bcop(SABR_OP_FOR_LEAVE);
+	return true;
+}
+
+void sabr_bytecode_link_tails(sabr_bytecode_t* bc, size_t* owners) {
+	size_t size = bc->bcop_vec.size;
+
+	for (size_t i = 0; i < size; i++) {
+		sabr_bcop_t bcop = *vector_at(sabr_bcop_t, &bc->bcop_vec, i);
+		size_t lambda = owners[i];
+		if (bcop.oc != SABR_OP_CALL || lambda == SIZE_MAX || bcop.operand.u >= size) continue;
+
+		if (sabr_bytecode_link_is_function(bc, lambda)) {
+			size_t next = sabr_bytecode_link_follow(bc, i + 1, true);
+			if (next >= size || owners[next] != lambda) continue;
+			if (vector_at(sabr_bcop_t, &bc->bcop_vec, next)->oc != SABR_OP_LOCAL_END) continue;
+			if (vector_at(sabr_bcop_t, &bc->bcop_vec, bcop.operand.u)->oc != SABR_OP_LOCAL) continue;
+			if (!sabr_bytecode_link_is_frame_safe(bc, owners, lambda)) continue;
+			vector_at(sabr_bcop_t, &bc->bcop_vec, i)->oc = SABR_OP_TAILCALL;
+		}
+		else {
+			size_t next = sabr_bytecode_link_follow(bc, i + 1, false);
+			if (next >= size || owners[next] != lambda) continue;
+			if (vector_at(sabr_bcop_t, &bc->bcop_vec, next)->oc != SABR_OP_RETURN) continue;
+			vector_at(sabr_bcop_t, &bc->bcop_vec, i)->oc = SABR_OP_JUMP;
+		}
+	}
+}
+
+bool sabr_bytecode_link_is_frame_safe(sabr_bytecode_t* bc, size_t* owners, size_t lambda) {
+	size_t end = vector_at(sabr_bcop_t, &bc->bcop_vec, lambda)->operand.u;
+	for (size_t i = lambda + 1; i < end; i++) {
+		if (owners[i] != lambda) continue;
+		switch (vector_at(sabr_bcop_t, &bc->bcop_vec, i)->oc) {
+			case SABR_OP_ADDR:
+			case SABR_OP_REF:
+				return false;
+			case SABR_OP_ADDR_LOCAL: {
+				sabr_opcode_t next_oc = vector_at(sabr_bcop_t, &bc->bcop_vec, i + 1)->oc;
+				if (next_oc != SABR_OP_FOR_INIT && next_oc != SABR_OP_FOR_ADDR) return false;
+			} break;
+			default: break;
+		}
+	}
+	return true;
+}
+
+size_t sabr_bytecode_link_follow(sabr_bytecode_t* bc, size_t index, bool scoped) {
+	size_t size = bc->bcop_vec.size;
+	for (size_t steps = 0; index < size && steps < size; steps++) {
+		sabr_bcop_t bcop = *vector_at(sabr_bcop_t, &bc->bcop_vec, index);
+		if (bcop.oc == SABR_OP_NONE || (scoped && bcop.oc == SABR_OP_SWITCH_END)) index++;
+		else if (bcop.oc == SABR_OP_JUMP) index = bcop.operand.u;
+		else break;
+	}
+	return index;
+}
+
+bool sabr_bytecode_link_switches(sabr_bytecode_t* bc) {
+	size_t size = bc->bcop_vec.size;
+	bool succeed = false;
+	bool tabled = false;
+	sabr_bytecode_case_data_t* cases = (sabr_bytecode_case_data_t*) malloc(sizeof(sabr_bytecode_case_data_t) * (size + 1));
+	if (!cases) {
+		fputs(sabr_errmsg_alloc, stderr);
+		return false;
+	}
+
+	for (size_t i = 0; i < size; i++) {
+		if (vector_at(sabr_bcop_t, &bc->bcop_vec, i)->oc != SABR_OP_SWITCH) continue;
+		if (!sabr_bytecode_link_switch(bc, i, size, cases, &tabled)) goto FREE_ALL;
+	}
+
+	succeed = true;
+
+FREE_ALL:
+	free(cases);
+	return succeed;
+}
+
+bool sabr_bytecode_link_switch(sabr_bytecode_t* bc, size_t index, size_t size, sabr_bytecode_case_data_t* cases, bool* tabled) {
+	size_t depth = 0;
+	size_t end = 0, pos = index + 1;
+	size_t count = 0, unique = 0;
+	bool chained = false;
+
+	for (size_t i = index + 1; i < size && !end; i++) {
+		switch (vector_at(sabr_bcop_t, &bc->bcop_vec, i)->oc) {
+			case SABR_OP_SWITCH:
+				depth++;
+				break;
+			case SABR_OP_SWITCH_END:
+				if (depth) depth--;
+				else end = i;
+				break;
+			default: break;
+		}
+	}
+	if (!end) return true;
+
+	while (pos < end) {
+		size_t head = pos;
+		while (head < end && vector_at(sabr_bcop_t, &bc->bcop_vec, head)->oc == SABR_OP_NONE) head++;
+		if (head + 4 > end) break;
+		if (vector_at(sabr_bcop_t, &bc->bcop_vec, head)->oc != SABR_OP_VALUE) break;
+		if (vector_at(sabr_bcop_t, &bc->bcop_vec, head + 1)->oc != SABR_OP_SWITCH_CASE) break;
+
+		sabr_bcop_t test = *vector_at(sabr_bcop_t, &bc->bcop_vec, head + 2);
+		sabr_bcop_t branch = *vector_at(sabr_bcop_t, &bc->bcop_vec, head + 3);
+		if ((test.oc != SABR_OP_EQU && test.oc != SABR_OP_NEQ) || branch.oc != SABR_OP_IF) return true;
+		if (branch.operand.u < head + 4 || branch.operand.u > end) return true;
+
+		cases[count].value = vector_at(sabr_bcop_t, &bc->bcop_vec, head)->operand;
+		cases[count].head = head;
+		chained = test.oc == SABR_OP_NEQ;
+		if (chained) {
+			cases[count].target = branch.operand.u;
+			pos = head + 4;
+		}
+		else {
+			sabr_bcop_t pass = *vector_at(sabr_bcop_t, &bc->bcop_vec, branch.operand.u - 1);
+			if (branch.operand.u == head + 4 || pass.oc != SABR_OP_JUMP || pass.operand.u != end) return true;
+			cases[count].target = head + 4;
+			pos = branch.operand.u;
+		}
+		count++;
+	}
+	if (!count || chained) return true;
+
+	for (size_t i = pos; i < end; i++) {
+		switch (vector_at(sabr_bcop_t, &bc->bcop_vec, i)->oc) {
+			case SABR_OP_SWITCH:
+				depth++;
+				break;
+			case SABR_OP_SWITCH_END:
+				depth--;
+				break;
+			case SABR_OP_SWITCH_CASE:
+				if (!depth) return true;
+				break;
+			default: break;
+		}
+	}
+
+	for (size_t i = 0; i < count; i++) {
+		for (size_t j = 0; j < 4; j++)
+			vector_at(sabr_bcop_t, &bc->bcop_vec, cases[i].head + j)->oc = SABR_OP_NONE;
+	}
+	qsort(cases, count, sizeof(sabr_bytecode_case_data_t), sabr_bytecode_case_data_compare);
+	for (size_t i = 0; i < count; i++) {
+		if (!unique || cases[unique - 1].value.u != cases[i].value.u) cases[unique++] = cases[i];
+	}
+
+	if (!*tabled) {
+		if (!sabr_bytecode_write_bcop(bc, SABR_OP_EXIT)) return false;
+		*tabled = true;
+	}
+
+	uint64_t range = cases[unique - 1].value.u - cases[0].value.u;
+	size_t table = bc->bcop_vec.size;
+	if (range < unique * 2) {
+		*vector_at(sabr_bcop_t, &bc->bcop_vec, index) = sabr_new_bcop_with_value(SABR_OP_SWITCH_TABLE, (sabr_value_t) { .u = table });
+		if (!sabr_bytecode_write_bcop_with_value(bc, SABR_OP_VALUE, cases[0].value)) return false;
+		if (!sabr_bytecode_write_bcop_with_value(bc, SABR_OP_VALUE, (sabr_value_t) { .u = range + 1 })) return false;
+		if (!sabr_bytecode_write_bcop_with_value(bc, SABR_OP_JUMP, (sabr_value_t) { .u = pos })) return false;
+		for (size_t slot = 0, i = 0; slot <= range; slot++) {
+			size_t target = pos;
+			if (i < unique && cases[i].value.u - cases[0].value.u == slot) target = cases[i++].target;
+			if (!sabr_bytecode_write_bcop_with_value(bc, SABR_OP_JUMP, (sabr_value_t) { .u = target })) return false;
+		}
+	}
+	else {
+		*vector_at(sabr_bcop_t, &bc->bcop_vec, index) = sabr_new_bcop_with_value(SABR_OP_SWITCH_SEARCH, (sabr_value_t) { .u = table });
+		if (!sabr_bytecode_write_bcop_with_value(bc, SABR_OP_VALUE, (sabr_value_t) { .u = unique })) return false;
+		if (!sabr_bytecode_write_bcop_with_value(bc, SABR_OP_JUMP, (sabr_value_t) { .u = pos })) return false;
+		for (size_t i = 0; i < unique; i++) {
+			if (!sabr_bytecode_write_bcop_with_value(bc, SABR_OP_VALUE, cases[i].value)) return false;
+			if (!sabr_bytecode_write_bcop_with_value(bc, SABR_OP_JUMP, (sabr_value_t) { .u = cases[i].target })) return false;
+		}
+	}
+	vector_at(sabr_bcop_t, &bc->bcop_vec, end)->oc = SABR_OP_NONE;
+	return true;
+}
+
+bool sabr_bytecode_link_literal(sabr_bytecode_t* bc, size_t begin, size_t end, sabr_value_t* value) {
+	bool found = false;
+	for (size_t i = begin; i < end; i++) {
+		sabr_bcop_t bcop = *vector_at(sabr_bcop_t, &bc->bcop_vec, i);
+		if (bcop.oc == SABR_OP_NONE) continue;
+		if (bcop.oc != SABR_OP_VALUE || found) return false;
+		*value = bcop.operand;
+		found = true;
+	}
+	return found;
+}
+
+bool sabr_bytecode_link_is_function(sabr_bytecode_t* bc, size_t lambda) {
+	if (lambda >= bc->bcop_vec.size || lambda + 1 >= bc->bcop_vec.size) return false;
+	if (vector_at(sabr_bcop_t, &bc->bcop_vec, lambda)->oc != SABR_OP_LAMBDA) return false;
+	return vector_at(sabr_bcop_t, &bc->bcop_vec, lambda + 1)->oc == SABR_OP_LOCAL;
+}
+
+bool sabr_bytecode_link_is_dynamic(sabr_bytecode_t* bc, bool* targets, size_t index) {
+	sabr_bcop_t bcop = *vector_at(sabr_bcop_t, &bc->bcop_vec, index);
+	switch (bcop.oc) {
+		case SABR_OP_EXEC:
+			return !bcop.operand.u;
+		case SABR_OP_SET:
+		case SABR_OP_REF:
+		case SABR_OP_FOR:
+		case SABR_OP_ADDR:
+			return !index || targets[index] || vector_at(sabr_bcop_t, &bc->bcop_vec, index - 1)->oc != SABR_OP_VALUE;
+		default:
+			return false;
+	}
+}
+
+bool sabr_bytecode_link_is_plain_call(sabr_bytecode_t* bc, size_t* owners, size_t entry) {
+	size_t lambda = entry - 1;
+	if (!entry || entry >= bc->bcop_vec.size) return false;
+	if (vector_at(sabr_bcop_t, &bc->bcop_vec, entry)->oc == SABR_OP_LOCAL) return true;
+	if (vector_at(sabr_bcop_t, &bc->bcop_vec, lambda)->oc != SABR_OP_LAMBDA) return false;
+
+	size_t end = vector_at(sabr_bcop_t, &bc->bcop_vec, lambda)->operand.u;
+	for (size_t i = entry; i < end; i++) {
+		if (owners[i] != lambda) continue;
+		switch (vector_at(sabr_bcop_t, &bc->bcop_vec, i)->oc) {
+			case SABR_OP_SET:
+			case SABR_OP_REF:
+			case SABR_OP_FOR:
+			case SABR_OP_ADDR:
+			case SABR_OP_EXEC:
+				return false;
+			case SABR_OP_CALL: {
+				size_t target = vector_at(sabr_bcop_t, &bc->bcop_vec, i)->operand.u;
+				if (target >= bc->bcop_vec.size || vector_at(sabr_bcop_t, &bc->bcop_vec, target)->oc != SABR_OP_LOCAL) return false;
+			} break;
+			default: break;
+		}
+	}
+	return true;
+}
+
+sabr_bytecode_link_data_t* sabr_bytecode_link_data_find(sabr_bytecode_link_data_t* data, size_t count, uint64_t identifier) {
+	sabr_bytecode_link_data_t key = { identifier, 0, false };
+	return (sabr_bytecode_link_data_t*) bsearch(&key, data, count, sizeof(sabr_bytecode_link_data_t), sabr_bytecode_link_data_compare);
+}
+
+int sabr_bytecode_link_data_compare(const void* a, const void* b) {
+	uint64_t x = ((const sabr_bytecode_link_data_t*) a)->identifier;
+	uint64_t y = ((const sabr_bytecode_link_data_t*) b)->identifier;
+	return (x > y) - (x < y);
+}
+
+int sabr_bytecode_case_data_compare(const void* a, const void* b) {
+	const sabr_bytecode_case_data_t* x = (const sabr_bytecode_case_data_t*) a;
+	const sabr_bytecode_case_data_t* y = (const sabr_bytecode_case_data_t*) b;
+	if (x->value.i != y->value.i) return (x->value.i > y->value.i) - (x->value.i < y->value.i);
+	return (x->head > y->head) - (x->head < y->head);
+}
+
+bool sabr_bytecode_check_switch(sabr_bytecode_t* bc, sabr_bcop_t bcop) {
+	size_t size = bc->bcop_vec.size;
+	size_t table = bcop.operand.u;
+	size_t first, count, stride;
+
+	if (bcop.oc == SABR_OP_SWITCH_TABLE) {
+		if (table >= size || size - table < 3) return false;
+		count = vector_at(sabr_bcop_t, &bc->bcop_vec, table + 1)->operand.u;
+		if (count > size - table - 3) return false;
+		first = table + 2;
+		stride = 1;
+	}
+	else {
+		if (table >= size || size - table < 2) return false;
+		count = vector_at(sabr_bcop_t, &bc->bcop_vec, table)->operand.u;
+		if (count > (size - table - 2) / 2) return false;
+		first = table + 1;
+		stride = 2;
+	}
+
+	for (size_t i = 0; i <= count; i++) {
+		sabr_bcop_t entry = *vector_at(sabr_bcop_t, &bc->bcop_vec, first + i * stride);
+		if (entry.oc != SABR_OP_JUMP || entry.operand.u > size) return false;
+	}
+	return true;
+}
+
 bool sabr_bytecode_write_bcop(sabr_bytecode_t* bc_data, sabr_opcode_t oc) {
 	if (!vector_push_back(sabr_bcop_t, &bc_data->bcop_vec, sabr_new_bcop(oc))) {
 		fputs(sabr_errmsg_alloc, stderr);
@@ -3,7 +3,7 @@
 #include "compiler.h"
 
 sabr_cmd_t cmd = {
-	{ false, false, false, false, false, false, false, false, false },
+	{ false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, false },
 	{
 		{ "compile", required_argument, NULL, 0 },
 		{ "execute", required_argument, NULL, 0 },
@@ -13,11 +13,27 @@ sabr_cmd_t cmd = {
 		{ "bytecode", no_argument, NULL, 0 },
 		{ "preprocess", no_argument, NULL, 0 },
 		{ "version", no_argument, NULL, 0 },
-		{ "help", no_argument, NULL, 0 }
+		{ "help", no_argument, NULL, 0 },
+		{ "engine", required_argument, NULL, 0 },
+		{ "stack", required_argument, NULL, 0 },
+		{ "count-pairs", no_argument, NULL, 0 },
+		{ "print-after", required_argument, NULL, 0 },
+		{ "jit", required_argument, NULL, 0 },
+		{ "jit-threshold", required_argument, NULL, 0 },
+		{ "perf-map", no_argument, NULL, 0 },
+		{ "emit-c", required_argument, NULL, 0 },
+		{ "profile-out", required_argument, NULL, 0 },
+		{ "profile-use", required_argument, NULL, 0 },
+		{ "compact", no_argument, NULL, 0 }
 	},
-	"c:e:o:m:rbpvh",
-	"", "", "",
-	1048576
+	"c:e:o:m:s:O:rbpvh",
+	"", "", "", "", "",
+	1048576,
+	1048576,
+	SABR_ENGINE_THREADED,
+	SABR_JIT_OFF,
+	SABR_JIT_THRESHOLD,
+	{ 2, "", NULL }
 };
 
 size_t sabr_cmd_opts_len = sizeof(cmd.long_opts) / sizeof(option_t);
@@ -37,6 +53,8 @@ void sabr_cmd_get_opt(sabr_cmd_t* cmd, int argc, char** argv) {
 			case 'e': sabr_cmd_get_opt_execute(cmd); break;
 			case 'o': sabr_cmd_get_opt_out(cmd); break;
 			case 'm': sabr_cmd_get_opt_memory(cmd); break;
+			case 's': sabr_cmd_get_opt_stack(cmd); break;
+			case 'O': sabr_cmd_get_opt_level(cmd); break;
 			case 'r': sabr_cmd_get_opt_run(cmd); break;
 			case 'b': sabr_cmd_get_opt_bytecode(cmd); break;
 			case 'p': sabr_cmd_get_opt_preprocess(cmd); break;
@@ -54,6 +72,7 @@ int sabr_cmd_run(sabr_cmd_t* cmd, sabr_compiler_t* comp, sabr_interpreter_t* int
 	sabr_bytecode_t* src_bc = NULL;
 
 	sabr_cmd_get_opt(cmd, argc, argv);
+	if (cmd->flags.wrong_arg) goto FAILURE;
 	if (cmd->flags.version) cmd_print_version(cmd);
 	if (cmd->flags.help) cmd_print_help(cmd);
 	if (cmd->flags.compile) {
@@ -69,6 +88,11 @@ int sabr_cmd_run(sabr_cmd_t* cmd, sabr_compiler_t* comp, sabr_interpreter_t* int
 		std_lib_bc = sabr_compiler_compile_file(comp, std_lib_path);
 		if (!std_lib_bc) goto FAILURE;
 
+		if (cmd->flags.profile_use) {
+			if (!sabr_profile_load(&cmd->profile, cmd->profile_use_filename)) goto FAILURE;
+			cmd->options.profile = &cmd->profile;
+		}
+
 		if (!cmd->flags.out)
 			strncpy(cmd->out_filename, cmd->flags.preprocess ? "out.sabrc": "out.sabre", PATH_MAX);
 		if (cmd->flags.preprocess) {
@@ -79,14 +103,26 @@ int sabr_cmd_run(sabr_cmd_t* cmd, sabr_compiler_t* comp, sabr_interpreter_t* int
 			src_bc = sabr_compiler_compile_file(comp, cmd->src_filename);
 			if (!src_bc) goto FAILURE;
 
-			bc = sabr_bytecode_concat(std_lib_bc, src_bc);
+			bc = sabr_bytecode_concat(std_lib_bc, src_bc, &cmd->options);
 
+			if (!bc) goto FAILURE;
 			if (cmd->flags.bytecode) sabr_bytecode_print(bc);
+			if (cmd->flags.compact && !sabr_compact_encode(bc)) goto FAILURE;
 			if (!sabr_compiler_save_bytecode(comp, bc, cmd->out_filename)) goto FAILURE;
 			if (cmd->flags.run) {
 				if (!sabr_interpreter_init(inter)) goto FAILURE;
+				inter->engine = cmd->engine;
+				inter->jit = cmd->jit;
+				inter->jit_threshold = cmd->jit_threshold;
+				inter->perf_map = cmd->flags.perf_map;
+				if (bc->compact && !cmd->flags.engine) inter->engine = SABR_ENGINE_COMPACT;
 				if (!sabr_interpreter_memory_pool_init(inter, cmd->memory_pool_size, cmd->memory_pool_size)) goto FAILURE;
+				if (!sabr_interpreter_data_stack_init(inter, cmd->data_stack_size)) goto FAILURE;
+				if (cmd->flags.count_pairs && !sabr_interpreter_pair_counts_init(inter)) goto FAILURE;
+				if (cmd->flags.profile_out && !sabr_interpreter_profile_init(inter, bc)) goto FAILURE;
 				sabr_interpreter_run_bytecode(inter, bc);
+				sabr_interpreter_print_pair_counts(inter, 32);
+				if (cmd->flags.profile_out && !sabr_profile_save(inter->profile, cmd->profile_out_filename)) goto FAILURE;
 				if (!sabr_interpreter_del(inter)) goto FAILURE;
 			}
 		}
@@ -95,15 +131,35 @@ int sabr_cmd_run(sabr_cmd_t* cmd, sabr_compiler_t* comp, sabr_interpreter_t* int
 	}
 	else if (cmd->flags.execute) {
 		if (!sabr_interpreter_init(inter)) goto FAILURE;
+		inter->engine = cmd->engine;
+		inter->jit = cmd->jit;
+		inter->jit_threshold = cmd->jit_threshold;
+		inter->perf_map = cmd->flags.perf_map;
 		if (!sabr_interpreter_memory_pool_init(inter, cmd->memory_pool_size, cmd->memory_pool_size)) goto FAILURE;
+		if (!sabr_interpreter_data_stack_init(inter, cmd->data_stack_size)) goto FAILURE;
+		if (cmd->flags.count_pairs && !sabr_interpreter_pair_counts_init(inter)) goto FAILURE;
 		bc = sabr_interpreter_load_bytecode(inter, cmd->bc_filename);
 		if (!bc) goto FAILURE;
+		if (bc->compact && !cmd->flags.engine) inter->engine = SABR_ENGINE_COMPACT;
+		if (cmd->flags.profile_out && !sabr_interpreter_profile_init(inter, bc)) goto FAILURE;
 		sabr_interpreter_run_bytecode(inter, bc);
+		sabr_interpreter_print_pair_counts(inter, 32);
+		if (cmd->flags.profile_out && !sabr_profile_save(inter->profile, cmd->profile_out_filename)) goto FAILURE;
+		if (!sabr_interpreter_del(inter)) goto FAILURE;
+	}
+	else if (cmd->flags.emit_c) {
+		if (!sabr_interpreter_init(inter)) goto FAILURE;
+		bc = sabr_interpreter_load_bytecode(inter, cmd->bc_filename);
+		if (!bc) goto FAILURE;
+		if (!sabr_compact_expand(bc) || !sabr_bytecode_expand(bc)) goto FAILURE;
+		if (!cmd->flags.out) strncpy(cmd->out_filename, "out.c", PATH_MAX);
+		if (!sabr_emitter_emit_c(bc, cmd->out_filename, cmd->memory_pool_size, cmd->data_stack_size)) goto FAILURE;
 		if (!sabr_interpreter_del(inter)) goto FAILURE;
 	}
 	result = 0;
 
 FAILURE:
+	sabr_profile_del(&cmd->profile);
 	sabr_bytecode_free(std_lib_bc);
 	sabr_bytecode_free(src_bc);
 	free(std_lib_bc);
@@ -129,9 +185,29 @@ void sabr_cmd_get_opt_out(sabr_cmd_t* cmd) {
 }
 
 void sabr_cmd_get_opt_memory(sabr_cmd_t* cmd) {
+	char* end;
+	size_t size = strtoull(optarg, &end, 10);
+	if (*end || !size) {
+		fputs(sabr_errmsg_wrong_option_arg, stderr);
+		cmd->flags.wrong_arg = true;
+		return;
+	}
+	cmd->memory_pool_size = size;
 	cmd->flags.memory = true;
 }
 
+void sabr_cmd_get_opt_stack(sabr_cmd_t* cmd) {
+	char* end;
+	size_t size = strtoull(optarg, &end, 10);
+	if (*end || !size) {
+		fputs(sabr_errmsg_wrong_option_arg, stderr);
+		cmd->flags.wrong_arg = true;
+		return;
+	}
+	cmd->data_stack_size = size;
+	cmd->flags.stack = true;
+}
+
 void sabr_cmd_get_opt_run(sabr_cmd_t* cmd) {
 	cmd->flags.run = true;
 }
@@ -152,6 +228,92 @@ void sabr_cmd_get_opt_help(sabr_cmd_t* cmd) {
 	cmd->flags.help = true;
 }
 
+void sabr_cmd_get_opt_engine(sabr_cmd_t* cmd) {
+	if (!strcmp(optarg, "threaded")) cmd->engine = SABR_ENGINE_THREADED;
+	else if (!strcmp(optarg, "tos")) cmd->engine = SABR_ENGINE_TOS;
+	else if (!strcmp(optarg, "classic")) cmd->engine = SABR_ENGINE_CLASSIC;
+	else if (!strcmp(optarg, "register")) cmd->engine = SABR_ENGINE_REGISTER;
+	else if (!strcmp(optarg, "compact")) cmd->engine = SABR_ENGINE_COMPACT;
+	else {
+		fputs(sabr_errmsg_wrong_option_arg, stderr);
+		cmd->flags.wrong_arg = true;
+		return;
+	}
+	cmd->flags.engine = true;
+}
+
+void sabr_cmd_get_opt_count_pairs(sabr_cmd_t* cmd) {
+	cmd->flags.count_pairs = true;
+}
+
+void sabr_cmd_get_opt_print_after(sabr_cmd_t* cmd) {
+	if (!sabr_bytecode_is_pass(optarg)) {
+		fputs(sabr_errmsg_wrong_option_arg, stderr);
+		cmd->flags.wrong_arg = true;
+		return;
+	}
+	strncpy(cmd->options.print_after, optarg, sizeof(cmd->options.print_after) - 1);
+}
+
+void sabr_cmd_get_opt_level(sabr_cmd_t* cmd) {
+	char* end;
+	unsigned long level = strtoul(optarg, &end, 10);
+	if (*end || end == optarg || level > 3) {
+		fputs(sabr_errmsg_wrong_option_arg, stderr);
+		cmd->flags.wrong_arg = true;
+		return;
+	}
+	cmd->options.level = level;
+	cmd->flags.level = true;
+}
+
+void sabr_cmd_get_opt_jit(sabr_cmd_t* cmd) {
+	if (!strcmp(optarg, "off")) cmd->jit = SABR_JIT_OFF;
+	else if (!strcmp(optarg, "on")) cmd->jit = SABR_JIT_ON;
+	else if (!strcmp(optarg, "always")) cmd->jit = SABR_JIT_ALWAYS;
+	else {
+		fputs(sabr_errmsg_wrong_option_arg, stderr);
+		cmd->flags.wrong_arg = true;
+	}
+}
+
+void sabr_cmd_get_opt_jit_threshold(sabr_cmd_t* cmd) {
+	char* end;
+	uint64_t threshold = strtoull(optarg, &end, 10);
+	if (*end || end == optarg || !threshold) {
+		fputs(sabr_errmsg_wrong_option_arg, stderr);
+		cmd->flags.wrong_arg = true;
+		return;
+	}
+	cmd->jit_threshold = threshold;
+}
+
+void sabr_cmd_get_opt_perf_map(sabr_cmd_t* cmd) {
+	cmd->flags.perf_map = true;
+}
+
+void sabr_cmd_get_opt_emit_c(sabr_cmd_t* cmd) {
+	strncpy(cmd->bc_filename, optarg, PATH_MAX - 1);
+	cmd->bc_filename[PATH_MAX - 1] = '\0';
+	cmd->flags.emit_c = true;
+}
+
+void sabr_cmd_get_opt_profile_out(sabr_cmd_t* cmd) {
+	strncpy(cmd->profile_out_filename, optarg, PATH_MAX - 1);
+	cmd->profile_out_filename[PATH_MAX - 1] = '\0';
+	cmd->flags.profile_out = true;
+}
+
+void sabr_cmd_get_opt_profile_use(sabr_cmd_t* cmd) {
+	strncpy(cmd->profile_use_filename, optarg, PATH_MAX - 1);
+	cmd->profile_use_filename[PATH_MAX - 1] = '\0';
+	cmd->flags.profile_use = true;
+}
+
+void sabr_cmd_get_opt_compact(sabr_cmd_t* cmd) {
+	cmd->flags.compact = true;
+}
+
 void (*opt_functions[])(sabr_cmd_t* cmd) = {
 	sabr_cmd_get_opt_compile,
 	sabr_cmd_get_opt_execute,
@@ -161,7 +323,18 @@ void (*opt_functions[])(sabr_cmd_t* cmd) = {
 	sabr_cmd_get_opt_bytecode,
 	sabr_cmd_get_opt_preprocess,
 	sabr_cmd_get_opt_version,
-	sabr_cmd_get_opt_help
+	sabr_cmd_get_opt_help,
+	sabr_cmd_get_opt_engine,
+	sabr_cmd_get_opt_stack,
+	sabr_cmd_get_opt_count_pairs,
+	sabr_cmd_get_opt_print_after,
+	sabr_cmd_get_opt_jit,
+	sabr_cmd_get_opt_jit_threshold,
+	sabr_cmd_get_opt_perf_map,
+	sabr_cmd_get_opt_emit_c,
+	sabr_cmd_get_opt_profile_out,
+	sabr_cmd_get_opt_profile_use,
+	sabr_cmd_get_opt_compact
 };
 
 void cmd_print_version(sabr_cmd_t* cmd) {
@@ -0,0 +1,264 @@
+#include "compact.h"
+
+extern inline uint64_t sabr_compact_zigzag(uint64_t v);
+extern inline uint64_t sabr_compact_unzigzag(uint64_t v);
+extern inline size_t sabr_compact_decode(const uint8_t* code, size_t size, size_t pos, const uint8_t* kinds, sabr_bcop_t* bcop);
+extern inline const uint8_t* sabr_compact_operand(const uint8_t* code, uint64_t* v);
+extern inline size_t sabr_compact_read(const uint8_t* code, size_t size, size_t pos, sabr_bcop_t* bcop);
+
+void sabr_compact_kinds(uint8_t* kinds) {
+	for (size_t oc = 0; oc < 256; oc++) {
+		if (sabr_opcode_has_index_operand(oc)) kinds[oc] = SABR_COMPACT_KIND_INDEX;
+		else if (sabr_opcode_has_operand(oc)) kinds[oc] = SABR_COMPACT_KIND_VALUE;
+		else kinds[oc] = SABR_COMPACT_KIND_NONE;
+	}
+}
+
+bool sabr_compact_is_compact(const uint8_t* code, size_t size) {
+	if (size < SABR_COMPACT_HEADER_SIZE) return false;
+	return !memcmp(code, SABR_COMPACT_MAGIC, SABR_COMPACT_MAGIC_SIZE);
+}
+
+bool sabr_compact_check(const uint8_t* code, size_t size) {
+	bool succeed = false;
+	bool* starts = NULL;
+
+	if (!sabr_compact_is_compact(code, size)) {
+		fputs(sabr_errmsg_bytecode_format, stderr);
+		return false;
+	}
+	if (code[SABR_COMPACT_MAGIC_SIZE] != SABR_COMPACT_VERSION) {
+		fputs(sabr_errmsg_bytecode_version, stderr);
+		return false;
+	}
+
+	starts = (bool*) calloc(size + 1, sizeof(bool));
+	if (!starts) {
+		fputs(sabr_errmsg_alloc, stderr);
+		return false;
+	}
+
+	for (size_t pos = SABR_COMPACT_HEADER_SIZE; pos < size;) {
+		sabr_bcop_t bcop;
+		starts[pos] = true;
+		pos = sabr_compact_read(code, size, pos, &bcop);
+		if (!pos || bcop.oc >= sabr_opcode_names_len) goto INVALID;
+	}
+	starts[size] = true;
+
+	for (size_t pos = SABR_COMPACT_HEADER_SIZE; pos < size;) {
+		sabr_bcop_t bcop;
+		pos = sabr_compact_read(code, size, pos, &bcop);
+		if (!sabr_opcode_has_index_operand(bcop.oc)) continue;
+		if (bcop.operand.u > size || !starts[bcop.operand.u]) goto INVALID;
+		if (bcop.oc != SABR_OP_SWITCH_TABLE && bcop.oc != SABR_OP_SWITCH_SEARCH) continue;
+		if (bcop.operand.u == size || !sabr_compact_check_switch(code, size, bcop)) goto INVALID;
+	}
+	succeed = true;
+
+INVALID:
+	if (!succeed) fputs(sabr_errmsg_invalid_bytecode, stderr);
+	free(starts);
+	return succeed;
+}
+
+bool sabr_compact_check_switch(const uint8_t* code, size_t size, sabr_bcop_t bcop) {
+	size_t table = bcop.operand.u;
+	size_t count, members;
+	sabr_bcop_t member;
+
+	size_t next = sabr_compact_read(code, size, table, &member);
+	if (!next) return false;
+	size_t stride = next - table;
+
+	if (bcop.oc == SABR_OP_SWITCH_TABLE) {
+		if ((size - table) / stride < 3 || !sabr_compact_read(code, size, table + stride, &member)) return false;
+		count = member.operand.u;
+		if ((size - table) / stride < 3 || count > (size - table) / stride - 3) return false;
+		members = count + 3;
+	}
+	else {
+		count = member.operand.u;
+		if ((size - table) / stride < 2 || count > ((size - table) / stride - 2) / 2) return false;
+		members = count * 2 + 2;
+	}
+
+	for (size_t j = 0; j < members; j++) {
+		size_t pos = table + j * stride;
+		if (sabr_compact_read(code, size, pos, &member) != pos + stride) return false;
+		bool entry = (bcop.oc == SABR_OP_SWITCH_TABLE) ? j >= 2 : j % 2;
+		if (entry && member.oc != SABR_OP_JUMP) return false;
+	}
+	return true;
+}
+
+bool sabr_compact_encode(sabr_bytecode_t* bc) {
+	bool succeed = false;
+	bool changed = true;
+	size_t size = bc->bcop_vec.size;
+	size_t* offsets = NULL;
+	size_t* groups = NULL;
+	uint8_t* widths = NULL;
+	uint8_t* code = NULL;
+
+	offsets = (size_t*) malloc(sizeof(size_t) * (size + 1));
+	groups = (size_t*) malloc(sizeof(size_t) * (size + 1));
+	widths = (uint8_t*) calloc(size + 1, sizeof(uint8_t));
+	if (!offsets || !groups || !widths) {
+		fputs(sabr_errmsg_alloc, stderr);
+		goto FREE_ALL;
+	}
+
+	for (size_t i = 0; i < size; i++) groups[i] = SIZE_MAX;
+	for (size_t i = 0; i < size; i++) {
+		sabr_bcop_t bcop = *vector_at(sabr_bcop_t, &bc->bcop_vec, i);
+		if (!sabr_opcode_has_index_operand(bcop.oc)) continue;
+		if (bcop.operand.u > size) {
+			fputs(sabr_errmsg_invalid_bytecode, stderr);
+			goto FREE_ALL;
+		}
+		if (bcop.oc != SABR_OP_SWITCH_TABLE && bcop.oc != SABR_OP_SWITCH_SEARCH) continue;
+		if (!sabr_bytecode_check_switch(bc, bcop)) {
+			fputs(sabr_errmsg_invalid_bytecode, stderr);
+			goto FREE_ALL;
+		}
+		size_t table = bcop.operand.u;
+		size_t end = (bcop.oc == SABR_OP_SWITCH_TABLE)
+			? table + 3 + vector_at(sabr_bcop_t, &bc->bcop_vec, table + 1)->operand.u
+			: table + 2 + vector_at(sabr_bcop_t, &bc->bcop_vec, table)->operand.u * 2;
+		for (size_t j = table; j < end; j++) groups[j] = table;
+	}
+
+	while (changed) {
+		changed = false;
+		size_t pos = SABR_COMPACT_HEADER_SIZE;
+		for (size_t i = 0; i < size; i++) {
+			offsets[i] = pos;
+			pos += 1 + widths[i];
+		}
+		offsets[size] = pos;
+
+		for (size_t i = 0; i < size; i++) {
+			sabr_bcop_t bcop = *vector_at(sabr_bcop_t, &bc->bcop_vec, i);
+			if (!sabr_opcode_has_operand(bcop.oc)) continue;
+			uint64_t v = sabr_opcode_has_index_operand(bcop.oc) ? offsets[bcop.operand.u] : sabr_compact_zigzag(bcop.operand.u);
+			size_t width = sabr_compact_size(v);
+			if (width <= widths[i]) continue;
+			widths[i] = width;
+			changed = true;
+		}
+		for (size_t i = 0; i < size; i++) {
+			if (groups[i] == SIZE_MAX || widths[i] <= widths[groups[i]]) continue;
+			widths[groups[i]] = widths[i];
+			changed = true;
+		}
+		for (size_t i = 0; i < size; i++) {
+			if (groups[i] == SIZE_MAX || widths[i] >= widths[groups[i]]) continue;
+			widths[i] = widths[groups[i]];
+			changed = true;
+		}
+	}
+
+	code = (uint8_t*) malloc(offsets[size]);
+	if (!code) {
+		fputs(sabr_errmsg_alloc, stderr);
+		goto FREE_ALL;
+	}
+	memcpy(code, SABR_COMPACT_MAGIC, SABR_COMPACT_MAGIC_SIZE);
+	code[SABR_COMPACT_MAGIC_SIZE] = SABR_COMPACT_VERSION;
+	for (size_t i = 0; i < size; i++) {
+		sabr_bcop_t bcop = *vector_at(sabr_bcop_t, &bc->bcop_vec, i);
+		code[offsets[i]] = bcop.oc;
+		if (!sabr_opcode_has_operand(bcop.oc)) continue;
+		uint64_t v = sabr_opcode_has_index_operand(bcop.oc) ? offsets[bcop.operand.u] : sabr_compact_zigzag(bcop.operand.u);
+		sabr_compact_write(code + offsets[i] + 1, v, widths[i]);
+	}
+
+	free(bc->compact);
+	bc->compact = code;
+	bc->compact_size = offsets[size];
+	code = NULL;
+	succeed = true;
+
+FREE_ALL:
+	free(offsets);
+	free(groups);
+	free(widths);
+	free(code);
+	return succeed;
+}
+
+bool sabr_compact_expand(sabr_bytecode_t* bc) {
+	bool succeed = false;
+	size_t count = 0;
+	size_t* indices = NULL;
+
+	if (!bc->compact || bc->bcop_vec.size) return true;
+
+	indices = (size_t*) malloc(sizeof(size_t) * (bc->compact_size + 1));
+	if (!indices) {
+		fputs(sabr_errmsg_alloc, stderr);
+		return false;
+	}
+
+	for (size_t pos = SABR_COMPACT_HEADER_SIZE; pos < bc->compact_size;) {
+		sabr_bcop_t bcop;
+		indices[pos] = count++;
+		pos = sabr_compact_read(bc->compact, bc->compact_size, pos, &bcop);
+		if (!pos) {
+			fputs(sabr_errmsg_invalid_bytecode, stderr);
+			goto FREE_ALL;
+		}
+	}
+	indices[bc->compact_size] = count;
+
+	for (size_t pos = SABR_COMPACT_HEADER_SIZE; pos < bc->compact_size;) {
+		sabr_bcop_t bcop;
+		pos = sabr_compact_read(bc->compact, bc->compact_size, pos, &bcop);
+		if (sabr_opcode_has_index_operand(bcop.oc)) bcop.operand.u = indices[bcop.operand.u];
+		bool result = sabr_opcode_has_operand(bcop.oc)
+			? sabr_bytecode_write_bcop_with_value(bc, bcop.oc, bcop.operand)
+			: sabr_bytecode_write_bcop(bc, bcop.oc);
+		if (!result) goto FREE_ALL;
+	}
+	succeed = true;
+
+FREE_ALL:
+	free(indices);
+	return succeed;
+}
+
+size_t sabr_compact_begin(sabr_bytecode_t* bc) {
+	if (bc->bcop_vec.size) return 0;
+	if (bc->compact) return SABR_COMPACT_HEADER_SIZE;
+	return bc->image ? SABR_BYTECODE_HEADER_SIZE : 0;
+}
+
+bool sabr_compact_next(sabr_bytecode_t* bc, size_t* pos, sabr_bcop_t* bcop) {
+	if (bc->bcop_vec.size || (!bc->compact && !bc->image)) {
+		if (*pos >= bc->bcop_vec.size) return false;
+		*bcop = *vector_at(sabr_bcop_t, &bc->bcop_vec, (*pos)++);
+		return true;
+	}
+	size_t next = bc->compact
+		? sabr_compact_read(bc->compact, bc->compact_size, *pos, bcop)
+		: sabr_bytecode_read(bc->image, bc->image_size, *pos, bcop);
+	if (!next) return false;
+	*pos = next;
+	return true;
+}
+
+size_t sabr_compact_size(uint64_t v) {
+	size_t size = 1;
+	while (v >>= 7) size++;
+	return size;
+}
+
+size_t sabr_compact_write(uint8_t* out, uint64_t v, size_t width) {
+	for (size_t i = 0; i + 1 < width; i++) {
+		out[i] = (v & 0x7f) | 0x80;
+		v >>= 7;
+	}
+	out[width - 1] = v & 0x7f;
+	return width;
+}
\ No newline at end of file
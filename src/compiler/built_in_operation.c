@@ -77,6 +77,24 @@ const char* sabr_bio_names[] = {
 
 	"fetch",
 	"store",
+	"++store",
+	"--store",
+	"+store",
+	"-store",
+	"*store",
+	"/store",
+	"%store",
+	"f+store",
+	"f-store",
+	"f*store",
+	"f/store",
+	"f%store",
+	"&store",
+	"|store",
+	"^store",
+	"~store",
+	"<<store",
+	">>store",
 	
 	"itof",
 	"utof",
@@ -175,6 +193,24 @@ const sabr_opcode_t sabr_bio_indices[] = {
 
 	SABR_OP_FETCH,
 	SABR_OP_STORE,
+	SABR_OP_INC_MEM,
+	SABR_OP_DEC_MEM,
+	SABR_OP_ADD_MEM,
+	SABR_OP_SUB_MEM,
+	SABR_OP_MUL_MEM,
+	SABR_OP_DIV_MEM,
+	SABR_OP_MOD_MEM,
+	SABR_OP_FADD_MEM,
+	SABR_OP_FSUB_MEM,
+	SABR_OP_FMUL_MEM,
+	SABR_OP_FDIV_MEM,
+	SABR_OP_FMOD_MEM,
+	SABR_OP_BAND_MEM,
+	SABR_OP_BOR_MEM,
+	SABR_OP_BXOR_MEM,
+	SABR_OP_BNOT_MEM,
+	SABR_OP_BLSFT_MEM,
+	SABR_OP_BRSFT_MEM,
 
 	SABR_OP_ITOF,
 	SABR_OP_UTOF,
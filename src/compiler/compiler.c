@@ -45,6 +45,9 @@ bool sabr_compiler_init(sabr_compiler_t* const comp) {
 
 	vector_init(cctl_ptr(vector(sabr_keyword_data_t)), &comp->keyword_data_stack);
 
+	vector_init(sabr_datagroup_data_t, &comp->datagroup_vector);
+	vector_init(sabr_value_t, &comp->member_vector);
+
 	comp->tab_size = 4;
 
 	if (!memset(&comp->convert_state, 0, sizeof(mbstate_t))) return false;
@@ -78,6 +81,9 @@ bool sabr_compiler_del(sabr_compiler_t* const comp) {
 		vector_free(sabr_keyword_data_t, *vector_at(cctl_ptr(vector(sabr_keyword_data_t)), &comp->keyword_data_stack, i));
 	vector_free(cctl_ptr(vector(sabr_keyword_data_t)), &comp->keyword_data_stack);
 
+	vector_free(sabr_datagroup_data_t, &comp->datagroup_vector);
+	vector_free(sabr_value_t, &comp->member_vector);
+
 	return true;
 }
 
@@ -240,6 +246,15 @@ bool sabr_compiler_save_bytecode(sabr_compiler_t* const comp, sabr_bytecode_t* c
 		return false;
 	}
 
+	if (bc->compact) {
+		bool succeed = fwrite(bc->compact, 1, bc->compact_size, file) == bc->compact_size;
+		fclose(file);
+		if (!succeed) fputs(sabr_errmsg_write, stderr);
+		return succeed;
+	}
+
+	fwrite(SABR_BYTECODE_MAGIC, 1, SABR_BYTECODE_MAGIC_SIZE, file);
+	fputc(SABR_BYTECODE_VERSION, file);
 	for (size_t i = 0; i < bc->bcop_vec.size; i++) {
 		sabr_bcop_t bcop = *vector_at(sabr_bcop_t, &bc->bcop_vec, i);
 		fputc(bcop.oc, file);
@@ -804,10 +819,16 @@ sabr_bytecode_t* sabr_compiler_compile_tokens(sabr_compiler_t* const comp, vecto
 				case SABR_WT_KWRD:
 					if (!sabr_compiler_compile_keyword(comp, bc_data, w->data.kwrd)) goto PRINT_ERR_POS;
 					break;
-				case SABR_WT_IDFR:
+				case SABR_WT_IDFR: {
+					sabr_datagroup_data_t* dg_data = sabr_compiler_find_datagroup(comp, w->data.identifer_index);
+					if (dg_data && dg_data->is_constant) {
+						value_a.u = dg_data->member_count * (dg_data->is_enum ? 1 : sizeof(sabr_value_t));
+						if (!sabr_bytecode_write_bcop_with_value(bc_data, SABR_OP_VALUE, value_a)) goto PRINT_ERR_POS;
+						break;
+					}
 					value_a.u = w->data.identifer_index;
 					if (!sabr_bytecode_write_bcop_with_value(bc_data, SABR_OP_EXEC, value_a)) goto PRINT_ERR_POS;
-					break;
+				} break;
 				case SABR_WT_OP:
 					if (!sabr_bytecode_write_bcop(bc_data, w->data.oc)) goto PRINT_ERR_POS;
 					break;
@@ -874,9 +895,7 @@ sabr_bytecode_t* sabr_compiler_compile_tokens(sabr_compiler_t* const comp, vecto
 					break;
 				default:
 					if (!sabr_compiler_parse_struct_member(comp, current_token.data, &value_a, &value_b)) goto PRINT_ERR_POS;
-					if (!sabr_bytecode_write_bcop_with_value(bc_data, SABR_OP_VALUE, value_a)) goto PRINT_ERR_POS;
-					if (!sabr_bytecode_write_bcop_with_value(bc_data, SABR_OP_VALUE, value_b)) goto PRINT_ERR_POS;
-					if (!sabr_bytecode_write_bcop(bc_data, SABR_OP_DATAGROUP_EXEC)) goto PRINT_ERR_POS;
+					if (!sabr_compiler_compile_datagroup_exec(comp, bc_data, value_a, value_b)) goto PRINT_ERR_POS;
 			}
 		}
 	}
@@ -1293,7 +1312,7 @@ bool sabr_compiler_compile_keyword(sabr_compiler_t* const comp, sabr_bytecode_t*
 			if (!vector_push_back(cctl_ptr(vector(sabr_keyword_data_t)), &comp->keyword_data_stack, temp_kd_vec))
 				goto FAILURE_ALLOC;
 			if (!sabr_bytecode_write_bcop_with_null(bc_data, SABR_OP_LAMBDA)) goto FREE_ALL;
-			if (!sabr_bytecode_write_bcop(bc_data, SABR_OP_LOCAL)) goto FREE_ALL;
+			if (!sabr_bytecode_write_bcop_with_null(bc_data, SABR_OP_LOCAL)) goto FREE_ALL;
 			break;
 		case SABR_KWRD_MACRO:
 			temp_kd_vec = (vector(sabr_keyword_data_t)*) malloc(sizeof(vector(sabr_keyword_data_t)));
@@ -1315,10 +1334,26 @@ bool sabr_compiler_compile_keyword(sabr_compiler_t* const comp, sabr_bytecode_t*
 			if (!vector_push_back(sabr_keyword_data_t, temp_kd_vec, current_kd)) goto FAILURE_ALLOC;
 			if (!sabr_bytecode_write_bcop_with_null(bc_data, SABR_OP_JUMP)) goto FREE_ALL;
 			break;
+		case SABR_KWRD_INLINE:
+		case SABR_KWRD_NOINLINE:
+			if (!comp->keyword_data_stack.size) goto FAILURE_WRONG;
+			temp_kd_vec = *vector_back(cctl_ptr(vector(sabr_keyword_data_t)), &comp->keyword_data_stack);
+			if (vector_at(sabr_keyword_data_t, temp_kd_vec, 0)->kwrd != SABR_KWRD_FUNC) goto FAILURE_WRONG;
+			if (!sabr_bytecode_write_bcop(bc_data, (current_kd.kwrd == SABR_KWRD_INLINE) ? SABR_OP_INLINE : SABR_OP_NOINLINE)) goto FREE_ALL;
+			break;
 		case SABR_KWRD_STRUCT:
 		case SABR_KWRD_ENUM: {
 			sabr_value_t dg_type;
 			dg_type.u = current_kd.kwrd == SABR_KWRD_STRUCT ? 0 : 1;
+			sabr_bcop_t* name_bcop = bc_data->bcop_vec.size ? vector_back(sabr_bcop_t, &bc_data->bcop_vec) : NULL;
+			sabr_datagroup_data_t dg_data = {0, };
+			dg_data.member_index = comp->member_vector.size;
+			dg_data.is_enum = dg_type.u;
+			if (name_bcop && name_bcop->oc == SABR_OP_VALUE) {
+				dg_data.identifier = name_bcop->operand.u;
+				dg_data.is_constant = !sabr_compiler_find_datagroup(comp, dg_data.identifier);
+			}
+			if (!vector_push_back(sabr_datagroup_data_t, &comp->datagroup_vector, dg_data)) goto FAILURE_ALLOC;
 			temp_kd_vec = (vector(sabr_keyword_data_t)*) malloc(sizeof(vector(sabr_keyword_data_t)));
 			if (!temp_kd_vec) goto FAILURE_ALLOC;
 			vector_init(sabr_keyword_data_t, temp_kd_vec);
@@ -1327,12 +1362,23 @@ bool sabr_compiler_compile_keyword(sabr_compiler_t* const comp, sabr_bytecode_t*
 				goto FAILURE_ALLOC;
 			if (!sabr_bytecode_write_bcop_with_value(bc_data, SABR_OP_DATAGROUP, dg_type)) goto FREE_ALL;
 		} break;
-		case SABR_KWRD_MEMBER:
+		case SABR_KWRD_MEMBER: {
 			if (!comp->keyword_data_stack.size) goto FAILURE_WRONG;
 			temp_kd_vec = *vector_back(cctl_ptr(vector(sabr_keyword_data_t)), &comp->keyword_data_stack);
 			if (!vector_push_back(sabr_keyword_data_t, temp_kd_vec, current_kd)) goto FAILURE_ALLOC;
+			sabr_bcop_t* name_bcop = bc_data->bcop_vec.size ? vector_back(sabr_bcop_t, &bc_data->bcop_vec) : NULL;
+			sabr_datagroup_data_t* dg_data = comp->datagroup_vector.size ? vector_back(sabr_datagroup_data_t, &comp->datagroup_vector) : NULL;
+			size_t member;
+			if (dg_data && dg_data->is_constant) {
+				if (!name_bcop || name_bcop->oc != SABR_OP_VALUE || sabr_compiler_find_member(comp, dg_data, name_bcop->operand.u, &member))
+					dg_data->is_constant = false;
+				else {
+					if (!vector_push_back(sabr_value_t, &comp->member_vector, name_bcop->operand)) goto FAILURE_ALLOC;
+					dg_data->member_count++;
+				}
+			}
 			if (!sabr_bytecode_write_bcop(bc_data, SABR_OP_MEMBER)) goto FREE_ALL;
-			break;
+		} break;
 		case SABR_KWRD_END: {
 			sabr_value_t pos;
 			if (comp->keyword_data_stack.size == 0) goto FAILURE_WRONG;
@@ -1801,6 +1847,40 @@ FREE_ALL:
 	return false;
 }
 
+bool sabr_compiler_compile_datagroup_exec(sabr_compiler_t* const comp, sabr_bytecode_t* bc_data, sabr_value_t struct_v, sabr_value_t member_v) {
+	sabr_datagroup_data_t* dg_data = sabr_compiler_find_datagroup(comp, struct_v.u);
+	size_t member;
+
+	if (!dg_data || !dg_data->is_constant || !sabr_compiler_find_member(comp, dg_data, member_v.u, &member)) {
+		if (!sabr_bytecode_write_bcop_with_value(bc_data, SABR_OP_VALUE, struct_v)) return false;
+		if (!sabr_bytecode_write_bcop_with_value(bc_data, SABR_OP_VALUE, member_v)) return false;
+		return sabr_bytecode_write_bcop(bc_data, SABR_OP_DATAGROUP_EXEC);
+	}
+
+	if (dg_data->is_enum)
+		return sabr_bytecode_write_bcop_with_value(bc_data, SABR_OP_VALUE, (sabr_value_t) { .u = member });
+	if (!member) return true;
+	if (!sabr_bytecode_write_bcop_with_value(bc_data, SABR_OP_VALUE, (sabr_value_t) { .u = member * sizeof(sabr_value_t) })) return false;
+	return sabr_bytecode_write_bcop(bc_data, SABR_OP_ADD);
+}
+
+sabr_datagroup_data_t* sabr_compiler_find_datagroup(sabr_compiler_t* const comp, uint64_t identifier) {
+	for (size_t i = 0; i < comp->datagroup_vector.size; i++) {
+		sabr_datagroup_data_t* dg_data = vector_at(sabr_datagroup_data_t, &comp->datagroup_vector, i);
+		if (dg_data->identifier == identifier && dg_data->is_constant) return dg_data;
+	}
+	return NULL;
+}
+
+bool sabr_compiler_find_member(sabr_compiler_t* const comp, sabr_datagroup_data_t* dg_data, uint64_t identifier, size_t* index) {
+	for (size_t i = 0; i < dg_data->member_count; i++) {
+		if (vector_at(sabr_value_t, &comp->member_vector, dg_data->member_index + i)->u != identifier) continue;
+		*index = i;
+		return true;
+	}
+	return false;
+}
+
 sabr_bcop_t* sabr_compiler_get_bcop(sabr_bytecode_t* bc_data, size_t index) {
 	if (index >= bc_data->bcop_vec.size) return NULL;
 	return vector_at(sabr_bcop_t, &bc_data->bcop_vec, index);
@@ -7,5 +7,6 @@ trie_imp_c(sabr_word_t);
 vector_imp_c(cctl_ptr(trie(sabr_word_t)));
 vector_imp_c(size_t);
 vector_imp_c(sabr_preproc_stop_flag_t);
+vector_imp_c(sabr_datagroup_data_t);
 vector_imp_c(sabr_keyword_data_t);
 vector_imp_c(cctl_ptr(vector(sabr_keyword_data_t)));
\ No newline at end of file
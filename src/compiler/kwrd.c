@@ -21,6 +21,8 @@ const char* sabr_keyword_names[] = {
 	"macro",
 	"defer",
 	"return",
+	"#inline",
+	"#noinline",
 	"struct",
 	"enum",
 	"member",
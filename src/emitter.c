@@ -0,0 +1,158 @@
+#include "emitter.h"
+
+bool sabr_emitter_emit_c(sabr_bytecode_t* bc, const char* filename, size_t memory_pool_size, size_t data_stack_size) {
+	bool succeed = false;
+	size_t size = bc->bcop_vec.size;
+	size_t image_size;
+	FILE* file = NULL;
+	sabr_block_data_t** begins = NULL;
+	vector(sabr_block_data_t) block_data_vec;
+
+	vector_init(sabr_block_data_t, &block_data_vec);
+
+	if (!sabr_emitter_check(bc)) {
+		fputs(sabr_errmsg_invalid_bytecode, stderr);
+		goto FREE_ALL;
+	}
+	if (!sabr_interpreter_verify_bytecode(bc, &block_data_vec)) goto FREE_ALL;
+
+	begins = (sabr_block_data_t**) calloc(size + 1, sizeof(sabr_block_data_t*));
+	if (!begins) {
+		fputs(sabr_errmsg_alloc, stderr);
+		goto FREE_ALL;
+	}
+	for (size_t i = 0; i < block_data_vec.size; i++) {
+		sabr_block_data_t* data = vector_at(sabr_block_data_t, &block_data_vec, i);
+		if (data->need || data->grow) begins[data->begin] = data;
+	}
+
+	file = fopen(filename, "w");
+	if (!file) {
+		fputs(sabr_errmsg_open, stderr);
+		goto FREE_ALL;
+	}
+
+	fputs("#include \"interpreter_aot.h\"\n\n", file);
+	image_size = sabr_emitter_write_image(bc, file);
+
+	fputs("bool sabr_aot_program(sabr_interpreter_t* inter, sabr_bytecode_t* bc) {\n\tSABR_AOT_ENTER();\n\n", file);
+	for (size_t i = 0; i < size; i++) {
+		fprintf(file, "L%zu:\n", i);
+		if (begins[i]) fprintf(file, "\tSABR_AOT_BLOCK(%zu, %zu, %zu, %zu);\n", i, begins[i]->end, begins[i]->need, begins[i]->grow);
+		sabr_bcop_t bcop = *vector_at(sabr_bcop_t, &bc->bcop_vec, i);
+		if (bcop.oc == SABR_OP_SWITCH_TABLE || bcop.oc == SABR_OP_SWITCH_SEARCH) {
+			if (sabr_emitter_write_switch(bc, file, i)) continue;
+		}
+		sabr_emitter_write_op(bc, file, i);
+	}
+	fprintf(file, "L%zu:\n\tSABR_AOT_END();\n\n", size);
+	sabr_emitter_write_dispatch(bc, file);
+	fputs("\n\tSABR_AOT_LEAVE();\n}\n\n", file);
+
+	fprintf(
+		file,
+		"int main(void) {\n\treturn sabr_interpreter_aot_main(sabr_aot_image, %zu, sabr_aot_program, %zu, %zu);\n}\n",
+		image_size, memory_pool_size, data_stack_size
+	);
+
+	if (ferror(file)) {
+		fputs(sabr_errmsg_write, stderr);
+		goto FREE_ALL;
+	}
+
+	succeed = true;
+
+FREE_ALL:
+	if (file) fclose(file);
+	free(begins);
+	vector_free(sabr_block_data_t, &block_data_vec);
+	return succeed;
+}
+
+bool sabr_emitter_check(sabr_bytecode_t* bc) {
+	size_t size = bc->bcop_vec.size;
+	for (size_t i = 0; i < size; i++) {
+		sabr_bcop_t bcop = *vector_at(sabr_bcop_t, &bc->bcop_vec, i);
+		if (bcop.oc >= sabr_opcode_names_len) return false;
+		if (sabr_opcode_has_index_operand(bcop.oc) && bcop.operand.u > size) return false;
+		if ((bcop.oc == SABR_OP_SWITCH_TABLE || bcop.oc == SABR_OP_SWITCH_SEARCH) && !sabr_bytecode_check_switch(bc, bcop)) return false;
+	}
+	return true;
+}
+
+size_t sabr_emitter_write_image(sabr_bytecode_t* bc, FILE* file) {
+	size_t count = 0;
+	fputs("static const uint8_t sabr_aot_image[] = {", file);
+	for (size_t i = 0; i < SABR_BYTECODE_HEADER_SIZE; i++) {
+		fputs((count % 16) ? " " : "\n\t", file);
+		fprintf(file, "0x%02x,", (i < SABR_BYTECODE_MAGIC_SIZE) ? (uint8_t) SABR_BYTECODE_MAGIC[i] : SABR_BYTECODE_VERSION);
+		count++;
+	}
+	for (size_t i = 0; i < bc->bcop_vec.size; i++) {
+		sabr_bcop_t bcop = *vector_at(sabr_bcop_t, &bc->bcop_vec, i);
+		size_t len = sabr_opcode_has_operand(bcop.oc) ? 9 : 1;
+		for (size_t j = 0; j < len; j++) {
+			uint8_t byte = j ? bcop.operand.bytes[j - 1] : bcop.oc;
+			fputs((count % 16) ? " " : "\n\t", file);
+			fprintf(file, "0x%02x,", byte);
+			count++;
+		}
+	}
+	fputs("\n};\n\n", file);
+	return count;
+}
+
+void sabr_emitter_write_op(sabr_bytecode_t* bc, FILE* file, size_t index) {
+	sabr_bcop_t bcop = *vector_at(sabr_bcop_t, &bc->bcop_vec, index);
+	fprintf(file, "\tSABR_AOT_%s(%zu, UINT64_C(%" PRIu64 ")", sabr_opcode_names[bcop.oc], index, bcop.operand.u);
+	if (sabr_opcode_has_index_operand(bcop.oc)) fprintf(file, ", L%" PRIu64, bcop.operand.u);
+	fputs(");\n", file);
+}
+
+bool sabr_emitter_write_switch(sabr_bytecode_t* bc, FILE* file, size_t index) {
+	sabr_bcop_t bcop = *vector_at(sabr_bcop_t, &bc->bcop_vec, index);
+	size_t table = bcop.operand.u;
+	size_t count, fallback;
+
+	if (bcop.oc == SABR_OP_SWITCH_SEARCH) {
+		count = vector_at(sabr_bcop_t, &bc->bcop_vec, table)->operand.u;
+		for (size_t k = 1; k < count; k++) {
+			int64_t prev = vector_at(sabr_bcop_t, &bc->bcop_vec, table + k * 2)->operand.i;
+			int64_t key = vector_at(sabr_bcop_t, &bc->bcop_vec, table + k * 2 + 2)->operand.i;
+			if (key < prev) return false;
+		}
+		fallback = table + 1;
+	}
+	else {
+		count = vector_at(sabr_bcop_t, &bc->bcop_vec, table + 1)->operand.u;
+		fallback = table + 2;
+	}
+
+	fputs("\t{\n\t\tuint64_t key = (--sp)->u;\n\t\tswitch (key) {\n", file);
+	for (size_t k = 0; k < count; k++) {
+		uint64_t key;
+		size_t entry;
+		if (bcop.oc == SABR_OP_SWITCH_SEARCH) {
+			key = vector_at(sabr_bcop_t, &bc->bcop_vec, table + k * 2 + 2)->operand.u;
+			if (k && key == vector_at(sabr_bcop_t, &bc->bcop_vec, table + k * 2)->operand.u) continue;
+			entry = table + k * 2 + 3;
+		}
+		else {
+			key = vector_at(sabr_bcop_t, &bc->bcop_vec, table)->operand.u + k;
+			entry = table + k + 3;
+		}
+		fprintf(file, "\t\t\tcase UINT64_C(%" PRIu64 "): goto L%zu;\n", key, sabr_emitter_target(bc, entry));
+	}
+	fprintf(file, "\t\t\tdefault: goto L%zu;\n\t\t}\n\t}\n", sabr_emitter_target(bc, fallback));
+	return true;
+}
+
+void sabr_emitter_write_dispatch(sabr_bytecode_t* bc, FILE* file) {
+	fputs("DISPATCH:\n\tswitch (index) {\n", file);
+	for (size_t i = 0; i <= bc->bcop_vec.size; i++) fprintf(file, "\t\tcase %zu: goto L%zu;\n", i, i);
+	fputs("\t\tdefault: SABR_AOT_END();\n\t}\n", file);
+}
+
+size_t sabr_emitter_target(sabr_bytecode_t* bc, size_t index) {
+	return vector_at(sabr_bcop_t, &bc->bcop_vec, index)->operand.u;
+}
\ No newline at end of file
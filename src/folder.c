@@ -0,0 +1,271 @@
+#include "folder.h"
+
+#include "peephole.h"
+
+bool sabr_folder_run(sabr_bytecode_t* bc) {
+	size_t size = bc->bcop_vec.size;
+	size_t count = 0;
+	size_t* run = NULL;
+	bool* targets = NULL;
+
+	run = (size_t*) malloc(sizeof(size_t) * (size + 1));
+	if (!run) {
+		fputs(sabr_errmsg_alloc, stderr);
+		return false;
+	}
+	targets = sabr_peephole_targets(bc);
+	if (!targets) {
+		free(run);
+		return false;
+	}
+
+	for (size_t i = 0; i < size; i++) {
+		sabr_bcop_t* bcop = vector_at(sabr_bcop_t, &bc->bcop_vec, i);
+		if (targets[i]) count = 0;
+		switch (bcop->oc) {
+			case SABR_OP_NONE:
+				break;
+			case SABR_OP_VALUE:
+				run[count++] = i;
+				break;
+			case SABR_OP_IF:
+				if (count) {
+					sabr_bcop_t* flag = vector_at(sabr_bcop_t, &bc->bcop_vec, run[count - 1]);
+					if (flag->operand.u) *bcop = sabr_new_bcop(SABR_OP_NONE);
+					else bcop->oc = SABR_OP_JUMP;
+					*flag = sabr_new_bcop(SABR_OP_NONE);
+				}
+				count = 0;
+				break;
+			default:
+				if (!sabr_folder_fold(bc, run, &count, i)) count = 0;
+				break;
+		}
+	}
+
+	free(run);
+	free(targets);
+	return true;
+}
+
+bool sabr_folder_fold(sabr_bytecode_t* bc, size_t* run, size_t* count, size_t index) {
+	sabr_value_t stack[SABR_FOLDER_STACK];
+	sabr_bcop_t bcop = *vector_at(sabr_bcop_t, &bc->bcop_vec, index);
+	size_t depth = (*count < SABR_FOLDER_STACK) ? *count : SABR_FOLDER_STACK;
+	size_t base = *count - depth;
+	size_t top = depth, low = depth, steps = 0;
+
+	for (size_t i = 0; i < depth; i++)
+		stack[i] = vector_at(sabr_bcop_t, &bc->bcop_vec, run[base + i])->operand;
+
+	if (bcop.oc == SABR_OP_CALL) {
+		if (!sabr_folder_call(bc, bcop.operand.u, stack, &top, &low, 0, &steps)) return false;
+	}
+	else if (!sabr_folder_eval(bcop, stack, &top, &low)) return false;
+
+	size_t consumed = depth - low;
+	size_t results = top - low;
+	if (results > consumed + 1) return false;
+
+	for (size_t i = 0; i < consumed; i++)
+		*vector_at(sabr_bcop_t, &bc->bcop_vec, run[base + low + i]) = sabr_new_bcop(SABR_OP_NONE);
+	*vector_at(sabr_bcop_t, &bc->bcop_vec, index) = sabr_new_bcop(SABR_OP_NONE);
+
+	*count = base + low;
+	for (size_t i = 0; i < results; i++) {
+		size_t slot = consumed + 1 - results + i;
+		size_t pos = (slot < consumed) ? run[base + low + slot] : index;
+		*vector_at(sabr_bcop_t, &bc->bcop_vec, pos) = sabr_new_bcop_with_value(SABR_OP_VALUE, stack[low + i]);
+		run[(*count)++] = pos;
+	}
+	return true;
+}
+
+bool sabr_folder_call(sabr_bytecode_t* bc, size_t entry, sabr_value_t* stack, size_t* top, size_t* low, size_t depth, size_t* steps) {
+	size_t size = bc->bcop_vec.size;
+	sabr_value_t frame[SABR_FOLDER_FRAME];
+	size_t frame_size = 0;
+
+	if (depth >= SABR_FOLDER_DEPTH || !entry || entry >= size) return false;
+	if (vector_at(sabr_bcop_t, &bc->bcop_vec, entry - 1)->oc != SABR_OP_LAMBDA) return false;
+
+	for (size_t i = entry; i < size; i++) {
+		sabr_bcop_t bcop = *vector_at(sabr_bcop_t, &bc->bcop_vec, i);
+		if (++*steps > SABR_FOLDER_STEPS) return false;
+		switch (bcop.oc) {
+			case SABR_OP_NONE:
+			case SABR_OP_INLINE:
+			case SABR_OP_NOINLINE:
+			case SABR_OP_LOCAL_END:
+				break;
+			case SABR_OP_LOCAL:
+				if (i != entry || bcop.operand.u > SABR_FOLDER_FRAME) return false;
+				frame_size = bcop.operand.u;
+				memset(frame, 0, sizeof(sabr_value_t) * frame_size);
+				break;
+			case SABR_OP_RETURN:
+				return true;
+			case SABR_OP_VALUE:
+				if (*top >= SABR_FOLDER_STACK) return false;
+				stack[(*top)++] = bcop.operand;
+				break;
+			case SABR_OP_LOAD_LOCAL:
+				if (bcop.operand.u >= frame_size || *top >= SABR_FOLDER_STACK) return false;
+				stack[(*top)++] = frame[bcop.operand.u];
+				break;
+			case SABR_OP_STORE_LOCAL:
+				if (bcop.operand.u >= frame_size || !*top) return false;
+				frame[bcop.operand.u] = stack[--*top];
+				if (*top < *low) *low = *top;
+				break;
+			case SABR_OP_IF:
+				if (!*top || bcop.operand.u > size) return false;
+				if (*top - 1 < *low) *low = *top - 1;
+				if (!stack[--*top].u) i = bcop.operand.u - 1;
+				break;
+			case SABR_OP_JUMP:
+				if (bcop.operand.u > size) return false;
+				i = bcop.operand.u - 1;
+				break;
+			case SABR_OP_CALL:
+				if (!sabr_folder_call(bc, bcop.operand.u, stack, top, low, depth + 1, steps)) return false;
+				break;
+			default:
+				if (!sabr_folder_eval(bcop, stack, top, low)) return false;
+				break;
+		}
+	}
+	return false;
+}
+
+bool sabr_folder_eval(sabr_bcop_t bcop, sabr_value_t* stack, size_t* top, size_t* low) {
+	size_t pops, pushes;
+	switch (bcop.oc) {
+		case SABR_OP_ADD: case SABR_OP_SUB: case SABR_OP_MUL: case SABR_OP_DIV: case SABR_OP_MOD:
+		case SABR_OP_UDIV: case SABR_OP_UMOD: case SABR_OP_NEG: case SABR_OP_INC: case SABR_OP_DEC:
+		case SABR_OP_ADD_IMM: case SABR_OP_MUL_IMM:
+		case SABR_OP_EQU: case SABR_OP_NEQ: case SABR_OP_GRT: case SABR_OP_GEQ: case SABR_OP_LST: case SABR_OP_LEQ:
+		case SABR_OP_UGRT: case SABR_OP_UGEQ: case SABR_OP_ULST: case SABR_OP_ULEQ:
+		case SABR_OP_EQU_IMM: case SABR_OP_NEQ_IMM: case SABR_OP_GRT_IMM: case SABR_OP_GEQ_IMM: case SABR_OP_LST_IMM: case SABR_OP_LEQ_IMM:
+		case SABR_OP_FADD: case SABR_OP_FSUB: case SABR_OP_FMUL: case SABR_OP_FDIV: case SABR_OP_FMOD: case SABR_OP_FNEG:
+		case SABR_OP_FEQU: case SABR_OP_FNEQ: case SABR_OP_FGRT: case SABR_OP_FGEQ: case SABR_OP_FLST: case SABR_OP_FLEQ:
+		case SABR_OP_BAND: case SABR_OP_BOR: case SABR_OP_BXOR: case SABR_OP_BNOT: case SABR_OP_BLSFT: case SABR_OP_BRSFT:
+		case SABR_OP_BAND_IMM: case SABR_OP_BLSFT_IMM: case SABR_OP_BRSFT_IMM:
+		case SABR_OP_DROP: case SABR_OP_NIP: case SABR_OP_DUP: case SABR_OP_OVER: case SABR_OP_TUCK: case SABR_OP_SWAP: case SABR_OP_ROT:
+		case SABR_OP_ITOF: case SABR_OP_UTOF: case SABR_OP_FTOI: case SABR_OP_FTOU:
+			break;
+		default:
+			return false;
+	}
+	if (!sabr_opcode_stack_effect(bcop.oc, &pops, &pushes)) return false;
+	if (*top < pops || *top - pops + pushes > SABR_FOLDER_STACK) return false;
+
+	sabr_value_t* s = stack + *top - pops;
+	sabr_value_t a = s[0];
+	sabr_value_t b = (pops > 1) ? s[1] : a;
+	sabr_value_t c = (pops > 2) ? s[2] : a;
+	switch (bcop.oc) {
+		case SABR_OP_ADD: s[0].u = a.u + b.u; break;
+		case SABR_OP_SUB: s[0].u = a.u - b.u; break;
+		case SABR_OP_MUL: s[0].u = a.u * b.u; break;
+		case SABR_OP_DIV:
+			if (!b.i || (a.i == INT64_MIN && b.i == -1)) return false;
+			s[0].i = a.i / b.i;
+			break;
+		case SABR_OP_MOD:
+			if (!b.i || (a.i == INT64_MIN && b.i == -1)) return false;
+			s[0].i = a.i % b.i;
+			break;
+		case SABR_OP_UDIV:
+			if (!b.u) return false;
+			s[0].u = a.u / b.u;
+			break;
+		case SABR_OP_UMOD:
+			if (!b.u) return false;
+			s[0].u = a.u % b.u;
+			break;
+		case SABR_OP_NEG: s[0].u = -a.u; break;
+		case SABR_OP_INC: s[0].u = a.u + 1; break;
+		case SABR_OP_DEC: s[0].u = a.u - 1; break;
+		case SABR_OP_ADD_IMM: s[0].u = a.u + bcop.operand.u; break;
+		case SABR_OP_MUL_IMM: s[0].u = a.u * bcop.operand.u; break;
+		case SABR_OP_EQU: s[0].u = (a.i == b.i) ? -1 : 0; break;
+		case SABR_OP_NEQ: s[0].u = (a.i != b.i) ? -1 : 0; break;
+		case SABR_OP_GRT: s[0].u = (a.i > b.i) ? -1 : 0; break;
+		case SABR_OP_GEQ: s[0].u = (a.i >= b.i) ? -1 : 0; break;
+		case SABR_OP_LST: s[0].u = (a.i < b.i) ? -1 : 0; break;
+		case SABR_OP_LEQ: s[0].u = (a.i <= b.i) ? -1 : 0; break;
+		case SABR_OP_UGRT: s[0].u = (a.u > b.u) ? -1 : 0; break;
+		case SABR_OP_UGEQ: s[0].u = (a.u >= b.u) ? -1 : 0; break;
+		case SABR_OP_ULST: s[0].u = (a.u < b.u) ? -1 : 0; break;
+		case SABR_OP_ULEQ: s[0].u = (a.u <= b.u) ? -1 : 0; break;
+		case SABR_OP_EQU_IMM: s[0].u = (a.i == bcop.operand.i) ? -1 : 0; break;
+		case SABR_OP_NEQ_IMM: s[0].u = (a.i != bcop.operand.i) ? -1 : 0; break;
+		case SABR_OP_GRT_IMM: s[0].u = (a.i > bcop.operand.i) ? -1 : 0; break;
+		case SABR_OP_GEQ_IMM: s[0].u = (a.i >= bcop.operand.i) ? -1 : 0; break;
+		case SABR_OP_LST_IMM: s[0].u = (a.i < bcop.operand.i) ? -1 : 0; break;
+		case SABR_OP_LEQ_IMM: s[0].u = (a.i <= bcop.operand.i) ? -1 : 0; break;
+		case SABR_OP_FADD: s[0].f = a.f + b.f; break;
+		case SABR_OP_FSUB: s[0].f = a.f - b.f; break;
+		case SABR_OP_FMUL: s[0].f = a.f * b.f; break;
+		case SABR_OP_FDIV:
+			if (b.f == 0.0f) return false;
+			s[0].f = a.f / b.f;
+			break;
+		case SABR_OP_FMOD:
+			if (b.f == 0.0f) return false;
+			s[0].f = fmod(a.f, b.f);
+			break;
+		case SABR_OP_FNEG: s[0].f = -a.f; break;
+		case SABR_OP_FEQU: s[0].u = (a.f == b.f) ? -1 : 0; break;
+		case SABR_OP_FNEQ: s[0].u = (a.f != b.f) ? -1 : 0; break;
+		case SABR_OP_FGRT: s[0].u = (a.f > b.f) ? -1 : 0; break;
+		case SABR_OP_FGEQ: s[0].u = (a.f >= b.f) ? -1 : 0; break;
+		case SABR_OP_FLST: s[0].u = (a.f < b.f) ? -1 : 0; break;
+		case SABR_OP_FLEQ: s[0].u = (a.f <= b.f) ? -1 : 0; break;
+		case SABR_OP_BAND: s[0].u = a.u & b.u; break;
+		case SABR_OP_BOR: s[0].u = a.u | b.u; break;
+		case SABR_OP_BXOR: s[0].u = a.u ^ b.u; break;
+		case SABR_OP_BNOT: s[0].u = ~a.u; break;
+		case SABR_OP_BLSFT:
+			if (b.u >= 64) return false;
+			s[0].u = a.u << b.u;
+			break;
+		case SABR_OP_BRSFT:
+			if (b.u >= 64) return false;
+			s[0].u = a.u >> b.u;
+			break;
+		case SABR_OP_BAND_IMM: s[0].u = a.u & bcop.operand.u; break;
+		case SABR_OP_BLSFT_IMM:
+			if (bcop.operand.u >= 64) return false;
+			s[0].u = a.u << bcop.operand.u;
+			break;
+		case SABR_OP_BRSFT_IMM:
+			if (bcop.operand.u >= 64) return false;
+			s[0].u = a.u >> bcop.operand.u;
+			break;
+		case SABR_OP_DROP: break;
+		case SABR_OP_NIP: break;
+		case SABR_OP_DUP: s[1] = a; break;
+		case SABR_OP_OVER: s[2] = a; break;
+		case SABR_OP_TUCK: s[0] = b; s[1] = a; s[2] = b; break;
+		case SABR_OP_SWAP: s[0] = b; s[1] = a; break;
+		case SABR_OP_ROT: s[0] = b; s[1] = c; s[2] = a; break;
+		case SABR_OP_ITOF: s[0].f = (double) a.i; break;
+		case SABR_OP_UTOF: s[0].f = (double) a.u; break;
+		case SABR_OP_FTOI:
+		case SABR_OP_FTOU:
+			if (!sabr_folder_fits_int(a.f)) return false;
+			s[0].i = (int64_t) a.f;
+			break;
+		default: return false;
+	}
+
+	if (*top - pops < *low) *low = *top - pops;
+	*top = *top - pops + pushes;
+	return true;
+}
+
+bool sabr_folder_fits_int(double f) {
+	return f >= -9223372036854775808.0 && f < 9223372036854775808.0;
+}
\ No newline at end of file
@@ -0,0 +1,265 @@
+#include "inliner.h"
+
+bool sabr_inliner_run(sabr_bytecode_t* bc, size_t* owners, bool* hot) {
+	bool succeed = false;
+	size_t size = bc->bcop_vec.size;
+	size_t count = 0;
+	sabr_bcop_t* source = NULL;
+	sabr_inliner_hint_t* hints = NULL;
+	bool* callees = NULL;
+	bool* sites = NULL;
+	uint64_t* grows = NULL;
+	size_t* offsets = NULL;
+	size_t* map = NULL;
+
+	source = (sabr_bcop_t*) malloc(sizeof(sabr_bcop_t) * (size + 1));
+	hints = (sabr_inliner_hint_t*) calloc(size + 1, sizeof(sabr_inliner_hint_t));
+	callees = (bool*) calloc(size + 1, sizeof(bool));
+	sites = (bool*) calloc(size + 1, sizeof(bool));
+	grows = (uint64_t*) calloc(size + 1, sizeof(uint64_t));
+	offsets = (size_t*) malloc(sizeof(size_t) * (size + 1));
+	map = (size_t*) malloc(sizeof(size_t) * (size + 1));
+	if (!source || !hints || !callees || !sites || !grows || !offsets || !map) {
+		fputs(sabr_errmsg_alloc, stderr);
+		goto FREE_ALL;
+	}
+
+	for (size_t i = 0; i < size; i++) {
+		sabr_bcop_t* bcop = vector_at(sabr_bcop_t, &bc->bcop_vec, i);
+		switch (bcop->oc) {
+			case SABR_OP_INLINE:
+			case SABR_OP_NOINLINE:
+				if (owners[i] != SIZE_MAX) hints[owners[i]] = (bcop->oc == SABR_OP_INLINE) ? SABR_INLINER_HINT_INLINE : SABR_INLINER_HINT_NOINLINE;
+				*bcop = sabr_new_bcop(SABR_OP_NONE);
+				break;
+			default: break;
+		}
+		source[i] = *bcop;
+	}
+
+	for (size_t i = 0; hot && i < size; i++) {
+		if (hot[i] && source[i].oc == SABR_OP_CALL && source[i].operand.u && source[i].operand.u < size) hints[source[i].operand.u - 1] = SABR_INLINER_HINT_HOT;
+	}
+
+	for (size_t i = 0; i + 1 < size; i++) {
+		if (owners[i + 1] == i && sabr_inliner_is_inlinable(source, owners, i, hints[i])) callees[i + 1] = true;
+	}
+
+	for (size_t i = 0; i < size; i++) {
+		if (hot && !hot[i]) continue;
+		if (!sabr_inliner_is_site(source, size, owners, callees, i)) continue;
+		uint64_t frame = source[source[i].operand.u].operand.u;
+		if (owners[i] != SIZE_MAX && frame > grows[owners[i]]) grows[owners[i]] = frame;
+		sites[i] = true;
+		count++;
+	}
+	if (!count) {
+		succeed = true;
+		goto FREE_ALL;
+	}
+
+	for (size_t entry = 0; entry < size; entry++) {
+		if (!callees[entry]) continue;
+		size_t end = source[entry - 1].operand.u - 2;
+		size_t length = sabr_inliner_zero_count(source, entry) * 2;
+		for (size_t i = entry + 1; i <= end; i++) {
+			offsets[i] = length;
+			if (i < end && source[i].oc != SABR_OP_NONE) length++;
+		}
+	}
+
+	size_t pos = 0;
+	for (size_t i = 0; i < size; i++) {
+		map[i] = pos;
+		if (sites[i]) {
+			size_t entry = source[i].operand.u;
+			pos += offsets[source[entry - 1].operand.u - 2];
+		}
+		else pos++;
+	}
+	map[size] = pos;
+
+	bc->bcop_vec.size = 0;
+	for (size_t i = 0; i < size; i++) {
+		sabr_bcop_t bcop = source[i];
+		if (sites[i]) {
+			uint64_t base = (owners[i] == SIZE_MAX) ? 0 : source[owners[i] + 1].operand.u;
+			if (!sabr_inliner_emit(bc, source, size, map, offsets, i, base)) goto FREE_ALL;
+			continue;
+		}
+		if (bcop.oc == SABR_OP_LOCAL && i && owners[i] == i - 1) bcop.operand.u += grows[i - 1];
+		else if (sabr_opcode_has_index_operand(bcop.oc) && bcop.operand.u <= size) bcop.operand.u = map[bcop.operand.u];
+		if (!vector_push_back(sabr_bcop_t, &bc->bcop_vec, bcop)) {
+			fputs(sabr_errmsg_alloc, stderr);
+			goto FREE_ALL;
+		}
+	}
+
+	bc->current_index = bc->bcop_vec.size;
+	bc->current_pos = 0;
+	for (size_t i = 0; i < bc->bcop_vec.size; i++)
+		bc->current_pos += sabr_opcode_has_operand(vector_at(sabr_bcop_t, &bc->bcop_vec, i)->oc) ? 9 : 1;
+
+	succeed = true;
+
+FREE_ALL:
+	free(source);
+	free(hints);
+	free(callees);
+	free(sites);
+	free(grows);
+	free(offsets);
+	free(map);
+	return succeed;
+}
+
+bool sabr_inliner_is_inlinable(sabr_bcop_t* source, size_t* owners, size_t lambda, sabr_inliner_hint_t hint) {
+	size_t end = source[lambda].operand.u;
+	size_t count = 0;
+
+	if (hint == SABR_INLINER_HINT_NOINLINE || end < lambda + 4) return false;
+	if (source[lambda + 1].oc != SABR_OP_LOCAL) return false;
+	if (source[end - 2].oc != SABR_OP_LOCAL_END || source[end - 1].oc != SABR_OP_RETURN) return false;
+
+	for (size_t i = lambda + 2; i < end - 2; i++) {
+		sabr_bcop_t bcop = source[i];
+		if (owners[i] != lambda) return false;
+		switch (bcop.oc) {
+			case SABR_OP_NONE:
+				continue;
+			case SABR_OP_FOR:
+			case SABR_OP_FOR_ADDR:
+			case SABR_OP_FOR_FROM:
+			case SABR_OP_FOR_TO:
+			case SABR_OP_FOR_STEP:
+			case SABR_OP_FOR_CHECK:
+			case SABR_OP_FOR_NEXT:
+			case SABR_OP_FOR_END:
+			case SABR_OP_FOR_INIT:
+			case SABR_OP_FOR_TO_I:
+			case SABR_OP_FOR_TO_U:
+			case SABR_OP_FOR_TO_F:
+			case SABR_OP_FOR_ENTER_I:
+			case SABR_OP_FOR_ENTER_U:
+			case SABR_OP_FOR_ENTER_F:
+			case SABR_OP_FOR_LOOP_I:
+			case SABR_OP_FOR_LOOP_U:
+			case SABR_OP_FOR_LOOP_F:
+			case SABR_OP_FOR_UP_I:
+			case SABR_OP_FOR_UP_U:
+			case SABR_OP_FOR_UP_F:
+			case SABR_OP_FOR_DOWN_I:
+			case SABR_OP_FOR_DOWN_U:
+			case SABR_OP_FOR_DOWN_F:
+			case SABR_OP_FOR_LEAVE:
+			case SABR_OP_SWITCH:
+			case SABR_OP_SWITCH_CASE:
+			case SABR_OP_SWITCH_END:
+			case SABR_OP_SWITCH_TABLE:
+			case SABR_OP_SWITCH_SEARCH:
+			case SABR_OP_LAMBDA:
+			case SABR_OP_RETURN:
+			case SABR_OP_LOCAL:
+			case SABR_OP_LOCAL_END:
+			case SABR_OP_INC_LOCAL:
+			case SABR_OP_DEC_LOCAL:
+			case SABR_OP_ADD_LOCAL:
+			case SABR_OP_FADD_LOCAL:
+			case SABR_OP_TAILCALL:
+			case SABR_OP_DEFINE:
+			case SABR_OP_DATAGROUP:
+			case SABR_OP_MEMBER:
+			case SABR_OP_DATAGROUP_END:
+			case SABR_OP_DATAGROUP_EXEC:
+			case SABR_OP_SET:
+			case SABR_OP_EXEC:
+			case SABR_OP_ADDR:
+			case SABR_OP_REF:
+			case SABR_OP_ALLOT:
+			case SABR_OP_ARRAY:
+			case SABR_OP_ARRAY_COMMA:
+			case SABR_OP_ARRAY_END:
+				return false;
+			case SABR_OP_CALL:
+				if (bcop.operand.u == lambda + 1) return false;
+				break;
+			default:
+				if (sabr_opcode_has_index_operand(bcop.oc) && (bcop.operand.u <= lambda + 1 || bcop.operand.u > end - 2)) return false;
+				break;
+		}
+		count++;
+	}
+	return hint == SABR_INLINER_HINT_INLINE || count <= ((hint == SABR_INLINER_HINT_HOT) ? SABR_INLINER_HOT_THRESHOLD : SABR_INLINER_THRESHOLD);
+}
+
+bool sabr_inliner_is_site(sabr_bcop_t* source, size_t size, size_t* owners, bool* callees, size_t index) {
+	sabr_bcop_t bcop = source[index];
+	size_t owner = owners[index];
+	if (bcop.oc != SABR_OP_CALL || bcop.operand.u >= size || !callees[bcop.operand.u]) return false;
+	if (owner == SIZE_MAX) return !source[bcop.operand.u].operand.u;
+	return source[owner + 1].oc == SABR_OP_LOCAL && owner + 1 != bcop.operand.u;
+}
+
+bool sabr_inliner_needs_zero(sabr_bcop_t* source, size_t entry, uint64_t slot) {
+	size_t end = source[entry - 1].operand.u - 2;
+	bool straight = true;
+	for (size_t i = entry + 1; i < end; i++) {
+		sabr_bcop_t bcop = source[i];
+		if (bcop.operand.u == slot) {
+			switch (bcop.oc) {
+				case SABR_OP_STORE_LOCAL:
+					if (straight) return false;
+					break;
+				case SABR_OP_LOAD_LOCAL:
+				case SABR_OP_ADDR_LOCAL:
+					return true;
+				default: break;
+			}
+		}
+		if (sabr_opcode_is_control(bcop.oc) || sabr_opcode_has_index_operand(bcop.oc)) straight = false;
+	}
+	return false;
+}
+
+size_t sabr_inliner_zero_count(sabr_bcop_t* source, size_t entry) {
+	size_t count = 0;
+	for (uint64_t slot = 0; slot < source[entry].operand.u; slot++)
+		if (sabr_inliner_needs_zero(source, entry, slot)) count++;
+	return count;
+}
+
+bool sabr_inliner_emit(sabr_bytecode_t* bc, sabr_bcop_t* source, size_t size, size_t* map, size_t* offsets, size_t site, uint64_t base) {
+	size_t entry = source[site].operand.u;
+	size_t end = source[entry - 1].operand.u - 2;
+	size_t start = map[site];
+
+	for (uint64_t slot = 0; slot < source[entry].operand.u; slot++) {
+		if (!sabr_inliner_needs_zero(source, entry, slot)) continue;
+		if (!vector_push_back(sabr_bcop_t, &bc->bcop_vec, sabr_new_bcop_with_value(SABR_OP_VALUE, (sabr_value_t) { .u = 0 }))) goto FAILURE;
+		if (!vector_push_back(sabr_bcop_t, &bc->bcop_vec, sabr_new_bcop_with_value(SABR_OP_STORE_LOCAL, (sabr_value_t) { .u = base + slot }))) goto FAILURE;
+	}
+
+	for (size_t i = entry + 1; i < end; i++) {
+		sabr_bcop_t bcop = source[i];
+		switch (bcop.oc) {
+			case SABR_OP_NONE:
+				continue;
+			case SABR_OP_LOAD_LOCAL:
+			case SABR_OP_STORE_LOCAL:
+			case SABR_OP_ADDR_LOCAL:
+				bcop.operand.u += base;
+				break;
+			default:
+				if (!sabr_opcode_has_index_operand(bcop.oc)) break;
+				if (bcop.operand.u > entry && bcop.operand.u <= end) bcop.operand.u = start + offsets[bcop.operand.u];
+				else if (bcop.operand.u <= size) bcop.operand.u = map[bcop.operand.u];
+				break;
+		}
+		if (!vector_push_back(sabr_bcop_t, &bc->bcop_vec, bcop)) goto FAILURE;
+	}
+	return true;
+
+FAILURE:
+	fputs(sabr_errmsg_alloc, stderr);
+	return false;
+}
\ No newline at end of file
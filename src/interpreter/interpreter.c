@@ -3,15 +3,30 @@
 
 extern inline sabr_value_t* sabr_memory_pool_top(sabr_memory_pool_t* pool);
 extern inline sabr_local_data_t* sabr_interpreter_get_local_data(sabr_interpreter_t* inter);
+extern inline bool sabr_interpreter_pop(sabr_interpreter_t* inter, sabr_value_t* v);
+extern inline bool sabr_interpreter_push(sabr_interpreter_t* inter, sabr_value_t v);
 
 bool sabr_interpreter_init(sabr_interpreter_t* inter) {
-    deque_init(sabr_value_t, &inter->data_stack);
+	inter->engine = SABR_ENGINE_THREADED;
+	inter->jit = SABR_JIT_OFF;
+	inter->jit_threshold = SABR_JIT_THRESHOLD;
+	inter->perf_map = false;
+
+    inter->data_stack.data = NULL;
+    inter->data_stack.size = 0;
+    inter->data_stack.capacity = 0;
     deque_init(sabr_value_t, &inter->switch_stack);
     deque_init(sabr_for_data_t, &inter->for_data_stack);
 	deque_init(sabr_local_data_t, &inter->local_data_stack);
+	inter->bc = NULL;
+	inter->frame = NULL;
+	inter->for_record = NULL;
     deque_init(sabr_cs_data_t, &inter->call_stack);
 
     rbt_init(sabr_def_data_t, &inter->global_words);
+	inter->globals = NULL;
+	inter->pair_counts = NULL;
+	inter->profile = NULL;
 
     vector_init(cctl_ptr(vector(sabr_value_t)), &inter->struct_vector);
     vector_init(cctl_ptr(vector(sabr_value_t)), &inter->array_vector);
@@ -20,11 +35,16 @@ bool sabr_interpreter_init(sabr_interpreter_t* inter) {
 }
 
 bool sabr_interpreter_del(sabr_interpreter_t* inter) {
-    deque_free(sabr_value_t, &inter->data_stack);
+    if (inter->data_stack.data) free(inter->data_stack.data - SABR_DATA_STACK_GUARD);
+    inter->data_stack.data = NULL;
     deque_free(sabr_value_t, &inter->switch_stack);
     deque_free(sabr_for_data_t, &inter->for_data_stack);
-	for (size_t i = 0; i < inter->local_data_stack.size; i++)
-		rbt_free(sabr_def_data_t, deque_at(sabr_local_data_t, &inter->local_data_stack, i)->local_words);
+	for (size_t i = 0; i < inter->local_data_stack.size; i++) {
+		rbt(sabr_def_data_t)* local_words = deque_at(sabr_local_data_t, &inter->local_data_stack, i)->local_words;
+		if (!local_words) continue;
+		rbt_free(sabr_def_data_t, local_words);
+		free(local_words);
+	}
 	deque_free(sabr_local_data_t, &inter->local_data_stack);
     deque_free(sabr_cs_data_t, &inter->call_stack);
 
@@ -47,14 +67,20 @@ bool sabr_interpreter_del(sabr_interpreter_t* inter) {
 	sabr_memory_pool_del(&inter->memory_pool);
 	sabr_memory_pool_del(&inter->global_memory_pool);
 
+	free(inter->pair_counts);
+	inter->pair_counts = NULL;
+	if (inter->profile) sabr_profile_del(inter->profile);
+	free(inter->profile);
+	inter->profile = NULL;
+
     return true;
 }
 
 sabr_bytecode_t* sabr_interpreter_load_bytecode(sabr_interpreter_t* inter, const char* filename) {
+#if defined(_WIN32)
 	FILE* file;
 	size_t size;
 
-#if defined(_WIN32)
 	wchar_t filename_windows[PATH_MAX] = {0, };
 	if (!sabr_convert_string_mbr2c16(filename, filename_windows, &(inter->convert_state))) {
 		fputs(sabr_errmsg_open, stderr);
@@ -65,13 +91,6 @@ sabr_bytecode_t* sabr_interpreter_load_bytecode(sabr_interpreter_t* inter, const
 		return NULL;
 	}
 	file = _wfopen(filename_windows, L"rb");
-#else
-	if (access(filename, R_OK)) {
-		fputs(sabr_errmsg_open, stderr);
-		return NULL;
-	}
-	file = fopen(filename, "rb");
-#endif
 
 	if (!file) {
 		fputs(sabr_errmsg_open, stderr);
@@ -98,49 +117,275 @@ sabr_bytecode_t* sabr_interpreter_load_bytecode(sabr_interpreter_t* inter, const
 		return NULL;
 	}
 
+	sabr_bytecode_t* bc = sabr_interpreter_load_bytecode_data(inter, code, size);
+	free(code);
+
+	return bc;
+#else
+	struct stat st;
+	int fd = open(filename, O_RDONLY);
+	if (fd < 0) {
+		fputs(sabr_errmsg_open, stderr);
+		return NULL;
+	}
+	if (fstat(fd, &st) || !S_ISREG(st.st_mode)) {
+		close(fd);
+		fputs(sabr_errmsg_open, stderr);
+		return NULL;
+	}
+
+	size_t size = st.st_size;
+	if (!size) {
+		close(fd);
+		fputs(sabr_errmsg_read, stderr);
+		return NULL;
+	}
+
+	uint8_t* code = (uint8_t*) mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (code == MAP_FAILED) {
+		fputs(sabr_errmsg_read, stderr);
+		return NULL;
+	}
+
+	bool compact = sabr_compact_is_compact(code, size);
 	sabr_bytecode_t* bc = (sabr_bytecode_t*) malloc(sizeof(sabr_bytecode_t));
-	if (!bc) {
-		free(code);
-		fputs(sabr_errmsg_alloc, stderr);
+	if (!bc) fputs(sabr_errmsg_alloc, stderr);
+	if (!bc || !(compact ? sabr_compact_check(code, size) : sabr_bytecode_check_image(code, size))) {
+		munmap(code, size);
+		free(bc);
 		return NULL;
 	}
 	sabr_bytecode_init(bc);
-
-	size_t index = 0;
-	while (index < size) {
-		sabr_bcop_t bcop;
-		bcop.oc = code[index++];
-		if (sabr_opcode_has_operand(bcop.oc)) {
-			for (size_t i = 0; i < 8; i++) bcop.operand.bytes[i] = code[index++];
-			sabr_bytecode_write_bcop_with_value(bc, bcop.oc, bcop.operand);
-		}
-		else sabr_bytecode_write_bcop(bc, bcop.oc);
+	if (compact) {
+		bc->compact = code;
+		bc->compact_size = size;
+	}
+	else {
+		bc->image = code;
+		bc->image_size = size;
 	}
+	bc->mapped = true;
+	return bc;
+#endif
+}
 
-	free(code);
+sabr_bytecode_t* sabr_interpreter_load_bytecode_data(sabr_interpreter_t* inter, const uint8_t* code, size_t size) {
+	bool compact = sabr_compact_is_compact(code, size);
+	if (!(compact ? sabr_compact_check(code, size) : sabr_bytecode_check_image(code, size))) return NULL;
 
+	sabr_bytecode_t* bc = (sabr_bytecode_t*) malloc(sizeof(sabr_bytecode_t));
+	uint8_t* copy = (uint8_t*) malloc(size);
+	if (!bc || !copy) {
+		fputs(sabr_errmsg_alloc, stderr);
+		free(bc);
+		free(copy);
+		return NULL;
+	}
+	memcpy(copy, code, size);
+	sabr_bytecode_init(bc);
+	if (compact) {
+		bc->compact = copy;
+		bc->compact_size = size;
+	}
+	else {
+		bc->image = copy;
+		bc->image_size = size;
+	}
 	return bc;
 }
 
 bool sabr_interpreter_run_bytecode(sabr_interpreter_t* inter, sabr_bytecode_t* bc) {
-	for (size_t index = 0; index < bc->bcop_vec.size; index++) {
-		sabr_bcop_t bcop = *vector_at(sabr_bcop_t, &bc->bcop_vec, index);
+	if (inter->engine == SABR_ENGINE_COMPACT && !inter->pair_counts && !inter->profile) {
+		if (!sabr_bytecode_expand(bc)) return false;
+		if (!bc->compact && !sabr_compact_encode(bc)) return false;
+		if (!sabr_interpreter_bind_globals(inter, bc)) return false;
+		inter->bc = bc;
+		return sabr_interpreter_run_bytecode_compact(inter, bc);
+	}
+	if (!sabr_compact_expand(bc)) return false;
+	if (!sabr_interpreter_bind_globals(inter, bc)) return false;
+	inter->bc = bc;
+	if (inter->pair_counts || inter->profile || inter->engine == SABR_ENGINE_CLASSIC) return sabr_interpreter_run_bytecode_classic(inter, bc);
+	if (!sabr_bytecode_expand(bc)) return false;
+	switch (inter->engine) {
+		case SABR_ENGINE_THREADED: return sabr_interpreter_run_bytecode_threaded(inter, bc);
+		case SABR_ENGINE_TOS: return sabr_interpreter_run_bytecode_tos(inter, bc);
+		case SABR_ENGINE_REGISTER: return sabr_interpreter_run_bytecode_register(inter, bc);
+		default: return sabr_interpreter_run_bytecode_classic(inter, bc);
+	}
+}
+
+bool sabr_interpreter_bind_globals(sabr_interpreter_t* inter, sabr_bytecode_t* bc) {
+	size_t count = 0;
+	sabr_bcop_t bcop;
+	for (size_t pos = sabr_compact_begin(bc); sabr_compact_next(bc, &pos, &bcop);) {
+		if (sabr_opcode_is_global(bcop.oc)) {
+			if (bcop.operand.u >= count) count = bcop.operand.u + 1;
+		}
+		else if (bcop.oc == SABR_OP_FOR_INIT) {
+			if (bcop.operand.u + SABR_OP_FOR_RECORD_SIZE > count) count = bcop.operand.u + SABR_OP_FOR_RECORD_SIZE;
+		}
+	}
+	if (!count) return true;
+
+	inter->globals = sabr_memory_pool_top(&inter->global_memory_pool);
+	if (!sabr_memory_pool_alloc(&inter->global_memory_pool, count)) {
+		inter->globals = NULL;
+		fputs(sabr_errmsg_alloc, stderr);
+		return false;
+	}
+	memset(inter->globals, 0, sizeof(sabr_value_t) * count);
+	if (!inter->local_data_stack.size) inter->frame = inter->globals;
+
+	for (size_t pos = sabr_compact_begin(bc); sabr_compact_next(bc, &pos, &bcop);) {
+		if (!sabr_opcode_is_global(bcop.oc)) continue;
+		if (rbt_find(sabr_def_data_t, &inter->global_words, bcop.operand.u)) continue;
+		sabr_def_data_t def_data;
+		def_data.data = (size_t) (inter->globals + bcop.operand.u);
+		def_data.dety = SABR_DETY_VARIABLE;
+		if (!rbt_insert(sabr_def_data_t, &inter->global_words, bcop.operand.u, def_data)) {
+			fputs(sabr_errmsg_alloc, stderr);
+			return false;
+		}
+	}
+	return true;
+}
+
+bool sabr_interpreter_run_bytecode_classic(sabr_interpreter_t* inter, sabr_bytecode_t* bc) {
+	sabr_opcode_t prev_oc = SABR_OP_NONE;
+	if (!bc->ocs && !sabr_bytecode_split(bc)) return false;
+	size_t size = bc->ocs_size;
+	const uint8_t* ocs = bc->ocs;
+	const uint32_t* operand_indices = bc->operand_indices;
+	const sabr_value_t* operands = bc->operands;
+	for (size_t index = 0; index < size; index++) {
+		sabr_bcop_t bcop;
+		bcop.oc = ocs[index];
 		if (bcop.oc == SABR_OP_NONE) continue;
-		uint32_t result = sabr_interpreter_op_functions[bcop.oc - 1](inter, bcop, &index);
+		bcop.operand = operands[operand_indices[index]];
+		if (inter->pair_counts) {
+			if (prev_oc != SABR_OP_NONE) inter->pair_counts[prev_oc * sabr_opcode_names_len + bcop.oc]++;
+			prev_oc = bcop.oc;
+		}
+		size_t current = index;
+		if (inter->profile) inter->profile->counts[index]++;
+		uint32_t result = (bcop.oc == SABR_OP_SWITCH_TABLE || bcop.oc == SABR_OP_SWITCH_SEARCH)
+			? sabr_interpreter_split_switch(inter, bcop, &index)
+			: sabr_interpreter_op_functions[bcop.oc - 1](inter, bcop, &index);
 		if (result) {
 			fprintf(stderr, "result: %u, index: %zu\n", result, index);
 			return false;
 		};
+		if (inter->profile && index != current && index + 1 <= size) {
+			if (!sabr_profile_add_edge(inter->profile, current, index + 1, 1)) return false;
+		}
 	}
 	return true;
 }
 
+uint32_t sabr_interpreter_split_switch(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index) {
+	size_t size = inter->bc->ocs_size;
+	size_t table = bcop.operand.u;
+	const sabr_value_t* operands = inter->bc->operands;
+	const uint32_t* members = inter->bc->operand_indices + table;
+	sabr_value_t v;
+
+	if (bcop.oc == SABR_OP_SWITCH_TABLE) {
+		if (table >= size || size - table < 3) return SABR_OPERR_SWITCH;
+		if (!sabr_interpreter_pop(inter, &v)) return SABR_OPERR_STACK;
+		uint64_t slot = v.u - operands[members[0]].u;
+		size_t entry = (slot < operands[members[1]].u) ? slot + 3 : 2;
+		if (entry >= size - table) return SABR_OPERR_SWITCH;
+		*index = operands[members[entry]].u - 1;
+		return SABR_OPERR_NONE;
+	}
+
+	if (table >= size || size - table < 2) return SABR_OPERR_SWITCH;
+	size_t count = operands[members[0]].u;
+	if (count > (size - table - 2) / 2) return SABR_OPERR_SWITCH;
+	if (!sabr_interpreter_pop(inter, &v)) return SABR_OPERR_STACK;
+	size_t low = 0, high = count;
+	while (low < high) {
+		size_t mid = low + (high - low) / 2;
+		if (operands[members[mid * 2 + 2]].i < v.i) low = mid + 1;
+		else high = mid;
+	}
+	*index = operands[members[(low < count && operands[members[low * 2 + 2]].u == v.u) ? low * 2 + 3 : 1]].u - 1;
+	return SABR_OPERR_NONE;
+}
+
 bool sabr_interpreter_memory_pool_init(sabr_interpreter_t* inter, size_t size, size_t global_size) {
 	if (!sabr_memory_pool_init(&inter->memory_pool, size)) return false;
 	if (!sabr_memory_pool_init(&inter->global_memory_pool, global_size)) return false;
 	return true;
 }
 
+bool sabr_interpreter_data_stack_init(sabr_interpreter_t* inter, size_t size) {
+	sabr_value_t* data = (sabr_value_t*) calloc(size + SABR_DATA_STACK_GUARD, sizeof(sabr_value_t));
+	inter->data_stack.data = data ? data + SABR_DATA_STACK_GUARD : NULL;
+	inter->data_stack.size = 0;
+	inter->data_stack.capacity = size;
+	if (inter->data_stack.data) return true;
+	inter->data_stack.capacity = 0;
+	return false;
+}
+
+bool sabr_interpreter_pair_counts_init(sabr_interpreter_t* inter) {
+	inter->pair_counts = (uint64_t*) calloc(sabr_opcode_names_len * sabr_opcode_names_len, sizeof(uint64_t));
+	return inter->pair_counts != NULL;
+}
+
+bool sabr_interpreter_profile_init(sabr_interpreter_t* inter, sabr_bytecode_t* bc) {
+	if (!sabr_compact_expand(bc) || !sabr_bytecode_expand(bc)) return false;
+	inter->profile = (sabr_profile_t*) malloc(sizeof(sabr_profile_t));
+	if (!inter->profile) {
+		fputs(sabr_errmsg_alloc, stderr);
+		return false;
+	}
+	if (sabr_profile_init(inter->profile, bc->bcop_vec.size, sabr_profile_checksum(bc))) return true;
+	free(inter->profile);
+	inter->profile = NULL;
+	return false;
+}
+
+void sabr_interpreter_print_pair_counts(sabr_interpreter_t* inter, size_t limit) {
+	size_t size = sabr_opcode_names_len * sabr_opcode_names_len;
+	size_t count = 0;
+	sabr_pair_count_t* pairs = NULL;
+
+	if (!inter->pair_counts) return;
+	pairs = (sabr_pair_count_t*) malloc(sizeof(sabr_pair_count_t) * size);
+	if (!pairs) {
+		fputs(sabr_errmsg_alloc, stderr);
+		return;
+	}
+
+	for (size_t i = 0; i < size; i++) {
+		if (!inter->pair_counts[i]) continue;
+		pairs[count].pair = i;
+		pairs[count].count = inter->pair_counts[i];
+		count++;
+	}
+	qsort(pairs, count, sizeof(sabr_pair_count_t), sabr_interpreter_pair_count_compare);
+
+	for (size_t i = 0; i < count && i < limit; i++) {
+		fprintf(
+			stderr, "%-20s %-20s %" PRIu64 "\n",
+			sabr_opcode_names[pairs[i].pair / sabr_opcode_names_len],
+			sabr_opcode_names[pairs[i].pair % sabr_opcode_names_len],
+			pairs[i].count
+		);
+	}
+	free(pairs);
+}
+
+int sabr_interpreter_pair_count_compare(const void* a, const void* b) {
+	uint64_t x = ((const sabr_pair_count_t*) a)->count;
+	uint64_t y = ((const sabr_pair_count_t*) b)->count;
+	return (x < y) - (x > y);
+}
+
 bool sabr_memory_pool_init(sabr_memory_pool_t* pool, size_t size) {
 	pool->data = (sabr_value_t*) malloc(sizeof(size_t) * size);
 	pool->size = size;
@@ -161,27 +406,17 @@ bool sabr_memory_pool_alloc(sabr_memory_pool_t* pool, size_t size) {
 }
 
 bool sabr_memory_pool_free(sabr_memory_pool_t* pool, size_t size) {
-	if ((pool->index - size) && (pool->index - size < pool->index)) return false;
+	if (size > pool->index) return false;
 	pool->index -= size;
 	return true;
 }
 
-bool sabr_interpreter_pop(sabr_interpreter_t* inter, sabr_value_t* v) {
-	if (!inter->data_stack.size) {
-		fputs(sabr_errmsg_stackunderflow, stderr);
-		return false;
-	}
-	*v = *deque_back(sabr_value_t, &inter->data_stack);
-	deque_pop_back(sabr_value_t, &inter->data_stack);
-	return true;
+void sabr_interpreter_stack_underflow(void) {
+	fputs(sabr_errmsg_stackunderflow, stderr);
 }
 
-bool sabr_interpreter_push(sabr_interpreter_t* inter, sabr_value_t v) {
-	if (!deque_push_back(sabr_value_t, &inter->data_stack, v)) {
-		fputs(sabr_errmsg_alloc, stderr);
-		return false;
-	}
-	return true;
+void sabr_interpreter_stack_overflow(void) {
+	fputs(sabr_errmsg_stackoverflow, stderr);
 }
 
 uint32_t sabr_interpreter_exec_identifier(sabr_interpreter_t* inter, sabr_value_t identifier, size_t* index) {
@@ -193,10 +428,8 @@ uint32_t sabr_interpreter_exec_identifier(sabr_interpreter_t* inter, sabr_value_
 	rbt(sabr_def_data_t)* local_words = NULL;
 	def_data = rbt_find(sabr_def_data_t, &inter->global_words, identifier.u);
 	if (!def_data) {
-		if (inter->local_data_stack.size > 0) {
-			local_words = sabr_interpreter_get_local_data(inter)->local_words;
-			def_data = rbt_find(sabr_def_data_t, local_words, identifier.u);
-		}
+		local_words = sabr_interpreter_get_local_words(inter, false);
+		if (local_words) def_data = rbt_find(sabr_def_data_t, local_words, identifier.u);
 	}
 	if (!def_data) return SABR_OPERR_UNDEFINED;
 
@@ -238,7 +471,8 @@ uint32_t sabr_interpreter_set_variable(sabr_interpreter_t* inter, sabr_value_t i
 	def_data = rbt_find(sabr_def_data_t, &inter->global_words, identifier.u);
 	if (!def_data) {
 		if (inter->local_data_stack.size > 0) {
-			words = sabr_interpreter_get_local_data(inter)->local_words;
+			words = sabr_interpreter_get_local_words(inter, true);
+			if (!words) return SABR_OPERR_MEMORY;
 			def_data = rbt_find(sabr_def_data_t, words, identifier.u);
 		}
 		else {
@@ -284,7 +518,8 @@ uint32_t sabr_interpreter_ref_variable(sabr_interpreter_t* inter, sabr_value_t i
 	def_data = rbt_find(sabr_def_data_t, &inter->global_words, identifier.u);
 	if (!def_data) {
 		if (inter->local_data_stack.size > 0) {
-			words = sabr_interpreter_get_local_data(inter)->local_words;
+			words = sabr_interpreter_get_local_words(inter, true);
+			if (!words) return SABR_OPERR_MEMORY;
 			def_data = rbt_find(sabr_def_data_t, words, identifier.u);
 		}
 		else {
@@ -309,15 +544,25 @@ sabr_value_t* sabr_interpreter_get_variable_addr(sabr_interpreter_t* inter, sabr
 	sabr_def_data_t* def_data = NULL;
 	def_data = rbt_find(sabr_def_data_t, &inter->global_words, identifier.u);
 	if (!def_data) {
-		if (inter->local_data_stack.size > 0) {
-			words = sabr_interpreter_get_local_data(inter)->local_words;
-			def_data = rbt_find(sabr_def_data_t, words, identifier.u);
-		}
-		else {
-			words = &inter->global_words;
-		}
+		words = sabr_interpreter_get_local_words(inter, false);
+		if (words) def_data = rbt_find(sabr_def_data_t, words, identifier.u);
 	}
 	if (!def_data) return NULL;
 	if (def_data->dety != SABR_DETY_VARIABLE) return NULL;
 	return (sabr_value_t*) def_data->data;
+}
+
+rbt(sabr_def_data_t)* sabr_interpreter_get_local_words(sabr_interpreter_t* inter, bool create) {
+	if (!inter->local_data_stack.size) return NULL;
+	sabr_local_data_t* local_data = sabr_interpreter_get_local_data(inter);
+	if (local_data->local_words || !create) return local_data->local_words;
+
+	rbt(sabr_def_data_t)* local_words = (rbt(sabr_def_data_t)*) malloc(sizeof(rbt(sabr_def_data_t)));
+	if (!local_words) return NULL;
+	if (!rbt_init(sabr_def_data_t, local_words)) {
+		free(local_words);
+		return NULL;
+	}
+	local_data->local_words = (void*) local_words;
+	return local_words;
 }
\ No newline at end of file
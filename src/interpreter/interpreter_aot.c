@@ -0,0 +1,24 @@
+#include "interpreter_aot.h"
+
+int sabr_interpreter_aot_main(const uint8_t* image, size_t size, sabr_aot_program_t program, size_t memory_pool_size, size_t data_stack_size) {
+	int result = 1;
+	sabr_interpreter_t inter;
+	sabr_bytecode_t* bc = NULL;
+
+	if (!sabr_interpreter_init(&inter)) return result;
+	if (!sabr_interpreter_memory_pool_init(&inter, memory_pool_size, memory_pool_size)) goto FREE_ALL;
+	if (!sabr_interpreter_data_stack_init(&inter, data_stack_size)) goto FREE_ALL;
+	bc = sabr_interpreter_load_bytecode_data(&inter, image, size);
+	if (!bc) goto FREE_ALL;
+	if (!sabr_compact_expand(bc) || !sabr_bytecode_expand(bc)) goto FREE_ALL;
+	if (!sabr_interpreter_bind_globals(&inter, bc)) goto FREE_ALL;
+	inter.bc = bc;
+	program(&inter, bc);
+	result = 0;
+
+FREE_ALL:
+	if (!sabr_interpreter_del(&inter)) result = 1;
+	sabr_bytecode_free(bc);
+	free(bc);
+	return result;
+}
\ No newline at end of file
@@ -7,4 +7,5 @@ deque_imp_c(size_t);
 deque_imp_c(sabr_for_data_t);
 deque_imp_c(sabr_cs_data_t);
 deque_imp_c(sabr_local_data_t);
-vector_imp_c(cctl_ptr(vector(sabr_value_t)));
\ No newline at end of file
+vector_imp_c(cctl_ptr(vector(sabr_value_t)));
+vector_imp_c(sabr_block_data_t);
\ No newline at end of file
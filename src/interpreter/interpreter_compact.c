@@ -0,0 +1,464 @@
+#include "interpreter_threaded.h"
+
+#if defined(SABR_THREADED_COMPUTED_GOTO)
+	#define SABR_COMPACT_DISPATCH() do { if (sabr_threaded_unlikely(ip >= end)) goto DONE; goto *table[*ip]; } while (0)
+#else
+	#define SABR_COMPACT_DISPATCH() goto DISPATCH
+#endif
+
+#define SABR_COMPACT_NONE() (next = ip + 1)
+#define SABR_COMPACT_INDEX() (next = sabr_compact_operand(ip + 1, &operand.u))
+#define SABR_COMPACT_VALUE() (next = sabr_compact_operand(ip + 1, &operand.u), operand.u = sabr_compact_unzigzag(operand.u))
+
+#define SABR_COMPACT_NEED(N) do { if (sabr_threaded_unlikely(sp - base < (N))) goto UNDERFLOW; } while (0)
+#define SABR_COMPACT_ROOM(N) do { if (sabr_threaded_unlikely(limit - sp < (N))) goto OVERFLOW; } while (0)
+
+#define SABR_COMPACT_NEXT() do { ip = next; SABR_COMPACT_DISPATCH(); } while (0)
+#define SABR_COMPACT_JUMP(TARGET) do { ip = code + (TARGET); SABR_COMPACT_DISPATCH(); } while (0)
+#define SABR_COMPACT_FAIL(ERRCODE) do { result = (ERRCODE); goto FAILURE; } while (0)
+
+#define SABR_COMPACT_PUSH(DECODE, V) \
+	SABR_COMPACT_##DECODE(); \
+	SABR_COMPACT_ROOM(1); \
+	*sp++ = (V); \
+	SABR_COMPACT_NEXT()
+
+#define SABR_COMPACT_SLOT(DECODE, NEED, EXPR) \
+	SABR_COMPACT_##DECODE(); \
+	SABR_COMPACT_NEED(NEED); \
+	EXPR; \
+	SABR_COMPACT_NEXT()
+
+#define SABR_COMPACT_UNARY(DECODE, EXPR) { \
+	SABR_COMPACT_##DECODE(); \
+	SABR_COMPACT_NEED(1); \
+	sabr_value_t a = sp[-1]; \
+	EXPR; \
+	sp[-1] = a; \
+} SABR_COMPACT_NEXT()
+
+#define SABR_COMPACT_BINARY(EXPR) { \
+	SABR_COMPACT_NONE(); \
+	SABR_COMPACT_NEED(2); \
+	sabr_value_t a = sp[-2]; \
+	sabr_value_t b = sp[-1]; \
+	EXPR; \
+	sp[-2] = a; \
+	sp--; \
+} SABR_COMPACT_NEXT()
+
+#define SABR_COMPACT_DIVISION(CHECK, EXPR) { \
+	SABR_COMPACT_NONE(); \
+	SABR_COMPACT_NEED(2); \
+	sabr_value_t a = sp[-2]; \
+	sabr_value_t b = sp[-1]; \
+	if (sabr_threaded_unlikely(CHECK)) SABR_COMPACT_FAIL(SABR_OPERR_DIV_BY_ZERO); \
+	EXPR; \
+	sp[-2] = a; \
+	sp--; \
+} SABR_COMPACT_NEXT()
+
+#define SABR_COMPACT_BRANCH(COND) { \
+	SABR_COMPACT_INDEX(); \
+	SABR_COMPACT_NEED(2); \
+	sabr_value_t a = sp[-2]; \
+	sabr_value_t b = sp[-1]; \
+	sp -= 2; \
+	if (!(COND)) SABR_COMPACT_JUMP(operand.u); \
+} SABR_COMPACT_NEXT()
+
+#define SABR_COMPACT_MEMORY_UNARY(EXPR) { \
+	SABR_COMPACT_NONE(); \
+	SABR_COMPACT_NEED(1); \
+	sabr_value_t a = { .u = *sp[-1].p }; \
+	EXPR; \
+	*sp[-1].p = a.u; \
+	sp--; \
+} SABR_COMPACT_NEXT()
+
+#define SABR_COMPACT_MEMORY_BINARY(EXPR) { \
+	SABR_COMPACT_NONE(); \
+	SABR_COMPACT_NEED(2); \
+	sabr_value_t a = { .u = *sp[-1].p }; \
+	sabr_value_t b = sp[-2]; \
+	EXPR; \
+	*sp[-1].p = a.u; \
+	sp -= 2; \
+} SABR_COMPACT_NEXT()
+
+#define SABR_COMPACT_MEMORY_DIVISION(CHECK, EXPR) { \
+	SABR_COMPACT_NONE(); \
+	SABR_COMPACT_NEED(2); \
+	sabr_value_t a = { .u = *sp[-1].p }; \
+	sabr_value_t b = sp[-2]; \
+	if (sabr_threaded_unlikely(CHECK)) SABR_COMPACT_FAIL(SABR_OPERR_DIV_BY_ZERO); \
+	EXPR; \
+	*sp[-1].p = a.u; \
+	sp -= 2; \
+} SABR_COMPACT_NEXT()
+
+#define SABR_COMPACT_FOR(FIELD, COND) { \
+	SABR_COMPACT_INDEX(); \
+	sabr_for_record_t* record = inter->for_record; \
+	if (sabr_threaded_unlikely(!record)) SABR_COMPACT_FAIL(SABR_OPERR_FOR); \
+	sabr_value_t* v = record->variable; \
+	v->FIELD += record->step.FIELD; \
+	if (COND) SABR_COMPACT_JUMP(operand.u); \
+	v->FIELD -= record->step.FIELD; \
+} SABR_COMPACT_NEXT()
+
+bool sabr_interpreter_run_bytecode_compact(sabr_interpreter_t* inter, sabr_bytecode_t* bc) {
+	bool succeed = false;
+	uint32_t result = SABR_OPERR_NONE;
+	uint8_t kinds[256];
+
+	const uint8_t* code = bc->compact;
+	const uint8_t* end = code + bc->compact_size;
+	const uint8_t* ip = code + SABR_COMPACT_HEADER_SIZE;
+	const uint8_t* next = ip;
+	sabr_value_t operand;
+
+	sabr_value_t* base = inter->data_stack.data;
+	sabr_value_t* sp = base + inter->data_stack.size;
+	sabr_value_t* limit = base + inter->data_stack.capacity;
+
+#if defined(SABR_THREADED_COMPUTED_GOTO)
+	static const void* labels[] = { SABR_THREADED_BIND_ALL };
+	size_t labels_len = sizeof(labels) / sizeof(void*);
+	const void* table[256];
+	for (size_t i = 0; i < 256; i++) table[i] = SABR_THREADED_LABEL(i);
+#endif
+
+	sabr_compact_kinds(kinds);
+	SABR_COMPACT_DISPATCH();
+
+#if !defined(SABR_THREADED_COMPUTED_GOTO)
+DISPATCH:
+	if (ip >= end) goto DONE;
+	switch (*ip) {
+#endif
+
+	SABR_THREADED_CASE(SABR_OP_NONE):
+		SABR_COMPACT_NONE();
+		SABR_COMPACT_NEXT();
+
+	SABR_THREADED_CASE(SABR_OP_EXIT):
+		goto DONE;
+
+	SABR_THREADED_CASE(SABR_OP_VALUE): SABR_COMPACT_PUSH(VALUE, operand);
+
+	SABR_THREADED_CASE(SABR_OP_IF):
+		SABR_COMPACT_INDEX();
+		SABR_COMPACT_NEED(1);
+		sp--;
+		if (!sp->u) SABR_COMPACT_JUMP(operand.u);
+		SABR_COMPACT_NEXT();
+
+	SABR_THREADED_CASE(SABR_OP_JUMP):
+		SABR_COMPACT_INDEX();
+		SABR_COMPACT_JUMP(operand.u);
+
+	SABR_THREADED_CASE(SABR_OP_FOR_LOOP_I): SABR_COMPACT_FOR(i, (record->step.i > 0) ? v->i < record->end.i : v->i > record->end.i);
+	SABR_THREADED_CASE(SABR_OP_FOR_LOOP_U): SABR_COMPACT_FOR(u, (record->step.u > 0) ? v->u < record->end.u : v->u > record->end.u);
+	SABR_THREADED_CASE(SABR_OP_FOR_LOOP_F): SABR_COMPACT_FOR(f, (record->step.f > 0.0) ? v->f < record->end.f : v->f > record->end.f);
+	SABR_THREADED_CASE(SABR_OP_FOR_UP_I): SABR_COMPACT_FOR(i, v->i < record->end.i);
+	SABR_THREADED_CASE(SABR_OP_FOR_UP_U): SABR_COMPACT_FOR(u, v->u < record->end.u);
+	SABR_THREADED_CASE(SABR_OP_FOR_UP_F): SABR_COMPACT_FOR(f, v->f < record->end.f);
+	SABR_THREADED_CASE(SABR_OP_FOR_DOWN_I): SABR_COMPACT_FOR(i, v->i > record->end.i);
+	SABR_THREADED_CASE(SABR_OP_FOR_DOWN_U): SABR_COMPACT_FOR(u, v->u > record->end.u);
+	SABR_THREADED_CASE(SABR_OP_FOR_DOWN_F): SABR_COMPACT_FOR(f, v->f > record->end.f);
+
+	SABR_THREADED_CASE(SABR_OP_CASE_IF): {
+		SABR_COMPACT_INDEX();
+		sabr_value_t* switch_value = deque_back(sabr_value_t, &inter->switch_stack);
+		if (sabr_threaded_unlikely(!switch_value)) SABR_COMPACT_FAIL(SABR_OPERR_SWITCH);
+		SABR_COMPACT_NEED(1);
+		sp--;
+		if (switch_value->u != sp->u) SABR_COMPACT_JUMP(operand.u);
+	} SABR_COMPACT_NEXT();
+
+	SABR_THREADED_CASE(SABR_OP_SWITCH_TABLE):
+	SABR_THREADED_CASE(SABR_OP_SWITCH_SEARCH):
+		goto GENERIC;
+
+	SABR_THREADED_CASE(SABR_OP_RETURN): {
+		SABR_COMPACT_NONE();
+		if (sabr_threaded_unlikely(!inter->call_stack.size)) SABR_COMPACT_FAIL(SABR_OPERR_EXEC);
+		size_t pos = deque_back(sabr_cs_data_t, &inter->call_stack)->pos;
+		deque_pop_back(sabr_cs_data_t, &inter->call_stack);
+		SABR_COMPACT_JUMP(pos);
+	}
+
+	SABR_THREADED_CASE(SABR_OP_CALL): {
+		SABR_COMPACT_INDEX();
+		sabr_cs_data_t csd;
+		csd.pos = next - code;
+		if (sabr_threaded_unlikely(!deque_push_back(sabr_cs_data_t, &inter->call_stack, csd))) SABR_COMPACT_FAIL(SABR_OPERR_WHAT);
+		SABR_COMPACT_JUMP(operand.u);
+	}
+
+	SABR_THREADED_CASE(SABR_OP_LOAD_LOCAL): SABR_COMPACT_PUSH(VALUE, inter->frame[operand.u]);
+	SABR_THREADED_CASE(SABR_OP_STORE_LOCAL): SABR_COMPACT_SLOT(VALUE, 1, inter->frame[operand.u] = *--sp);
+	SABR_THREADED_CASE(SABR_OP_ADDR_LOCAL): SABR_COMPACT_PUSH(VALUE, (sabr_value_t) { .p = (uint64_t*) (inter->frame + operand.u) });
+	SABR_THREADED_CASE(SABR_OP_INC_LOCAL): SABR_COMPACT_SLOT(VALUE, 0, inter->frame[operand.u].i++);
+	SABR_THREADED_CASE(SABR_OP_DEC_LOCAL): SABR_COMPACT_SLOT(VALUE, 0, inter->frame[operand.u].i--);
+	SABR_THREADED_CASE(SABR_OP_ADD_LOCAL): SABR_COMPACT_SLOT(VALUE, 1, inter->frame[operand.u].i += (--sp)->i);
+	SABR_THREADED_CASE(SABR_OP_FADD_LOCAL): SABR_COMPACT_SLOT(VALUE, 1, inter->frame[operand.u].f += (--sp)->f);
+
+	SABR_THREADED_CASE(SABR_OP_LOAD_GLOBAL): SABR_COMPACT_PUSH(VALUE, inter->globals[operand.u]);
+	SABR_THREADED_CASE(SABR_OP_STORE_GLOBAL): SABR_COMPACT_SLOT(VALUE, 1, inter->globals[operand.u] = *--sp);
+	SABR_THREADED_CASE(SABR_OP_ADDR_GLOBAL): SABR_COMPACT_PUSH(VALUE, (sabr_value_t) { .p = (uint64_t*) (inter->globals + operand.u) });
+	SABR_THREADED_CASE(SABR_OP_INC_GLOBAL): SABR_COMPACT_SLOT(VALUE, 0, inter->globals[operand.u].i++);
+	SABR_THREADED_CASE(SABR_OP_DEC_GLOBAL): SABR_COMPACT_SLOT(VALUE, 0, inter->globals[operand.u].i--);
+	SABR_THREADED_CASE(SABR_OP_ADD_GLOBAL): SABR_COMPACT_SLOT(VALUE, 1, inter->globals[operand.u].i += (--sp)->i);
+	SABR_THREADED_CASE(SABR_OP_FADD_GLOBAL): SABR_COMPACT_SLOT(VALUE, 1, inter->globals[operand.u].f += (--sp)->f);
+
+	SABR_THREADED_CASE(SABR_OP_ADD): SABR_COMPACT_BINARY(a.i = a.i + b.i);
+	SABR_THREADED_CASE(SABR_OP_SUB): SABR_COMPACT_BINARY(a.i = a.i - b.i);
+	SABR_THREADED_CASE(SABR_OP_MUL): SABR_COMPACT_BINARY(a.i = a.i * b.i);
+	SABR_THREADED_CASE(SABR_OP_DIV): SABR_COMPACT_DIVISION(b.i == 0, a.i = a.i / b.i);
+	SABR_THREADED_CASE(SABR_OP_MOD): SABR_COMPACT_DIVISION(b.i == 0, a.i = a.i % b.i);
+	SABR_THREADED_CASE(SABR_OP_UDIV): SABR_COMPACT_DIVISION(b.u == 0, a.u = a.u / b.u);
+	SABR_THREADED_CASE(SABR_OP_UMOD): SABR_COMPACT_DIVISION(b.u == 0, a.u = a.u % b.u);
+	SABR_THREADED_CASE(SABR_OP_NEG): SABR_COMPACT_UNARY(NONE, a.i = -a.i);
+	SABR_THREADED_CASE(SABR_OP_INC): SABR_COMPACT_UNARY(NONE, a.i++);
+	SABR_THREADED_CASE(SABR_OP_DEC): SABR_COMPACT_UNARY(NONE, a.i--);
+	SABR_THREADED_CASE(SABR_OP_ADD_IMM): SABR_COMPACT_UNARY(VALUE, a.i = a.i + operand.i);
+	SABR_THREADED_CASE(SABR_OP_MUL_IMM): SABR_COMPACT_UNARY(VALUE, a.i = a.i * operand.i);
+
+	SABR_THREADED_CASE(SABR_OP_EQU): SABR_COMPACT_BINARY(a.u = (a.i == b.i) ? -1 : 0);
+	SABR_THREADED_CASE(SABR_OP_NEQ): SABR_COMPACT_BINARY(a.u = (a.i != b.i) ? -1 : 0);
+	SABR_THREADED_CASE(SABR_OP_GRT): SABR_COMPACT_BINARY(a.u = (a.i > b.i) ? -1 : 0);
+	SABR_THREADED_CASE(SABR_OP_GEQ): SABR_COMPACT_BINARY(a.u = (a.i >= b.i) ? -1 : 0);
+	SABR_THREADED_CASE(SABR_OP_LST): SABR_COMPACT_BINARY(a.u = (a.i < b.i) ? -1 : 0);
+	SABR_THREADED_CASE(SABR_OP_LEQ): SABR_COMPACT_BINARY(a.u = (a.i <= b.i) ? -1 : 0);
+	SABR_THREADED_CASE(SABR_OP_UGRT): SABR_COMPACT_BINARY(a.u = (a.u > b.u) ? -1 : 0);
+	SABR_THREADED_CASE(SABR_OP_UGEQ): SABR_COMPACT_BINARY(a.u = (a.u >= b.u) ? -1 : 0);
+	SABR_THREADED_CASE(SABR_OP_ULST): SABR_COMPACT_BINARY(a.u = (a.u < b.u) ? -1 : 0);
+	SABR_THREADED_CASE(SABR_OP_ULEQ): SABR_COMPACT_BINARY(a.u = (a.u <= b.u) ? -1 : 0);
+
+	SABR_THREADED_CASE(SABR_OP_LST_IF): SABR_COMPACT_BRANCH(a.i < b.i);
+	SABR_THREADED_CASE(SABR_OP_EQU_IF): SABR_COMPACT_BRANCH(a.i == b.i);
+	SABR_THREADED_CASE(SABR_OP_NEQ_IF): SABR_COMPACT_BRANCH(a.i != b.i);
+	SABR_THREADED_CASE(SABR_OP_GRT_IF): SABR_COMPACT_BRANCH(a.i > b.i);
+	SABR_THREADED_CASE(SABR_OP_GEQ_IF): SABR_COMPACT_BRANCH(a.i >= b.i);
+	SABR_THREADED_CASE(SABR_OP_LEQ_IF): SABR_COMPACT_BRANCH(a.i <= b.i);
+	SABR_THREADED_CASE(SABR_OP_UGRT_IF): SABR_COMPACT_BRANCH(a.u > b.u);
+	SABR_THREADED_CASE(SABR_OP_UGEQ_IF): SABR_COMPACT_BRANCH(a.u >= b.u);
+	SABR_THREADED_CASE(SABR_OP_ULST_IF): SABR_COMPACT_BRANCH(a.u < b.u);
+	SABR_THREADED_CASE(SABR_OP_ULEQ_IF): SABR_COMPACT_BRANCH(a.u <= b.u);
+
+	SABR_THREADED_CASE(SABR_OP_EQU_IMM): SABR_COMPACT_UNARY(VALUE, a.u = (a.i == operand.i) ? -1 : 0);
+	SABR_THREADED_CASE(SABR_OP_NEQ_IMM): SABR_COMPACT_UNARY(VALUE, a.u = (a.i != operand.i) ? -1 : 0);
+	SABR_THREADED_CASE(SABR_OP_GRT_IMM): SABR_COMPACT_UNARY(VALUE, a.u = (a.i > operand.i) ? -1 : 0);
+	SABR_THREADED_CASE(SABR_OP_GEQ_IMM): SABR_COMPACT_UNARY(VALUE, a.u = (a.i >= operand.i) ? -1 : 0);
+	SABR_THREADED_CASE(SABR_OP_LST_IMM): SABR_COMPACT_UNARY(VALUE, a.u = (a.i < operand.i) ? -1 : 0);
+	SABR_THREADED_CASE(SABR_OP_LEQ_IMM): SABR_COMPACT_UNARY(VALUE, a.u = (a.i <= operand.i) ? -1 : 0);
+
+	SABR_THREADED_CASE(SABR_OP_FADD): SABR_COMPACT_BINARY(a.f = a.f + b.f);
+	SABR_THREADED_CASE(SABR_OP_FSUB): SABR_COMPACT_BINARY(a.f = a.f - b.f);
+	SABR_THREADED_CASE(SABR_OP_FMUL): SABR_COMPACT_BINARY(a.f = a.f * b.f);
+	SABR_THREADED_CASE(SABR_OP_FDIV): SABR_COMPACT_DIVISION(b.f == 0.0f, a.f = a.f / b.f);
+	SABR_THREADED_CASE(SABR_OP_FMOD): SABR_COMPACT_DIVISION(b.f == 0.0f, a.f = fmod(a.f, b.f));
+	SABR_THREADED_CASE(SABR_OP_FNEG): SABR_COMPACT_UNARY(NONE, a.f = -a.f);
+
+	SABR_THREADED_CASE(SABR_OP_FEQU): SABR_COMPACT_BINARY(a.u = (a.f == b.f) ? -1 : 0);
+	SABR_THREADED_CASE(SABR_OP_FNEQ): SABR_COMPACT_BINARY(a.u = (a.f != b.f) ? -1 : 0);
+	SABR_THREADED_CASE(SABR_OP_FGRT): SABR_COMPACT_BINARY(a.u = (a.f > b.f) ? -1 : 0);
+	SABR_THREADED_CASE(SABR_OP_FGEQ): SABR_COMPACT_BINARY(a.u = (a.f >= b.f) ? -1 : 0);
+	SABR_THREADED_CASE(SABR_OP_FLST): SABR_COMPACT_BINARY(a.u = (a.f < b.f) ? -1 : 0);
+	SABR_THREADED_CASE(SABR_OP_FLEQ): SABR_COMPACT_BINARY(a.u = (a.f <= b.f) ? -1 : 0);
+	SABR_THREADED_CASE(SABR_OP_FEQU_IF): SABR_COMPACT_BRANCH(a.f == b.f);
+	SABR_THREADED_CASE(SABR_OP_FNEQ_IF): SABR_COMPACT_BRANCH(a.f != b.f);
+	SABR_THREADED_CASE(SABR_OP_FGRT_IF): SABR_COMPACT_BRANCH(a.f > b.f);
+	SABR_THREADED_CASE(SABR_OP_FGEQ_IF): SABR_COMPACT_BRANCH(a.f >= b.f);
+	SABR_THREADED_CASE(SABR_OP_FLST_IF): SABR_COMPACT_BRANCH(a.f < b.f);
+	SABR_THREADED_CASE(SABR_OP_FLEQ_IF): SABR_COMPACT_BRANCH(a.f <= b.f);
+
+	SABR_THREADED_CASE(SABR_OP_BAND): SABR_COMPACT_BINARY(a.u = a.u & b.u);
+	SABR_THREADED_CASE(SABR_OP_BOR): SABR_COMPACT_BINARY(a.u = a.u | b.u);
+	SABR_THREADED_CASE(SABR_OP_BXOR): SABR_COMPACT_BINARY(a.u = a.u ^ b.u);
+	SABR_THREADED_CASE(SABR_OP_BNOT): SABR_COMPACT_UNARY(NONE, a.u = ~a.u);
+	SABR_THREADED_CASE(SABR_OP_BLSFT): SABR_COMPACT_BINARY(a.u = a.u << b.u);
+	SABR_THREADED_CASE(SABR_OP_BRSFT): SABR_COMPACT_BINARY(a.u = a.u >> b.u);
+	SABR_THREADED_CASE(SABR_OP_BAND_IMM): SABR_COMPACT_UNARY(VALUE, a.u = a.u & operand.u);
+	SABR_THREADED_CASE(SABR_OP_BLSFT_IMM): SABR_COMPACT_UNARY(VALUE, a.u = a.u << operand.u);
+	SABR_THREADED_CASE(SABR_OP_BRSFT_IMM): SABR_COMPACT_UNARY(VALUE, a.u = a.u >> operand.u);
+
+	SABR_THREADED_CASE(SABR_OP_DROP): SABR_COMPACT_SLOT(NONE, 1, sp--);
+	SABR_THREADED_CASE(SABR_OP_NIP): SABR_COMPACT_SLOT(NONE, 2, sp--);
+
+	SABR_THREADED_CASE(SABR_OP_DUP):
+		SABR_COMPACT_NONE();
+		SABR_COMPACT_NEED(1);
+		SABR_COMPACT_ROOM(1);
+		sp[0] = sp[-1];
+		sp++;
+		SABR_COMPACT_NEXT();
+
+	SABR_THREADED_CASE(SABR_OP_OVER):
+		SABR_COMPACT_NONE();
+		SABR_COMPACT_NEED(2);
+		SABR_COMPACT_ROOM(1);
+		sp[0] = sp[-2];
+		sp++;
+		SABR_COMPACT_NEXT();
+
+	SABR_THREADED_CASE(SABR_OP_TUCK): {
+		SABR_COMPACT_NONE();
+		SABR_COMPACT_NEED(2);
+		SABR_COMPACT_ROOM(1);
+		sabr_value_t b = sp[-1];
+		sp[-1] = sp[-2];
+		sp[-2] = b;
+		sp[0] = b;
+		sp++;
+	} SABR_COMPACT_NEXT();
+
+	SABR_THREADED_CASE(SABR_OP_SWAP): {
+		SABR_COMPACT_NONE();
+		SABR_COMPACT_NEED(2);
+		sabr_value_t b = sp[-1];
+		sp[-1] = sp[-2];
+		sp[-2] = b;
+	} SABR_COMPACT_NEXT();
+
+	SABR_THREADED_CASE(SABR_OP_ROT): {
+		SABR_COMPACT_NONE();
+		SABR_COMPACT_NEED(3);
+		sabr_value_t a = sp[-3];
+		sp[-3] = sp[-2];
+		sp[-2] = sp[-1];
+		sp[-1] = a;
+	} SABR_COMPACT_NEXT();
+
+	SABR_THREADED_CASE(SABR_OP_FETCH): SABR_COMPACT_UNARY(NONE, a.u = *a.p);
+
+	SABR_THREADED_CASE(SABR_OP_STORE):
+		SABR_COMPACT_NONE();
+		SABR_COMPACT_NEED(2);
+		sp -= 2;
+		*sp[1].p = sp[0].u;
+		SABR_COMPACT_NEXT();
+
+	SABR_THREADED_CASE(SABR_OP_INC_MEM): SABR_COMPACT_MEMORY_UNARY(a.i++);
+	SABR_THREADED_CASE(SABR_OP_DEC_MEM): SABR_COMPACT_MEMORY_UNARY(a.i--);
+	SABR_THREADED_CASE(SABR_OP_ADD_MEM): SABR_COMPACT_MEMORY_BINARY(a.i = a.i + b.i);
+	SABR_THREADED_CASE(SABR_OP_SUB_MEM): SABR_COMPACT_MEMORY_BINARY(a.i = a.i - b.i);
+	SABR_THREADED_CASE(SABR_OP_MUL_MEM): SABR_COMPACT_MEMORY_BINARY(a.i = a.i * b.i);
+	SABR_THREADED_CASE(SABR_OP_DIV_MEM): SABR_COMPACT_MEMORY_DIVISION(b.i == 0, a.i = a.i / b.i);
+	SABR_THREADED_CASE(SABR_OP_MOD_MEM): SABR_COMPACT_MEMORY_DIVISION(b.i == 0, a.i = a.i % b.i);
+	SABR_THREADED_CASE(SABR_OP_FADD_MEM): SABR_COMPACT_MEMORY_BINARY(a.f = a.f + b.f);
+	SABR_THREADED_CASE(SABR_OP_FSUB_MEM): SABR_COMPACT_MEMORY_BINARY(a.f = a.f - b.f);
+	SABR_THREADED_CASE(SABR_OP_FMUL_MEM): SABR_COMPACT_MEMORY_BINARY(a.f = a.f * b.f);
+	SABR_THREADED_CASE(SABR_OP_FDIV_MEM): SABR_COMPACT_MEMORY_DIVISION(b.f == 0.0f, a.f = a.f / b.f);
+	SABR_THREADED_CASE(SABR_OP_FMOD_MEM): SABR_COMPACT_MEMORY_DIVISION(b.f == 0.0f, a.f = fmod(a.f, b.f));
+	SABR_THREADED_CASE(SABR_OP_BAND_MEM): SABR_COMPACT_MEMORY_BINARY(a.u = a.u & b.u);
+	SABR_THREADED_CASE(SABR_OP_BOR_MEM): SABR_COMPACT_MEMORY_BINARY(a.u = a.u | b.u);
+	SABR_THREADED_CASE(SABR_OP_BXOR_MEM): SABR_COMPACT_MEMORY_BINARY(a.u = a.u ^ b.u);
+	SABR_THREADED_CASE(SABR_OP_BNOT_MEM): SABR_COMPACT_MEMORY_UNARY(a.u = ~a.u);
+	SABR_THREADED_CASE(SABR_OP_BLSFT_MEM): SABR_COMPACT_MEMORY_BINARY(a.u = a.u << b.u);
+	SABR_THREADED_CASE(SABR_OP_BRSFT_MEM): SABR_COMPACT_MEMORY_BINARY(a.u = a.u >> b.u);
+
+	SABR_THREADED_CASE(SABR_OP_INDEX_CELL): SABR_COMPACT_BINARY(a.u = b.u + a.u * sizeof(sabr_value_t));
+	SABR_THREADED_CASE(SABR_OP_FETCH_IDX): SABR_COMPACT_BINARY(a.u = b.p[a.u]);
+
+	SABR_THREADED_CASE(SABR_OP_STORE_IDX):
+		SABR_COMPACT_NONE();
+		SABR_COMPACT_NEED(3);
+		sp -= 3;
+		sp[2].p[sp[1].u] = sp[0].u;
+		SABR_COMPACT_NEXT();
+
+	SABR_THREADED_CASE(SABR_OP_FETCH_OFF): SABR_COMPACT_UNARY(VALUE, a.u = *(uint64_t*) (a.u + operand.u));
+
+	SABR_THREADED_CASE(SABR_OP_STORE_OFF):
+		SABR_COMPACT_VALUE();
+		SABR_COMPACT_NEED(2);
+		sp -= 2;
+		*(uint64_t*) (sp[1].u + operand.u) = sp[0].u;
+		SABR_COMPACT_NEXT();
+
+	SABR_THREADED_CASE(SABR_OP_ITOF): SABR_COMPACT_UNARY(NONE, a.f = (double) a.i);
+	SABR_THREADED_CASE(SABR_OP_UTOF): SABR_COMPACT_UNARY(NONE, a.f = (double) a.u);
+	SABR_THREADED_CASE(SABR_OP_FTOI): SABR_COMPACT_UNARY(NONE, a.i = (int64_t) a.f);
+	SABR_THREADED_CASE(SABR_OP_FTOU): SABR_COMPACT_UNARY(NONE, a.u = (int64_t) a.f);
+
+	SABR_THREADED_DEFAULT:
+	GENERIC: {
+		sabr_bcop_t bcop;
+		size_t index = sabr_compact_decode(code, end - code, ip - code, kinds, &bcop) - 1;
+		inter->data_stack.size = sp - base;
+		if (bcop.oc == SABR_OP_SWITCH_TABLE || bcop.oc == SABR_OP_SWITCH_SEARCH) result = sabr_interpreter_compact_switch(inter, bcop, kinds, &index);
+		else result = sabr_interpreter_op_functions[bcop.oc - 1](inter, bcop, &index);
+		sp = base + inter->data_stack.size;
+		if (sabr_threaded_unlikely(result)) {
+			fprintf(stderr, "result: %u, index: %zu\n", result, index);
+			goto FREE_ALL;
+		}
+		if (index == SIZE_MAX - 1) goto DONE;
+		SABR_COMPACT_JUMP(index + 1);
+	}
+
+#if !defined(SABR_THREADED_COMPUTED_GOTO)
+	}
+#endif
+
+UNDERFLOW:
+	sabr_interpreter_stack_underflow();
+	SABR_COMPACT_FAIL(SABR_OPERR_STACK);
+
+OVERFLOW:
+	sabr_interpreter_stack_overflow();
+	SABR_COMPACT_FAIL(SABR_OPERR_STACK);
+
+FAILURE:
+	fprintf(stderr, "result: %u, index: %zu\n", result, (size_t) (next - code - 1));
+	goto FREE_ALL;
+
+DONE:
+	succeed = true;
+
+FREE_ALL:
+	inter->data_stack.size = sp - base;
+	return succeed;
+}
+
+uint32_t sabr_interpreter_compact_switch(sabr_interpreter_t* inter, sabr_bcop_t bcop, const uint8_t* kinds, size_t* index) {
+	const uint8_t* code = inter->bc->compact;
+	size_t size = inter->bc->compact_size;
+	size_t table = bcop.operand.u;
+	size_t entry;
+	sabr_bcop_t member;
+	sabr_value_t v;
+
+	size_t next = sabr_compact_decode(code, size, table, kinds, &member);
+	if (!next) return SABR_OPERR_SWITCH;
+	size_t stride = next - table;
+	if (!sabr_interpreter_pop(inter, &v)) return SABR_OPERR_STACK;
+
+	if (bcop.oc == SABR_OP_SWITCH_TABLE) {
+		uint64_t slot = v.u - member.operand.u;
+		if (!sabr_compact_decode(code, size, table + stride, kinds, &member)) return SABR_OPERR_SWITCH;
+		entry = (slot < member.operand.u) ? slot + 3 : 2;
+	}
+	else {
+		size_t count = member.operand.u;
+		size_t low = 0, high = count;
+		while (low < high) {
+			size_t mid = low + (high - low) / 2;
+			if (!sabr_compact_decode(code, size, table + (mid * 2 + 2) * stride, kinds, &member)) return SABR_OPERR_SWITCH;
+			if (member.operand.i < v.i) low = mid + 1;
+			else high = mid;
+		}
+		entry = 1;
+		if (low < count) {
+			if (!sabr_compact_decode(code, size, table + (low * 2 + 2) * stride, kinds, &member)) return SABR_OPERR_SWITCH;
+			if (member.operand.u == v.u) entry = low * 2 + 3;
+		}
+	}
+
+	if (!sabr_compact_decode(code, size, table + entry * stride, kinds, &member)) return SABR_OPERR_SWITCH;
+	*index = member.operand.u - 1;
+	return SABR_OPERR_NONE;
+}
\ No newline at end of file
@@ -0,0 +1,1279 @@
+#include "interpreter_jit.h"
+
+#if defined(SABR_JIT_X86_64)
+
+_Static_assert(offsetof(sabr_jit_context_t, sp) == 0, "jit context layout");
+_Static_assert(offsetof(sabr_jit_context_t, frame) == 8, "jit context layout");
+_Static_assert(offsetof(sabr_jit_context_t, globals) == 16, "jit context layout");
+_Static_assert(offsetof(sabr_jit_context_t, for_record) == 24, "jit context layout");
+_Static_assert(offsetof(sabr_jit_context_t, base) == 32, "jit context layout");
+_Static_assert(offsetof(sabr_jit_context_t, limit) == 40, "jit context layout");
+_Static_assert(offsetof(sabr_jit_context_t, index) == 48, "jit context layout");
+_Static_assert(offsetof(sabr_jit_context_t, depth) == 56, "jit context layout");
+_Static_assert(offsetof(sabr_jit_context_t, call_op) == 64, "jit context layout");
+_Static_assert(offsetof(sabr_jit_context_t, call_block) == 72, "jit context layout");
+_Static_assert(offsetof(sabr_jit_context_t, select) == 80, "jit context layout");
+_Static_assert(offsetof(sabr_jit_context_t, stack) == 88, "jit context layout");
+_Static_assert(offsetof(sabr_for_record_t, variable) == 0, "for record layout");
+_Static_assert(offsetof(sabr_for_record_t, end) == 8, "for record layout");
+_Static_assert(offsetof(sabr_for_record_t, step) == 16, "for record layout");
+
+/*
+	Templates run with the data stack pointer in rbx (pointing at the slot of
+	the top of the stack), the top of the stack in r12, the frame in r14, the
+	globals in r15 and the context in rbp. Each hole is marked by a label
+	placed right after it.
+*/
+
+#define SABR_JIT_TEMPLATE(NAME, CODE) \
+	__asm__( \
+		".pushsection .rodata\n" \
+		"sabr_jit_template_" #NAME ":\n" \
+		CODE \
+		"sabr_jit_template_" #NAME "_end:\n" \
+		".ifndef sabr_jit_template_" #NAME "_h0\n" \
+		"sabr_jit_template_" #NAME "_h0:\n" \
+		".endif\n" \
+		".ifndef sabr_jit_template_" #NAME "_h1\n" \
+		"sabr_jit_template_" #NAME "_h1:\n" \
+		".endif\n" \
+		".ifndef sabr_jit_template_" #NAME "_h2\n" \
+		"sabr_jit_template_" #NAME "_h2:\n" \
+		".endif\n" \
+		".popsection\n" \
+	); \
+	extern const uint8_t sabr_jit_template_##NAME[] __attribute__((visibility("hidden"))); \
+	extern const uint8_t sabr_jit_template_##NAME##_end[] __attribute__((visibility("hidden"))); \
+	extern const uint8_t sabr_jit_template_##NAME##_h0[] __attribute__((visibility("hidden"))); \
+	extern const uint8_t sabr_jit_template_##NAME##_h1[] __attribute__((visibility("hidden"))); \
+	extern const uint8_t sabr_jit_template_##NAME##_h2[] __attribute__((visibility("hidden")));
+
+#define SABR_JIT_USE(NAME) ((sabr_jit_template_t) { \
+	sabr_jit_template_##NAME, \
+	sabr_jit_template_##NAME##_end, \
+	{ sabr_jit_template_##NAME##_h0, sabr_jit_template_##NAME##_h1, sabr_jit_template_##NAME##_h2 } \
+})
+
+#define SABR_JIT_HOLE(NAME, K) "sabr_jit_template_" #NAME "_h" #K ":\n"
+#define SABR_JIT_JCC(CC) ".byte 0x0f, " CC "\n" ".long 0\n"
+#define SABR_JIT_JMP ".byte 0xe9\n" ".long 0\n"
+
+#define SABR_JIT_PUSH "mov %r12, (%rbx)\n" "add $8, %rbx\n"
+#define SABR_JIT_POP "sub $8, %rbx\n" "mov (%rbx), %r12\n"
+#define SABR_JIT_POP2 "mov -16(%rbx), %r12\n" "sub $16, %rbx\n"
+#define SABR_JIT_POP3 "mov -24(%rbx), %r12\n" "sub $24, %rbx\n"
+#define SABR_JIT_LEAVE "addq $1, " SABR_JIT_DEPTH_LEFT "\n" "add $8, %rsp\n" "ret\n"
+
+#define SABR_JIT_BINARY(INST) "sub $8, %rbx\n" INST " (%rbx), %r12\n"
+#define SABR_JIT_COMPARE(CC) \
+	"sub $8, %rbx\n" \
+	"mov (%rbx), %rax\n" \
+	"cmp %r12, %rax\n" \
+	"set" CC " %al\n" \
+	"movzbl %al, %eax\n" \
+	"neg %rax\n" \
+	"mov %rax, %r12\n"
+#define SABR_JIT_COMPARE_IMM(NAME, CC) \
+	"movabs $0, %rax\n" \
+	SABR_JIT_HOLE(NAME, 0) \
+	"cmp %rax, %r12\n" \
+	"set" CC " %al\n" \
+	"movzbl %al, %eax\n" \
+	"neg %rax\n" \
+	"mov %rax, %r12\n"
+#define SABR_JIT_BRANCH(NAME, CC) \
+	"mov -8(%rbx), %rax\n" \
+	"mov %r12, %rcx\n" \
+	SABR_JIT_POP2 \
+	"cmp %rcx, %rax\n" \
+	SABR_JIT_JCC(CC) \
+	SABR_JIT_HOLE(NAME, 0)
+#define SABR_JIT_FLOAT(INST) \
+	"sub $8, %rbx\n" \
+	"movq (%rbx), %xmm0\n" \
+	"movq %r12, %xmm1\n" \
+	INST " %xmm1, %xmm0\n" \
+	"movq %xmm0, %r12\n"
+#define SABR_JIT_FCOMPARE(INST, A, B) \
+	"sub $8, %rbx\n" \
+	"movq (%rbx), " A "\n" \
+	"movq %r12, " B "\n" \
+	INST " %xmm1, %xmm0\n" \
+	"movq %xmm0, %r12\n"
+#define SABR_JIT_FBRANCH(NAME, INST, A, B) \
+	"movq -8(%rbx), " A "\n" \
+	"movq %r12, " B "\n" \
+	SABR_JIT_POP2 \
+	INST " %xmm1, %xmm0\n" \
+	"movq %xmm0, %rax\n" \
+	"test %rax, %rax\n" \
+	SABR_JIT_JCC("0x84") \
+	SABR_JIT_HOLE(NAME, 0)
+#define SABR_JIT_SLOT(BASE, INST) INST " 0x7fffffff(" BASE ")"
+#define SABR_JIT_MEMORY(INST) \
+	"mov -8(%rbx), %rax\n" \
+	INST " %rax, (%r12)\n" \
+	SABR_JIT_POP2
+#define SABR_JIT_FMEMORY(INST) \
+	"movsd (%r12), %xmm0\n" \
+	"movq -8(%rbx), %xmm1\n" \
+	INST " %xmm1, %xmm0\n" \
+	"movsd %xmm0, (%r12)\n" \
+	SABR_JIT_POP2
+#define SABR_JIT_FOR(NAME, CC) \
+	"mov " SABR_JIT_FOR_RECORD ", %rax\n" \
+	"test %rax, %rax\n" \
+	SABR_JIT_JCC("0x84") \
+	SABR_JIT_HOLE(NAME, 0) \
+	"mov (%rax), %rcx\n" \
+	"mov (%rcx), %rdx\n" \
+	"add 16(%rax), %rdx\n" \
+	"mov %rdx, (%rcx)\n" \
+	"cmp 8(%rax), %rdx\n" \
+	SABR_JIT_JCC(CC) \
+	SABR_JIT_HOLE(NAME, 1) \
+	"mov 16(%rax), %rdx\n" \
+	"sub %rdx, (%rcx)\n"
+#define SABR_JIT_FOR_LOOP(NAME, TEST, UP, DOWN) \
+	"mov " SABR_JIT_FOR_RECORD ", %rax\n" \
+	"test %rax, %rax\n" \
+	SABR_JIT_JCC("0x84") \
+	SABR_JIT_HOLE(NAME, 0) \
+	"mov (%rax), %rcx\n" \
+	"mov (%rcx), %rdx\n" \
+	"add 16(%rax), %rdx\n" \
+	"mov %rdx, (%rcx)\n" \
+	"cmpq $0, 16(%rax)\n" \
+	TEST " 1f\n" \
+	"cmp 8(%rax), %rdx\n" \
+	SABR_JIT_JCC(UP) \
+	SABR_JIT_HOLE(NAME, 1) \
+	"jmp 2f\n" \
+	"1:\n" \
+	"cmp 8(%rax), %rdx\n" \
+	SABR_JIT_JCC(DOWN) \
+	SABR_JIT_HOLE(NAME, 2) \
+	"2:\n" \
+	"mov 16(%rax), %rdx\n" \
+	"sub %rdx, (%rcx)\n"
+
+__asm__(
+	".text\n"
+	".globl sabr_jit_enter\n"
+	".hidden sabr_jit_enter\n"
+	".type sabr_jit_enter, @function\n"
+	"sabr_jit_enter:\n"
+	"push %rbx\n"
+	"push %rbp\n"
+	"push %r12\n"
+	"push %r14\n"
+	"push %r15\n"
+	"mov %rdi, %rbp\n"
+	"mov %rsp, %rax\n"
+	"mov " SABR_JIT_STACK ", %rsp\n"
+	"push %rax\n"
+	"sub $8, %rsp\n"
+	"mov " SABR_JIT_SP ", %rbx\n"
+	"mov (%rbx), %r12\n"
+	"mov " SABR_JIT_FRAME ", %r14\n"
+	"mov " SABR_JIT_GLOBALS ", %r15\n"
+	"call *%rsi\n"
+	"mov %rbx, " SABR_JIT_SP "\n"
+	"mov %r12, (%rbx)\n"
+	"mov 8(%rsp), %rsp\n"
+	"pop %r15\n"
+	"pop %r14\n"
+	"pop %r12\n"
+	"pop %rbp\n"
+	"pop %rbx\n"
+	"ret\n"
+	".size sabr_jit_enter, .-sabr_jit_enter\n"
+);
+uint32_t sabr_jit_enter(sabr_jit_context_t* ctx, void* code) __attribute__((visibility("hidden")));
+
+SABR_JIT_TEMPLATE(enter,
+	"sub $8, %rsp\n"
+	"subq $1, " SABR_JIT_DEPTH_LEFT "\n"
+	SABR_JIT_JCC("0x88")
+	SABR_JIT_HOLE(enter, 0)
+)
+SABR_JIT_TEMPLATE(leave, SABR_JIT_LEAVE)
+SABR_JIT_TEMPLATE(return, "xor %eax, %eax\n" SABR_JIT_LEAVE)
+SABR_JIT_TEMPLATE(halt, "mov $-1, %eax\n" SABR_JIT_JMP)
+SABR_JIT_TEMPLATE(jump, SABR_JIT_JMP)
+SABR_JIT_TEMPLATE(fail,
+	"movabs $0, %rax\n"
+	SABR_JIT_HOLE(fail, 0)
+	"mov %rax, " SABR_JIT_INDEX "\n"
+	"mov $0, %eax\n"
+	SABR_JIT_HOLE(fail, 1)
+	SABR_JIT_JMP
+	SABR_JIT_HOLE(fail, 2)
+)
+SABR_JIT_TEMPLATE(block,
+	"mov %r12, (%rbx)\n"
+	"mov %rbx, " SABR_JIT_SP "\n"
+	"mov %rbp, %rdi\n"
+	"movabs $0, %rsi\n"
+	SABR_JIT_HOLE(block, 0)
+	"movabs $0, %rdx\n"
+	SABR_JIT_HOLE(block, 1)
+	"call *" SABR_JIT_CALL_BLOCK "\n"
+	"mov " SABR_JIT_SP ", %rbx\n"
+	"mov (%rbx), %r12\n"
+	SABR_JIT_JMP
+	SABR_JIT_HOLE(block, 2)
+)
+SABR_JIT_TEMPLATE(need,
+	"lea 8(%rbx), %rax\n"
+	"sub " SABR_JIT_BASE ", %rax\n"
+	"cmp $0x7fffffff, %rax\n"
+	SABR_JIT_HOLE(need, 0)
+	SABR_JIT_JCC("0x82")
+	SABR_JIT_HOLE(need, 1)
+)
+SABR_JIT_TEMPLATE(grow,
+	"lea 8(%rbx), %rax\n"
+	"sub " SABR_JIT_BASE ", %rax\n"
+	"add $0x7fffffff, %rax\n"
+	SABR_JIT_HOLE(grow, 0)
+	"cmp " SABR_JIT_LIMIT ", %rax\n"
+	SABR_JIT_JCC("0x87")
+	SABR_JIT_HOLE(grow, 1)
+)
+SABR_JIT_TEMPLATE(call_op,
+	"mov %r12, (%rbx)\n"
+	"mov %rbx, " SABR_JIT_SP "\n"
+	"mov %rbp, %rdi\n"
+	"movabs $0, %rsi\n"
+	SABR_JIT_HOLE(call_op, 0)
+	"call *" SABR_JIT_CALL_OP "\n"
+	"mov " SABR_JIT_SP ", %rbx\n"
+	"mov (%rbx), %r12\n"
+	"mov " SABR_JIT_FRAME ", %r14\n"
+	"test %eax, %eax\n"
+	SABR_JIT_JCC("0x85")
+	SABR_JIT_HOLE(call_op, 1)
+)
+SABR_JIT_TEMPLATE(branch_index,
+	"cmpq $0x7fffffff, " SABR_JIT_INDEX "\n"
+	SABR_JIT_HOLE(branch_index, 0)
+	SABR_JIT_JCC("0x85")
+	SABR_JIT_HOLE(branch_index, 1)
+)
+SABR_JIT_TEMPLATE(call,
+	"movabs $0, %rax\n"
+	SABR_JIT_HOLE(call, 0)
+	"call *(%rax)\n"
+	"mov " SABR_JIT_FRAME ", %r14\n"
+	"test %eax, %eax\n"
+	SABR_JIT_JCC("0x85")
+	SABR_JIT_HOLE(call, 1)
+)
+SABR_JIT_TEMPLATE(select,
+	"mov %r12, %rdx\n"
+	SABR_JIT_POP
+	"mov %rbp, %rdi\n"
+	"movabs $0, %rsi\n"
+	SABR_JIT_HOLE(select, 0)
+	"call *" SABR_JIT_SELECT "\n"
+	"lea 0x7fffffff(%rip), %rcx\n"
+	SABR_JIT_HOLE(select, 1)
+	"movslq (%rcx, %rax, 4), %rax\n"
+	"add %rcx, %rax\n"
+	"jmp *%rax\n"
+)
+
+SABR_JIT_TEMPLATE(value, SABR_JIT_PUSH "movabs $0, %r12\n" SABR_JIT_HOLE(value, 0))
+SABR_JIT_TEMPLATE(if,
+	"mov %r12, %rax\n"
+	SABR_JIT_POP
+	"test %rax, %rax\n"
+	SABR_JIT_JCC("0x84")
+	SABR_JIT_HOLE(if, 0)
+)
+
+SABR_JIT_TEMPLATE(for_up_i, SABR_JIT_FOR(for_up_i, "0x8c"))
+SABR_JIT_TEMPLATE(for_up_u, SABR_JIT_FOR(for_up_u, "0x82"))
+SABR_JIT_TEMPLATE(for_down_i, SABR_JIT_FOR(for_down_i, "0x8f"))
+SABR_JIT_TEMPLATE(for_down_u, SABR_JIT_FOR(for_down_u, "0x87"))
+SABR_JIT_TEMPLATE(for_loop_i, SABR_JIT_FOR_LOOP(for_loop_i, "jle", "0x8c", "0x8f"))
+SABR_JIT_TEMPLATE(for_loop_u, SABR_JIT_FOR_LOOP(for_loop_u, "je", "0x82", "0x87"))
+
+SABR_JIT_TEMPLATE(load_local, SABR_JIT_PUSH SABR_JIT_SLOT("%r14", "mov") ", %r12\n" SABR_JIT_HOLE(load_local, 0))
+SABR_JIT_TEMPLATE(store_local, "mov %r12, " SABR_JIT_SLOT("%r14", "") "\n" SABR_JIT_HOLE(store_local, 0) SABR_JIT_POP)
+SABR_JIT_TEMPLATE(addr_local, SABR_JIT_PUSH SABR_JIT_SLOT("%r14", "lea") ", %r12\n" SABR_JIT_HOLE(addr_local, 0))
+SABR_JIT_TEMPLATE(inc_local, SABR_JIT_SLOT("%r14", "lea") ", %rax\n" SABR_JIT_HOLE(inc_local, 0) "addq $1, (%rax)\n")
+SABR_JIT_TEMPLATE(dec_local, SABR_JIT_SLOT("%r14", "lea") ", %rax\n" SABR_JIT_HOLE(dec_local, 0) "subq $1, (%rax)\n")
+SABR_JIT_TEMPLATE(add_local, "add %r12, " SABR_JIT_SLOT("%r14", "") "\n" SABR_JIT_HOLE(add_local, 0) SABR_JIT_POP)
+SABR_JIT_TEMPLATE(fadd_local,
+	SABR_JIT_SLOT("%r14", "lea") ", %rax\n"
+	SABR_JIT_HOLE(fadd_local, 0)
+	"movq %r12, %xmm1\n"
+	"movsd (%rax), %xmm0\n"
+	"addsd %xmm1, %xmm0\n"
+	"movsd %xmm0, (%rax)\n"
+	SABR_JIT_POP
+)
+SABR_JIT_TEMPLATE(load_global, SABR_JIT_PUSH SABR_JIT_SLOT("%r15", "mov") ", %r12\n" SABR_JIT_HOLE(load_global, 0))
+SABR_JIT_TEMPLATE(store_global, "mov %r12, " SABR_JIT_SLOT("%r15", "") "\n" SABR_JIT_HOLE(store_global, 0) SABR_JIT_POP)
+SABR_JIT_TEMPLATE(addr_global, SABR_JIT_PUSH SABR_JIT_SLOT("%r15", "lea") ", %r12\n" SABR_JIT_HOLE(addr_global, 0))
+SABR_JIT_TEMPLATE(inc_global, SABR_JIT_SLOT("%r15", "lea") ", %rax\n" SABR_JIT_HOLE(inc_global, 0) "addq $1, (%rax)\n")
+SABR_JIT_TEMPLATE(dec_global, SABR_JIT_SLOT("%r15", "lea") ", %rax\n" SABR_JIT_HOLE(dec_global, 0) "subq $1, (%rax)\n")
+SABR_JIT_TEMPLATE(add_global, "add %r12, " SABR_JIT_SLOT("%r15", "") "\n" SABR_JIT_HOLE(add_global, 0) SABR_JIT_POP)
+SABR_JIT_TEMPLATE(fadd_global,
+	SABR_JIT_SLOT("%r15", "lea") ", %rax\n"
+	SABR_JIT_HOLE(fadd_global, 0)
+	"movq %r12, %xmm1\n"
+	"movsd (%rax), %xmm0\n"
+	"addsd %xmm1, %xmm0\n"
+	"movsd %xmm0, (%rax)\n"
+	SABR_JIT_POP
+)
+
+SABR_JIT_TEMPLATE(add, SABR_JIT_BINARY("add"))
+SABR_JIT_TEMPLATE(sub, "sub $8, %rbx\n" "mov (%rbx), %rax\n" "sub %r12, %rax\n" "mov %rax, %r12\n")
+SABR_JIT_TEMPLATE(mul, SABR_JIT_BINARY("imul"))
+SABR_JIT_TEMPLATE(zero,
+	"test %r12, %r12\n"
+	SABR_JIT_JCC("0x84")
+	SABR_JIT_HOLE(zero, 0)
+)
+SABR_JIT_TEMPLATE(div, "sub $8, %rbx\n" "mov (%rbx), %rax\n" "cqo\n" "idiv %r12\n" "mov %rax, %r12\n")
+SABR_JIT_TEMPLATE(mod, "sub $8, %rbx\n" "mov (%rbx), %rax\n" "cqo\n" "idiv %r12\n" "mov %rdx, %r12\n")
+SABR_JIT_TEMPLATE(udiv, "sub $8, %rbx\n" "mov (%rbx), %rax\n" "xor %edx, %edx\n" "div %r12\n" "mov %rax, %r12\n")
+SABR_JIT_TEMPLATE(umod, "sub $8, %rbx\n" "mov (%rbx), %rax\n" "xor %edx, %edx\n" "div %r12\n" "mov %rdx, %r12\n")
+SABR_JIT_TEMPLATE(neg, "neg %r12\n")
+SABR_JIT_TEMPLATE(inc, "add $1, %r12\n")
+SABR_JIT_TEMPLATE(dec, "sub $1, %r12\n")
+SABR_JIT_TEMPLATE(add_imm, "movabs $0, %rax\n" SABR_JIT_HOLE(add_imm, 0) "add %rax, %r12\n")
+SABR_JIT_TEMPLATE(mul_imm, "movabs $0, %rax\n" SABR_JIT_HOLE(mul_imm, 0) "imul %rax, %r12\n")
+
+SABR_JIT_TEMPLATE(equ, SABR_JIT_COMPARE("e"))
+SABR_JIT_TEMPLATE(neq, SABR_JIT_COMPARE("ne"))
+SABR_JIT_TEMPLATE(grt, SABR_JIT_COMPARE("g"))
+SABR_JIT_TEMPLATE(geq, SABR_JIT_COMPARE("ge"))
+SABR_JIT_TEMPLATE(lst, SABR_JIT_COMPARE("l"))
+SABR_JIT_TEMPLATE(leq, SABR_JIT_COMPARE("le"))
+SABR_JIT_TEMPLATE(ugrt, SABR_JIT_COMPARE("a"))
+SABR_JIT_TEMPLATE(ugeq, SABR_JIT_COMPARE("ae"))
+SABR_JIT_TEMPLATE(ulst, SABR_JIT_COMPARE("b"))
+SABR_JIT_TEMPLATE(uleq, SABR_JIT_COMPARE("be"))
+SABR_JIT_TEMPLATE(lst_if, SABR_JIT_BRANCH(lst_if, "0x8d"))
+SABR_JIT_TEMPLATE(equ_if, SABR_JIT_BRANCH(equ_if, "0x85"))
+SABR_JIT_TEMPLATE(neq_if, SABR_JIT_BRANCH(neq_if, "0x84"))
+SABR_JIT_TEMPLATE(grt_if, SABR_JIT_BRANCH(grt_if, "0x8e"))
+SABR_JIT_TEMPLATE(geq_if, SABR_JIT_BRANCH(geq_if, "0x8c"))
+SABR_JIT_TEMPLATE(leq_if, SABR_JIT_BRANCH(leq_if, "0x8f"))
+SABR_JIT_TEMPLATE(ugrt_if, SABR_JIT_BRANCH(ugrt_if, "0x86"))
+SABR_JIT_TEMPLATE(ugeq_if, SABR_JIT_BRANCH(ugeq_if, "0x82"))
+SABR_JIT_TEMPLATE(ulst_if, SABR_JIT_BRANCH(ulst_if, "0x83"))
+SABR_JIT_TEMPLATE(uleq_if, SABR_JIT_BRANCH(uleq_if, "0x87"))
+SABR_JIT_TEMPLATE(equ_imm, SABR_JIT_COMPARE_IMM(equ_imm, "e"))
+SABR_JIT_TEMPLATE(neq_imm, SABR_JIT_COMPARE_IMM(neq_imm, "ne"))
+SABR_JIT_TEMPLATE(grt_imm, SABR_JIT_COMPARE_IMM(grt_imm, "g"))
+SABR_JIT_TEMPLATE(geq_imm, SABR_JIT_COMPARE_IMM(geq_imm, "ge"))
+SABR_JIT_TEMPLATE(lst_imm, SABR_JIT_COMPARE_IMM(lst_imm, "l"))
+SABR_JIT_TEMPLATE(leq_imm, SABR_JIT_COMPARE_IMM(leq_imm, "le"))
+
+SABR_JIT_TEMPLATE(fadd, SABR_JIT_FLOAT("addsd"))
+SABR_JIT_TEMPLATE(fsub, SABR_JIT_FLOAT("subsd"))
+SABR_JIT_TEMPLATE(fmul, SABR_JIT_FLOAT("mulsd"))
+SABR_JIT_TEMPLATE(fdiv, SABR_JIT_FLOAT("divsd"))
+SABR_JIT_TEMPLATE(fzero,
+	"movq %r12, %xmm1\n"
+	"xorpd %xmm2, %xmm2\n"
+	"ucomisd %xmm2, %xmm1\n"
+	"jp 1f\n"
+	SABR_JIT_JCC("0x84")
+	SABR_JIT_HOLE(fzero, 0)
+	"1:\n"
+)
+SABR_JIT_TEMPLATE(fneg, "btc $63, %r12\n")
+SABR_JIT_TEMPLATE(fequ, SABR_JIT_FCOMPARE("cmpeqsd", "%xmm0", "%xmm1"))
+SABR_JIT_TEMPLATE(fneq, SABR_JIT_FCOMPARE("cmpneqsd", "%xmm0", "%xmm1"))
+SABR_JIT_TEMPLATE(fgrt, SABR_JIT_FCOMPARE("cmpltsd", "%xmm1", "%xmm0"))
+SABR_JIT_TEMPLATE(fgeq, SABR_JIT_FCOMPARE("cmplesd", "%xmm1", "%xmm0"))
+SABR_JIT_TEMPLATE(flst, SABR_JIT_FCOMPARE("cmpltsd", "%xmm0", "%xmm1"))
+SABR_JIT_TEMPLATE(fleq, SABR_JIT_FCOMPARE("cmplesd", "%xmm0", "%xmm1"))
+SABR_JIT_TEMPLATE(fequ_if, SABR_JIT_FBRANCH(fequ_if, "cmpeqsd", "%xmm0", "%xmm1"))
+SABR_JIT_TEMPLATE(fneq_if, SABR_JIT_FBRANCH(fneq_if, "cmpneqsd", "%xmm0", "%xmm1"))
+SABR_JIT_TEMPLATE(fgrt_if, SABR_JIT_FBRANCH(fgrt_if, "cmpltsd", "%xmm1", "%xmm0"))
+SABR_JIT_TEMPLATE(fgeq_if, SABR_JIT_FBRANCH(fgeq_if, "cmplesd", "%xmm1", "%xmm0"))
+SABR_JIT_TEMPLATE(flst_if, SABR_JIT_FBRANCH(flst_if, "cmpltsd", "%xmm0", "%xmm1"))
+SABR_JIT_TEMPLATE(fleq_if, SABR_JIT_FBRANCH(fleq_if, "cmplesd", "%xmm0", "%xmm1"))
+
+SABR_JIT_TEMPLATE(band, SABR_JIT_BINARY("and"))
+SABR_JIT_TEMPLATE(bor, SABR_JIT_BINARY("or"))
+SABR_JIT_TEMPLATE(bxor, SABR_JIT_BINARY("xor"))
+SABR_JIT_TEMPLATE(bnot, "not %r12\n")
+SABR_JIT_TEMPLATE(blsft, "mov %r12, %rcx\n" SABR_JIT_POP "shl %cl, %r12\n")
+SABR_JIT_TEMPLATE(brsft, "mov %r12, %rcx\n" SABR_JIT_POP "shr %cl, %r12\n")
+SABR_JIT_TEMPLATE(band_imm, "movabs $0, %rax\n" SABR_JIT_HOLE(band_imm, 0) "and %rax, %r12\n")
+SABR_JIT_TEMPLATE(blsft_imm, "movabs $0, %rcx\n" SABR_JIT_HOLE(blsft_imm, 0) "shl %cl, %r12\n")
+SABR_JIT_TEMPLATE(brsft_imm, "movabs $0, %rcx\n" SABR_JIT_HOLE(brsft_imm, 0) "shr %cl, %r12\n")
+
+SABR_JIT_TEMPLATE(drop, SABR_JIT_POP)
+SABR_JIT_TEMPLATE(dup, SABR_JIT_PUSH)
+SABR_JIT_TEMPLATE(over, "mov -8(%rbx), %rax\n" SABR_JIT_PUSH "mov %rax, %r12\n")
+SABR_JIT_TEMPLATE(tuck, "mov -8(%rbx), %rax\n" "mov %r12, -8(%rbx)\n" "mov %rax, (%rbx)\n" "add $8, %rbx\n")
+SABR_JIT_TEMPLATE(swap, "mov -8(%rbx), %rax\n" "mov %r12, -8(%rbx)\n" "mov %rax, %r12\n")
+SABR_JIT_TEMPLATE(rot,
+	"mov -16(%rbx), %rax\n"
+	"mov -8(%rbx), %rcx\n"
+	"mov %rcx, -16(%rbx)\n"
+	"mov %r12, -8(%rbx)\n"
+	"mov %rax, %r12\n"
+)
+
+SABR_JIT_TEMPLATE(fetch, "mov (%r12), %r12\n")
+SABR_JIT_TEMPLATE(store, SABR_JIT_MEMORY("mov"))
+SABR_JIT_TEMPLATE(inc_mem, "addq $1, (%r12)\n" SABR_JIT_POP)
+SABR_JIT_TEMPLATE(dec_mem, "subq $1, (%r12)\n" SABR_JIT_POP)
+SABR_JIT_TEMPLATE(bnot_mem, "notq (%r12)\n" SABR_JIT_POP)
+SABR_JIT_TEMPLATE(add_mem, SABR_JIT_MEMORY("add"))
+SABR_JIT_TEMPLATE(sub_mem, SABR_JIT_MEMORY("sub"))
+SABR_JIT_TEMPLATE(mul_mem, "mov -8(%rbx), %rax\n" "imul (%r12), %rax\n" "mov %rax, (%r12)\n" SABR_JIT_POP2)
+SABR_JIT_TEMPLATE(band_mem, SABR_JIT_MEMORY("and"))
+SABR_JIT_TEMPLATE(bor_mem, SABR_JIT_MEMORY("or"))
+SABR_JIT_TEMPLATE(bxor_mem, SABR_JIT_MEMORY("xor"))
+SABR_JIT_TEMPLATE(blsft_mem, "mov -8(%rbx), %rcx\n" "shlq %cl, (%r12)\n" SABR_JIT_POP2)
+SABR_JIT_TEMPLATE(brsft_mem, "mov -8(%rbx), %rcx\n" "shrq %cl, (%r12)\n" SABR_JIT_POP2)
+SABR_JIT_TEMPLATE(fadd_mem, SABR_JIT_FMEMORY("addsd"))
+SABR_JIT_TEMPLATE(fsub_mem, SABR_JIT_FMEMORY("subsd"))
+SABR_JIT_TEMPLATE(fmul_mem, SABR_JIT_FMEMORY("mulsd"))
+SABR_JIT_TEMPLATE(index_cell, "sub $8, %rbx\n" "mov (%rbx), %rax\n" "lea (%r12, %rax, 8), %r12\n")
+SABR_JIT_TEMPLATE(fetch_idx, "sub $8, %rbx\n" "mov (%rbx), %rax\n" "mov (%r12, %rax, 8), %r12\n")
+SABR_JIT_TEMPLATE(store_idx,
+	"mov -8(%rbx), %rax\n"
+	"mov -16(%rbx), %rcx\n"
+	"mov %rcx, (%r12, %rax, 8)\n"
+	SABR_JIT_POP3
+)
+SABR_JIT_TEMPLATE(fetch_off, "mov 0x7fffffff(%r12), %r12\n" SABR_JIT_HOLE(fetch_off, 0))
+SABR_JIT_TEMPLATE(store_off,
+	"mov -8(%rbx), %rax\n"
+	"mov %rax, 0x7fffffff(%r12)\n"
+	SABR_JIT_HOLE(store_off, 0)
+	SABR_JIT_POP2
+)
+
+SABR_JIT_TEMPLATE(itof, "cvtsi2sdq %r12, %xmm0\n" "movq %xmm0, %r12\n")
+SABR_JIT_TEMPLATE(ftoi, "movq %r12, %xmm0\n" "cvttsd2si %xmm0, %r12\n")
+
+#endif
+
+bool sabr_jit_init(sabr_jit_t* jit) {
+	memset(jit, 0, sizeof(sabr_jit_t));
+	vector_init(sabr_block_data_t, &jit->block_vec);
+	return true;
+}
+
+bool sabr_jit_prepare(sabr_jit_t* jit, sabr_interpreter_t* inter, sabr_bytecode_t* bc) {
+#if defined(SABR_JIT_X86_64)
+	size_t size = bc->bcop_vec.size;
+
+	if (inter->jit == SABR_JIT_OFF) return true;
+
+	jit->size = size;
+	jit->bc = bc;
+	jit->threshold = (inter->jit == SABR_JIT_ALWAYS) ? 1 : inter->jit_threshold;
+
+	jit->entries = (void**) calloc(size + 1, sizeof(void*));
+	jit->failed = (bool*) calloc(size + 1, sizeof(bool));
+	jit->candidates = (bool*) calloc(size + 1, sizeof(bool));
+	jit->queued = (bool*) calloc(size + 1, sizeof(bool));
+	jit->counts = (uint64_t*) calloc(size + 1, sizeof(uint64_t));
+	jit->blocks = (sabr_block_data_t**) calloc(size + 1, sizeof(sabr_block_data_t*));
+	jit->marks = (uint32_t*) calloc(size + 1, sizeof(uint32_t));
+	jit->labels = (size_t*) calloc(size + 1, sizeof(size_t));
+	jit->region = (size_t*) calloc(size + 1, sizeof(size_t));
+	jit->roots = (size_t*) calloc(size + 1, sizeof(size_t));
+	jit->offsets = (size_t*) calloc(size + 2, sizeof(size_t));
+	if (!jit->entries || !jit->failed || !jit->candidates || !jit->queued || !jit->counts || !jit->blocks || !jit->marks || !jit->labels || !jit->region || !jit->roots || !jit->offsets) {
+		fputs(sabr_errmsg_alloc, stderr);
+		return false;
+	}
+
+	if (!sabr_interpreter_verify_bytecode(bc, &jit->block_vec)) return false;
+	for (size_t i = 0; i < jit->block_vec.size; i++) {
+		sabr_block_data_t* block = vector_at(sabr_block_data_t, &jit->block_vec, i);
+		jit->blocks[block->begin] = block;
+	}
+
+	jit->candidates[0] = true;
+	for (size_t i = 0; i < size; i++) {
+		sabr_bcop_t bcop = *vector_at(sabr_bcop_t, &bc->bcop_vec, i);
+		if (!sabr_opcode_has_index_operand(bcop.oc) || bcop.oc == SABR_OP_SWITCH_TABLE || bcop.oc == SABR_OP_SWITCH_SEARCH) continue;
+		if (bcop.oc == SABR_OP_CALL || bcop.oc == SABR_OP_TAILCALL || bcop.operand.u <= i) jit->candidates[bcop.operand.u] = true;
+	}
+
+	jit->ctx.base = inter->data_stack.data;
+	jit->ctx.limit = inter->data_stack.capacity * sizeof(sabr_value_t);
+	jit->stack = (uint8_t*) mmap(NULL, SABR_JIT_STACK_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+	if (jit->stack == MAP_FAILED) {
+		jit->stack = NULL;
+		fputs(sabr_errmsg_alloc, stderr);
+		return false;
+	}
+	jit->ctx.stack = jit->stack + SABR_JIT_STACK_SIZE;
+	jit->ctx.depth = (SABR_JIT_STACK_SIZE - SABR_JIT_STACK_RESERVE) / 16;
+	jit->ctx.call_op = sabr_jit_call_op;
+	jit->ctx.call_block = sabr_jit_call_block;
+	jit->ctx.select = sabr_jit_select;
+	jit->ctx.inter = inter;
+	jit->ctx.bc = bc;
+
+	if (inter->perf_map) {
+		char path[PATH_MAX];
+		snprintf(path, PATH_MAX, "/tmp/perf-%d.map", (int) getpid());
+		jit->perf_map = fopen(path, "a");
+		if (!jit->perf_map) fputs(sabr_errmsg_open, stderr);
+	}
+
+	jit->enabled = true;
+#endif
+	return true;
+}
+
+void sabr_jit_del(sabr_jit_t* jit) {
+#if defined(SABR_JIT_X86_64)
+	for (size_t i = 0; i < jit->chunk_count; i++) munmap(jit->chunks[i].data, jit->chunks[i].size);
+	if (jit->stack) munmap(jit->stack, SABR_JIT_STACK_SIZE);
+#endif
+	if (jit->perf_map) fclose(jit->perf_map);
+	free(jit->entries);
+	free(jit->failed);
+	free(jit->candidates);
+	free(jit->queued);
+	free(jit->counts);
+	free(jit->blocks);
+	free(jit->marks);
+	free(jit->labels);
+	free(jit->region);
+	free(jit->roots);
+	free(jit->offsets);
+	free(jit->code);
+	free(jit->patches);
+	free(jit->stubs);
+	free(jit->chunks);
+	vector_free(sabr_block_data_t, &jit->block_vec);
+	memset(jit, 0, sizeof(sabr_jit_t));
+}
+
+void* sabr_jit_lookup(sabr_jit_t* jit, size_t index) {
+	if (jit->entries[index]) return jit->entries[index];
+	if (jit->failed[index] || ++jit->counts[index] < jit->threshold) return NULL;
+	return sabr_jit_compile(jit, index);
+}
+
+void* sabr_jit_compile(sabr_jit_t* jit, size_t root) {
+	bool succeed = true;
+	size_t k;
+
+	jit->root_count = 0;
+	jit->roots[jit->root_count++] = root;
+	jit->queued[root] = true;
+	for (k = 0; k < jit->root_count && succeed; k++) succeed = sabr_jit_discover(jit, jit->roots[k]);
+	if (!succeed) jit->failed[jit->roots[k - 1]] = true;
+
+	jit->code_size = 0;
+	for (k = 0; k < jit->root_count && succeed; k++) {
+		jit->offsets[k] = jit->code_size;
+		succeed = sabr_jit_emit_region(jit, jit->roots[k]);
+	}
+	jit->offsets[jit->root_count] = jit->code_size;
+	if (succeed) succeed = sabr_jit_publish(jit);
+
+	for (k = 0; k < jit->root_count; k++) jit->queued[jit->roots[k]] = false;
+	if (!succeed) {
+		jit->failed[root] = true;
+		return NULL;
+	}
+	return jit->entries[root];
+}
+
+uint32_t sabr_jit_run(sabr_jit_t* jit, void* code) {
+	sabr_interpreter_t* inter = jit->ctx.inter;
+	uint32_t result = SABR_OPERR_WHAT;
+
+	jit->ctx.sp = inter->data_stack.data + inter->data_stack.size - 1;
+	jit->ctx.frame = inter->frame;
+	jit->ctx.globals = inter->globals;
+	jit->ctx.for_record = inter->for_record;
+#if defined(SABR_JIT_X86_64)
+	result = sabr_jit_enter(&jit->ctx, code);
+#endif
+	inter->data_stack.size = jit->ctx.sp + 1 - inter->data_stack.data;
+	return result;
+}
+
+bool sabr_jit_discover(sabr_jit_t* jit, size_t root) {
+	size_t head = 0;
+	size_t succs[2];
+
+	if (!++jit->stamp) {
+		memset(jit->marks, 0, sizeof(uint32_t) * (jit->size + 1));
+		jit->stamp = 1;
+	}
+	jit->region_size = 0;
+	jit->marks[root] = jit->stamp;
+	jit->region[jit->region_size++] = root;
+
+	while (head < jit->region_size) {
+		size_t index = jit->region[head++];
+		size_t succ_count;
+		if (index == jit->size) continue;
+		if (!sabr_jit_is_supported(jit, index)) return false;
+
+		sabr_bcop_t bcop = *vector_at(sabr_bcop_t, &jit->bc->bcop_vec, index);
+		if (bcop.oc == SABR_OP_CALL && !jit->entries[bcop.operand.u] && !jit->queued[bcop.operand.u]) {
+			if (jit->failed[bcop.operand.u]) return false;
+			jit->queued[bcop.operand.u] = true;
+			jit->roots[jit->root_count++] = bcop.operand.u;
+		}
+
+		if (bcop.oc == SABR_OP_SWITCH_TABLE || bcop.oc == SABR_OP_SWITCH_SEARCH) {
+			size_t first, count, stride;
+			sabr_jit_switch_layout(jit, bcop, &first, &count, &stride);
+			for (size_t i = 0; i <= count; i++) {
+				size_t target = vector_at(sabr_bcop_t, &jit->bc->bcop_vec, first + i * stride)->operand.u;
+				if (jit->marks[target] == jit->stamp) continue;
+				jit->marks[target] = jit->stamp;
+				jit->region[jit->region_size++] = target;
+			}
+			continue;
+		}
+
+		succ_count = sabr_jit_successors(jit, index, succs);
+		for (size_t i = 0; i < succ_count; i++) {
+			if (jit->marks[succs[i]] == jit->stamp) continue;
+			if (jit->region_size >= SABR_JIT_REGION_LIMIT) return false;
+			jit->marks[succs[i]] = jit->stamp;
+			jit->region[jit->region_size++] = succs[i];
+		}
+	}
+
+	qsort(jit->region, jit->region_size, sizeof(size_t), sabr_jit_index_compare);
+	return true;
+}
+
+bool sabr_jit_is_supported(sabr_jit_t* jit, size_t index) {
+	sabr_bcop_t bcop = *vector_at(sabr_bcop_t, &jit->bc->bcop_vec, index);
+	sabr_block_data_t* block = jit->blocks[index];
+
+	if (index > INT32_MAX) return false;
+	if (block && (block->need > INT32_MAX / sizeof(sabr_value_t) || block->grow > INT32_MAX / sizeof(sabr_value_t))) return false;
+
+	switch (bcop.oc) {
+		case SABR_OP_EXEC:
+		case SABR_OP_DATAGROUP_EXEC:
+		case SABR_OP_FOR_CHECK:
+		case SABR_OP_FOR_NEXT:
+			return false;
+		default:
+			return true;
+	}
+}
+
+size_t sabr_jit_successors(sabr_jit_t* jit, size_t index, size_t* succs) {
+	sabr_bcop_t bcop = *vector_at(sabr_bcop_t, &jit->bc->bcop_vec, index);
+	size_t count = 0;
+
+	if (sabr_jit_falls_through(bcop.oc)) succs[count++] = index + 1;
+	if (sabr_opcode_has_index_operand(bcop.oc) && bcop.oc != SABR_OP_CALL) succs[count++] = bcop.operand.u;
+	return count;
+}
+
+bool sabr_jit_falls_through(sabr_opcode_t oc) {
+	switch (oc) {
+		case SABR_OP_EXIT:
+		case SABR_OP_JUMP:
+		case SABR_OP_RETURN:
+		case SABR_OP_TAILCALL:
+		case SABR_OP_LAMBDA:
+		case SABR_OP_SWITCH_TABLE:
+		case SABR_OP_SWITCH_SEARCH:
+			return false;
+		default:
+			return true;
+	}
+}
+
+void sabr_jit_switch_layout(sabr_jit_t* jit, sabr_bcop_t bcop, size_t* first, size_t* count, size_t* stride) {
+	sabr_bcop_t* table = vector_at(sabr_bcop_t, &jit->bc->bcop_vec, bcop.operand.u);
+
+	if (bcop.oc == SABR_OP_SWITCH_TABLE) {
+		*first = bcop.operand.u + 2;
+		*count = table[1].operand.u;
+		*stride = 1;
+	}
+	else {
+		*first = bcop.operand.u + 1;
+		*count = table[0].operand.u;
+		*stride = 2;
+	}
+}
+
+bool sabr_jit_emit_region(sabr_jit_t* jit, size_t root) {
+	sabr_jit_template_t t;
+	size_t at;
+
+	if (!sabr_jit_discover(jit, root)) return false;
+	jit->patch_count = 0;
+	jit->stub_count = 0;
+
+#if defined(SABR_JIT_X86_64)
+	t = SABR_JIT_USE(enter);
+	if (!sabr_jit_emit(jit, t, &at)) return false;
+	if (!sabr_jit_set_stub(jit, t, at, 0, SABR_JIT_STUB_FAIL, root, SABR_OPERR_WHAT)) return false;
+	if (jit->region[0] != root && !sabr_jit_emit_jump(jit, root)) return false;
+
+	for (size_t k = 0; k < jit->region_size; k++) {
+		size_t index = jit->region[k];
+		jit->labels[index] = jit->code_size;
+		if (!sabr_jit_emit_op(jit, index)) return false;
+		if (index == jit->size) continue;
+		if (!sabr_jit_falls_through(vector_at(sabr_bcop_t, &jit->bc->bcop_vec, index)->oc)) continue;
+		if (k + 1 < jit->region_size && jit->region[k + 1] == index + 1) continue;
+		if (!sabr_jit_emit_jump(jit, index + 1)) return false;
+	}
+
+	jit->exit_pos = jit->code_size;
+	if (!sabr_jit_emit(jit, SABR_JIT_USE(leave), &at)) return false;
+	if (!sabr_jit_emit_stubs(jit)) return false;
+	sabr_jit_resolve(jit);
+	return true;
+#else
+	return false;
+#endif
+}
+
+bool sabr_jit_emit_op(sabr_jit_t* jit, size_t index) {
+#if defined(SABR_JIT_X86_64)
+	sabr_jit_template_t t;
+	size_t at;
+	sabr_bcop_t bcop = (index < jit->size) ? *vector_at(sabr_bcop_t, &jit->bc->bcop_vec, index) : sabr_new_bcop(SABR_OP_EXIT);
+	sabr_block_data_t* block = (index < jit->size) ? jit->blocks[index] : NULL;
+
+	if (block && block->need) {
+		t = SABR_JIT_USE(need);
+		if (!sabr_jit_emit(jit, t, &at)) return false;
+		sabr_jit_set_u32(jit, t, at, 0, (uint32_t) (block->need * sizeof(sabr_value_t)));
+		if (!sabr_jit_set_stub(jit, t, at, 1, SABR_JIT_STUB_BLOCK, index, 0)) return false;
+	}
+	if (block && block->grow) {
+		t = SABR_JIT_USE(grow);
+		if (!sabr_jit_emit(jit, t, &at)) return false;
+		sabr_jit_set_u32(jit, t, at, 0, (uint32_t) (block->grow * sizeof(sabr_value_t)));
+		if (!sabr_jit_set_stub(jit, t, at, 1, SABR_JIT_STUB_BLOCK, index, 0)) return false;
+	}
+
+	if (sabr_jit_template(bcop.oc, &t)) return sabr_jit_emit(jit, t, &at);
+	if (sabr_jit_template_immediate(bcop.oc, &t)) {
+		if (!sabr_jit_emit(jit, t, &at)) return false;
+		sabr_jit_set_u64(jit, t, at, 0, bcop.operand.u);
+		return true;
+	}
+	if (sabr_jit_template_branch(bcop.oc, &t)) {
+		if (!sabr_jit_emit(jit, t, &at)) return false;
+		return sabr_jit_set_patch(jit, t, at, 0, SABR_JIT_PATCH_LABEL, bcop.operand.u);
+	}
+	if (sabr_jit_template_slot(bcop.oc, &t)) {
+		if (bcop.operand.u > INT32_MAX / sizeof(sabr_value_t)) return sabr_jit_emit_generic(jit, index);
+		if (!sabr_jit_emit(jit, t, &at)) return false;
+		sabr_jit_set_u32(jit, t, at, 0, (uint32_t) (bcop.operand.u * sizeof(sabr_value_t)));
+		return true;
+	}
+
+	switch (bcop.oc) {
+		case SABR_OP_NONE:
+			return true;
+		case SABR_OP_EXIT:
+			t = SABR_JIT_USE(halt);
+			if (!sabr_jit_emit(jit, t, &at)) return false;
+			return sabr_jit_set_patch(jit, t, at, 0, SABR_JIT_PATCH_EXIT, 0);
+		case SABR_OP_JUMP:
+			return sabr_jit_emit_jump(jit, bcop.operand.u);
+		case SABR_OP_CALL:
+			t = SABR_JIT_USE(call);
+			if (!sabr_jit_emit(jit, t, &at)) return false;
+			sabr_jit_set_u64(jit, t, at, 0, (uint64_t) (uintptr_t) (jit->entries + bcop.operand.u));
+			return sabr_jit_set_patch(jit, t, at, 1, SABR_JIT_PATCH_EXIT, 0);
+		case SABR_OP_TAILCALL:
+		case SABR_OP_LAMBDA:
+			return sabr_jit_emit_generic(jit, index) && sabr_jit_emit_jump(jit, bcop.operand.u);
+		case SABR_OP_SWITCH_TABLE:
+		case SABR_OP_SWITCH_SEARCH:
+			t = SABR_JIT_USE(select);
+			if (!sabr_jit_emit(jit, t, &at)) return false;
+			sabr_jit_set_u64(jit, t, at, 0, index);
+			return sabr_jit_set_stub(jit, t, at, 1, SABR_JIT_STUB_TABLE, index, 0);
+		case SABR_OP_FOR_UP_I:
+		case SABR_OP_FOR_UP_U:
+		case SABR_OP_FOR_DOWN_I:
+		case SABR_OP_FOR_DOWN_U:
+		case SABR_OP_FOR_LOOP_I:
+		case SABR_OP_FOR_LOOP_U:
+			switch (bcop.oc) {
+				case SABR_OP_FOR_UP_I: t = SABR_JIT_USE(for_up_i); break;
+				case SABR_OP_FOR_UP_U: t = SABR_JIT_USE(for_up_u); break;
+				case SABR_OP_FOR_DOWN_I: t = SABR_JIT_USE(for_down_i); break;
+				case SABR_OP_FOR_DOWN_U: t = SABR_JIT_USE(for_down_u); break;
+				case SABR_OP_FOR_LOOP_I: t = SABR_JIT_USE(for_loop_i); break;
+				default: t = SABR_JIT_USE(for_loop_u); break;
+			}
+			if (!sabr_jit_emit(jit, t, &at)) return false;
+			if (!sabr_jit_set_stub(jit, t, at, 0, SABR_JIT_STUB_FAIL, index, SABR_OPERR_FOR)) return false;
+			if (!sabr_jit_set_patch(jit, t, at, 1, SABR_JIT_PATCH_LABEL, bcop.operand.u)) return false;
+			if (bcop.oc != SABR_OP_FOR_LOOP_I && bcop.oc != SABR_OP_FOR_LOOP_U) return true;
+			return sabr_jit_set_patch(jit, t, at, 2, SABR_JIT_PATCH_LABEL, bcop.operand.u);
+		case SABR_OP_DIV:
+		case SABR_OP_MOD:
+		case SABR_OP_UDIV:
+		case SABR_OP_UMOD:
+		case SABR_OP_FDIV:
+			t = (bcop.oc == SABR_OP_FDIV) ? SABR_JIT_USE(fzero) : SABR_JIT_USE(zero);
+			if (!sabr_jit_emit(jit, t, &at)) return false;
+			if (!sabr_jit_set_stub(jit, t, at, 0, SABR_JIT_STUB_FAIL, index, SABR_OPERR_DIV_BY_ZERO)) return false;
+			switch (bcop.oc) {
+				case SABR_OP_DIV: t = SABR_JIT_USE(div); break;
+				case SABR_OP_MOD: t = SABR_JIT_USE(mod); break;
+				case SABR_OP_UDIV: t = SABR_JIT_USE(udiv); break;
+				case SABR_OP_UMOD: t = SABR_JIT_USE(umod); break;
+				default: t = SABR_JIT_USE(fdiv); break;
+			}
+			return sabr_jit_emit(jit, t, &at);
+		case SABR_OP_FETCH_OFF:
+		case SABR_OP_STORE_OFF:
+			if (bcop.operand.i < INT32_MIN || bcop.operand.i > INT32_MAX) return sabr_jit_emit_generic(jit, index);
+			t = (bcop.oc == SABR_OP_FETCH_OFF) ? SABR_JIT_USE(fetch_off) : SABR_JIT_USE(store_off);
+			if (!sabr_jit_emit(jit, t, &at)) return false;
+			sabr_jit_set_u32(jit, t, at, 0, (uint32_t) bcop.operand.i);
+			return true;
+		default:
+			return sabr_jit_emit_generic(jit, index);
+	}
+#else
+	return false;
+#endif
+}
+
+bool sabr_jit_template(sabr_opcode_t oc, sabr_jit_template_t* t) {
+#if defined(SABR_JIT_X86_64)
+	switch (oc) {
+		case SABR_OP_RETURN: *t = SABR_JIT_USE(return); return true;
+		case SABR_OP_ADD: *t = SABR_JIT_USE(add); return true;
+		case SABR_OP_SUB: *t = SABR_JIT_USE(sub); return true;
+		case SABR_OP_MUL: *t = SABR_JIT_USE(mul); return true;
+		case SABR_OP_NEG: *t = SABR_JIT_USE(neg); return true;
+		case SABR_OP_INC: *t = SABR_JIT_USE(inc); return true;
+		case SABR_OP_DEC: *t = SABR_JIT_USE(dec); return true;
+		case SABR_OP_EQU: *t = SABR_JIT_USE(equ); return true;
+		case SABR_OP_NEQ: *t = SABR_JIT_USE(neq); return true;
+		case SABR_OP_GRT: *t = SABR_JIT_USE(grt); return true;
+		case SABR_OP_GEQ: *t = SABR_JIT_USE(geq); return true;
+		case SABR_OP_LST: *t = SABR_JIT_USE(lst); return true;
+		case SABR_OP_LEQ: *t = SABR_JIT_USE(leq); return true;
+		case SABR_OP_UGRT: *t = SABR_JIT_USE(ugrt); return true;
+		case SABR_OP_UGEQ: *t = SABR_JIT_USE(ugeq); return true;
+		case SABR_OP_ULST: *t = SABR_JIT_USE(ulst); return true;
+		case SABR_OP_ULEQ: *t = SABR_JIT_USE(uleq); return true;
+		case SABR_OP_FADD: *t = SABR_JIT_USE(fadd); return true;
+		case SABR_OP_FSUB: *t = SABR_JIT_USE(fsub); return true;
+		case SABR_OP_FMUL: *t = SABR_JIT_USE(fmul); return true;
+		case SABR_OP_FNEG: *t = SABR_JIT_USE(fneg); return true;
+		case SABR_OP_FEQU: *t = SABR_JIT_USE(fequ); return true;
+		case SABR_OP_FNEQ: *t = SABR_JIT_USE(fneq); return true;
+		case SABR_OP_FGRT: *t = SABR_JIT_USE(fgrt); return true;
+		case SABR_OP_FGEQ: *t = SABR_JIT_USE(fgeq); return true;
+		case SABR_OP_FLST: *t = SABR_JIT_USE(flst); return true;
+		case SABR_OP_FLEQ: *t = SABR_JIT_USE(fleq); return true;
+		case SABR_OP_BAND: *t = SABR_JIT_USE(band); return true;
+		case SABR_OP_BOR: *t = SABR_JIT_USE(bor); return true;
+		case SABR_OP_BXOR: *t = SABR_JIT_USE(bxor); return true;
+		case SABR_OP_BNOT: *t = SABR_JIT_USE(bnot); return true;
+		case SABR_OP_BLSFT: *t = SABR_JIT_USE(blsft); return true;
+		case SABR_OP_BRSFT: *t = SABR_JIT_USE(brsft); return true;
+		case SABR_OP_DROP: *t = SABR_JIT_USE(drop); return true;
+		case SABR_OP_NIP: *t = SABR_JIT_USE(drop); return true;
+		case SABR_OP_DUP: *t = SABR_JIT_USE(dup); return true;
+		case SABR_OP_OVER: *t = SABR_JIT_USE(over); return true;
+		case SABR_OP_TUCK: *t = SABR_JIT_USE(tuck); return true;
+		case SABR_OP_SWAP: *t = SABR_JIT_USE(swap); return true;
+		case SABR_OP_ROT: *t = SABR_JIT_USE(rot); return true;
+		case SABR_OP_FETCH: *t = SABR_JIT_USE(fetch); return true;
+		case SABR_OP_STORE: *t = SABR_JIT_USE(store); return true;
+		case SABR_OP_INC_MEM: *t = SABR_JIT_USE(inc_mem); return true;
+		case SABR_OP_DEC_MEM: *t = SABR_JIT_USE(dec_mem); return true;
+		case SABR_OP_BNOT_MEM: *t = SABR_JIT_USE(bnot_mem); return true;
+		case SABR_OP_ADD_MEM: *t = SABR_JIT_USE(add_mem); return true;
+		case SABR_OP_SUB_MEM: *t = SABR_JIT_USE(sub_mem); return true;
+		case SABR_OP_MUL_MEM: *t = SABR_JIT_USE(mul_mem); return true;
+		case SABR_OP_BAND_MEM: *t = SABR_JIT_USE(band_mem); return true;
+		case SABR_OP_BOR_MEM: *t = SABR_JIT_USE(bor_mem); return true;
+		case SABR_OP_BXOR_MEM: *t = SABR_JIT_USE(bxor_mem); return true;
+		case SABR_OP_BLSFT_MEM: *t = SABR_JIT_USE(blsft_mem); return true;
+		case SABR_OP_BRSFT_MEM: *t = SABR_JIT_USE(brsft_mem); return true;
+		case SABR_OP_FADD_MEM: *t = SABR_JIT_USE(fadd_mem); return true;
+		case SABR_OP_FSUB_MEM: *t = SABR_JIT_USE(fsub_mem); return true;
+		case SABR_OP_FMUL_MEM: *t = SABR_JIT_USE(fmul_mem); return true;
+		case SABR_OP_INDEX_CELL: *t = SABR_JIT_USE(index_cell); return true;
+		case SABR_OP_FETCH_IDX: *t = SABR_JIT_USE(fetch_idx); return true;
+		case SABR_OP_STORE_IDX: *t = SABR_JIT_USE(store_idx); return true;
+		case SABR_OP_ITOF: *t = SABR_JIT_USE(itof); return true;
+		case SABR_OP_FTOI: *t = SABR_JIT_USE(ftoi); return true;
+		case SABR_OP_FTOU: *t = SABR_JIT_USE(ftoi); return true;
+		default: return false;
+	}
+#else
+	return false;
+#endif
+}
+
+bool sabr_jit_template_immediate(sabr_opcode_t oc, sabr_jit_template_t* t) {
+#if defined(SABR_JIT_X86_64)
+	switch (oc) {
+		case SABR_OP_VALUE: *t = SABR_JIT_USE(value); return true;
+		case SABR_OP_ADD_IMM: *t = SABR_JIT_USE(add_imm); return true;
+		case SABR_OP_MUL_IMM: *t = SABR_JIT_USE(mul_imm); return true;
+		case SABR_OP_EQU_IMM: *t = SABR_JIT_USE(equ_imm); return true;
+		case SABR_OP_NEQ_IMM: *t = SABR_JIT_USE(neq_imm); return true;
+		case SABR_OP_GRT_IMM: *t = SABR_JIT_USE(grt_imm); return true;
+		case SABR_OP_GEQ_IMM: *t = SABR_JIT_USE(geq_imm); return true;
+		case SABR_OP_LST_IMM: *t = SABR_JIT_USE(lst_imm); return true;
+		case SABR_OP_LEQ_IMM: *t = SABR_JIT_USE(leq_imm); return true;
+		case SABR_OP_BAND_IMM: *t = SABR_JIT_USE(band_imm); return true;
+		case SABR_OP_BLSFT_IMM: *t = SABR_JIT_USE(blsft_imm); return true;
+		case SABR_OP_BRSFT_IMM: *t = SABR_JIT_USE(brsft_imm); return true;
+		default: return false;
+	}
+#else
+	return false;
+#endif
+}
+
+bool sabr_jit_template_branch(sabr_opcode_t oc, sabr_jit_template_t* t) {
+#if defined(SABR_JIT_X86_64)
+	switch (oc) {
+		case SABR_OP_IF: *t = SABR_JIT_USE(if); return true;
+		case SABR_OP_LST_IF: *t = SABR_JIT_USE(lst_if); return true;
+		case SABR_OP_EQU_IF: *t = SABR_JIT_USE(equ_if); return true;
+		case SABR_OP_NEQ_IF: *t = SABR_JIT_USE(neq_if); return true;
+		case SABR_OP_GRT_IF: *t = SABR_JIT_USE(grt_if); return true;
+		case SABR_OP_GEQ_IF: *t = SABR_JIT_USE(geq_if); return true;
+		case SABR_OP_LEQ_IF: *t = SABR_JIT_USE(leq_if); return true;
+		case SABR_OP_UGRT_IF: *t = SABR_JIT_USE(ugrt_if); return true;
+		case SABR_OP_UGEQ_IF: *t = SABR_JIT_USE(ugeq_if); return true;
+		case SABR_OP_ULST_IF: *t = SABR_JIT_USE(ulst_if); return true;
+		case SABR_OP_ULEQ_IF: *t = SABR_JIT_USE(uleq_if); return true;
+		case SABR_OP_FEQU_IF: *t = SABR_JIT_USE(fequ_if); return true;
+		case SABR_OP_FNEQ_IF: *t = SABR_JIT_USE(fneq_if); return true;
+		case SABR_OP_FGRT_IF: *t = SABR_JIT_USE(fgrt_if); return true;
+		case SABR_OP_FGEQ_IF: *t = SABR_JIT_USE(fgeq_if); return true;
+		case SABR_OP_FLST_IF: *t = SABR_JIT_USE(flst_if); return true;
+		case SABR_OP_FLEQ_IF: *t = SABR_JIT_USE(fleq_if); return true;
+		default: return false;
+	}
+#else
+	return false;
+#endif
+}
+
+bool sabr_jit_template_slot(sabr_opcode_t oc, sabr_jit_template_t* t) {
+#if defined(SABR_JIT_X86_64)
+	switch (oc) {
+		case SABR_OP_LOAD_LOCAL: *t = SABR_JIT_USE(load_local); return true;
+		case SABR_OP_STORE_LOCAL: *t = SABR_JIT_USE(store_local); return true;
+		case SABR_OP_ADDR_LOCAL: *t = SABR_JIT_USE(addr_local); return true;
+		case SABR_OP_INC_LOCAL: *t = SABR_JIT_USE(inc_local); return true;
+		case SABR_OP_DEC_LOCAL: *t = SABR_JIT_USE(dec_local); return true;
+		case SABR_OP_ADD_LOCAL: *t = SABR_JIT_USE(add_local); return true;
+		case SABR_OP_FADD_LOCAL: *t = SABR_JIT_USE(fadd_local); return true;
+		case SABR_OP_LOAD_GLOBAL: *t = SABR_JIT_USE(load_global); return true;
+		case SABR_OP_STORE_GLOBAL: *t = SABR_JIT_USE(store_global); return true;
+		case SABR_OP_ADDR_GLOBAL: *t = SABR_JIT_USE(addr_global); return true;
+		case SABR_OP_INC_GLOBAL: *t = SABR_JIT_USE(inc_global); return true;
+		case SABR_OP_DEC_GLOBAL: *t = SABR_JIT_USE(dec_global); return true;
+		case SABR_OP_ADD_GLOBAL: *t = SABR_JIT_USE(add_global); return true;
+		case SABR_OP_FADD_GLOBAL: *t = SABR_JIT_USE(fadd_global); return true;
+		default: return false;
+	}
+#else
+	return false;
+#endif
+}
+
+bool sabr_jit_emit_generic(sabr_jit_t* jit, size_t index) {
+#if defined(SABR_JIT_X86_64)
+	sabr_jit_template_t t = SABR_JIT_USE(call_op);
+	sabr_bcop_t bcop = *vector_at(sabr_bcop_t, &jit->bc->bcop_vec, index);
+	size_t at;
+
+	if (!sabr_jit_emit(jit, t, &at)) return false;
+	sabr_jit_set_u64(jit, t, at, 0, index);
+	if (!sabr_jit_set_patch(jit, t, at, 1, SABR_JIT_PATCH_EXIT, 0)) return false;
+
+	if (!sabr_opcode_has_index_operand(bcop.oc) || !sabr_jit_falls_through(bcop.oc)) return true;
+	t = SABR_JIT_USE(branch_index);
+	if (!sabr_jit_emit(jit, t, &at)) return false;
+	sabr_jit_set_u32(jit, t, at, 0, (uint32_t) index);
+	return sabr_jit_set_patch(jit, t, at, 1, SABR_JIT_PATCH_LABEL, bcop.operand.u);
+#else
+	return false;
+#endif
+}
+
+bool sabr_jit_emit_stubs(sabr_jit_t* jit) {
+#if defined(SABR_JIT_X86_64)
+	for (size_t i = 0; i < jit->stub_count; i++) {
+		sabr_jit_stub_t stub = jit->stubs[i];
+		sabr_jit_template_t t;
+		size_t at;
+
+		if (stub.kind == SABR_JIT_STUB_TABLE) {
+			size_t first, count, stride;
+			sabr_jit_switch_layout(jit, *vector_at(sabr_bcop_t, &jit->bc->bcop_vec, stub.index), &first, &count, &stride);
+			while (jit->code_size % sizeof(int32_t)) {
+				if (!sabr_jit_reserve(jit, 1)) return false;
+				jit->code[jit->code_size++] = 0xcc;
+			}
+			if (!sabr_jit_reserve(jit, (count + 1) * sizeof(int32_t))) return false;
+			at = jit->code_size;
+			for (size_t k = 0; k <= count; k++) {
+				size_t target = vector_at(sabr_bcop_t, &jit->bc->bcop_vec, first + k * stride)->operand.u;
+				int32_t offset = (int32_t) (jit->labels[target] - at);
+				memcpy(jit->code + jit->code_size, &offset, sizeof(int32_t));
+				jit->code_size += sizeof(int32_t);
+			}
+			sabr_jit_link(jit, stub.pos, at);
+			continue;
+		}
+
+		t = (stub.kind == SABR_JIT_STUB_FAIL) ? SABR_JIT_USE(fail) : SABR_JIT_USE(block);
+		if (!sabr_jit_emit(jit, t, &at)) return false;
+		sabr_jit_link(jit, stub.pos, at);
+		if (stub.kind == SABR_JIT_STUB_FAIL) {
+			sabr_jit_set_u64(jit, t, at, 0, stub.index);
+			sabr_jit_set_u32(jit, t, at, 1, stub.result);
+		}
+		else {
+			sabr_jit_set_u64(jit, t, at, 0, jit->blocks[stub.index]->begin);
+			sabr_jit_set_u64(jit, t, at, 1, jit->blocks[stub.index]->end);
+		}
+		if (!sabr_jit_set_patch(jit, t, at, 2, SABR_JIT_PATCH_EXIT, 0)) return false;
+	}
+	return true;
+#else
+	return false;
+#endif
+}
+
+bool sabr_jit_publish(sabr_jit_t* jit) {
+#if defined(SABR_JIT_X86_64)
+	size_t page = (size_t) sysconf(_SC_PAGESIZE);
+	size_t length = (jit->code_size + page - 1) / page * page;
+	sabr_jit_chunk_t* chunks = NULL;
+	uint8_t* data = NULL;
+
+	chunks = (sabr_jit_chunk_t*) realloc(jit->chunks, sizeof(sabr_jit_chunk_t) * (jit->chunk_count + 1));
+	if (!chunks) {
+		fputs(sabr_errmsg_alloc, stderr);
+		return false;
+	}
+	jit->chunks = chunks;
+
+	data = (uint8_t*) mmap(NULL, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if (data == MAP_FAILED) {
+		fputs(sabr_errmsg_alloc, stderr);
+		return false;
+	}
+	memcpy(data, jit->code, jit->code_size);
+	if (mprotect(data, length, PROT_READ | PROT_EXEC)) {
+		munmap(data, length);
+		fputs(sabr_errmsg_alloc, stderr);
+		return false;
+	}
+	jit->chunks[jit->chunk_count].data = data;
+	jit->chunks[jit->chunk_count].size = length;
+	jit->chunk_count++;
+
+	for (size_t k = 0; k < jit->root_count; k++) {
+		jit->entries[jit->roots[k]] = data + jit->offsets[k];
+		if (!jit->perf_map) continue;
+		fprintf(jit->perf_map, "%" PRIxPTR " %zx sabr_jit_%zu\n", (uintptr_t) (data + jit->offsets[k]), jit->offsets[k + 1] - jit->offsets[k], jit->roots[k]);
+	}
+	if (jit->perf_map) fflush(jit->perf_map);
+	return true;
+#else
+	return false;
+#endif
+}
+
+bool sabr_jit_reserve(sabr_jit_t* jit, size_t length) {
+	if (jit->code_size + length <= jit->code_capacity) return true;
+
+	size_t capacity = jit->code_capacity ? jit->code_capacity : 4096;
+	while (capacity < jit->code_size + length) capacity *= 2;
+	uint8_t* code = (uint8_t*) realloc(jit->code, capacity);
+	if (!code) {
+		fputs(sabr_errmsg_alloc, stderr);
+		return false;
+	}
+	jit->code = code;
+	jit->code_capacity = capacity;
+	return true;
+}
+
+bool sabr_jit_emit(sabr_jit_t* jit, sabr_jit_template_t t, size_t* at) {
+	size_t length = t.end - t.begin;
+
+	if (!sabr_jit_reserve(jit, length)) return false;
+	memcpy(jit->code + jit->code_size, t.begin, length);
+	*at = jit->code_size;
+	jit->code_size += length;
+	return true;
+}
+
+bool sabr_jit_emit_jump(sabr_jit_t* jit, size_t target) {
+#if defined(SABR_JIT_X86_64)
+	sabr_jit_template_t t = SABR_JIT_USE(jump);
+	size_t at;
+
+	if (!sabr_jit_emit(jit, t, &at)) return false;
+	return sabr_jit_set_patch(jit, t, at, 0, SABR_JIT_PATCH_LABEL, target);
+#else
+	return false;
+#endif
+}
+
+void sabr_jit_set_u64(sabr_jit_t* jit, sabr_jit_template_t t, size_t at, size_t hole, uint64_t v) {
+	memcpy(jit->code + at + (t.holes[hole] - t.begin) - sizeof(uint64_t), &v, sizeof(uint64_t));
+}
+
+void sabr_jit_set_u32(sabr_jit_t* jit, sabr_jit_template_t t, size_t at, size_t hole, uint32_t v) {
+	memcpy(jit->code + at + (t.holes[hole] - t.begin) - sizeof(uint32_t), &v, sizeof(uint32_t));
+}
+
+bool sabr_jit_set_patch(sabr_jit_t* jit, sabr_jit_template_t t, size_t at, size_t hole, sabr_jit_patch_kind_t kind, size_t target) {
+	if (jit->patch_count == jit->patch_capacity) {
+		size_t capacity = jit->patch_capacity ? jit->patch_capacity * 2 : 256;
+		sabr_jit_patch_t* patches = (sabr_jit_patch_t*) realloc(jit->patches, sizeof(sabr_jit_patch_t) * capacity);
+		if (!patches) {
+			fputs(sabr_errmsg_alloc, stderr);
+			return false;
+		}
+		jit->patches = patches;
+		jit->patch_capacity = capacity;
+	}
+	jit->patches[jit->patch_count].kind = kind;
+	jit->patches[jit->patch_count].pos = at + (t.holes[hole] - t.begin);
+	jit->patches[jit->patch_count].target = target;
+	jit->patch_count++;
+	return true;
+}
+
+bool sabr_jit_set_stub(sabr_jit_t* jit, sabr_jit_template_t t, size_t at, size_t hole, sabr_jit_stub_kind_t kind, size_t index, uint32_t result) {
+	if (jit->stub_count == jit->stub_capacity) {
+		size_t capacity = jit->stub_capacity ? jit->stub_capacity * 2 : 64;
+		sabr_jit_stub_t* stubs = (sabr_jit_stub_t*) realloc(jit->stubs, sizeof(sabr_jit_stub_t) * capacity);
+		if (!stubs) {
+			fputs(sabr_errmsg_alloc, stderr);
+			return false;
+		}
+		jit->stubs = stubs;
+		jit->stub_capacity = capacity;
+	}
+	jit->stubs[jit->stub_count].kind = kind;
+	jit->stubs[jit->stub_count].pos = at + (t.holes[hole] - t.begin);
+	jit->stubs[jit->stub_count].index = index;
+	jit->stubs[jit->stub_count].result = result;
+	jit->stub_count++;
+	return true;
+}
+
+void sabr_jit_link(sabr_jit_t* jit, size_t pos, size_t target) {
+	int32_t offset = (int32_t) ((int64_t) target - (int64_t) pos);
+	memcpy(jit->code + pos - sizeof(int32_t), &offset, sizeof(int32_t));
+}
+
+void sabr_jit_resolve(sabr_jit_t* jit) {
+	for (size_t i = 0; i < jit->patch_count; i++) {
+		sabr_jit_patch_t patch = jit->patches[i];
+		size_t target;
+		switch (patch.kind) {
+			case SABR_JIT_PATCH_LABEL: target = jit->labels[patch.target]; break;
+			case SABR_JIT_PATCH_EXIT: target = jit->exit_pos; break;
+			default: target = patch.target; break;
+		}
+		sabr_jit_link(jit, patch.pos, target);
+	}
+}
+
+int sabr_jit_index_compare(const void* a, const void* b) {
+	size_t x = *(const size_t*) a;
+	size_t y = *(const size_t*) b;
+	return (x > y) - (x < y);
+}
+
+uint32_t sabr_jit_call_op(sabr_jit_context_t* ctx, size_t index) {
+	sabr_interpreter_t* inter = ctx->inter;
+	sabr_bcop_t bcop = *vector_at(sabr_bcop_t, &ctx->bc->bcop_vec, index);
+	uint32_t result;
+
+	inter->data_stack.size = ctx->sp + 1 - inter->data_stack.data;
+	result = sabr_interpreter_op_functions[bcop.oc - 1](inter, bcop, &index);
+	ctx->sp = inter->data_stack.data + inter->data_stack.size - 1;
+	ctx->frame = inter->frame;
+	ctx->for_record = inter->for_record;
+	ctx->index = index;
+	return result;
+}
+
+uint32_t sabr_jit_call_block(sabr_jit_context_t* ctx, size_t begin, size_t end) {
+	sabr_interpreter_t* inter = ctx->inter;
+	uint32_t result = SABR_OPERR_STACK;
+	size_t index = begin;
+
+	inter->data_stack.size = ctx->sp + 1 - inter->data_stack.data;
+	while (index < end) {
+		sabr_bcop_t bcop = *vector_at(sabr_bcop_t, &ctx->bc->bcop_vec, index);
+		size_t current = index;
+		if (bcop.oc == SABR_OP_EXIT) {
+			result = SABR_JIT_EXIT;
+			break;
+		}
+		if (bcop.oc != SABR_OP_NONE) {
+			uint32_t r = sabr_interpreter_op_functions[bcop.oc - 1](inter, bcop, &index);
+			if (r) {
+				result = r;
+				break;
+			}
+		}
+		index++;
+		if (index != current + 1) break;
+	}
+	ctx->sp = inter->data_stack.data + inter->data_stack.size - 1;
+	ctx->frame = inter->frame;
+	ctx->for_record = inter->for_record;
+	ctx->index = index;
+	return result;
+}
+
+uint64_t sabr_jit_select(sabr_jit_context_t* ctx, size_t index, uint64_t key) {
+	sabr_bcop_t bcop = *vector_at(sabr_bcop_t, &ctx->bc->bcop_vec, index);
+	sabr_bcop_t* table = vector_at(sabr_bcop_t, &ctx->bc->bcop_vec, bcop.operand.u);
+
+	if (bcop.oc == SABR_OP_SWITCH_TABLE) {
+		uint64_t slot = key - table[0].operand.u;
+		return (slot < table[1].operand.u) ? slot + 1 : 0;
+	}
+
+	size_t count = table[0].operand.u, low = 0, high = count;
+	while (low < high) {
+		size_t mid = low + (high - low) / 2;
+		if (table[mid * 2 + 2].operand.i < (int64_t) key) low = mid + 1;
+		else high = mid;
+	}
+	return (low < count && table[low * 2 + 2].operand.u == key) ? low + 1 : 0;
+}
\ No newline at end of file
@@ -2,7 +2,7 @@
 #include "bif.h"
 
 const uint32_t sabr_interpreter_op(op_exit)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index) {
-	*index = UINT64_MAX;
+	*index = SIZE_MAX - 1;
 	return SABR_OPERR_NONE;
 }
 
@@ -46,6 +46,25 @@ const uint32_t sabr_interpreter_op(op_for)(sabr_interpreter_t* inter, sabr_bcop_
 	return SABR_OPERR_NONE;
 }
 
+const uint32_t sabr_interpreter_op(op_for_addr)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index) {
+	sabr_for_data_t data = sabr_interpreter_for_data_new();
+	sabr_value_t addr;
+	sabr_value_t foty = bcop.operand;
+
+	if (!sabr_interpreter_pop(inter, &addr)) return SABR_OPERR_STACK;
+
+	data.variable_addr = (sabr_value_t*) addr.p;
+	data.foty = foty.u;
+	if (data.foty == SABR_FOTY_F) {
+		data.step.f = 1.0;
+		data.end.f = INFINITY;
+	}
+	*data.variable_addr = data.start;
+
+	if (!deque_push_back(sabr_for_data_t, &inter->for_data_stack, data)) return SABR_OPERR_FOR;
+	return SABR_OPERR_NONE;
+}
+
 const uint32_t sabr_interpreter_op(op_for_from)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index) {
 	sabr_for_data_t* data = NULL;
 	sabr_value_t v;
@@ -54,7 +73,9 @@ const uint32_t sabr_interpreter_op(op_for_from)(sabr_interpreter_t* inter, sabr_
 	data = deque_back(sabr_for_data_t, &inter->for_data_stack);
 	data->start.u = v.u;
 
-	return sabr_interpreter_set_variable(inter, data->variable_kwrd, data->start);
+	if (!data->variable_addr) return SABR_OPERR_UNDEFINED;
+	*data->variable_addr = data->start;
+	return SABR_OPERR_NONE;
 }
 
 const uint32_t sabr_interpreter_op(op_for_to)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index) {
@@ -168,6 +189,187 @@ const uint32_t sabr_interpreter_op(op_for_end)(sabr_interpreter_t* inter, sabr_b
 	return SABR_OPERR_NONE;
 }
 
+const uint32_t sabr_interpreter_op(op_for_init)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index) {
+	sabr_for_record_t* record = (sabr_for_record_t*) (inter->frame + bcop.operand.u);
+	sabr_value_t addr;
+
+	if (!sabr_interpreter_pop(inter, &addr)) return SABR_OPERR_STACK;
+
+	record->variable = (sabr_value_t*) addr.p;
+	record->variable->u = 0;
+	record->prev = inter->for_record;
+	inter->for_record = record;
+	return SABR_OPERR_NONE;
+}
+
+const uint32_t sabr_interpreter_op(op_for_to_i)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index) {
+	sabr_for_record_t* record = inter->for_record;
+	if (!record) return SABR_OPERR_FOR;
+	if (!sabr_interpreter_pop(inter, &record->end)) return SABR_OPERR_STACK;
+
+	record->step.i = (record->variable->i > record->end.i) ? -1 : 1;
+	return SABR_OPERR_NONE;
+}
+
+const uint32_t sabr_interpreter_op(op_for_to_u)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index) {
+	sabr_for_record_t* record = inter->for_record;
+	if (!record) return SABR_OPERR_FOR;
+	if (!sabr_interpreter_pop(inter, &record->end)) return SABR_OPERR_STACK;
+
+	record->step.i = (record->variable->u > record->end.u) ? -1 : 1;
+	return SABR_OPERR_NONE;
+}
+
+const uint32_t sabr_interpreter_op(op_for_to_f)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index) {
+	sabr_for_record_t* record = inter->for_record;
+	if (!record) return SABR_OPERR_FOR;
+	if (!sabr_interpreter_pop(inter, &record->end)) return SABR_OPERR_STACK;
+
+	record->step.f = (record->variable->f > record->end.f) ? -1.0 : 1.0;
+	return SABR_OPERR_NONE;
+}
+
+const uint32_t sabr_interpreter_op(op_for_enter_i)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index) {
+	sabr_for_record_t* record = inter->for_record;
+	if (!record) return SABR_OPERR_FOR;
+
+	sabr_value_t* v = record->variable;
+	if ((record->step.i > 0) ? v->i < record->end.i : v->i > record->end.i) return SABR_OPERR_NONE;
+
+	v->i -= record->step.i;
+	*index = bcop.operand.u - 1;
+	return SABR_OPERR_NONE;
+}
+
+const uint32_t sabr_interpreter_op(op_for_enter_u)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index) {
+	sabr_for_record_t* record = inter->for_record;
+	if (!record) return SABR_OPERR_FOR;
+
+	sabr_value_t* v = record->variable;
+	if ((record->step.u > 0) ? v->u < record->end.u : v->u > record->end.u) return SABR_OPERR_NONE;
+
+	v->u -= record->step.u;
+	*index = bcop.operand.u - 1;
+	return SABR_OPERR_NONE;
+}
+
+const uint32_t sabr_interpreter_op(op_for_enter_f)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index) {
+	sabr_for_record_t* record = inter->for_record;
+	if (!record) return SABR_OPERR_FOR;
+
+	sabr_value_t* v = record->variable;
+	if ((record->step.f > 0.0) ? v->f < record->end.f : v->f > record->end.f) return SABR_OPERR_NONE;
+
+	v->f -= record->step.f;
+	*index = bcop.operand.u - 1;
+	return SABR_OPERR_NONE;
+}
+
+const uint32_t sabr_interpreter_op(op_for_loop_i)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index) {
+	sabr_for_record_t* record = inter->for_record;
+	if (!record) return SABR_OPERR_FOR;
+
+	sabr_value_t* v = record->variable;
+	v->i += record->step.i;
+	if ((record->step.i > 0) ? v->i < record->end.i : v->i > record->end.i) *index = bcop.operand.u - 1;
+	else v->i -= record->step.i;
+	return SABR_OPERR_NONE;
+}
+
+const uint32_t sabr_interpreter_op(op_for_loop_u)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index) {
+	sabr_for_record_t* record = inter->for_record;
+	if (!record) return SABR_OPERR_FOR;
+
+	sabr_value_t* v = record->variable;
+	v->u += record->step.u;
+	if ((record->step.u > 0) ? v->u < record->end.u : v->u > record->end.u) *index = bcop.operand.u - 1;
+	else v->u -= record->step.u;
+	return SABR_OPERR_NONE;
+}
+
+const uint32_t sabr_interpreter_op(op_for_loop_f)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index) {
+	sabr_for_record_t* record = inter->for_record;
+	if (!record) return SABR_OPERR_FOR;
+
+	sabr_value_t* v = record->variable;
+	v->f += record->step.f;
+	if ((record->step.f > 0.0) ? v->f < record->end.f : v->f > record->end.f) *index = bcop.operand.u - 1;
+	else v->f -= record->step.f;
+	return SABR_OPERR_NONE;
+}
+
+const uint32_t sabr_interpreter_op(op_for_up_i)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index) {
+	sabr_for_record_t* record = inter->for_record;
+	if (!record) return SABR_OPERR_FOR;
+
+	sabr_value_t* v = record->variable;
+	v->i += record->step.i;
+	if (v->i < record->end.i) *index = bcop.operand.u - 1;
+	else v->i -= record->step.i;
+	return SABR_OPERR_NONE;
+}
+
+const uint32_t sabr_interpreter_op(op_for_up_u)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index) {
+	sabr_for_record_t* record = inter->for_record;
+	if (!record) return SABR_OPERR_FOR;
+
+	sabr_value_t* v = record->variable;
+	v->u += record->step.u;
+	if (v->u < record->end.u) *index = bcop.operand.u - 1;
+	else v->u -= record->step.u;
+	return SABR_OPERR_NONE;
+}
+
+const uint32_t sabr_interpreter_op(op_for_up_f)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index) {
+	sabr_for_record_t* record = inter->for_record;
+	if (!record) return SABR_OPERR_FOR;
+
+	sabr_value_t* v = record->variable;
+	v->f += record->step.f;
+	if (v->f < record->end.f) *index = bcop.operand.u - 1;
+	else v->f -= record->step.f;
+	return SABR_OPERR_NONE;
+}
+
+const uint32_t sabr_interpreter_op(op_for_down_i)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index) {
+	sabr_for_record_t* record = inter->for_record;
+	if (!record) return SABR_OPERR_FOR;
+
+	sabr_value_t* v = record->variable;
+	v->i += record->step.i;
+	if (v->i > record->end.i) *index = bcop.operand.u - 1;
+	else v->i -= record->step.i;
+	return SABR_OPERR_NONE;
+}
+
+const uint32_t sabr_interpreter_op(op_for_down_u)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index) {
+	sabr_for_record_t* record = inter->for_record;
+	if (!record) return SABR_OPERR_FOR;
+
+	sabr_value_t* v = record->variable;
+	v->u += record->step.u;
+	if (v->u > record->end.u) *index = bcop.operand.u - 1;
+	else v->u -= record->step.u;
+	return SABR_OPERR_NONE;
+}
+
+const uint32_t sabr_interpreter_op(op_for_down_f)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index) {
+	sabr_for_record_t* record = inter->for_record;
+	if (!record) return SABR_OPERR_FOR;
+
+	sabr_value_t* v = record->variable;
+	v->f += record->step.f;
+	if (v->f > record->end.f) *index = bcop.operand.u - 1;
+	else v->f -= record->step.f;
+	return SABR_OPERR_NONE;
+}
+
+const uint32_t sabr_interpreter_op(op_for_leave)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index) {
+	if (!inter->for_record) return SABR_OPERR_FOR;
+	inter->for_record = inter->for_record->prev;
+	return SABR_OPERR_NONE;
+}
+
 const uint32_t sabr_interpreter_op(op_switch)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index) {
 	sabr_value_t v;
 	if (!sabr_interpreter_pop(inter, &v)) return SABR_OPERR_STACK;
@@ -187,6 +389,46 @@ const uint32_t sabr_interpreter_op(op_switch_end)(sabr_interpreter_t* inter, sab
 	return SABR_OPERR_NONE;
 }
 
+const uint32_t sabr_interpreter_op(op_case_if)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index) {
+	sabr_value_t v;
+	sabr_value_t* switch_value = deque_back(sabr_value_t, &inter->switch_stack);
+	if (!switch_value) return SABR_OPERR_SWITCH;
+	if (!sabr_interpreter_pop(inter, &v)) return SABR_OPERR_STACK;
+	if (switch_value->u != v.u) *index = bcop.operand.u - 1;
+	return SABR_OPERR_NONE;
+}
+
+const uint32_t sabr_interpreter_op(op_switch_table)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index) {
+	sabr_value_t v;
+	size_t size = inter->bc->bcop_vec.size;
+	if (bcop.operand.u >= size || size - bcop.operand.u < 3) return SABR_OPERR_SWITCH;
+	sabr_bcop_t* table = vector_at(sabr_bcop_t, &inter->bc->bcop_vec, bcop.operand.u);
+	if (!sabr_interpreter_pop(inter, &v)) return SABR_OPERR_STACK;
+	uint64_t slot = v.u - table[0].operand.u;
+	size_t entry = (slot < table[1].operand.u) ? slot + 3 : 2;
+	if (entry >= size - bcop.operand.u) return SABR_OPERR_SWITCH;
+	*index = table[entry].operand.u - 1;
+	return SABR_OPERR_NONE;
+}
+
+const uint32_t sabr_interpreter_op(op_switch_search)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index) {
+	sabr_value_t v;
+	size_t size = inter->bc->bcop_vec.size;
+	if (bcop.operand.u >= size || size - bcop.operand.u < 2) return SABR_OPERR_SWITCH;
+	sabr_bcop_t* table = vector_at(sabr_bcop_t, &inter->bc->bcop_vec, bcop.operand.u);
+	size_t count = table[0].operand.u;
+	if (count > (size - bcop.operand.u - 2) / 2) return SABR_OPERR_SWITCH;
+	if (!sabr_interpreter_pop(inter, &v)) return SABR_OPERR_STACK;
+	size_t low = 0, high = count;
+	while (low < high) {
+		size_t mid = low + (high - low) / 2;
+		if (table[mid * 2 + 2].operand.i < v.i) low = mid + 1;
+		else high = mid;
+	}
+	*index = table[(low < count && table[low * 2 + 2].operand.u == v.u) ? low * 2 + 3 : 1].operand.u - 1;
+	return SABR_OPERR_NONE;
+}
+
 const uint32_t sabr_interpreter_op(op_lambda)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index) {
 	sabr_value_t pos;
 
@@ -207,18 +449,20 @@ const uint32_t sabr_interpreter_op(op_return)(sabr_interpreter_t* inter, sabr_bc
 }
 
 const uint32_t sabr_interpreter_op(op_local)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index) {
-	rbt(sabr_def_data_t)* local_words = NULL;
-	local_words = (rbt(sabr_def_data_t)*) malloc(sizeof(rbt(sabr_def_data_t)));
-	if (!local_words) return SABR_OPERR_WHAT;
-	if (!rbt_init(sabr_def_data_t, local_words)) return SABR_OPERR_WHAT;
-
 	sabr_local_data_t local_data;
 	local_data.for_data_stack_size = inter->for_data_stack.size;
+	local_data.for_record = inter->for_record;
 	local_data.switch_stack_size = inter->switch_stack.size;
-	local_data.local_memory_size = 0;
-	local_data.local_words = (void*) local_words;
+	local_data.local_memory_size = bcop.operand.u;
+	local_data.local_words = NULL;
+	local_data.frame = sabr_memory_pool_top(&inter->memory_pool);
+	local_data.alloted = false;
+
+	if (!sabr_memory_pool_alloc(&inter->memory_pool, bcop.operand.u)) return SABR_OPERR_MEMORY;
+	memset(local_data.frame, 0, sizeof(sabr_value_t) * bcop.operand.u);
 
 	if (!deque_push_back(sabr_local_data_t, &inter->local_data_stack, local_data)) return SABR_OPERR_WHAT;
+	inter->frame = local_data.frame;
 	return SABR_OPERR_NONE;
 }
 
@@ -230,16 +474,24 @@ const uint32_t sabr_interpreter_op(op_local_end)(sabr_interpreter_t* inter, sabr
 	count = inter->for_data_stack.size - local_data->for_data_stack_size;
 	for (size_t i = 0; i < count; i++)
 		if (!deque_pop_back(sabr_for_data_t, &inter->for_data_stack)) return SABR_OPERR_WHAT;
+	inter->for_record = local_data->for_record;
 
 	count = inter->switch_stack.size - local_data->switch_stack_size;
 	for (size_t i = 0; i < count; i++)
 		if (!deque_pop_back(sabr_value_t, &inter->switch_stack)) return SABR_OPERR_WHAT;
 
 	rbt(sabr_def_data_t)* local_words = (rbt(sabr_def_data_t)*) local_data->local_words;
-	rbt_free(sabr_def_data_t, local_words);
-	free(local_words);
+	if (local_words) {
+		rbt_free(sabr_def_data_t, local_words);
+		free(local_words);
+	}
+
+	if (!local_data->alloted && sabr_memory_pool_top(&inter->memory_pool) == local_data->frame + local_data->local_memory_size) {
+		if (!sabr_memory_pool_free(&inter->memory_pool, local_data->local_memory_size)) return SABR_OPERR_MEMORY;
+	}
 
 	if (!deque_pop_back(sabr_local_data_t, &inter->local_data_stack)) return SABR_OPERR_WHAT;
+	inter->frame = inter->local_data_stack.size ? sabr_interpreter_get_local_data(inter)->frame : inter->globals;
 
 	return SABR_OPERR_NONE;
 }
@@ -263,6 +515,14 @@ const uint32_t sabr_interpreter_op(op_define)(sabr_interpreter_t* inter, sabr_bc
 	return SABR_OPERR_NONE;
 }
 
+const uint32_t sabr_interpreter_op(op_inline)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index) {
+	return SABR_OPERR_NONE;
+}
+
+const uint32_t sabr_interpreter_op(op_noinline)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index) {
+	return SABR_OPERR_NONE;
+}
+
 const uint32_t sabr_interpreter_op(op_datagroup)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index) {
 	sabr_value_t identifier, defdata_type;
 	defdata_type = bcop.operand;
@@ -367,12 +627,28 @@ const uint32_t sabr_interpreter_op(op_exec)(sabr_interpreter_t* inter, sabr_bcop
 	return sabr_interpreter_exec_identifier(inter, bcop.operand, index);
 }
 
+const uint32_t sabr_interpreter_op(op_call)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index) {
+	sabr_cs_data_t csd;
+	csd.pos = *index + 1;
+	if (!deque_push_back(sabr_cs_data_t, &inter->call_stack, csd)) return SABR_OPERR_WHAT;
+	*index = bcop.operand.u - 1;
+	return SABR_OPERR_NONE;
+}
+
+const uint32_t sabr_interpreter_op(op_tailcall)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index) {
+	uint32_t result = sabr_interpreter_op(op_local_end)(inter, bcop, index);
+	if (result) return result;
+	*index = bcop.operand.u - 1;
+	return SABR_OPERR_NONE;
+}
+
 const uint32_t sabr_interpreter_op(op_addr)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index) {
 	sabr_value_t identifier;
 	sabr_value_t addr;
 
 	if (!sabr_interpreter_pop(inter, &identifier)) return SABR_OPERR_STACK;
 	addr.p = (uint64_t*) sabr_interpreter_get_variable_addr(inter, identifier);
+	if (!addr.p) return SABR_OPERR_UNDEFINED;
 	if (!sabr_interpreter_push(inter, addr)) return SABR_OPERR_STACK;
 	return SABR_OPERR_NONE;
 }
@@ -387,6 +663,88 @@ const uint32_t sabr_interpreter_op(op_ref)(sabr_interpreter_t* inter, sabr_bcop_
 	return sabr_interpreter_ref_variable(inter, identifier, (sabr_value_t*) addr.p);
 }
 
+const uint32_t sabr_interpreter_op(op_load_local)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index) {
+	if (!sabr_interpreter_push(inter, inter->frame[bcop.operand.u])) return SABR_OPERR_STACK;
+	return SABR_OPERR_NONE;
+}
+
+const uint32_t sabr_interpreter_op(op_store_local)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index) {
+	if (!sabr_interpreter_pop(inter, inter->frame + bcop.operand.u)) return SABR_OPERR_STACK;
+	return SABR_OPERR_NONE;
+}
+
+const uint32_t sabr_interpreter_op(op_addr_local)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index) {
+	sabr_value_t addr;
+	addr.p = (uint64_t*) (inter->frame + bcop.operand.u);
+	if (!sabr_interpreter_push(inter, addr)) return SABR_OPERR_STACK;
+	return SABR_OPERR_NONE;
+}
+
+const uint32_t sabr_interpreter_op(op_inc_local)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index) {
+	inter->frame[bcop.operand.u].i++;
+	return SABR_OPERR_NONE;
+}
+
+const uint32_t sabr_interpreter_op(op_dec_local)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index) {
+	inter->frame[bcop.operand.u].i--;
+	return SABR_OPERR_NONE;
+}
+
+const uint32_t sabr_interpreter_op(op_add_local)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index) {
+	sabr_value_t a;
+	if (!sabr_interpreter_pop(inter, &a)) return SABR_OPERR_STACK;
+	inter->frame[bcop.operand.u].i += a.i;
+	return SABR_OPERR_NONE;
+}
+
+const uint32_t sabr_interpreter_op(op_fadd_local)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index) {
+	sabr_value_t a;
+	if (!sabr_interpreter_pop(inter, &a)) return SABR_OPERR_STACK;
+	inter->frame[bcop.operand.u].f += a.f;
+	return SABR_OPERR_NONE;
+}
+
+const uint32_t sabr_interpreter_op(op_load_global)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index) {
+	if (!sabr_interpreter_push(inter, inter->globals[bcop.operand.u])) return SABR_OPERR_STACK;
+	return SABR_OPERR_NONE;
+}
+
+const uint32_t sabr_interpreter_op(op_store_global)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index) {
+	if (!sabr_interpreter_pop(inter, inter->globals + bcop.operand.u)) return SABR_OPERR_STACK;
+	return SABR_OPERR_NONE;
+}
+
+const uint32_t sabr_interpreter_op(op_addr_global)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index) {
+	sabr_value_t addr;
+	addr.p = (uint64_t*) (inter->globals + bcop.operand.u);
+	if (!sabr_interpreter_push(inter, addr)) return SABR_OPERR_STACK;
+	return SABR_OPERR_NONE;
+}
+
+const uint32_t sabr_interpreter_op(op_inc_global)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index) {
+	inter->globals[bcop.operand.u].i++;
+	return SABR_OPERR_NONE;
+}
+
+const uint32_t sabr_interpreter_op(op_dec_global)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index) {
+	inter->globals[bcop.operand.u].i--;
+	return SABR_OPERR_NONE;
+}
+
+const uint32_t sabr_interpreter_op(op_add_global)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index) {
+	sabr_value_t a;
+	if (!sabr_interpreter_pop(inter, &a)) return SABR_OPERR_STACK;
+	inter->globals[bcop.operand.u].i += a.i;
+	return SABR_OPERR_NONE;
+}
+
+const uint32_t sabr_interpreter_op(op_fadd_global)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index) {
+	sabr_value_t a;
+	if (!sabr_interpreter_pop(inter, &a)) return SABR_OPERR_STACK;
+	inter->globals[bcop.operand.u].f += a.f;
+	return SABR_OPERR_NONE;
+}
+
 const uint32_t sabr_interpreter_op(op_call_bif)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index) {
 	sabr_value_t module_index, func_index;
 	
@@ -458,7 +816,7 @@ const uint32_t sabr_interpreter_op(op_umod)(sabr_interpreter_t* inter, sabr_bcop
 	if (!sabr_interpreter_pop(inter, &b)) return SABR_OPERR_STACK;
 	if (!sabr_interpreter_pop(inter, &a)) return SABR_OPERR_STACK;
 	if (b.u == 0) return SABR_OPERR_DIV_BY_ZERO;
-	a.u = a.u / b.u;
+	a.u = a.u % b.u;
 	if (!sabr_interpreter_push(inter, a)) return SABR_OPERR_STACK;
 	return SABR_OPERR_NONE;
 }
@@ -487,6 +845,22 @@ const uint32_t sabr_interpreter_op(op_dec)(sabr_interpreter_t* inter, sabr_bcop_
 	return SABR_OPERR_NONE;
 }
 
+const uint32_t sabr_interpreter_op(op_add_imm)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index) {
+	sabr_value_t a;
+	if (!sabr_interpreter_pop(inter, &a)) return SABR_OPERR_STACK;
+	a.i = a.i + bcop.operand.i;
+	if (!sabr_interpreter_push(inter, a)) return SABR_OPERR_STACK;
+	return SABR_OPERR_NONE;
+}
+
+const uint32_t sabr_interpreter_op(op_mul_imm)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index) {
+	sabr_value_t a;
+	if (!sabr_interpreter_pop(inter, &a)) return SABR_OPERR_STACK;
+	a.i = a.i * bcop.operand.i;
+	if (!sabr_interpreter_push(inter, a)) return SABR_OPERR_STACK;
+	return SABR_OPERR_NONE;
+}
+
 const uint32_t sabr_interpreter_op(op_equ)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index) {
 	sabr_value_t a, b;
 	if (!sabr_interpreter_pop(inter, &b)) return SABR_OPERR_STACK;
@@ -577,6 +951,134 @@ const uint32_t sabr_interpreter_op(op_uleq)(sabr_interpreter_t* inter, sabr_bcop
 	return SABR_OPERR_NONE;
 }
 
+const uint32_t sabr_interpreter_op(op_lst_if)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index) {
+	sabr_value_t a, b;
+	if (!sabr_interpreter_pop(inter, &b)) return SABR_OPERR_STACK;
+	if (!sabr_interpreter_pop(inter, &a)) return SABR_OPERR_STACK;
+	if (!(a.i < b.i)) *index = bcop.operand.u - 1;
+	return SABR_OPERR_NONE;
+}
+
+const uint32_t sabr_interpreter_op(op_equ_if)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index) {
+	sabr_value_t a, b;
+	if (!sabr_interpreter_pop(inter, &b)) return SABR_OPERR_STACK;
+	if (!sabr_interpreter_pop(inter, &a)) return SABR_OPERR_STACK;
+	if (!(a.i == b.i)) *index = bcop.operand.u - 1;
+	return SABR_OPERR_NONE;
+}
+
+const uint32_t sabr_interpreter_op(op_neq_if)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index) {
+	sabr_value_t a, b;
+	if (!sabr_interpreter_pop(inter, &b)) return SABR_OPERR_STACK;
+	if (!sabr_interpreter_pop(inter, &a)) return SABR_OPERR_STACK;
+	if (!(a.i != b.i)) *index = bcop.operand.u - 1;
+	return SABR_OPERR_NONE;
+}
+
+const uint32_t sabr_interpreter_op(op_grt_if)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index) {
+	sabr_value_t a, b;
+	if (!sabr_interpreter_pop(inter, &b)) return SABR_OPERR_STACK;
+	if (!sabr_interpreter_pop(inter, &a)) return SABR_OPERR_STACK;
+	if (!(a.i > b.i)) *index = bcop.operand.u - 1;
+	return SABR_OPERR_NONE;
+}
+
+const uint32_t sabr_interpreter_op(op_geq_if)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index) {
+	sabr_value_t a, b;
+	if (!sabr_interpreter_pop(inter, &b)) return SABR_OPERR_STACK;
+	if (!sabr_interpreter_pop(inter, &a)) return SABR_OPERR_STACK;
+	if (!(a.i >= b.i)) *index = bcop.operand.u - 1;
+	return SABR_OPERR_NONE;
+}
+
+const uint32_t sabr_interpreter_op(op_leq_if)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index) {
+	sabr_value_t a, b;
+	if (!sabr_interpreter_pop(inter, &b)) return SABR_OPERR_STACK;
+	if (!sabr_interpreter_pop(inter, &a)) return SABR_OPERR_STACK;
+	if (!(a.i <= b.i)) *index = bcop.operand.u - 1;
+	return SABR_OPERR_NONE;
+}
+
+const uint32_t sabr_interpreter_op(op_ugrt_if)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index) {
+	sabr_value_t a, b;
+	if (!sabr_interpreter_pop(inter, &b)) return SABR_OPERR_STACK;
+	if (!sabr_interpreter_pop(inter, &a)) return SABR_OPERR_STACK;
+	if (!(a.u > b.u)) *index = bcop.operand.u - 1;
+	return SABR_OPERR_NONE;
+}
+
+const uint32_t sabr_interpreter_op(op_ugeq_if)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index) {
+	sabr_value_t a, b;
+	if (!sabr_interpreter_pop(inter, &b)) return SABR_OPERR_STACK;
+	if (!sabr_interpreter_pop(inter, &a)) return SABR_OPERR_STACK;
+	if (!(a.u >= b.u)) *index = bcop.operand.u - 1;
+	return SABR_OPERR_NONE;
+}
+
+const uint32_t sabr_interpreter_op(op_ulst_if)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index) {
+	sabr_value_t a, b;
+	if (!sabr_interpreter_pop(inter, &b)) return SABR_OPERR_STACK;
+	if (!sabr_interpreter_pop(inter, &a)) return SABR_OPERR_STACK;
+	if (!(a.u < b.u)) *index = bcop.operand.u - 1;
+	return SABR_OPERR_NONE;
+}
+
+const uint32_t sabr_interpreter_op(op_uleq_if)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index) {
+	sabr_value_t a, b;
+	if (!sabr_interpreter_pop(inter, &b)) return SABR_OPERR_STACK;
+	if (!sabr_interpreter_pop(inter, &a)) return SABR_OPERR_STACK;
+	if (!(a.u <= b.u)) *index = bcop.operand.u - 1;
+	return SABR_OPERR_NONE;
+}
+
+const uint32_t sabr_interpreter_op(op_equ_imm)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index) {
+	sabr_value_t a;
+	if (!sabr_interpreter_pop(inter, &a)) return SABR_OPERR_STACK;
+	a.u = (a.i == bcop.operand.i) ? -1 : 0;
+	if (!sabr_interpreter_push(inter, a)) return SABR_OPERR_STACK;
+	return SABR_OPERR_NONE;
+}
+
+const uint32_t sabr_interpreter_op(op_neq_imm)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index) {
+	sabr_value_t a;
+	if (!sabr_interpreter_pop(inter, &a)) return SABR_OPERR_STACK;
+	a.u = (a.i != bcop.operand.i) ? -1 : 0;
+	if (!sabr_interpreter_push(inter, a)) return SABR_OPERR_STACK;
+	return SABR_OPERR_NONE;
+}
+
+const uint32_t sabr_interpreter_op(op_grt_imm)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index) {
+	sabr_value_t a;
+	if (!sabr_interpreter_pop(inter, &a)) return SABR_OPERR_STACK;
+	a.u = (a.i > bcop.operand.i) ? -1 : 0;
+	if (!sabr_interpreter_push(inter, a)) return SABR_OPERR_STACK;
+	return SABR_OPERR_NONE;
+}
+
+const uint32_t sabr_interpreter_op(op_geq_imm)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index) {
+	sabr_value_t a;
+	if (!sabr_interpreter_pop(inter, &a)) return SABR_OPERR_STACK;
+	a.u = (a.i >= bcop.operand.i) ? -1 : 0;
+	if (!sabr_interpreter_push(inter, a)) return SABR_OPERR_STACK;
+	return SABR_OPERR_NONE;
+}
+
+const uint32_t sabr_interpreter_op(op_lst_imm)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index) {
+	sabr_value_t a;
+	if (!sabr_interpreter_pop(inter, &a)) return SABR_OPERR_STACK;
+	a.u = (a.i < bcop.operand.i) ? -1 : 0;
+	if (!sabr_interpreter_push(inter, a)) return SABR_OPERR_STACK;
+	return SABR_OPERR_NONE;
+}
+
+const uint32_t sabr_interpreter_op(op_leq_imm)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index) {
+	sabr_value_t a;
+	if (!sabr_interpreter_pop(inter, &a)) return SABR_OPERR_STACK;
+	a.u = (a.i <= bcop.operand.i) ? -1 : 0;
+	if (!sabr_interpreter_push(inter, a)) return SABR_OPERR_STACK;
+	return SABR_OPERR_NONE;
+}
+
 const uint32_t sabr_interpreter_op(op_fadd)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index) {
 	sabr_value_t a, b;
 	if (!sabr_interpreter_pop(inter, &b)) return SABR_OPERR_STACK;
@@ -686,6 +1188,54 @@ const uint32_t sabr_interpreter_op(op_fleq)(sabr_interpreter_t* inter, sabr_bcop
 	return SABR_OPERR_NONE;
 }
 
+const uint32_t sabr_interpreter_op(op_fequ_if)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index) {
+	sabr_value_t a, b;
+	if (!sabr_interpreter_pop(inter, &b)) return SABR_OPERR_STACK;
+	if (!sabr_interpreter_pop(inter, &a)) return SABR_OPERR_STACK;
+	if (!(a.f == b.f)) *index = bcop.operand.u - 1;
+	return SABR_OPERR_NONE;
+}
+
+const uint32_t sabr_interpreter_op(op_fneq_if)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index) {
+	sabr_value_t a, b;
+	if (!sabr_interpreter_pop(inter, &b)) return SABR_OPERR_STACK;
+	if (!sabr_interpreter_pop(inter, &a)) return SABR_OPERR_STACK;
+	if (!(a.f != b.f)) *index = bcop.operand.u - 1;
+	return SABR_OPERR_NONE;
+}
+
+const uint32_t sabr_interpreter_op(op_fgrt_if)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index) {
+	sabr_value_t a, b;
+	if (!sabr_interpreter_pop(inter, &b)) return SABR_OPERR_STACK;
+	if (!sabr_interpreter_pop(inter, &a)) return SABR_OPERR_STACK;
+	if (!(a.f > b.f)) *index = bcop.operand.u - 1;
+	return SABR_OPERR_NONE;
+}
+
+const uint32_t sabr_interpreter_op(op_fgeq_if)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index) {
+	sabr_value_t a, b;
+	if (!sabr_interpreter_pop(inter, &b)) return SABR_OPERR_STACK;
+	if (!sabr_interpreter_pop(inter, &a)) return SABR_OPERR_STACK;
+	if (!(a.f >= b.f)) *index = bcop.operand.u - 1;
+	return SABR_OPERR_NONE;
+}
+
+const uint32_t sabr_interpreter_op(op_flst_if)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index) {
+	sabr_value_t a, b;
+	if (!sabr_interpreter_pop(inter, &b)) return SABR_OPERR_STACK;
+	if (!sabr_interpreter_pop(inter, &a)) return SABR_OPERR_STACK;
+	if (!(a.f < b.f)) *index = bcop.operand.u - 1;
+	return SABR_OPERR_NONE;
+}
+
+const uint32_t sabr_interpreter_op(op_fleq_if)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index) {
+	sabr_value_t a, b;
+	if (!sabr_interpreter_pop(inter, &b)) return SABR_OPERR_STACK;
+	if (!sabr_interpreter_pop(inter, &a)) return SABR_OPERR_STACK;
+	if (!(a.f <= b.f)) *index = bcop.operand.u - 1;
+	return SABR_OPERR_NONE;
+}
+
 const uint32_t sabr_interpreter_op(op_band)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index) {
 	sabr_value_t a, b;
 	if (!sabr_interpreter_pop(inter, &b)) return SABR_OPERR_STACK;
@@ -739,6 +1289,30 @@ const uint32_t sabr_interpreter_op(op_brsft)(sabr_interpreter_t* inter, sabr_bco
 	return SABR_OPERR_NONE;
 }
 
+const uint32_t sabr_interpreter_op(op_band_imm)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index) {
+	sabr_value_t a;
+	if (!sabr_interpreter_pop(inter, &a)) return SABR_OPERR_STACK;
+	a.u = a.u & bcop.operand.u;
+	if (!sabr_interpreter_push(inter, a)) return SABR_OPERR_STACK;
+	return SABR_OPERR_NONE;
+}
+
+const uint32_t sabr_interpreter_op(op_blsft_imm)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index) {
+	sabr_value_t a;
+	if (!sabr_interpreter_pop(inter, &a)) return SABR_OPERR_STACK;
+	a.u = a.u << bcop.operand.u;
+	if (!sabr_interpreter_push(inter, a)) return SABR_OPERR_STACK;
+	return SABR_OPERR_NONE;
+}
+
+const uint32_t sabr_interpreter_op(op_brsft_imm)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index) {
+	sabr_value_t a;
+	if (!sabr_interpreter_pop(inter, &a)) return SABR_OPERR_STACK;
+	a.u = a.u >> bcop.operand.u;
+	if (!sabr_interpreter_push(inter, a)) return SABR_OPERR_STACK;
+	return SABR_OPERR_NONE;
+}
+
 const uint32_t sabr_interpreter_op(op_drop)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index) {
 	sabr_value_t a;
 	if (!sabr_interpreter_pop(inter, &a)) return SABR_OPERR_STACK;
@@ -874,19 +1448,22 @@ const uint32_t sabr_interpreter_op(op_tswap)(sabr_interpreter_t* inter, sabr_bco
 }
 
 const uint32_t sabr_interpreter_op(op_trot)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index) {
-	sabr_value_t a, b, c, d, e, f;
-	if (!sabr_interpreter_pop(inter, &e)) return SABR_OPERR_STACK;
-	if (!sabr_interpreter_pop(inter, &f)) return SABR_OPERR_STACK;
-	if (!sabr_interpreter_pop(inter, &d)) return SABR_OPERR_STACK;
-	if (!sabr_interpreter_pop(inter, &c)) return SABR_OPERR_STACK;
-	if (!sabr_interpreter_pop(inter, &b)) return SABR_OPERR_STACK;
-	if (!sabr_interpreter_pop(inter, &a)) return SABR_OPERR_STACK;
-	if (!sabr_interpreter_push(inter, c)) return SABR_OPERR_STACK;
-	if (!sabr_interpreter_push(inter, d)) return SABR_OPERR_STACK;
-	if (!sabr_interpreter_push(inter, e)) return SABR_OPERR_STACK;
-	if (!sabr_interpreter_push(inter, f)) return SABR_OPERR_STACK;
-	if (!sabr_interpreter_push(inter, a)) return SABR_OPERR_STACK;
-	if (!sabr_interpreter_push(inter, b)) return SABR_OPERR_STACK;
+	sabr_value_t a, b;
+	sabr_value_t* top;
+	if (inter->data_stack.size < 6) {
+		inter->data_stack.size = 0;
+		sabr_interpreter_stack_underflow();
+		return SABR_OPERR_STACK;
+	}
+	top = inter->data_stack.data + inter->data_stack.size - 6;
+	a = top[0];
+	b = top[1];
+	top[0] = top[2];
+	top[1] = top[3];
+	top[2] = top[5];
+	top[3] = top[4];
+	top[4] = a;
+	top[5] = b;
 	return SABR_OPERR_NONE;
 }
 
@@ -926,8 +1503,9 @@ const uint32_t sabr_interpreter_op(op_allot)(sabr_interpreter_t* inter, sabr_bco
 
 	if (inter->local_data_stack.size > 0) {
 		p = sabr_memory_pool_top(&inter->memory_pool);
-		size_t* local_memory_size = &(sabr_interpreter_get_local_data(inter)->local_memory_size);
-		*local_memory_size += alloted_size;
+		sabr_local_data_t* local_data = sabr_interpreter_get_local_data(inter);
+		local_data->local_memory_size += alloted_size;
+		local_data->alloted = true;
 		if (!sabr_memory_pool_alloc(&inter->memory_pool, alloted_size)) return SABR_OPERR_MEMORY;
 	}
 	else {
@@ -959,6 +1537,230 @@ const uint32_t sabr_interpreter_op(op_store)(sabr_interpreter_t* inter, sabr_bco
 	return SABR_OPERR_NONE;
 }
 
+const uint32_t sabr_interpreter_op(op_inc_mem)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index) {
+	sabr_value_t a, addr;
+	if (!sabr_interpreter_pop(inter, &addr)) return SABR_OPERR_STACK;
+	a.u = *addr.p;
+	a.i++;
+	*addr.p = a.u;
+	return SABR_OPERR_NONE;
+}
+
+const uint32_t sabr_interpreter_op(op_dec_mem)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index) {
+	sabr_value_t a, addr;
+	if (!sabr_interpreter_pop(inter, &addr)) return SABR_OPERR_STACK;
+	a.u = *addr.p;
+	a.i--;
+	*addr.p = a.u;
+	return SABR_OPERR_NONE;
+}
+
+const uint32_t sabr_interpreter_op(op_add_mem)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index) {
+	sabr_value_t a, b, addr;
+	if (!sabr_interpreter_pop(inter, &addr)) return SABR_OPERR_STACK;
+	if (!sabr_interpreter_pop(inter, &b)) return SABR_OPERR_STACK;
+	a.u = *addr.p;
+	a.i = a.i + b.i;
+	*addr.p = a.u;
+	return SABR_OPERR_NONE;
+}
+
+const uint32_t sabr_interpreter_op(op_sub_mem)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index) {
+	sabr_value_t a, b, addr;
+	if (!sabr_interpreter_pop(inter, &addr)) return SABR_OPERR_STACK;
+	if (!sabr_interpreter_pop(inter, &b)) return SABR_OPERR_STACK;
+	a.u = *addr.p;
+	a.i = a.i - b.i;
+	*addr.p = a.u;
+	return SABR_OPERR_NONE;
+}
+
+const uint32_t sabr_interpreter_op(op_mul_mem)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index) {
+	sabr_value_t a, b, addr;
+	if (!sabr_interpreter_pop(inter, &addr)) return SABR_OPERR_STACK;
+	if (!sabr_interpreter_pop(inter, &b)) return SABR_OPERR_STACK;
+	a.u = *addr.p;
+	a.i = a.i * b.i;
+	*addr.p = a.u;
+	return SABR_OPERR_NONE;
+}
+
+const uint32_t sabr_interpreter_op(op_div_mem)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index) {
+	sabr_value_t a, b, addr;
+	if (!sabr_interpreter_pop(inter, &addr)) return SABR_OPERR_STACK;
+	if (!sabr_interpreter_pop(inter, &b)) return SABR_OPERR_STACK;
+	if (b.i == 0) return SABR_OPERR_DIV_BY_ZERO;
+	a.u = *addr.p;
+	a.i = a.i / b.i;
+	*addr.p = a.u;
+	return SABR_OPERR_NONE;
+}
+
+const uint32_t sabr_interpreter_op(op_mod_mem)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index) {
+	sabr_value_t a, b, addr;
+	if (!sabr_interpreter_pop(inter, &addr)) return SABR_OPERR_STACK;
+	if (!sabr_interpreter_pop(inter, &b)) return SABR_OPERR_STACK;
+	if (b.i == 0) return SABR_OPERR_DIV_BY_ZERO;
+	a.u = *addr.p;
+	a.i = a.i % b.i;
+	*addr.p = a.u;
+	return SABR_OPERR_NONE;
+}
+
+const uint32_t sabr_interpreter_op(op_fadd_mem)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index) {
+	sabr_value_t a, b, addr;
+	if (!sabr_interpreter_pop(inter, &addr)) return SABR_OPERR_STACK;
+	if (!sabr_interpreter_pop(inter, &b)) return SABR_OPERR_STACK;
+	a.u = *addr.p;
+	a.f = a.f + b.f;
+	*addr.p = a.u;
+	return SABR_OPERR_NONE;
+}
+
+const uint32_t sabr_interpreter_op(op_fsub_mem)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index) {
+	sabr_value_t a, b, addr;
+	if (!sabr_interpreter_pop(inter, &addr)) return SABR_OPERR_STACK;
+	if (!sabr_interpreter_pop(inter, &b)) return SABR_OPERR_STACK;
+	a.u = *addr.p;
+	a.f = a.f - b.f;
+	*addr.p = a.u;
+	return SABR_OPERR_NONE;
+}
+
+const uint32_t sabr_interpreter_op(op_fmul_mem)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index) {
+	sabr_value_t a, b, addr;
+	if (!sabr_interpreter_pop(inter, &addr)) return SABR_OPERR_STACK;
+	if (!sabr_interpreter_pop(inter, &b)) return SABR_OPERR_STACK;
+	a.u = *addr.p;
+	a.f = a.f * b.f;
+	*addr.p = a.u;
+	return SABR_OPERR_NONE;
+}
+
+const uint32_t sabr_interpreter_op(op_fdiv_mem)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index) {
+	sabr_value_t a, b, addr;
+	if (!sabr_interpreter_pop(inter, &addr)) return SABR_OPERR_STACK;
+	if (!sabr_interpreter_pop(inter, &b)) return SABR_OPERR_STACK;
+	if (b.f == 0.0f) return SABR_OPERR_DIV_BY_ZERO;
+	a.u = *addr.p;
+	a.f = a.f / b.f;
+	*addr.p = a.u;
+	return SABR_OPERR_NONE;
+}
+
+const uint32_t sabr_interpreter_op(op_fmod_mem)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index) {
+	sabr_value_t a, b, addr;
+	if (!sabr_interpreter_pop(inter, &addr)) return SABR_OPERR_STACK;
+	if (!sabr_interpreter_pop(inter, &b)) return SABR_OPERR_STACK;
+	if (b.f == 0.0f) return SABR_OPERR_DIV_BY_ZERO;
+	a.u = *addr.p;
+	a.f = fmod(a.f, b.f);
+	*addr.p = a.u;
+	return SABR_OPERR_NONE;
+}
+
+const uint32_t sabr_interpreter_op(op_band_mem)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index) {
+	sabr_value_t a, b, addr;
+	if (!sabr_interpreter_pop(inter, &addr)) return SABR_OPERR_STACK;
+	if (!sabr_interpreter_pop(inter, &b)) return SABR_OPERR_STACK;
+	a.u = *addr.p;
+	a.u = a.u & b.u;
+	*addr.p = a.u;
+	return SABR_OPERR_NONE;
+}
+
+const uint32_t sabr_interpreter_op(op_bor_mem)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index) {
+	sabr_value_t a, b, addr;
+	if (!sabr_interpreter_pop(inter, &addr)) return SABR_OPERR_STACK;
+	if (!sabr_interpreter_pop(inter, &b)) return SABR_OPERR_STACK;
+	a.u = *addr.p;
+	a.u = a.u | b.u;
+	*addr.p = a.u;
+	return SABR_OPERR_NONE;
+}
+
+const uint32_t sabr_interpreter_op(op_bxor_mem)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index) {
+	sabr_value_t a, b, addr;
+	if (!sabr_interpreter_pop(inter, &addr)) return SABR_OPERR_STACK;
+	if (!sabr_interpreter_pop(inter, &b)) return SABR_OPERR_STACK;
+	a.u = *addr.p;
+	a.u = a.u ^ b.u;
+	*addr.p = a.u;
+	return SABR_OPERR_NONE;
+}
+
+const uint32_t sabr_interpreter_op(op_bnot_mem)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index) {
+	sabr_value_t a, addr;
+	if (!sabr_interpreter_pop(inter, &addr)) return SABR_OPERR_STACK;
+	a.u = *addr.p;
+	a.u = ~a.u;
+	*addr.p = a.u;
+	return SABR_OPERR_NONE;
+}
+
+const uint32_t sabr_interpreter_op(op_blsft_mem)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index) {
+	sabr_value_t a, b, addr;
+	if (!sabr_interpreter_pop(inter, &addr)) return SABR_OPERR_STACK;
+	if (!sabr_interpreter_pop(inter, &b)) return SABR_OPERR_STACK;
+	a.u = *addr.p;
+	a.u = a.u << b.u;
+	*addr.p = a.u;
+	return SABR_OPERR_NONE;
+}
+
+const uint32_t sabr_interpreter_op(op_brsft_mem)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index) {
+	sabr_value_t a, b, addr;
+	if (!sabr_interpreter_pop(inter, &addr)) return SABR_OPERR_STACK;
+	if (!sabr_interpreter_pop(inter, &b)) return SABR_OPERR_STACK;
+	a.u = *addr.p;
+	a.u = a.u >> b.u;
+	*addr.p = a.u;
+	return SABR_OPERR_NONE;
+}
+
+const uint32_t sabr_interpreter_op(op_index_cell)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index) {
+	sabr_value_t a, b;
+	if (!sabr_interpreter_pop(inter, &b)) return SABR_OPERR_STACK;
+	if (!sabr_interpreter_pop(inter, &a)) return SABR_OPERR_STACK;
+	b.u = b.u + a.u * sizeof(sabr_value_t);
+	if (!sabr_interpreter_push(inter, b)) return SABR_OPERR_STACK;
+	return SABR_OPERR_NONE;
+}
+
+const uint32_t sabr_interpreter_op(op_fetch_idx)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index) {
+	sabr_value_t a, b;
+	if (!sabr_interpreter_pop(inter, &b)) return SABR_OPERR_STACK;
+	if (!sabr_interpreter_pop(inter, &a)) return SABR_OPERR_STACK;
+	a.u = b.p[a.u];
+	if (!sabr_interpreter_push(inter, a)) return SABR_OPERR_STACK;
+	return SABR_OPERR_NONE;
+}
+
+const uint32_t sabr_interpreter_op(op_store_idx)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index) {
+	sabr_value_t a, b, c;
+	if (!sabr_interpreter_pop(inter, &c)) return SABR_OPERR_STACK;
+	if (!sabr_interpreter_pop(inter, &b)) return SABR_OPERR_STACK;
+	if (!sabr_interpreter_pop(inter, &a)) return SABR_OPERR_STACK;
+	c.p[b.u] = a.u;
+	return SABR_OPERR_NONE;
+}
+
+const uint32_t sabr_interpreter_op(op_fetch_off)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index) {
+	sabr_value_t a;
+	if (!sabr_interpreter_pop(inter, &a)) return SABR_OPERR_STACK;
+	a.u = *(uint64_t*) (a.u + bcop.operand.u);
+	if (!sabr_interpreter_push(inter, a)) return SABR_OPERR_STACK;
+	return SABR_OPERR_NONE;
+}
+
+const uint32_t sabr_interpreter_op(op_store_off)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index) {
+	sabr_value_t a, b;
+	if (!sabr_interpreter_pop(inter, &b)) return SABR_OPERR_STACK;
+	if (!sabr_interpreter_pop(inter, &a)) return SABR_OPERR_STACK;
+	*(uint64_t*) (b.u + bcop.operand.u) = a.u;
+	return SABR_OPERR_NONE;
+}
+
 const uint32_t sabr_interpreter_op(op_array)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index) {
 	vector(sabr_value_t)* current_array = (vector(sabr_value_t)*) malloc(sizeof(vector(sabr_value_t)));
 	if (!current_array) return SABR_OPERR_MEMORY;
@@ -998,8 +1800,9 @@ const uint32_t sabr_interpreter_op(op_array_end)(sabr_interpreter_t* inter, sabr
 
 	if (inter->local_data_stack.size > 0) {
 		p = sabr_memory_pool_top(&inter->memory_pool);
-		size_t* local_memory_size = &(sabr_interpreter_get_local_data(inter)->local_memory_size);
-		*local_memory_size += alloted_size;
+		sabr_local_data_t* local_data = sabr_interpreter_get_local_data(inter);
+		local_data->local_memory_size += alloted_size;
+		local_data->alloted = true;
 		if (!sabr_memory_pool_alloc(&inter->memory_pool, alloted_size)) return SABR_OPERR_MEMORY;
 	}
 	else {
@@ -1135,7 +1938,7 @@ const uint32_t sabr_interpreter_op(op_puts)(sabr_interpreter_t* inter, sabr_bcop
 const uint32_t sabr_interpreter_op(op_show)(sabr_interpreter_t* inter, sabr_bcop_t bcop, size_t* index) {
 	printf("[%zu] [ ", inter->data_stack.size);
 	for (size_t i = 0; i < inter->data_stack.size; i++) {
-		printf("%" PRId64 " ", (*deque_at(sabr_value_t, &inter->data_stack, i)).i);
+		printf("%" PRId64 " ", inter->data_stack.data[i].i);
 	}
 	puts("]");
 
@@ -1148,28 +1951,67 @@ const uint32_t (*sabr_interpreter_op_functions[])(sabr_interpreter_t*, sabr_bcop
 	sabr_interpreter_op(op_if),
 	sabr_interpreter_op(op_jump),
 	sabr_interpreter_op(op_for),
+	sabr_interpreter_op(op_for_addr),
 	sabr_interpreter_op(op_for_from),
 	sabr_interpreter_op(op_for_to),
 	sabr_interpreter_op(op_for_step),
 	sabr_interpreter_op(op_for_check),
 	sabr_interpreter_op(op_for_next),
 	sabr_interpreter_op(op_for_end),
+	sabr_interpreter_op(op_for_init),
+	sabr_interpreter_op(op_for_to_i),
+	sabr_interpreter_op(op_for_to_u),
+	sabr_interpreter_op(op_for_to_f),
+	sabr_interpreter_op(op_for_enter_i),
+	sabr_interpreter_op(op_for_enter_u),
+	sabr_interpreter_op(op_for_enter_f),
+	sabr_interpreter_op(op_for_loop_i),
+	sabr_interpreter_op(op_for_loop_u),
+	sabr_interpreter_op(op_for_loop_f),
+	sabr_interpreter_op(op_for_up_i),
+	sabr_interpreter_op(op_for_up_u),
+	sabr_interpreter_op(op_for_up_f),
+	sabr_interpreter_op(op_for_down_i),
+	sabr_interpreter_op(op_for_down_u),
+	sabr_interpreter_op(op_for_down_f),
+	sabr_interpreter_op(op_for_leave),
 	sabr_interpreter_op(op_switch),
 	sabr_interpreter_op(op_switch_case),
 	sabr_interpreter_op(op_switch_end),
+	sabr_interpreter_op(op_case_if),
+	sabr_interpreter_op(op_switch_table),
+	sabr_interpreter_op(op_switch_search),
 	sabr_interpreter_op(op_lambda),
 	sabr_interpreter_op(op_return),
 	sabr_interpreter_op(op_local),
 	sabr_interpreter_op(op_local_end),
 	sabr_interpreter_op(op_define),
+	sabr_interpreter_op(op_inline),
+	sabr_interpreter_op(op_noinline),
 	sabr_interpreter_op(op_datagroup),
 	sabr_interpreter_op(op_member),
 	sabr_interpreter_op(op_datagroup_end),
 	sabr_interpreter_op(op_datagroup_exec),
 	sabr_interpreter_op(op_set),
 	sabr_interpreter_op(op_exec),
+	sabr_interpreter_op(op_call),
+	sabr_interpreter_op(op_tailcall),
 	sabr_interpreter_op(op_addr),
 	sabr_interpreter_op(op_ref),
+	sabr_interpreter_op(op_load_local),
+	sabr_interpreter_op(op_store_local),
+	sabr_interpreter_op(op_addr_local),
+	sabr_interpreter_op(op_inc_local),
+	sabr_interpreter_op(op_dec_local),
+	sabr_interpreter_op(op_add_local),
+	sabr_interpreter_op(op_fadd_local),
+	sabr_interpreter_op(op_load_global),
+	sabr_interpreter_op(op_store_global),
+	sabr_interpreter_op(op_addr_global),
+	sabr_interpreter_op(op_inc_global),
+	sabr_interpreter_op(op_dec_global),
+	sabr_interpreter_op(op_add_global),
+	sabr_interpreter_op(op_fadd_global),
 	sabr_interpreter_op(op_call_bif),
 	sabr_interpreter_op(op_add),
 	sabr_interpreter_op(op_sub),
@@ -1181,6 +2023,8 @@ const uint32_t (*sabr_interpreter_op_functions[])(sabr_interpreter_t*, sabr_bcop
 	sabr_interpreter_op(op_neg),
 	sabr_interpreter_op(op_inc),
 	sabr_interpreter_op(op_dec),
+	sabr_interpreter_op(op_add_imm),
+	sabr_interpreter_op(op_mul_imm),
 	sabr_interpreter_op(op_equ),
 	sabr_interpreter_op(op_neq),
 	sabr_interpreter_op(op_grt),
@@ -1191,6 +2035,22 @@ const uint32_t (*sabr_interpreter_op_functions[])(sabr_interpreter_t*, sabr_bcop
 	sabr_interpreter_op(op_ugeq),
 	sabr_interpreter_op(op_ulst),
 	sabr_interpreter_op(op_uleq),
+	sabr_interpreter_op(op_lst_if),
+	sabr_interpreter_op(op_equ_if),
+	sabr_interpreter_op(op_neq_if),
+	sabr_interpreter_op(op_grt_if),
+	sabr_interpreter_op(op_geq_if),
+	sabr_interpreter_op(op_leq_if),
+	sabr_interpreter_op(op_ugrt_if),
+	sabr_interpreter_op(op_ugeq_if),
+	sabr_interpreter_op(op_ulst_if),
+	sabr_interpreter_op(op_uleq_if),
+	sabr_interpreter_op(op_equ_imm),
+	sabr_interpreter_op(op_neq_imm),
+	sabr_interpreter_op(op_grt_imm),
+	sabr_interpreter_op(op_geq_imm),
+	sabr_interpreter_op(op_lst_imm),
+	sabr_interpreter_op(op_leq_imm),
 	sabr_interpreter_op(op_fadd),
 	sabr_interpreter_op(op_fsub),
 	sabr_interpreter_op(op_fmul),
@@ -1203,12 +2063,21 @@ const uint32_t (*sabr_interpreter_op_functions[])(sabr_interpreter_t*, sabr_bcop
 	sabr_interpreter_op(op_fgeq),
 	sabr_interpreter_op(op_flst),
 	sabr_interpreter_op(op_fleq),
+	sabr_interpreter_op(op_fequ_if),
+	sabr_interpreter_op(op_fneq_if),
+	sabr_interpreter_op(op_fgrt_if),
+	sabr_interpreter_op(op_fgeq_if),
+	sabr_interpreter_op(op_flst_if),
+	sabr_interpreter_op(op_fleq_if),
 	sabr_interpreter_op(op_band),
 	sabr_interpreter_op(op_bor),
 	sabr_interpreter_op(op_bxor),
 	sabr_interpreter_op(op_bnot),
 	sabr_interpreter_op(op_blsft),
 	sabr_interpreter_op(op_brsft),
+	sabr_interpreter_op(op_band_imm),
+	sabr_interpreter_op(op_blsft_imm),
+	sabr_interpreter_op(op_brsft_imm),
 	sabr_interpreter_op(op_drop),
 	sabr_interpreter_op(op_nip),
 	sabr_interpreter_op(op_dup),
@@ -1229,6 +2098,29 @@ const uint32_t (*sabr_interpreter_op_functions[])(sabr_interpreter_t*, sabr_bcop
 	sabr_interpreter_op(op_allot),
 	sabr_interpreter_op(op_fetch),
 	sabr_interpreter_op(op_store),
+	sabr_interpreter_op(op_inc_mem),
+	sabr_interpreter_op(op_dec_mem),
+	sabr_interpreter_op(op_add_mem),
+	sabr_interpreter_op(op_sub_mem),
+	sabr_interpreter_op(op_mul_mem),
+	sabr_interpreter_op(op_div_mem),
+	sabr_interpreter_op(op_mod_mem),
+	sabr_interpreter_op(op_fadd_mem),
+	sabr_interpreter_op(op_fsub_mem),
+	sabr_interpreter_op(op_fmul_mem),
+	sabr_interpreter_op(op_fdiv_mem),
+	sabr_interpreter_op(op_fmod_mem),
+	sabr_interpreter_op(op_band_mem),
+	sabr_interpreter_op(op_bor_mem),
+	sabr_interpreter_op(op_bxor_mem),
+	sabr_interpreter_op(op_bnot_mem),
+	sabr_interpreter_op(op_blsft_mem),
+	sabr_interpreter_op(op_brsft_mem),
+	sabr_interpreter_op(op_index_cell),
+	sabr_interpreter_op(op_fetch_idx),
+	sabr_interpreter_op(op_store_idx),
+	sabr_interpreter_op(op_fetch_off),
+	sabr_interpreter_op(op_store_off),
 	sabr_interpreter_op(op_array),
 	sabr_interpreter_op(op_array_comma),
 	sabr_interpreter_op(op_array_end),
@@ -0,0 +1,958 @@
+#include "interpreter_register.h"
+
+#define SABR_REGISTER_SPILL() (inter->data_stack.size = bases[SABR_REGISTER_BASE_STACK] - base)
+#define SABR_REGISTER_FILL() do { \
+	bases[SABR_REGISTER_BASE_STACK] = base + inter->data_stack.size; \
+	bases[SABR_REGISTER_BASE_FRAME] = inter->frame; \
+} while (0)
+
+#define SABR_REGISTER_RESUME() do { \
+	if (index < size && tr.map[index] != SIZE_MAX) SABR_THREADED_JUMP(tr.map[index]); \
+	end = 0; \
+	goto RESUME; \
+} while (0)
+
+#define SABR_REGISTER_UNARY(EXPR) { \
+	sabr_value_t a = SABR_REGISTER_AT(ip->lhs); \
+	EXPR; \
+	SABR_REGISTER_AT(ip->dst) = a; \
+} SABR_THREADED_NEXT()
+
+#define SABR_REGISTER_BINARY(EXPR) { \
+	sabr_value_t a = SABR_REGISTER_AT(ip->lhs); \
+	sabr_value_t b = SABR_REGISTER_AT(ip->rhs); \
+	EXPR; \
+	SABR_REGISTER_AT(ip->dst) = a; \
+} SABR_THREADED_NEXT()
+
+#define SABR_REGISTER_IMMEDIATE(EXPR) { \
+	sabr_value_t a = SABR_REGISTER_AT(ip->lhs); \
+	sabr_value_t b = ip->operand; \
+	EXPR; \
+	SABR_REGISTER_AT(ip->dst) = a; \
+} SABR_THREADED_NEXT()
+
+#define SABR_REGISTER_DIVISION(CHECK, EXPR) { \
+	sabr_value_t a = SABR_REGISTER_AT(ip->lhs); \
+	sabr_value_t b = SABR_REGISTER_AT(ip->rhs); \
+	if (sabr_threaded_unlikely(CHECK)) SABR_THREADED_FAIL(SABR_OPERR_DIV_BY_ZERO); \
+	EXPR; \
+	SABR_REGISTER_AT(ip->dst) = a; \
+} SABR_THREADED_NEXT()
+
+#define SABR_REGISTER_BRANCH(COND) { \
+	sabr_value_t a = SABR_REGISTER_AT(ip->lhs); \
+	sabr_value_t b = SABR_REGISTER_AT(ip->rhs); \
+	if (!(COND)) SABR_THREADED_JUMP(ip->operand.u); \
+} SABR_THREADED_NEXT()
+
+#define SABR_REGISTER_MEMORY_UNARY(EXPR) { \
+	uint64_t* p = SABR_REGISTER_AT(ip->lhs).p; \
+	sabr_value_t a = { .u = *p }; \
+	EXPR; \
+	*p = a.u; \
+} SABR_THREADED_NEXT()
+
+#define SABR_REGISTER_MEMORY_BINARY(EXPR) { \
+	uint64_t* p = SABR_REGISTER_AT(ip->lhs).p; \
+	sabr_value_t a = { .u = *p }; \
+	sabr_value_t b = SABR_REGISTER_AT(ip->rhs); \
+	EXPR; \
+	*p = a.u; \
+} SABR_THREADED_NEXT()
+
+#define SABR_REGISTER_MEMORY_DIVISION(CHECK, EXPR) { \
+	uint64_t* p = SABR_REGISTER_AT(ip->lhs).p; \
+	sabr_value_t a = { .u = *p }; \
+	sabr_value_t b = SABR_REGISTER_AT(ip->rhs); \
+	if (sabr_threaded_unlikely(CHECK)) SABR_THREADED_FAIL(SABR_OPERR_DIV_BY_ZERO); \
+	EXPR; \
+	*p = a.u; \
+} SABR_THREADED_NEXT()
+
+bool sabr_interpreter_run_bytecode_register(sabr_interpreter_t* inter, sabr_bytecode_t* bc) {
+	bool succeed = false;
+	uint32_t result = SABR_OPERR_NONE;
+	sabr_register_translator_t tr;
+	sabr_register_op_t* stream = NULL;
+	sabr_register_op_t* ip = NULL;
+	size_t size = bc->bcop_vec.size;
+	size_t index = 0;
+	size_t end = 0;
+
+	sabr_value_t* base = inter->data_stack.data;
+	sabr_value_t* bases[SABR_REGISTER_BASE_COUNT];
+	size_t capacity = inter->data_stack.capacity;
+
+#if !defined(SABR_THREADED_COMPUTED_GOTO)
+	uint32_t oc;
+#endif
+
+#if defined(SABR_THREADED_COMPUTED_GOTO)
+	static const void* labels[] = { SABR_REGISTER_BIND_ALL };
+#endif
+
+	if (!sabr_register_translate(&tr, bc)) goto FREE_ALL;
+	if (!tr.supported) {
+		sabr_register_translator_free(&tr);
+		return sabr_interpreter_run_bytecode_threaded(inter, bc);
+	}
+	stream = tr.ops;
+#if defined(SABR_THREADED_COMPUTED_GOTO)
+	for (size_t i = 0; i < tr.op_count; i++) stream[i].label = labels[stream[i].oc];
+#endif
+
+	bases[SABR_REGISTER_BASE_STACK] = base + inter->data_stack.size;
+	bases[SABR_REGISTER_BASE_FRAME] = inter->frame;
+	bases[SABR_REGISTER_BASE_GLOBAL] = inter->globals;
+	bases[SABR_REGISTER_BASE_CONST] = tr.consts;
+
+	ip = stream;
+	SABR_THREADED_DISPATCH();
+
+#if !defined(SABR_THREADED_COMPUTED_GOTO)
+DISPATCH:
+	oc = ip->oc;
+	switch (oc) {
+#endif
+
+	SABR_THREADED_CASE(SABR_REGISTER_OP_ENTER): {
+		sabr_block_data_t* block = vector_at(sabr_block_data_t, &tr.blocks, ip->operand.u);
+		size_t depth = bases[SABR_REGISTER_BASE_STACK] - base;
+		if (sabr_threaded_unlikely(depth < block->need || block->grow > capacity - depth)) {
+			index = block->begin;
+			end = block->end;
+			goto RESUME;
+		}
+	} SABR_THREADED_NEXT();
+
+	SABR_THREADED_CASE(SABR_REGISTER_OP_GENERIC): {
+		sabr_bcop_t bcop = *vector_at(sabr_bcop_t, &bc->bcop_vec, ip->index);
+		index = ip->index;
+		SABR_REGISTER_SPILL();
+		result = sabr_interpreter_op_functions[bcop.oc - 1](inter, bcop, &index);
+		SABR_REGISTER_FILL();
+		if (sabr_threaded_unlikely(result)) {
+			fprintf(stderr, "result: %u, index: %zu\n", result, index);
+			goto FREE_ALL;
+		}
+		if (index == ip->index) SABR_THREADED_NEXT();
+		index++;
+		SABR_REGISTER_RESUME();
+	}
+
+	SABR_THREADED_CASE(SABR_REGISTER_OP_MOVE):
+		SABR_REGISTER_AT(ip->dst) = SABR_REGISTER_AT(ip->lhs);
+		SABR_THREADED_NEXT();
+
+	SABR_THREADED_CASE(SABR_REGISTER_OP_EXCHANGE): {
+		sabr_value_t a = SABR_REGISTER_AT(ip->lhs);
+		SABR_REGISTER_AT(ip->lhs) = SABR_REGISTER_AT(ip->rhs);
+		SABR_REGISTER_AT(ip->rhs) = a;
+	} SABR_THREADED_NEXT();
+
+	SABR_THREADED_CASE(SABR_REGISTER_OP_ADJUST):
+		bases[SABR_REGISTER_BASE_STACK] += ip->operand.i;
+		SABR_THREADED_NEXT();
+
+	SABR_THREADED_CASE(SABR_OP_EXIT):
+		succeed = true;
+		goto FREE_ALL;
+
+	SABR_THREADED_CASE(SABR_OP_IF):
+		if (!SABR_REGISTER_AT(ip->lhs).u) SABR_THREADED_JUMP(ip->operand.u);
+		SABR_THREADED_NEXT();
+
+	SABR_THREADED_CASE(SABR_OP_JUMP):
+		SABR_THREADED_JUMP(ip->operand.u);
+
+	SABR_THREADED_CASE(SABR_OP_FOR_LOOP_I): SABR_THREADED_FOR(i, (record->step.i > 0) ? v->i < record->end.i : v->i > record->end.i);
+	SABR_THREADED_CASE(SABR_OP_FOR_LOOP_U): SABR_THREADED_FOR(u, (record->step.u > 0) ? v->u < record->end.u : v->u > record->end.u);
+	SABR_THREADED_CASE(SABR_OP_FOR_LOOP_F): SABR_THREADED_FOR(f, (record->step.f > 0.0) ? v->f < record->end.f : v->f > record->end.f);
+	SABR_THREADED_CASE(SABR_OP_FOR_UP_I): SABR_THREADED_FOR(i, v->i < record->end.i);
+	SABR_THREADED_CASE(SABR_OP_FOR_UP_U): SABR_THREADED_FOR(u, v->u < record->end.u);
+	SABR_THREADED_CASE(SABR_OP_FOR_UP_F): SABR_THREADED_FOR(f, v->f < record->end.f);
+	SABR_THREADED_CASE(SABR_OP_FOR_DOWN_I): SABR_THREADED_FOR(i, v->i > record->end.i);
+	SABR_THREADED_CASE(SABR_OP_FOR_DOWN_U): SABR_THREADED_FOR(u, v->u > record->end.u);
+	SABR_THREADED_CASE(SABR_OP_FOR_DOWN_F): SABR_THREADED_FOR(f, v->f > record->end.f);
+
+	SABR_THREADED_CASE(SABR_OP_RETURN):
+		if (sabr_threaded_unlikely(!inter->call_stack.size)) SABR_THREADED_FAIL(SABR_OPERR_EXEC);
+		index = deque_back(sabr_cs_data_t, &inter->call_stack)->pos;
+		deque_pop_back(sabr_cs_data_t, &inter->call_stack);
+		SABR_REGISTER_RESUME();
+
+	SABR_THREADED_CASE(SABR_OP_CALL): {
+		sabr_cs_data_t csd;
+		csd.pos = ip->index + 1;
+		if (sabr_threaded_unlikely(!deque_push_back(sabr_cs_data_t, &inter->call_stack, csd))) SABR_THREADED_FAIL(SABR_OPERR_WHAT);
+		SABR_THREADED_JUMP(ip->operand.u);
+	}
+
+	SABR_THREADED_CASE(SABR_OP_SWITCH_TABLE): {
+		sabr_value_t key = SABR_REGISTER_AT(ip->lhs);
+		sabr_bcop_t* table = vector_at(sabr_bcop_t, &bc->bcop_vec, ip->operand.u);
+		uint64_t slot = key.u - table[0].operand.u;
+		index = table[(slot < table[1].operand.u) ? slot + 3 : 2].operand.u;
+		SABR_REGISTER_RESUME();
+	}
+
+	SABR_THREADED_CASE(SABR_OP_SWITCH_SEARCH): {
+		sabr_value_t key = SABR_REGISTER_AT(ip->lhs);
+		sabr_bcop_t* table = vector_at(sabr_bcop_t, &bc->bcop_vec, ip->operand.u);
+		size_t count = table[0].operand.u, low = 0, high = count;
+		while (low < high) {
+			size_t mid = low + (high - low) / 2;
+			if (table[mid * 2 + 2].operand.i < key.i) low = mid + 1;
+			else high = mid;
+		}
+		index = table[(low < count && table[low * 2 + 2].operand.u == key.u) ? low * 2 + 3 : 1].operand.u;
+		SABR_REGISTER_RESUME();
+	}
+
+	SABR_THREADED_CASE(SABR_OP_ADDR_LOCAL):
+		SABR_REGISTER_AT(ip->dst).p = (uint64_t*) &SABR_REGISTER_AT(ip->lhs);
+		SABR_THREADED_NEXT();
+
+	SABR_THREADED_CASE(SABR_OP_ADD): SABR_REGISTER_BINARY(a.i = a.i + b.i);
+	SABR_THREADED_CASE(SABR_OP_SUB): SABR_REGISTER_BINARY(a.i = a.i - b.i);
+	SABR_THREADED_CASE(SABR_OP_MUL): SABR_REGISTER_BINARY(a.i = a.i * b.i);
+	SABR_THREADED_CASE(SABR_OP_ADD_IMM): SABR_REGISTER_IMMEDIATE(a.i = a.i + b.i);
+	SABR_THREADED_CASE(SABR_OP_MUL_IMM): SABR_REGISTER_IMMEDIATE(a.i = a.i * b.i);
+	SABR_THREADED_CASE(SABR_OP_DIV): SABR_REGISTER_DIVISION(b.i == 0, a.i = a.i / b.i);
+	SABR_THREADED_CASE(SABR_OP_MOD): SABR_REGISTER_DIVISION(b.i == 0, a.i = a.i % b.i);
+	SABR_THREADED_CASE(SABR_OP_UDIV): SABR_REGISTER_DIVISION(b.u == 0, a.u = a.u / b.u);
+	SABR_THREADED_CASE(SABR_OP_UMOD): SABR_REGISTER_DIVISION(b.u == 0, a.u = a.u % b.u);
+	SABR_THREADED_CASE(SABR_OP_NEG): SABR_REGISTER_UNARY(a.i = -a.i);
+	SABR_THREADED_CASE(SABR_OP_INC): SABR_REGISTER_UNARY(a.i++);
+	SABR_THREADED_CASE(SABR_OP_DEC): SABR_REGISTER_UNARY(a.i--);
+
+	SABR_THREADED_CASE(SABR_OP_EQU): SABR_REGISTER_BINARY(a.u = (a.i == b.i) ? -1 : 0);
+	SABR_THREADED_CASE(SABR_OP_NEQ): SABR_REGISTER_BINARY(a.u = (a.i != b.i) ? -1 : 0);
+	SABR_THREADED_CASE(SABR_OP_GRT): SABR_REGISTER_BINARY(a.u = (a.i > b.i) ? -1 : 0);
+	SABR_THREADED_CASE(SABR_OP_GEQ): SABR_REGISTER_BINARY(a.u = (a.i >= b.i) ? -1 : 0);
+	SABR_THREADED_CASE(SABR_OP_LST): SABR_REGISTER_BINARY(a.u = (a.i < b.i) ? -1 : 0);
+	SABR_THREADED_CASE(SABR_OP_LEQ): SABR_REGISTER_BINARY(a.u = (a.i <= b.i) ? -1 : 0);
+	SABR_THREADED_CASE(SABR_OP_EQU_IMM): SABR_REGISTER_IMMEDIATE(a.u = (a.i == b.i) ? -1 : 0);
+	SABR_THREADED_CASE(SABR_OP_NEQ_IMM): SABR_REGISTER_IMMEDIATE(a.u = (a.i != b.i) ? -1 : 0);
+	SABR_THREADED_CASE(SABR_OP_GRT_IMM): SABR_REGISTER_IMMEDIATE(a.u = (a.i > b.i) ? -1 : 0);
+	SABR_THREADED_CASE(SABR_OP_GEQ_IMM): SABR_REGISTER_IMMEDIATE(a.u = (a.i >= b.i) ? -1 : 0);
+	SABR_THREADED_CASE(SABR_OP_LST_IMM): SABR_REGISTER_IMMEDIATE(a.u = (a.i < b.i) ? -1 : 0);
+	SABR_THREADED_CASE(SABR_OP_LEQ_IMM): SABR_REGISTER_IMMEDIATE(a.u = (a.i <= b.i) ? -1 : 0);
+	SABR_THREADED_CASE(SABR_OP_UGRT): SABR_REGISTER_BINARY(a.u = (a.u > b.u) ? -1 : 0);
+	SABR_THREADED_CASE(SABR_OP_UGEQ): SABR_REGISTER_BINARY(a.u = (a.u >= b.u) ? -1 : 0);
+	SABR_THREADED_CASE(SABR_OP_ULST): SABR_REGISTER_BINARY(a.u = (a.u < b.u) ? -1 : 0);
+	SABR_THREADED_CASE(SABR_OP_ULEQ): SABR_REGISTER_BINARY(a.u = (a.u <= b.u) ? -1 : 0);
+
+	SABR_THREADED_CASE(SABR_OP_LST_IF): SABR_REGISTER_BRANCH(a.i < b.i);
+	SABR_THREADED_CASE(SABR_OP_EQU_IF): SABR_REGISTER_BRANCH(a.i == b.i);
+	SABR_THREADED_CASE(SABR_OP_NEQ_IF): SABR_REGISTER_BRANCH(a.i != b.i);
+	SABR_THREADED_CASE(SABR_OP_GRT_IF): SABR_REGISTER_BRANCH(a.i > b.i);
+	SABR_THREADED_CASE(SABR_OP_GEQ_IF): SABR_REGISTER_BRANCH(a.i >= b.i);
+	SABR_THREADED_CASE(SABR_OP_LEQ_IF): SABR_REGISTER_BRANCH(a.i <= b.i);
+	SABR_THREADED_CASE(SABR_OP_UGRT_IF): SABR_REGISTER_BRANCH(a.u > b.u);
+	SABR_THREADED_CASE(SABR_OP_UGEQ_IF): SABR_REGISTER_BRANCH(a.u >= b.u);
+	SABR_THREADED_CASE(SABR_OP_ULST_IF): SABR_REGISTER_BRANCH(a.u < b.u);
+	SABR_THREADED_CASE(SABR_OP_ULEQ_IF): SABR_REGISTER_BRANCH(a.u <= b.u);
+
+	SABR_THREADED_CASE(SABR_OP_FADD): SABR_REGISTER_BINARY(a.f = a.f + b.f);
+	SABR_THREADED_CASE(SABR_OP_FSUB): SABR_REGISTER_BINARY(a.f = a.f - b.f);
+	SABR_THREADED_CASE(SABR_OP_FMUL): SABR_REGISTER_BINARY(a.f = a.f * b.f);
+	SABR_THREADED_CASE(SABR_OP_FDIV): SABR_REGISTER_DIVISION(b.f == 0.0f, a.f = a.f / b.f);
+	SABR_THREADED_CASE(SABR_OP_FMOD): SABR_REGISTER_DIVISION(b.f == 0.0f, a.f = fmod(a.f, b.f));
+	SABR_THREADED_CASE(SABR_OP_FNEG): SABR_REGISTER_UNARY(a.f = -a.f);
+
+	SABR_THREADED_CASE(SABR_OP_FEQU): SABR_REGISTER_BINARY(a.u = (a.f == b.f) ? -1 : 0);
+	SABR_THREADED_CASE(SABR_OP_FNEQ): SABR_REGISTER_BINARY(a.u = (a.f != b.f) ? -1 : 0);
+	SABR_THREADED_CASE(SABR_OP_FGRT): SABR_REGISTER_BINARY(a.u = (a.f > b.f) ? -1 : 0);
+	SABR_THREADED_CASE(SABR_OP_FGEQ): SABR_REGISTER_BINARY(a.u = (a.f >= b.f) ? -1 : 0);
+	SABR_THREADED_CASE(SABR_OP_FLST): SABR_REGISTER_BINARY(a.u = (a.f < b.f) ? -1 : 0);
+	SABR_THREADED_CASE(SABR_OP_FLEQ): SABR_REGISTER_BINARY(a.u = (a.f <= b.f) ? -1 : 0);
+	SABR_THREADED_CASE(SABR_OP_FEQU_IF): SABR_REGISTER_BRANCH(a.f == b.f);
+	SABR_THREADED_CASE(SABR_OP_FNEQ_IF): SABR_REGISTER_BRANCH(a.f != b.f);
+	SABR_THREADED_CASE(SABR_OP_FGRT_IF): SABR_REGISTER_BRANCH(a.f > b.f);
+	SABR_THREADED_CASE(SABR_OP_FGEQ_IF): SABR_REGISTER_BRANCH(a.f >= b.f);
+	SABR_THREADED_CASE(SABR_OP_FLST_IF): SABR_REGISTER_BRANCH(a.f < b.f);
+	SABR_THREADED_CASE(SABR_OP_FLEQ_IF): SABR_REGISTER_BRANCH(a.f <= b.f);
+
+	SABR_THREADED_CASE(SABR_OP_BAND): SABR_REGISTER_BINARY(a.u = a.u & b.u);
+	SABR_THREADED_CASE(SABR_OP_BOR): SABR_REGISTER_BINARY(a.u = a.u | b.u);
+	SABR_THREADED_CASE(SABR_OP_BXOR): SABR_REGISTER_BINARY(a.u = a.u ^ b.u);
+	SABR_THREADED_CASE(SABR_OP_BNOT): SABR_REGISTER_UNARY(a.u = ~a.u);
+	SABR_THREADED_CASE(SABR_OP_BLSFT): SABR_REGISTER_BINARY(a.u = a.u << b.u);
+	SABR_THREADED_CASE(SABR_OP_BRSFT): SABR_REGISTER_BINARY(a.u = a.u >> b.u);
+	SABR_THREADED_CASE(SABR_OP_BAND_IMM): SABR_REGISTER_IMMEDIATE(a.u = a.u & b.u);
+	SABR_THREADED_CASE(SABR_OP_BLSFT_IMM): SABR_REGISTER_IMMEDIATE(a.u = a.u << b.u);
+	SABR_THREADED_CASE(SABR_OP_BRSFT_IMM): SABR_REGISTER_IMMEDIATE(a.u = a.u >> b.u);
+
+	SABR_THREADED_CASE(SABR_OP_FETCH): SABR_REGISTER_UNARY(a.u = *a.p);
+
+	SABR_THREADED_CASE(SABR_OP_STORE):
+		*SABR_REGISTER_AT(ip->rhs).p = SABR_REGISTER_AT(ip->lhs).u;
+		SABR_THREADED_NEXT();
+
+	SABR_THREADED_CASE(SABR_OP_INC_MEM): SABR_REGISTER_MEMORY_UNARY(a.i++);
+	SABR_THREADED_CASE(SABR_OP_DEC_MEM): SABR_REGISTER_MEMORY_UNARY(a.i--);
+	SABR_THREADED_CASE(SABR_OP_ADD_MEM): SABR_REGISTER_MEMORY_BINARY(a.i = a.i + b.i);
+	SABR_THREADED_CASE(SABR_OP_SUB_MEM): SABR_REGISTER_MEMORY_BINARY(a.i = a.i - b.i);
+	SABR_THREADED_CASE(SABR_OP_MUL_MEM): SABR_REGISTER_MEMORY_BINARY(a.i = a.i * b.i);
+	SABR_THREADED_CASE(SABR_OP_DIV_MEM): SABR_REGISTER_MEMORY_DIVISION(b.i == 0, a.i = a.i / b.i);
+	SABR_THREADED_CASE(SABR_OP_MOD_MEM): SABR_REGISTER_MEMORY_DIVISION(b.i == 0, a.i = a.i % b.i);
+	SABR_THREADED_CASE(SABR_OP_FADD_MEM): SABR_REGISTER_MEMORY_BINARY(a.f = a.f + b.f);
+	SABR_THREADED_CASE(SABR_OP_FSUB_MEM): SABR_REGISTER_MEMORY_BINARY(a.f = a.f - b.f);
+	SABR_THREADED_CASE(SABR_OP_FMUL_MEM): SABR_REGISTER_MEMORY_BINARY(a.f = a.f * b.f);
+	SABR_THREADED_CASE(SABR_OP_FDIV_MEM): SABR_REGISTER_MEMORY_DIVISION(b.f == 0.0f, a.f = a.f / b.f);
+	SABR_THREADED_CASE(SABR_OP_FMOD_MEM): SABR_REGISTER_MEMORY_DIVISION(b.f == 0.0f, a.f = fmod(a.f, b.f));
+	SABR_THREADED_CASE(SABR_OP_BAND_MEM): SABR_REGISTER_MEMORY_BINARY(a.u = a.u & b.u);
+	SABR_THREADED_CASE(SABR_OP_BOR_MEM): SABR_REGISTER_MEMORY_BINARY(a.u = a.u | b.u);
+	SABR_THREADED_CASE(SABR_OP_BXOR_MEM): SABR_REGISTER_MEMORY_BINARY(a.u = a.u ^ b.u);
+	SABR_THREADED_CASE(SABR_OP_BNOT_MEM): SABR_REGISTER_MEMORY_UNARY(a.u = ~a.u);
+	SABR_THREADED_CASE(SABR_OP_BLSFT_MEM): SABR_REGISTER_MEMORY_BINARY(a.u = a.u << b.u);
+	SABR_THREADED_CASE(SABR_OP_BRSFT_MEM): SABR_REGISTER_MEMORY_BINARY(a.u = a.u >> b.u);
+
+	SABR_THREADED_CASE(SABR_OP_INDEX_CELL): SABR_REGISTER_BINARY(a.u = b.u + a.u * sizeof(sabr_value_t));
+	SABR_THREADED_CASE(SABR_OP_FETCH_IDX): SABR_REGISTER_BINARY(a.u = b.p[a.u]);
+
+	SABR_THREADED_CASE(SABR_OP_STORE_IDX):
+		SABR_REGISTER_AT(ip->dst).p[SABR_REGISTER_AT(ip->rhs).u] = SABR_REGISTER_AT(ip->lhs).u;
+		SABR_THREADED_NEXT();
+
+	SABR_THREADED_CASE(SABR_OP_FETCH_OFF): SABR_REGISTER_UNARY(a.u = *(uint64_t*) (a.u + ip->operand.u));
+
+	SABR_THREADED_CASE(SABR_OP_STORE_OFF):
+		*(uint64_t*) (SABR_REGISTER_AT(ip->rhs).u + ip->operand.u) = SABR_REGISTER_AT(ip->lhs).u;
+		SABR_THREADED_NEXT();
+
+	SABR_THREADED_CASE(SABR_OP_ITOF): SABR_REGISTER_UNARY(a.f = (double) a.i);
+	SABR_THREADED_CASE(SABR_OP_UTOF): SABR_REGISTER_UNARY(a.f = (double) a.u);
+	SABR_THREADED_CASE(SABR_OP_FTOI): SABR_REGISTER_UNARY(a.i = (int64_t) a.f);
+	SABR_THREADED_CASE(SABR_OP_FTOU): SABR_REGISTER_UNARY(a.u = (int64_t) a.f);
+
+#if !defined(SABR_THREADED_COMPUTED_GOTO)
+		default:
+			SABR_THREADED_FAIL(SABR_OPERR_WHAT);
+	}
+#endif
+
+RESUME:
+	SABR_REGISTER_SPILL();
+	while (index < end || (index < size && tr.map[index] == SIZE_MAX)) {
+		sabr_bcop_t bcop = *vector_at(sabr_bcop_t, &bc->bcop_vec, index);
+		size_t current = index;
+		if (bcop.oc == SABR_OP_EXIT) {
+			SABR_REGISTER_FILL();
+			succeed = true;
+			goto FREE_ALL;
+		}
+		if (bcop.oc != SABR_OP_NONE) {
+			result = sabr_interpreter_op_functions[bcop.oc - 1](inter, bcop, &index);
+			if (result) {
+				SABR_REGISTER_FILL();
+				fprintf(stderr, "result: %u, index: %zu\n", result, index);
+				goto FREE_ALL;
+			}
+		}
+		index++;
+		if (index != current + 1) end = 0;
+	}
+	SABR_REGISTER_FILL();
+	if (sabr_threaded_unlikely(index > size)) SABR_THREADED_FAIL(SABR_OPERR_EXEC);
+	SABR_THREADED_JUMP(tr.map[index]);
+
+FAILURE:
+	fprintf(stderr, "result: %u, index: %zu\n", result, ip->index);
+
+FREE_ALL:
+	if (stream) SABR_REGISTER_SPILL();
+	sabr_register_translator_free(&tr);
+	return succeed;
+}
+
+bool sabr_register_translate(sabr_register_translator_t* tr, sabr_bytecode_t* bc) {
+	size_t size = bc->bcop_vec.size;
+	size_t longest = 0;
+	size_t block = 0;
+
+	memset(tr, 0, sizeof(sabr_register_translator_t));
+	tr->bc = bc;
+	tr->supported = true;
+	tr->last = SIZE_MAX;
+	vector_init(sabr_block_data_t, &tr->blocks);
+
+	for (size_t i = 0; i < size; i++) {
+		sabr_bcop_t bcop = *vector_at(sabr_bcop_t, &bc->bcop_vec, i);
+		bool valid = bcop.oc < sabr_opcode_names_len;
+		if (valid && sabr_opcode_has_index_operand(bcop.oc) && bcop.operand.u > size) valid = false;
+		if (valid && (bcop.oc == SABR_OP_SWITCH_TABLE || bcop.oc == SABR_OP_SWITCH_SEARCH)) valid = sabr_bytecode_check_switch(bc, bcop);
+		if (!valid) {
+			tr->supported = false;
+			return true;
+		}
+	}
+
+	if (!sabr_interpreter_verify_bytecode(bc, &tr->blocks)) return false;
+	for (size_t k = 0; k < tr->blocks.size; k++) {
+		sabr_block_data_t* data = vector_at(sabr_block_data_t, &tr->blocks, k);
+		if (data->end - data->begin > longest) longest = data->end - data->begin;
+	}
+
+	tr->bias = (int64_t) longest * 6 + 1;
+	tr->map = (size_t*) malloc(sizeof(size_t) * (size + 1));
+	tr->stack = (sabr_register_operand_t*) malloc(sizeof(sabr_register_operand_t) * (tr->bias * 2 + 1));
+	if (!tr->map || !tr->stack) {
+		fputs(sabr_errmsg_alloc, stderr);
+		return false;
+	}
+	for (size_t i = 0; i <= size; i++) tr->map[i] = SIZE_MAX;
+
+	for (size_t i = 0; i < size && tr->supported;) {
+		if (block < tr->blocks.size && vector_at(sabr_block_data_t, &tr->blocks, block)->begin == i) {
+			if (!sabr_register_translate_block(tr, block)) return false;
+			i = vector_at(sabr_block_data_t, &tr->blocks, block)->end;
+			block++;
+			continue;
+		}
+		tr->map[i] = tr->op_count;
+		if (!sabr_register_emit_generic(tr, i)) return false;
+		i++;
+	}
+	tr->map[size] = tr->op_count;
+	if (!sabr_register_emit(tr, sabr_register_new_op(SABR_OP_EXIT, size))) return false;
+
+	for (size_t i = 0; i < tr->op_count; i++) {
+		sabr_register_op_t* op = tr->ops + i;
+		if (!sabr_register_has_target(op->oc)) continue;
+		if (op->operand.u > size || tr->map[op->operand.u] == SIZE_MAX) tr->supported = false;
+		else op->operand.u = tr->map[op->operand.u];
+	}
+	return true;
+}
+
+void sabr_register_translator_free(sabr_register_translator_t* tr) {
+	free(tr->ops);
+	free(tr->consts);
+	free(tr->map);
+	free(tr->stack);
+	vector_free(sabr_block_data_t, &tr->blocks);
+	tr->ops = NULL;
+	tr->consts = NULL;
+	tr->map = NULL;
+	tr->stack = NULL;
+}
+
+bool sabr_register_translate_block(sabr_register_translator_t* tr, size_t block) {
+	sabr_block_data_t data = *vector_at(sabr_block_data_t, &tr->blocks, block);
+
+	tr->map[data.begin] = tr->op_count;
+	sabr_register_reset(tr);
+	if (data.need || data.grow) {
+		sabr_register_op_t op = sabr_register_new_op(SABR_REGISTER_OP_ENTER, data.begin);
+		op.operand.u = block;
+		if (!sabr_register_emit(tr, op)) return false;
+	}
+
+	for (size_t i = data.begin; i < data.end; i++) {
+		sabr_bcop_t bcop = *vector_at(sabr_bcop_t, &tr->bc->bcop_vec, i);
+		if (!sabr_register_translate_op(tr, i, bcop)) return false;
+	}
+	return sabr_register_sync(tr, data.end - 1, 0);
+}
+
+bool sabr_register_translate_op(sabr_register_translator_t* tr, size_t index, sabr_bcop_t bcop) {
+	sabr_register_op_t op = sabr_register_new_op(bcop.oc, index);
+	sabr_register_operand_t slot, a, b, c;
+	op.operand = bcop.operand;
+	uint32_t base = sabr_opcode_is_global(bcop.oc) ? SABR_REGISTER_BASE_GLOBAL : SABR_REGISTER_BASE_FRAME;
+
+	switch (bcop.oc) {
+		case SABR_OP_NONE:
+			return true;
+
+		case SABR_OP_VALUE:
+			if (!sabr_register_const(tr, bcop.operand, &a)) return false;
+			sabr_register_push(tr, a);
+			return true;
+
+		case SABR_OP_LOAD_LOCAL:
+		case SABR_OP_LOAD_GLOBAL:
+			sabr_register_push(tr, sabr_register_slot(tr, base, bcop.operand.u));
+			return true;
+
+		case SABR_OP_STORE_LOCAL:
+		case SABR_OP_STORE_GLOBAL:
+			slot = sabr_register_slot(tr, base, bcop.operand.u);
+			if (!sabr_register_flush(tr, slot, false, index)) return false;
+			a = sabr_register_pop(tr);
+			if (a.base == SABR_REGISTER_BASE_STACK && tr->last == tr->op_count - 1 && tr->last_pos == a.offset && !sabr_register_is_referenced(tr, a.offset)) {
+				tr->ops[tr->last].dst = slot;
+				tr->last = SIZE_MAX;
+				return true;
+			}
+			op.oc = SABR_REGISTER_OP_MOVE;
+			op.dst = slot;
+			op.lhs = sabr_register_resolve(tr, a);
+			return sabr_register_emit(tr, op);
+
+		case SABR_OP_INC_LOCAL:
+		case SABR_OP_DEC_LOCAL:
+		case SABR_OP_INC_GLOBAL:
+		case SABR_OP_DEC_GLOBAL:
+			slot = sabr_register_slot(tr, base, bcop.operand.u);
+			if (!sabr_register_flush(tr, slot, false, index)) return false;
+			op.oc = (bcop.oc == SABR_OP_INC_LOCAL || bcop.oc == SABR_OP_INC_GLOBAL) ? SABR_OP_INC : SABR_OP_DEC;
+			op.dst = slot;
+			op.lhs = slot;
+			return sabr_register_emit(tr, op);
+
+		case SABR_OP_ADD_LOCAL:
+		case SABR_OP_FADD_LOCAL:
+		case SABR_OP_ADD_GLOBAL:
+		case SABR_OP_FADD_GLOBAL:
+			slot = sabr_register_slot(tr, base, bcop.operand.u);
+			if (!sabr_register_flush(tr, slot, false, index)) return false;
+			a = sabr_register_pop(tr);
+			op.oc = (bcop.oc == SABR_OP_ADD_LOCAL || bcop.oc == SABR_OP_ADD_GLOBAL) ? SABR_OP_ADD : SABR_OP_FADD;
+			op.dst = slot;
+			op.lhs = slot;
+			op.rhs = sabr_register_resolve(tr, a);
+			return sabr_register_emit(tr, op);
+
+		case SABR_OP_ADDR_LOCAL:
+		case SABR_OP_ADDR_GLOBAL:
+			op.oc = SABR_OP_ADDR_LOCAL;
+			op.lhs = sabr_register_slot(tr, base, bcop.operand.u);
+			return sabr_register_emit_result(tr, op);
+
+		case SABR_OP_ADD_IMM:
+		case SABR_OP_MUL_IMM:
+		case SABR_OP_EQU_IMM:
+		case SABR_OP_NEQ_IMM:
+		case SABR_OP_GRT_IMM:
+		case SABR_OP_GEQ_IMM:
+		case SABR_OP_LST_IMM:
+		case SABR_OP_LEQ_IMM:
+		case SABR_OP_BAND_IMM:
+		case SABR_OP_BLSFT_IMM:
+		case SABR_OP_BRSFT_IMM:
+			a = sabr_register_pop(tr);
+			op.lhs = sabr_register_resolve(tr, a);
+			return sabr_register_emit_result(tr, op);
+
+		case SABR_OP_NEG:
+		case SABR_OP_INC:
+		case SABR_OP_DEC:
+		case SABR_OP_FNEG:
+		case SABR_OP_BNOT:
+		case SABR_OP_FETCH:
+		case SABR_OP_FETCH_OFF:
+		case SABR_OP_ITOF:
+		case SABR_OP_UTOF:
+		case SABR_OP_FTOI:
+		case SABR_OP_FTOU:
+			a = sabr_register_pop(tr);
+			op.lhs = sabr_register_resolve(tr, a);
+			return sabr_register_emit_result(tr, op);
+
+		case SABR_OP_ADD:
+		case SABR_OP_SUB:
+		case SABR_OP_MUL:
+		case SABR_OP_DIV:
+		case SABR_OP_MOD:
+		case SABR_OP_UDIV:
+		case SABR_OP_UMOD:
+		case SABR_OP_EQU:
+		case SABR_OP_NEQ:
+		case SABR_OP_GRT:
+		case SABR_OP_GEQ:
+		case SABR_OP_LST:
+		case SABR_OP_LEQ:
+		case SABR_OP_UGRT:
+		case SABR_OP_UGEQ:
+		case SABR_OP_ULST:
+		case SABR_OP_ULEQ:
+		case SABR_OP_FADD:
+		case SABR_OP_FSUB:
+		case SABR_OP_FMUL:
+		case SABR_OP_FDIV:
+		case SABR_OP_FMOD:
+		case SABR_OP_FEQU:
+		case SABR_OP_FNEQ:
+		case SABR_OP_FGRT:
+		case SABR_OP_FGEQ:
+		case SABR_OP_FLST:
+		case SABR_OP_FLEQ:
+		case SABR_OP_BAND:
+		case SABR_OP_BOR:
+		case SABR_OP_BXOR:
+		case SABR_OP_BLSFT:
+		case SABR_OP_BRSFT:
+		case SABR_OP_INDEX_CELL:
+		case SABR_OP_FETCH_IDX:
+			b = sabr_register_pop(tr);
+			a = sabr_register_pop(tr);
+			op.lhs = sabr_register_resolve(tr, a);
+			op.rhs = sabr_register_resolve(tr, b);
+			sabr_register_immediate(tr, &op);
+			return sabr_register_emit_result(tr, op);
+
+		case SABR_OP_STORE:
+		case SABR_OP_STORE_OFF:
+			if (!sabr_register_flush(tr, op.lhs, true, index)) return false;
+			b = sabr_register_pop(tr);
+			a = sabr_register_pop(tr);
+			op.lhs = sabr_register_resolve(tr, a);
+			op.rhs = sabr_register_resolve(tr, b);
+			return sabr_register_emit(tr, op);
+
+		case SABR_OP_STORE_IDX:
+			if (!sabr_register_flush(tr, op.lhs, true, index)) return false;
+			c = sabr_register_pop(tr);
+			b = sabr_register_pop(tr);
+			a = sabr_register_pop(tr);
+			op.dst = sabr_register_resolve(tr, c);
+			op.lhs = sabr_register_resolve(tr, a);
+			op.rhs = sabr_register_resolve(tr, b);
+			return sabr_register_emit(tr, op);
+
+		case SABR_OP_INC_MEM:
+		case SABR_OP_DEC_MEM:
+		case SABR_OP_BNOT_MEM:
+			if (!sabr_register_flush(tr, op.lhs, true, index)) return false;
+			a = sabr_register_pop(tr);
+			op.lhs = sabr_register_resolve(tr, a);
+			return sabr_register_emit(tr, op);
+
+		case SABR_OP_ADD_MEM:
+		case SABR_OP_SUB_MEM:
+		case SABR_OP_MUL_MEM:
+		case SABR_OP_DIV_MEM:
+		case SABR_OP_MOD_MEM:
+		case SABR_OP_FADD_MEM:
+		case SABR_OP_FSUB_MEM:
+		case SABR_OP_FMUL_MEM:
+		case SABR_OP_FDIV_MEM:
+		case SABR_OP_FMOD_MEM:
+		case SABR_OP_BAND_MEM:
+		case SABR_OP_BOR_MEM:
+		case SABR_OP_BXOR_MEM:
+		case SABR_OP_BLSFT_MEM:
+		case SABR_OP_BRSFT_MEM:
+			if (!sabr_register_flush(tr, op.lhs, true, index)) return false;
+			a = sabr_register_pop(tr);
+			b = sabr_register_pop(tr);
+			op.lhs = sabr_register_resolve(tr, a);
+			op.rhs = sabr_register_resolve(tr, b);
+			return sabr_register_emit(tr, op);
+
+		case SABR_OP_DROP: return sabr_register_translate_shuffle(tr, 1, NULL, 0);
+		case SABR_OP_NIP: return sabr_register_translate_shuffle(tr, 2, (const uint8_t[]) { 0 }, 1);
+		case SABR_OP_DUP: return sabr_register_translate_shuffle(tr, 1, (const uint8_t[]) { 0, 0 }, 2);
+		case SABR_OP_OVER: return sabr_register_translate_shuffle(tr, 2, (const uint8_t[]) { 0, 1, 0 }, 3);
+		case SABR_OP_TUCK: return sabr_register_translate_shuffle(tr, 2, (const uint8_t[]) { 1, 0, 1 }, 3);
+		case SABR_OP_SWAP: return sabr_register_translate_shuffle(tr, 2, (const uint8_t[]) { 1, 0 }, 2);
+		case SABR_OP_ROT: return sabr_register_translate_shuffle(tr, 3, (const uint8_t[]) { 1, 2, 0 }, 3);
+		case SABR_OP_TDROP: return sabr_register_translate_shuffle(tr, 2, NULL, 0);
+		case SABR_OP_TNIP: return sabr_register_translate_shuffle(tr, 4, (const uint8_t[]) { 2, 3 }, 2);
+		case SABR_OP_TDUP: return sabr_register_translate_shuffle(tr, 2, (const uint8_t[]) { 0, 1, 0, 1 }, 4);
+		case SABR_OP_TOVER: return sabr_register_translate_shuffle(tr, 4, (const uint8_t[]) { 0, 1, 2, 3, 0, 1 }, 6);
+		case SABR_OP_TTUCK: return sabr_register_translate_shuffle(tr, 4, (const uint8_t[]) { 2, 3, 0, 1, 2, 3 }, 6);
+		case SABR_OP_TSWAP: return sabr_register_translate_shuffle(tr, 4, (const uint8_t[]) { 2, 3, 0, 1 }, 4);
+		case SABR_OP_TROT: return sabr_register_translate_shuffle(tr, 6, (const uint8_t[]) { 2, 3, 5, 4, 0, 1 }, 6);
+
+		case SABR_OP_IF:
+		case SABR_OP_SWITCH_TABLE:
+		case SABR_OP_SWITCH_SEARCH:
+			return sabr_register_emit_branch(tr, op, 1);
+
+		case SABR_OP_LST_IF:
+		case SABR_OP_EQU_IF:
+		case SABR_OP_NEQ_IF:
+		case SABR_OP_GRT_IF:
+		case SABR_OP_GEQ_IF:
+		case SABR_OP_LEQ_IF:
+		case SABR_OP_UGRT_IF:
+		case SABR_OP_UGEQ_IF:
+		case SABR_OP_ULST_IF:
+		case SABR_OP_ULEQ_IF:
+		case SABR_OP_FEQU_IF:
+		case SABR_OP_FNEQ_IF:
+		case SABR_OP_FGRT_IF:
+		case SABR_OP_FGEQ_IF:
+		case SABR_OP_FLST_IF:
+		case SABR_OP_FLEQ_IF:
+			return sabr_register_emit_branch(tr, op, 2);
+
+		case SABR_OP_EXIT:
+		case SABR_OP_JUMP:
+		case SABR_OP_FOR_LOOP_I:
+		case SABR_OP_FOR_LOOP_U:
+		case SABR_OP_FOR_LOOP_F:
+		case SABR_OP_FOR_UP_I:
+		case SABR_OP_FOR_UP_U:
+		case SABR_OP_FOR_UP_F:
+		case SABR_OP_FOR_DOWN_I:
+		case SABR_OP_FOR_DOWN_U:
+		case SABR_OP_FOR_DOWN_F:
+		case SABR_OP_RETURN:
+		case SABR_OP_CALL:
+			return sabr_register_emit_branch(tr, op, 0);
+
+		default:
+			return sabr_register_emit_generic(tr, index);
+	}
+}
+
+bool sabr_register_translate_shuffle(sabr_register_translator_t* tr, size_t pops, const uint8_t* order, size_t pushes) {
+	sabr_register_operand_t in[6];
+
+	for (size_t k = pops; k-- > 0;) in[k] = sabr_register_pop(tr);
+	for (size_t k = 0; k < pushes; k++) sabr_register_push(tr, in[order[k]]);
+	return true;
+}
+
+bool sabr_register_emit(sabr_register_translator_t* tr, sabr_register_op_t op) {
+	if (tr->op_count >= tr->op_capacity) {
+		size_t capacity = tr->op_capacity ? tr->op_capacity * 2 : 64;
+		sabr_register_op_t* ops = (sabr_register_op_t*) realloc(tr->ops, sizeof(sabr_register_op_t) * capacity);
+		if (!ops) {
+			fputs(sabr_errmsg_alloc, stderr);
+			return false;
+		}
+		tr->ops = ops;
+		tr->op_capacity = capacity;
+	}
+	tr->ops[tr->op_count++] = op;
+	tr->last = SIZE_MAX;
+	return true;
+}
+
+bool sabr_register_emit_result(sabr_register_translator_t* tr, sabr_register_op_t op) {
+	int64_t pos = sabr_register_free(tr, tr->depth);
+	op.dst = sabr_register_resolve(tr, sabr_register_stack(pos));
+	if (!sabr_register_emit(tr, op)) return false;
+	sabr_register_push(tr, sabr_register_stack(pos));
+	tr->last = tr->op_count - 1;
+	tr->last_pos = pos;
+	return true;
+}
+
+bool sabr_register_emit_generic(sabr_register_translator_t* tr, size_t index) {
+	if (!sabr_register_sync(tr, index, 0)) return false;
+	if (!sabr_register_emit(tr, sabr_register_new_op(SABR_REGISTER_OP_GENERIC, index))) return false;
+	sabr_register_reset(tr);
+	return true;
+}
+
+bool sabr_register_emit_branch(sabr_register_translator_t* tr, sabr_register_op_t op, size_t keep) {
+	if (!sabr_register_sync(tr, op.index, keep)) return false;
+	if (keep > 1) op.rhs = sabr_register_resolve(tr, sabr_register_pop(tr));
+	if (keep > 0) op.lhs = sabr_register_resolve(tr, sabr_register_pop(tr));
+	if (!sabr_register_emit(tr, op)) return false;
+	sabr_register_reset(tr);
+	return true;
+}
+
+bool sabr_register_move(sabr_register_translator_t* tr, int64_t pos, sabr_register_operand_t src, size_t index) {
+	sabr_register_op_t op = sabr_register_new_op(SABR_REGISTER_OP_MOVE, index);
+	op.dst = sabr_register_resolve(tr, sabr_register_stack(pos));
+	op.lhs = sabr_register_resolve(tr, src);
+	if (!sabr_register_emit(tr, op)) return false;
+	tr->last = tr->op_count - 1;
+	tr->last_pos = pos;
+	return true;
+}
+
+bool sabr_register_exchange(sabr_register_translator_t* tr, int64_t pos, int64_t other, int64_t top, size_t index) {
+	sabr_register_op_t op = sabr_register_new_op(SABR_REGISTER_OP_EXCHANGE, index);
+	op.lhs = sabr_register_resolve(tr, sabr_register_stack(pos));
+	op.rhs = sabr_register_resolve(tr, sabr_register_stack(other));
+	if (!sabr_register_emit(tr, op)) return false;
+	for (int64_t k = tr->low; k < top; k++) {
+		sabr_register_operand_t* entry = tr->stack + k + tr->bias;
+		if (entry->base != SABR_REGISTER_BASE_STACK) continue;
+		if (entry->offset == pos) entry->offset = (int32_t) other;
+		else if (entry->offset == other) entry->offset = (int32_t) pos;
+	}
+	return true;
+}
+
+bool sabr_register_materialize(sabr_register_translator_t* tr, int64_t pos, size_t index) {
+	sabr_register_operand_t* entry = tr->stack + pos + tr->bias;
+	if (entry->base == SABR_REGISTER_BASE_STACK) return true;
+	int64_t target = sabr_register_free(tr, pos);
+	if (!sabr_register_move(tr, target, *entry, index)) return false;
+	*entry = sabr_register_stack(target);
+	return true;
+}
+
+bool sabr_register_flush(sabr_register_translator_t* tr, sabr_register_operand_t operand, bool memory, size_t index) {
+	for (int64_t pos = tr->low; pos < tr->depth; pos++) {
+		sabr_register_operand_t entry = tr->stack[pos + tr->bias];
+		if (entry.base != SABR_REGISTER_BASE_FRAME && entry.base != SABR_REGISTER_BASE_GLOBAL) continue;
+		if (!memory && (entry.base != operand.base || entry.offset != operand.offset)) continue;
+		if (!sabr_register_materialize(tr, pos, index)) return false;
+	}
+	return true;
+}
+
+bool sabr_register_sync(sabr_register_translator_t* tr, size_t index, size_t keep) {
+	int64_t top = tr->depth;
+	int64_t lazy = top - (int64_t) keep;
+
+	while (true) {
+		int64_t pending = INT64_MAX;
+		int64_t pick = INT64_MAX;
+		for (int64_t pos = tr->low; pos < top && pick == INT64_MAX; pos++) {
+			sabr_register_operand_t entry = tr->stack[pos + tr->bias];
+			if (entry.base != SABR_REGISTER_BASE_STACK || entry.offset == pos) continue;
+			if (pos >= lazy && !sabr_register_is_clobbered(tr, entry.offset, lazy)) continue;
+			pending = pos;
+			bool needed = false;
+			for (int64_t k = tr->low; k < top && !needed; k++)
+				needed = k != pos && sabr_register_is_stack(tr->stack[k + tr->bias], pos);
+			if (!needed) pick = pos;
+		}
+		if (pending == INT64_MAX) break;
+
+		if (pick != INT64_MAX) {
+			if (!sabr_register_move(tr, pick, tr->stack[pick + tr->bias], index)) return false;
+			tr->stack[pick + tr->bias] = sabr_register_stack(pick);
+			continue;
+		}
+		if (!sabr_register_exchange(tr, pending, tr->stack[pending + tr->bias].offset, top, index)) return false;
+	}
+
+	for (int64_t pos = tr->low; pos < lazy; pos++) {
+		sabr_register_operand_t* entry = tr->stack + pos + tr->bias;
+		if (entry->base == SABR_REGISTER_BASE_STACK) continue;
+		if (!sabr_register_move(tr, pos, *entry, index)) return false;
+		*entry = sabr_register_stack(pos);
+	}
+	if (lazy != tr->shift) {
+		sabr_register_op_t op = sabr_register_new_op(SABR_REGISTER_OP_ADJUST, index);
+		op.operand.i = lazy - tr->shift;
+		if (!sabr_register_emit(tr, op)) return false;
+		tr->shift = lazy;
+	}
+	return true;
+}
+
+void sabr_register_reset(sabr_register_translator_t* tr) {
+	tr->low = 0;
+	tr->depth = 0;
+	tr->shift = 0;
+	tr->last = SIZE_MAX;
+}
+
+sabr_register_op_t sabr_register_new_op(uint32_t oc, size_t index) {
+	sabr_register_op_t op;
+	memset(&op, 0, sizeof(sabr_register_op_t));
+	op.oc = oc;
+	op.dst.base = SABR_REGISTER_BASE_CONST;
+	op.lhs.base = SABR_REGISTER_BASE_CONST;
+	op.rhs.base = SABR_REGISTER_BASE_CONST;
+	op.index = index;
+	return op;
+}
+
+sabr_register_operand_t sabr_register_stack(int64_t pos) {
+	return (sabr_register_operand_t) { SABR_REGISTER_BASE_STACK, (int32_t) pos };
+}
+
+sabr_register_operand_t sabr_register_slot(sabr_register_translator_t* tr, uint32_t base, uint64_t slot) {
+	if (slot > INT32_MAX) {
+		tr->supported = false;
+		slot = 0;
+	}
+	return (sabr_register_operand_t) { base, (int32_t) slot };
+}
+
+bool sabr_register_const(sabr_register_translator_t* tr, sabr_value_t v, sabr_register_operand_t* operand) {
+	if (tr->const_count >= INT32_MAX) {
+		tr->supported = false;
+		*operand = (sabr_register_operand_t) { SABR_REGISTER_BASE_CONST, 0 };
+		return true;
+	}
+	if (tr->const_count >= tr->const_capacity) {
+		size_t capacity = tr->const_capacity ? tr->const_capacity * 2 : 64;
+		sabr_value_t* consts = (sabr_value_t*) realloc(tr->consts, sizeof(sabr_value_t) * capacity);
+		if (!consts) {
+			fputs(sabr_errmsg_alloc, stderr);
+			return false;
+		}
+		tr->consts = consts;
+		tr->const_capacity = capacity;
+	}
+	tr->consts[tr->const_count] = v;
+	*operand = (sabr_register_operand_t) { SABR_REGISTER_BASE_CONST, (int32_t) tr->const_count++ };
+	return true;
+}
+
+void sabr_register_immediate(sabr_register_translator_t* tr, sabr_register_op_t* op) {
+	if (op->rhs.base != SABR_REGISTER_BASE_CONST) return;
+	sabr_value_t v = tr->consts[op->rhs.offset];
+	switch (op->oc) {
+		case SABR_OP_ADD: op->oc = SABR_OP_ADD_IMM; break;
+		case SABR_OP_SUB: op->oc = SABR_OP_ADD_IMM; v.u = -v.u; break;
+		case SABR_OP_MUL: op->oc = SABR_OP_MUL_IMM; break;
+		case SABR_OP_EQU: op->oc = SABR_OP_EQU_IMM; break;
+		case SABR_OP_NEQ: op->oc = SABR_OP_NEQ_IMM; break;
+		case SABR_OP_GRT: op->oc = SABR_OP_GRT_IMM; break;
+		case SABR_OP_GEQ: op->oc = SABR_OP_GEQ_IMM; break;
+		case SABR_OP_LST: op->oc = SABR_OP_LST_IMM; break;
+		case SABR_OP_LEQ: op->oc = SABR_OP_LEQ_IMM; break;
+		case SABR_OP_BAND: op->oc = SABR_OP_BAND_IMM; break;
+		case SABR_OP_BLSFT: op->oc = SABR_OP_BLSFT_IMM; break;
+		case SABR_OP_BRSFT: op->oc = SABR_OP_BRSFT_IMM; break;
+		default: return;
+	}
+	op->operand = v;
+}
+
+sabr_register_operand_t sabr_register_resolve(sabr_register_translator_t* tr, sabr_register_operand_t operand) {
+	if (operand.base == SABR_REGISTER_BASE_STACK) operand.offset -= (int32_t) tr->shift;
+	return operand;
+}
+
+sabr_register_operand_t sabr_register_pop(sabr_register_translator_t* tr) {
+	tr->depth--;
+	if (tr->depth < tr->low) {
+		tr->low = tr->depth;
+		tr->stack[tr->depth + tr->bias] = sabr_register_stack(tr->depth);
+	}
+	return tr->stack[tr->depth + tr->bias];
+}
+
+void sabr_register_push(sabr_register_translator_t* tr, sabr_register_operand_t operand) {
+	tr->stack[tr->depth + tr->bias] = operand;
+	tr->depth++;
+}
+
+bool sabr_register_is_referenced(sabr_register_translator_t* tr, int64_t pos) {
+	for (int64_t k = tr->low; k < tr->depth; k++)
+		if (sabr_register_is_stack(tr->stack[k + tr->bias], pos)) return true;
+	return pos < tr->low;
+}
+
+bool sabr_register_is_clobbered(sabr_register_translator_t* tr, int64_t pos, int64_t lazy) {
+	if (pos < tr->low || pos >= tr->depth) return false;
+	sabr_register_operand_t entry = tr->stack[pos + tr->bias];
+	if (entry.base != SABR_REGISTER_BASE_STACK) return pos < lazy;
+	return entry.offset != pos;
+}
+
+int64_t sabr_register_free(sabr_register_translator_t* tr, int64_t pos) {
+	if (!sabr_register_is_referenced(tr, pos)) return pos;
+	for (int64_t k = tr->depth - 1; k >= tr->low; k--)
+		if (!sabr_register_is_referenced(tr, k)) return k;
+	return pos;
+}
+
+bool sabr_register_is_stack(sabr_register_operand_t operand, int64_t pos) {
+	return operand.base == SABR_REGISTER_BASE_STACK && operand.offset == pos;
+}
+
+bool sabr_register_has_target(uint32_t oc) {
+	if (oc == SABR_OP_SWITCH_TABLE || oc == SABR_OP_SWITCH_SEARCH) return false;
+	return oc < sabr_opcode_names_len && sabr_opcode_has_index_operand(oc);
+}
\ No newline at end of file
@@ -0,0 +1,510 @@
+#include "interpreter_threaded.h"
+
+#define SABR_THREADED_UNARY(EXPR) { \
+	sabr_value_t a = sp[-1]; \
+	EXPR; \
+	sp[-1] = a; \
+} SABR_THREADED_NEXT()
+
+#define SABR_THREADED_BINARY(EXPR) { \
+	sabr_value_t a = sp[-2]; \
+	sabr_value_t b = sp[-1]; \
+	EXPR; \
+	sp[-2] = a; \
+	sp--; \
+} SABR_THREADED_NEXT()
+
+#define SABR_THREADED_DIVISION(CHECK, EXPR) { \
+	sabr_value_t a = sp[-2]; \
+	sabr_value_t b = sp[-1]; \
+	if (sabr_threaded_unlikely(CHECK)) SABR_THREADED_FAIL(SABR_OPERR_DIV_BY_ZERO); \
+	EXPR; \
+	sp[-2] = a; \
+	sp--; \
+} SABR_THREADED_NEXT()
+
+#define SABR_THREADED_BRANCH(COND) { \
+	sabr_value_t a = sp[-2]; \
+	sabr_value_t b = sp[-1]; \
+	sp -= 2; \
+	if (!(COND)) SABR_THREADED_JUMP(ip->operand.u); \
+} SABR_THREADED_NEXT()
+
+#define SABR_THREADED_MEMORY_UNARY(EXPR) { \
+	sabr_value_t a = { .u = *sp[-1].p }; \
+	EXPR; \
+	*sp[-1].p = a.u; \
+	sp--; \
+} SABR_THREADED_NEXT()
+
+#define SABR_THREADED_MEMORY_BINARY(EXPR) { \
+	sabr_value_t a = { .u = *sp[-1].p }; \
+	sabr_value_t b = sp[-2]; \
+	EXPR; \
+	*sp[-1].p = a.u; \
+	sp -= 2; \
+} SABR_THREADED_NEXT()
+
+#define SABR_THREADED_MEMORY_DIVISION(CHECK, EXPR) { \
+	sabr_value_t a = { .u = *sp[-1].p }; \
+	sabr_value_t b = sp[-2]; \
+	if (sabr_threaded_unlikely(CHECK)) SABR_THREADED_FAIL(SABR_OPERR_DIV_BY_ZERO); \
+	EXPR; \
+	*sp[-1].p = a.u; \
+	sp -= 2; \
+} SABR_THREADED_NEXT()
+
+bool sabr_interpreter_run_bytecode_threaded(sabr_interpreter_t* inter, sabr_bytecode_t* bc) {
+	bool succeed = false;
+	uint32_t result = SABR_OPERR_NONE;
+	sabr_threaded_op_t* stream = NULL;
+	sabr_threaded_block_t* blocks = NULL;
+	sabr_threaded_hot_t* hots = NULL;
+	sabr_threaded_op_t* ip = NULL;
+	sabr_jit_t jit;
+
+	sabr_value_t* base = inter->data_stack.data;
+	sabr_value_t* sp = base + inter->data_stack.size;
+	size_t capacity = inter->data_stack.capacity;
+
+#if !defined(SABR_THREADED_COMPUTED_GOTO)
+	uint32_t oc;
+#endif
+
+#if defined(SABR_THREADED_COMPUTED_GOTO)
+	static const void* labels[] = { SABR_THREADED_BIND_ALL };
+	size_t labels_len = sizeof(labels) / sizeof(void*);
+#endif
+
+	sabr_jit_init(&jit);
+	if (!sabr_interpreter_threaded_prepare(bc, &stream, &blocks)) goto FREE_ALL;
+	SABR_THREADED_RESOLVE();
+
+	if (!sabr_jit_prepare(&jit, inter, bc)) goto FREE_ALL;
+	if (jit.enabled) {
+		hots = (sabr_threaded_hot_t*) malloc(sizeof(sabr_threaded_hot_t) * (bc->bcop_vec.size + 1));
+		if (!hots) {
+			fputs(sabr_errmsg_alloc, stderr);
+			goto FREE_ALL;
+		}
+		for (size_t i = 0; i <= bc->bcop_vec.size; i++) {
+			if (jit.candidates[i]) SABR_THREADED_MARK(i);
+		}
+	}
+
+	ip = stream;
+	SABR_THREADED_DISPATCH();
+
+#if !defined(SABR_THREADED_COMPUTED_GOTO)
+DISPATCH:
+	oc = ip->oc;
+SWITCH:
+	switch (oc) {
+#endif
+
+	SABR_THREADED_BLOCK: {
+		sabr_threaded_block_t* block = blocks + (ip - stream);
+		size_t depth = sp - base;
+		if (sabr_threaded_unlikely(depth < block->need || block->grow > capacity - depth)) goto CHECKED;
+#if defined(SABR_THREADED_COMPUTED_GOTO)
+		goto *block->label;
+#else
+		oc = block->oc;
+		goto SWITCH;
+#endif
+	}
+
+	SABR_THREADED_HOT: {
+		size_t index = ip - stream;
+		void* code = sabr_jit_lookup(&jit, index);
+		if (!code) {
+			if (jit.failed[index]) SABR_THREADED_UNMARK(index);
+			SABR_THREADED_RESUME(index);
+		}
+		inter->data_stack.size = sp - base;
+		result = sabr_jit_run(&jit, code);
+		sp = base + inter->data_stack.size;
+		if (result == SABR_JIT_EXIT) {
+			succeed = true;
+			goto FREE_ALL;
+		}
+		if (sabr_threaded_unlikely(result)) {
+			fprintf(stderr, "result: %u, index: %zu\n", result, (size_t) jit.ctx.index);
+			goto FREE_ALL;
+		}
+		if (sabr_threaded_unlikely(!inter->call_stack.size)) SABR_THREADED_FAIL(SABR_OPERR_EXEC);
+		size_t pos = deque_back(sabr_cs_data_t, &inter->call_stack)->pos;
+		deque_pop_back(sabr_cs_data_t, &inter->call_stack);
+		SABR_THREADED_JUMP(pos);
+	}
+
+	SABR_THREADED_CASE(SABR_OP_NONE):
+		SABR_THREADED_NEXT();
+
+	SABR_THREADED_CASE(SABR_OP_EXIT):
+		succeed = true;
+		goto FREE_ALL;
+
+	SABR_THREADED_CASE(SABR_OP_VALUE):
+		*sp++ = ip->operand;
+		SABR_THREADED_NEXT();
+
+	SABR_THREADED_CASE(SABR_OP_IF):
+		sp--;
+		if (!sp->u) SABR_THREADED_JUMP(ip->operand.u);
+		SABR_THREADED_NEXT();
+
+	SABR_THREADED_CASE(SABR_OP_JUMP):
+		SABR_THREADED_JUMP(ip->operand.u);
+
+	SABR_THREADED_CASE(SABR_OP_FOR_LOOP_I): SABR_THREADED_FOR(i, (record->step.i > 0) ? v->i < record->end.i : v->i > record->end.i);
+	SABR_THREADED_CASE(SABR_OP_FOR_LOOP_U): SABR_THREADED_FOR(u, (record->step.u > 0) ? v->u < record->end.u : v->u > record->end.u);
+	SABR_THREADED_CASE(SABR_OP_FOR_LOOP_F): SABR_THREADED_FOR(f, (record->step.f > 0.0) ? v->f < record->end.f : v->f > record->end.f);
+	SABR_THREADED_CASE(SABR_OP_FOR_UP_I): SABR_THREADED_FOR(i, v->i < record->end.i);
+	SABR_THREADED_CASE(SABR_OP_FOR_UP_U): SABR_THREADED_FOR(u, v->u < record->end.u);
+	SABR_THREADED_CASE(SABR_OP_FOR_UP_F): SABR_THREADED_FOR(f, v->f < record->end.f);
+	SABR_THREADED_CASE(SABR_OP_FOR_DOWN_I): SABR_THREADED_FOR(i, v->i > record->end.i);
+	SABR_THREADED_CASE(SABR_OP_FOR_DOWN_U): SABR_THREADED_FOR(u, v->u > record->end.u);
+	SABR_THREADED_CASE(SABR_OP_FOR_DOWN_F): SABR_THREADED_FOR(f, v->f > record->end.f);
+
+	SABR_THREADED_CASE(SABR_OP_CASE_IF): {
+		sabr_value_t* switch_value = deque_back(sabr_value_t, &inter->switch_stack);
+		if (sabr_threaded_unlikely(!switch_value)) SABR_THREADED_FAIL(SABR_OPERR_SWITCH);
+		sp--;
+		if (switch_value->u != sp->u) SABR_THREADED_JUMP(ip->operand.u);
+	} SABR_THREADED_NEXT();
+
+	SABR_THREADED_CASE(SABR_OP_SWITCH_TABLE): SABR_THREADED_SWITCH_TABLE(*--sp);
+	SABR_THREADED_CASE(SABR_OP_SWITCH_SEARCH): SABR_THREADED_SWITCH_SEARCH(*--sp);
+
+	SABR_THREADED_CASE(SABR_OP_RETURN): {
+		if (sabr_threaded_unlikely(!inter->call_stack.size)) SABR_THREADED_FAIL(SABR_OPERR_EXEC);
+		size_t pos = deque_back(sabr_cs_data_t, &inter->call_stack)->pos;
+		deque_pop_back(sabr_cs_data_t, &inter->call_stack);
+		SABR_THREADED_JUMP(pos);
+	}
+
+	SABR_THREADED_CASE(SABR_OP_CALL): {
+		sabr_cs_data_t csd;
+		csd.pos = ip - stream + 1;
+		if (sabr_threaded_unlikely(!deque_push_back(sabr_cs_data_t, &inter->call_stack, csd))) SABR_THREADED_FAIL(SABR_OPERR_WHAT);
+		SABR_THREADED_JUMP(ip->operand.u);
+	}
+
+	SABR_THREADED_CASE(SABR_OP_LOAD_LOCAL):
+		*sp++ = inter->frame[ip->operand.u];
+		SABR_THREADED_NEXT();
+
+	SABR_THREADED_CASE(SABR_OP_STORE_LOCAL):
+		inter->frame[ip->operand.u] = *--sp;
+		SABR_THREADED_NEXT();
+
+	SABR_THREADED_CASE(SABR_OP_ADDR_LOCAL):
+		sp->p = (uint64_t*) (inter->frame + ip->operand.u);
+		sp++;
+		SABR_THREADED_NEXT();
+
+	SABR_THREADED_CASE(SABR_OP_INC_LOCAL):
+		inter->frame[ip->operand.u].i++;
+		SABR_THREADED_NEXT();
+
+	SABR_THREADED_CASE(SABR_OP_DEC_LOCAL):
+		inter->frame[ip->operand.u].i--;
+		SABR_THREADED_NEXT();
+
+	SABR_THREADED_CASE(SABR_OP_ADD_LOCAL):
+		inter->frame[ip->operand.u].i += (--sp)->i;
+		SABR_THREADED_NEXT();
+
+	SABR_THREADED_CASE(SABR_OP_FADD_LOCAL):
+		inter->frame[ip->operand.u].f += (--sp)->f;
+		SABR_THREADED_NEXT();
+
+	SABR_THREADED_CASE(SABR_OP_LOAD_GLOBAL):
+		*sp++ = inter->globals[ip->operand.u];
+		SABR_THREADED_NEXT();
+
+	SABR_THREADED_CASE(SABR_OP_STORE_GLOBAL):
+		inter->globals[ip->operand.u] = *--sp;
+		SABR_THREADED_NEXT();
+
+	SABR_THREADED_CASE(SABR_OP_ADDR_GLOBAL):
+		sp->p = (uint64_t*) (inter->globals + ip->operand.u);
+		sp++;
+		SABR_THREADED_NEXT();
+
+	SABR_THREADED_CASE(SABR_OP_INC_GLOBAL):
+		inter->globals[ip->operand.u].i++;
+		SABR_THREADED_NEXT();
+
+	SABR_THREADED_CASE(SABR_OP_DEC_GLOBAL):
+		inter->globals[ip->operand.u].i--;
+		SABR_THREADED_NEXT();
+
+	SABR_THREADED_CASE(SABR_OP_ADD_GLOBAL):
+		inter->globals[ip->operand.u].i += (--sp)->i;
+		SABR_THREADED_NEXT();
+
+	SABR_THREADED_CASE(SABR_OP_FADD_GLOBAL):
+		inter->globals[ip->operand.u].f += (--sp)->f;
+		SABR_THREADED_NEXT();
+
+	SABR_THREADED_CASE(SABR_OP_ADD): SABR_THREADED_BINARY(a.i = a.i + b.i);
+	SABR_THREADED_CASE(SABR_OP_SUB): SABR_THREADED_BINARY(a.i = a.i - b.i);
+	SABR_THREADED_CASE(SABR_OP_MUL): SABR_THREADED_BINARY(a.i = a.i * b.i);
+	SABR_THREADED_CASE(SABR_OP_DIV): SABR_THREADED_DIVISION(b.i == 0, a.i = a.i / b.i);
+	SABR_THREADED_CASE(SABR_OP_MOD): SABR_THREADED_DIVISION(b.i == 0, a.i = a.i % b.i);
+	SABR_THREADED_CASE(SABR_OP_UDIV): SABR_THREADED_DIVISION(b.u == 0, a.u = a.u / b.u);
+	SABR_THREADED_CASE(SABR_OP_UMOD): SABR_THREADED_DIVISION(b.u == 0, a.u = a.u % b.u);
+	SABR_THREADED_CASE(SABR_OP_NEG): SABR_THREADED_UNARY(a.i = -a.i);
+	SABR_THREADED_CASE(SABR_OP_INC): SABR_THREADED_UNARY(a.i++);
+	SABR_THREADED_CASE(SABR_OP_DEC): SABR_THREADED_UNARY(a.i--);
+	SABR_THREADED_CASE(SABR_OP_ADD_IMM): SABR_THREADED_UNARY(a.i = a.i + ip->operand.i);
+	SABR_THREADED_CASE(SABR_OP_MUL_IMM): SABR_THREADED_UNARY(a.i = a.i * ip->operand.i);
+
+	SABR_THREADED_CASE(SABR_OP_EQU): SABR_THREADED_BINARY(a.u = (a.i == b.i) ? -1 : 0);
+	SABR_THREADED_CASE(SABR_OP_NEQ): SABR_THREADED_BINARY(a.u = (a.i != b.i) ? -1 : 0);
+	SABR_THREADED_CASE(SABR_OP_GRT): SABR_THREADED_BINARY(a.u = (a.i > b.i) ? -1 : 0);
+	SABR_THREADED_CASE(SABR_OP_GEQ): SABR_THREADED_BINARY(a.u = (a.i >= b.i) ? -1 : 0);
+	SABR_THREADED_CASE(SABR_OP_LST): SABR_THREADED_BINARY(a.u = (a.i < b.i) ? -1 : 0);
+	SABR_THREADED_CASE(SABR_OP_LEQ): SABR_THREADED_BINARY(a.u = (a.i <= b.i) ? -1 : 0);
+	SABR_THREADED_CASE(SABR_OP_UGRT): SABR_THREADED_BINARY(a.u = (a.u > b.u) ? -1 : 0);
+	SABR_THREADED_CASE(SABR_OP_UGEQ): SABR_THREADED_BINARY(a.u = (a.u >= b.u) ? -1 : 0);
+	SABR_THREADED_CASE(SABR_OP_ULST): SABR_THREADED_BINARY(a.u = (a.u < b.u) ? -1 : 0);
+	SABR_THREADED_CASE(SABR_OP_ULEQ): SABR_THREADED_BINARY(a.u = (a.u <= b.u) ? -1 : 0);
+
+	SABR_THREADED_CASE(SABR_OP_LST_IF): SABR_THREADED_BRANCH(a.i < b.i);
+	SABR_THREADED_CASE(SABR_OP_EQU_IF): SABR_THREADED_BRANCH(a.i == b.i);
+	SABR_THREADED_CASE(SABR_OP_NEQ_IF): SABR_THREADED_BRANCH(a.i != b.i);
+	SABR_THREADED_CASE(SABR_OP_GRT_IF): SABR_THREADED_BRANCH(a.i > b.i);
+	SABR_THREADED_CASE(SABR_OP_GEQ_IF): SABR_THREADED_BRANCH(a.i >= b.i);
+	SABR_THREADED_CASE(SABR_OP_LEQ_IF): SABR_THREADED_BRANCH(a.i <= b.i);
+	SABR_THREADED_CASE(SABR_OP_UGRT_IF): SABR_THREADED_BRANCH(a.u > b.u);
+	SABR_THREADED_CASE(SABR_OP_UGEQ_IF): SABR_THREADED_BRANCH(a.u >= b.u);
+	SABR_THREADED_CASE(SABR_OP_ULST_IF): SABR_THREADED_BRANCH(a.u < b.u);
+	SABR_THREADED_CASE(SABR_OP_ULEQ_IF): SABR_THREADED_BRANCH(a.u <= b.u);
+
+	SABR_THREADED_CASE(SABR_OP_EQU_IMM): SABR_THREADED_UNARY(a.u = (a.i == ip->operand.i) ? -1 : 0);
+	SABR_THREADED_CASE(SABR_OP_NEQ_IMM): SABR_THREADED_UNARY(a.u = (a.i != ip->operand.i) ? -1 : 0);
+	SABR_THREADED_CASE(SABR_OP_GRT_IMM): SABR_THREADED_UNARY(a.u = (a.i > ip->operand.i) ? -1 : 0);
+	SABR_THREADED_CASE(SABR_OP_GEQ_IMM): SABR_THREADED_UNARY(a.u = (a.i >= ip->operand.i) ? -1 : 0);
+	SABR_THREADED_CASE(SABR_OP_LST_IMM): SABR_THREADED_UNARY(a.u = (a.i < ip->operand.i) ? -1 : 0);
+	SABR_THREADED_CASE(SABR_OP_LEQ_IMM): SABR_THREADED_UNARY(a.u = (a.i <= ip->operand.i) ? -1 : 0);
+
+	SABR_THREADED_CASE(SABR_OP_FADD): SABR_THREADED_BINARY(a.f = a.f + b.f);
+	SABR_THREADED_CASE(SABR_OP_FSUB): SABR_THREADED_BINARY(a.f = a.f - b.f);
+	SABR_THREADED_CASE(SABR_OP_FMUL): SABR_THREADED_BINARY(a.f = a.f * b.f);
+	SABR_THREADED_CASE(SABR_OP_FDIV): SABR_THREADED_DIVISION(b.f == 0.0f, a.f = a.f / b.f);
+	SABR_THREADED_CASE(SABR_OP_FMOD): SABR_THREADED_DIVISION(b.f == 0.0f, a.f = fmod(a.f, b.f));
+	SABR_THREADED_CASE(SABR_OP_FNEG): SABR_THREADED_UNARY(a.f = -a.f);
+
+	SABR_THREADED_CASE(SABR_OP_FEQU): SABR_THREADED_BINARY(a.u = (a.f == b.f) ? -1 : 0);
+	SABR_THREADED_CASE(SABR_OP_FNEQ): SABR_THREADED_BINARY(a.u = (a.f != b.f) ? -1 : 0);
+	SABR_THREADED_CASE(SABR_OP_FGRT): SABR_THREADED_BINARY(a.u = (a.f > b.f) ? -1 : 0);
+	SABR_THREADED_CASE(SABR_OP_FGEQ): SABR_THREADED_BINARY(a.u = (a.f >= b.f) ? -1 : 0);
+	SABR_THREADED_CASE(SABR_OP_FLST): SABR_THREADED_BINARY(a.u = (a.f < b.f) ? -1 : 0);
+	SABR_THREADED_CASE(SABR_OP_FLEQ): SABR_THREADED_BINARY(a.u = (a.f <= b.f) ? -1 : 0);
+	SABR_THREADED_CASE(SABR_OP_FEQU_IF): SABR_THREADED_BRANCH(a.f == b.f);
+	SABR_THREADED_CASE(SABR_OP_FNEQ_IF): SABR_THREADED_BRANCH(a.f != b.f);
+	SABR_THREADED_CASE(SABR_OP_FGRT_IF): SABR_THREADED_BRANCH(a.f > b.f);
+	SABR_THREADED_CASE(SABR_OP_FGEQ_IF): SABR_THREADED_BRANCH(a.f >= b.f);
+	SABR_THREADED_CASE(SABR_OP_FLST_IF): SABR_THREADED_BRANCH(a.f < b.f);
+	SABR_THREADED_CASE(SABR_OP_FLEQ_IF): SABR_THREADED_BRANCH(a.f <= b.f);
+
+	SABR_THREADED_CASE(SABR_OP_BAND): SABR_THREADED_BINARY(a.u = a.u & b.u);
+	SABR_THREADED_CASE(SABR_OP_BOR): SABR_THREADED_BINARY(a.u = a.u | b.u);
+	SABR_THREADED_CASE(SABR_OP_BXOR): SABR_THREADED_BINARY(a.u = a.u ^ b.u);
+	SABR_THREADED_CASE(SABR_OP_BNOT): SABR_THREADED_UNARY(a.u = ~a.u);
+	SABR_THREADED_CASE(SABR_OP_BLSFT): SABR_THREADED_BINARY(a.u = a.u << b.u);
+	SABR_THREADED_CASE(SABR_OP_BRSFT): SABR_THREADED_BINARY(a.u = a.u >> b.u);
+	SABR_THREADED_CASE(SABR_OP_BAND_IMM): SABR_THREADED_UNARY(a.u = a.u & ip->operand.u);
+	SABR_THREADED_CASE(SABR_OP_BLSFT_IMM): SABR_THREADED_UNARY(a.u = a.u << ip->operand.u);
+	SABR_THREADED_CASE(SABR_OP_BRSFT_IMM): SABR_THREADED_UNARY(a.u = a.u >> ip->operand.u);
+
+	SABR_THREADED_CASE(SABR_OP_DROP):
+		sp--;
+		SABR_THREADED_NEXT();
+
+	SABR_THREADED_CASE(SABR_OP_NIP):
+		sp--;
+		SABR_THREADED_NEXT();
+
+	SABR_THREADED_CASE(SABR_OP_DUP):
+		sp[0] = sp[-1];
+		sp++;
+		SABR_THREADED_NEXT();
+
+	SABR_THREADED_CASE(SABR_OP_OVER):
+		sp[0] = sp[-2];
+		sp++;
+		SABR_THREADED_NEXT();
+
+	SABR_THREADED_CASE(SABR_OP_TUCK): {
+		sabr_value_t b = sp[-1];
+		sp[-1] = sp[-2];
+		sp[-2] = b;
+		sp[0] = b;
+		sp++;
+	} SABR_THREADED_NEXT();
+
+	SABR_THREADED_CASE(SABR_OP_SWAP): {
+		sabr_value_t b = sp[-1];
+		sp[-1] = sp[-2];
+		sp[-2] = b;
+	} SABR_THREADED_NEXT();
+
+	SABR_THREADED_CASE(SABR_OP_ROT): {
+		sabr_value_t a = sp[-3];
+		sp[-3] = sp[-2];
+		sp[-2] = sp[-1];
+		sp[-1] = a;
+	} SABR_THREADED_NEXT();
+
+	SABR_THREADED_CASE(SABR_OP_FETCH): SABR_THREADED_UNARY(a.u = *a.p);
+
+	SABR_THREADED_CASE(SABR_OP_STORE):
+		sp -= 2;
+		*sp[1].p = sp[0].u;
+		SABR_THREADED_NEXT();
+
+	SABR_THREADED_CASE(SABR_OP_INC_MEM): SABR_THREADED_MEMORY_UNARY(a.i++);
+	SABR_THREADED_CASE(SABR_OP_DEC_MEM): SABR_THREADED_MEMORY_UNARY(a.i--);
+	SABR_THREADED_CASE(SABR_OP_ADD_MEM): SABR_THREADED_MEMORY_BINARY(a.i = a.i + b.i);
+	SABR_THREADED_CASE(SABR_OP_SUB_MEM): SABR_THREADED_MEMORY_BINARY(a.i = a.i - b.i);
+	SABR_THREADED_CASE(SABR_OP_MUL_MEM): SABR_THREADED_MEMORY_BINARY(a.i = a.i * b.i);
+	SABR_THREADED_CASE(SABR_OP_DIV_MEM): SABR_THREADED_MEMORY_DIVISION(b.i == 0, a.i = a.i / b.i);
+	SABR_THREADED_CASE(SABR_OP_MOD_MEM): SABR_THREADED_MEMORY_DIVISION(b.i == 0, a.i = a.i % b.i);
+	SABR_THREADED_CASE(SABR_OP_FADD_MEM): SABR_THREADED_MEMORY_BINARY(a.f = a.f + b.f);
+	SABR_THREADED_CASE(SABR_OP_FSUB_MEM): SABR_THREADED_MEMORY_BINARY(a.f = a.f - b.f);
+	SABR_THREADED_CASE(SABR_OP_FMUL_MEM): SABR_THREADED_MEMORY_BINARY(a.f = a.f * b.f);
+	SABR_THREADED_CASE(SABR_OP_FDIV_MEM): SABR_THREADED_MEMORY_DIVISION(b.f == 0.0f, a.f = a.f / b.f);
+	SABR_THREADED_CASE(SABR_OP_FMOD_MEM): SABR_THREADED_MEMORY_DIVISION(b.f == 0.0f, a.f = fmod(a.f, b.f));
+	SABR_THREADED_CASE(SABR_OP_BAND_MEM): SABR_THREADED_MEMORY_BINARY(a.u = a.u & b.u);
+	SABR_THREADED_CASE(SABR_OP_BOR_MEM): SABR_THREADED_MEMORY_BINARY(a.u = a.u | b.u);
+	SABR_THREADED_CASE(SABR_OP_BXOR_MEM): SABR_THREADED_MEMORY_BINARY(a.u = a.u ^ b.u);
+	SABR_THREADED_CASE(SABR_OP_BNOT_MEM): SABR_THREADED_MEMORY_UNARY(a.u = ~a.u);
+	SABR_THREADED_CASE(SABR_OP_BLSFT_MEM): SABR_THREADED_MEMORY_BINARY(a.u = a.u << b.u);
+	SABR_THREADED_CASE(SABR_OP_BRSFT_MEM): SABR_THREADED_MEMORY_BINARY(a.u = a.u >> b.u);
+
+	SABR_THREADED_CASE(SABR_OP_INDEX_CELL): SABR_THREADED_BINARY(a.u = b.u + a.u * sizeof(sabr_value_t));
+	SABR_THREADED_CASE(SABR_OP_FETCH_IDX): SABR_THREADED_BINARY(a.u = b.p[a.u]);
+
+	SABR_THREADED_CASE(SABR_OP_STORE_IDX):
+		sp -= 3;
+		sp[2].p[sp[1].u] = sp[0].u;
+		SABR_THREADED_NEXT();
+
+	SABR_THREADED_CASE(SABR_OP_FETCH_OFF): SABR_THREADED_UNARY(a.u = *(uint64_t*) (a.u + ip->operand.u));
+
+	SABR_THREADED_CASE(SABR_OP_STORE_OFF):
+		sp -= 2;
+		*(uint64_t*) (sp[1].u + ip->operand.u) = sp[0].u;
+		SABR_THREADED_NEXT();
+
+	SABR_THREADED_CASE(SABR_OP_ITOF): SABR_THREADED_UNARY(a.f = (double) a.i);
+	SABR_THREADED_CASE(SABR_OP_UTOF): SABR_THREADED_UNARY(a.f = (double) a.u);
+	SABR_THREADED_CASE(SABR_OP_FTOI): SABR_THREADED_UNARY(a.i = (int64_t) a.f);
+	SABR_THREADED_CASE(SABR_OP_FTOU): SABR_THREADED_UNARY(a.u = (int64_t) a.f);
+
+	SABR_THREADED_DEFAULT: {
+		size_t index = ip - stream;
+		sabr_bcop_t bcop = *vector_at(sabr_bcop_t, &bc->bcop_vec, index);
+		inter->data_stack.size = sp - base;
+		result = sabr_interpreter_op_functions[bcop.oc - 1](inter, bcop, &index);
+		sp = base + inter->data_stack.size;
+		if (sabr_threaded_unlikely(result)) {
+			fprintf(stderr, "result: %u, index: %zu\n", result, index);
+			goto FREE_ALL;
+		}
+		SABR_THREADED_JUMP(index + 1);
+	}
+
+#if !defined(SABR_THREADED_COMPUTED_GOTO)
+	}
+#endif
+
+CHECKED: {
+		size_t index = ip - stream;
+		size_t end = blocks[index].end;
+		inter->data_stack.size = sp - base;
+		while (index < end) {
+			sabr_bcop_t bcop = *vector_at(sabr_bcop_t, &bc->bcop_vec, index);
+			size_t current = index;
+			if (bcop.oc == SABR_OP_EXIT) {
+				sp = base + inter->data_stack.size;
+				succeed = true;
+				goto FREE_ALL;
+			}
+			if (bcop.oc != SABR_OP_NONE) {
+				result = sabr_interpreter_op_functions[bcop.oc - 1](inter, bcop, &index);
+				if (result) {
+					sp = base + inter->data_stack.size;
+					fprintf(stderr, "result: %u, index: %zu\n", result, index);
+					goto FREE_ALL;
+				}
+			}
+			index++;
+			if (index != current + 1) break;
+		}
+		sp = base + inter->data_stack.size;
+		SABR_THREADED_JUMP(index);
+	}
+
+FAILURE:
+	fprintf(stderr, "result: %u, index: %zu\n", result, (size_t) (ip - stream));
+	goto FREE_ALL;
+
+FREE_ALL:
+	inter->data_stack.size = sp - base;
+	sabr_jit_del(&jit);
+	free(stream);
+	free(blocks);
+	free(hots);
+	return succeed;
+}
+
+bool sabr_interpreter_threaded_prepare(sabr_bytecode_t* bc, sabr_threaded_op_t** stream, sabr_threaded_block_t** blocks) {
+	bool succeed = false;
+	size_t size = bc->bcop_vec.size;
+	vector(sabr_block_data_t) block_data_vec;
+
+	vector_init(sabr_block_data_t, &block_data_vec);
+
+	*stream = (sabr_threaded_op_t*) malloc(sizeof(sabr_threaded_op_t) * (size + 1));
+	*blocks = (sabr_threaded_block_t*) malloc(sizeof(sabr_threaded_block_t) * (size + 1));
+	if (!*stream || !*blocks) {
+		fputs(sabr_errmsg_alloc, stderr);
+		goto FREE_ALL;
+	}
+
+	for (size_t i = 0; i <= size; i++) {
+		sabr_bcop_t bcop = (i < size) ? *vector_at(sabr_bcop_t, &bc->bcop_vec, i) : sabr_new_bcop(SABR_OP_EXIT);
+		if (bcop.oc >= sabr_opcode_names_len) goto INVALID;
+		if (sabr_opcode_has_index_operand(bcop.oc) && bcop.operand.u > size) goto INVALID;
+		if ((bcop.oc == SABR_OP_SWITCH_TABLE || bcop.oc == SABR_OP_SWITCH_SEARCH) && !sabr_bytecode_check_switch(bc, bcop)) goto INVALID;
+		(*stream)[i].oc = bcop.oc;
+		(*stream)[i].operand = bcop.operand;
+	}
+
+	if (!sabr_interpreter_verify_bytecode(bc, &block_data_vec)) goto FREE_ALL;
+	for (size_t i = 0; i < block_data_vec.size; i++) {
+		sabr_block_data_t data = *vector_at(sabr_block_data_t, &block_data_vec, i);
+		if (!data.need && !data.grow) continue;
+		sabr_threaded_block_t* block = *blocks + data.begin;
+		block->oc = (*stream)[data.begin].oc;
+		block->end = data.end;
+		block->need = data.need;
+		block->grow = data.grow;
+		(*stream)[data.begin].oc = SABR_THREADED_OC_BLOCK;
+	}
+
+	succeed = true;
+	goto FREE_ALL;
+
+INVALID:
+	fputs(sabr_errmsg_invalid_bytecode, stderr);
+
+FREE_ALL:
+	vector_free(sabr_block_data_t, &block_data_vec);
+	return succeed;
+}
\ No newline at end of file
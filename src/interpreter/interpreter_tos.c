@@ -0,0 +1,442 @@
+#include "interpreter_threaded.h"
+
+#define SABR_TOS_SPILL() do { sp[-2] = nos; sp[-1] = tos; inter->data_stack.size = sp - base; } while (0)
+#define SABR_TOS_FILL() do { sp = base + inter->data_stack.size; tos = sp[-1]; nos = sp[-2]; } while (0)
+
+#define SABR_TOS_PUSH(V) do { sabr_value_t v = (V); sp[-2] = nos; nos = tos; tos = v; sp++; } while (0)
+#define SABR_TOS_POP() do { tos = nos; nos = sp[-3]; sp--; } while (0)
+#define SABR_TOS_POP2() do { tos = sp[-3]; nos = sp[-4]; sp -= 2; } while (0)
+
+#define SABR_TOS_UNARY(EXPR) { \
+	sabr_value_t a = tos; \
+	EXPR; \
+	tos = a; \
+} SABR_THREADED_NEXT()
+
+#define SABR_TOS_BINARY(EXPR) { \
+	sabr_value_t a = nos; \
+	sabr_value_t b = tos; \
+	EXPR; \
+	tos = a; \
+	nos = sp[-3]; \
+	sp--; \
+} SABR_THREADED_NEXT()
+
+#define SABR_TOS_DIVISION(CHECK, EXPR) { \
+	sabr_value_t a = nos; \
+	sabr_value_t b = tos; \
+	if (sabr_threaded_unlikely(CHECK)) SABR_THREADED_FAIL(SABR_OPERR_DIV_BY_ZERO); \
+	EXPR; \
+	tos = a; \
+	nos = sp[-3]; \
+	sp--; \
+} SABR_THREADED_NEXT()
+
+#define SABR_TOS_BRANCH(COND) { \
+	sabr_value_t a = nos; \
+	sabr_value_t b = tos; \
+	SABR_TOS_POP2(); \
+	if (!(COND)) SABR_THREADED_JUMP(ip->operand.u); \
+} SABR_THREADED_NEXT()
+
+#define SABR_TOS_MEMORY_UNARY(EXPR) { \
+	sabr_value_t a = { .u = *tos.p }; \
+	EXPR; \
+	*tos.p = a.u; \
+	SABR_TOS_POP(); \
+} SABR_THREADED_NEXT()
+
+#define SABR_TOS_MEMORY_BINARY(EXPR) { \
+	sabr_value_t a = { .u = *tos.p }; \
+	sabr_value_t b = nos; \
+	EXPR; \
+	*tos.p = a.u; \
+	SABR_TOS_POP2(); \
+} SABR_THREADED_NEXT()
+
+#define SABR_TOS_MEMORY_DIVISION(CHECK, EXPR) { \
+	sabr_value_t a = { .u = *tos.p }; \
+	sabr_value_t b = nos; \
+	if (sabr_threaded_unlikely(CHECK)) SABR_THREADED_FAIL(SABR_OPERR_DIV_BY_ZERO); \
+	EXPR; \
+	*tos.p = a.u; \
+	SABR_TOS_POP2(); \
+} SABR_THREADED_NEXT()
+
+bool sabr_interpreter_run_bytecode_tos(sabr_interpreter_t* inter, sabr_bytecode_t* bc) {
+	bool succeed = false;
+	uint32_t result = SABR_OPERR_NONE;
+	sabr_threaded_op_t* stream = NULL;
+	sabr_threaded_block_t* blocks = NULL;
+	sabr_threaded_op_t* ip = NULL;
+
+	sabr_value_t* base = inter->data_stack.data;
+	sabr_value_t* sp = base + inter->data_stack.size;
+	sabr_value_t tos = sp[-1];
+	sabr_value_t nos = sp[-2];
+	size_t capacity = inter->data_stack.capacity;
+
+#if !defined(SABR_THREADED_COMPUTED_GOTO)
+	uint32_t oc;
+#endif
+
+#if defined(SABR_THREADED_COMPUTED_GOTO)
+	static const void* labels[] = { SABR_THREADED_BIND_ALL };
+	size_t labels_len = sizeof(labels) / sizeof(void*);
+#endif
+
+	if (!sabr_interpreter_threaded_prepare(bc, &stream, &blocks)) goto FREE_ALL;
+	SABR_THREADED_RESOLVE();
+
+	ip = stream;
+	SABR_THREADED_DISPATCH();
+
+#if !defined(SABR_THREADED_COMPUTED_GOTO)
+DISPATCH:
+	oc = ip->oc;
+SWITCH:
+	switch (oc) {
+#endif
+
+	SABR_THREADED_BLOCK: {
+		sabr_threaded_block_t* block = blocks + (ip - stream);
+		size_t depth = sp - base;
+		if (sabr_threaded_unlikely(depth < block->need || block->grow > capacity - depth)) goto CHECKED;
+#if defined(SABR_THREADED_COMPUTED_GOTO)
+		goto *block->label;
+#else
+		oc = block->oc;
+		goto SWITCH;
+#endif
+	}
+
+	SABR_THREADED_CASE(SABR_OP_NONE):
+		SABR_THREADED_NEXT();
+
+	SABR_THREADED_CASE(SABR_OP_EXIT):
+		succeed = true;
+		goto FREE_ALL;
+
+	SABR_THREADED_CASE(SABR_OP_VALUE):
+		SABR_TOS_PUSH(ip->operand);
+		SABR_THREADED_NEXT();
+
+	SABR_THREADED_CASE(SABR_OP_IF): {
+		sabr_value_t cond = tos;
+		SABR_TOS_POP();
+		if (!cond.u) SABR_THREADED_JUMP(ip->operand.u);
+	} SABR_THREADED_NEXT();
+
+	SABR_THREADED_CASE(SABR_OP_CASE_IF): {
+		sabr_value_t* switch_value = deque_back(sabr_value_t, &inter->switch_stack);
+		if (sabr_threaded_unlikely(!switch_value)) SABR_THREADED_FAIL(SABR_OPERR_SWITCH);
+		sabr_value_t v = tos;
+		SABR_TOS_POP();
+		if (switch_value->u != v.u) SABR_THREADED_JUMP(ip->operand.u);
+	} SABR_THREADED_NEXT();
+
+	SABR_THREADED_CASE(SABR_OP_SWITCH_TABLE): {
+		sabr_value_t v = tos;
+		SABR_TOS_POP();
+		SABR_THREADED_SWITCH_TABLE(v);
+	}
+
+	SABR_THREADED_CASE(SABR_OP_SWITCH_SEARCH): {
+		sabr_value_t v = tos;
+		SABR_TOS_POP();
+		SABR_THREADED_SWITCH_SEARCH(v);
+	}
+
+	SABR_THREADED_CASE(SABR_OP_JUMP):
+		SABR_THREADED_JUMP(ip->operand.u);
+
+	SABR_THREADED_CASE(SABR_OP_FOR_LOOP_I): SABR_THREADED_FOR(i, (record->step.i > 0) ? v->i < record->end.i : v->i > record->end.i);
+	SABR_THREADED_CASE(SABR_OP_FOR_LOOP_U): SABR_THREADED_FOR(u, (record->step.u > 0) ? v->u < record->end.u : v->u > record->end.u);
+	SABR_THREADED_CASE(SABR_OP_FOR_LOOP_F): SABR_THREADED_FOR(f, (record->step.f > 0.0) ? v->f < record->end.f : v->f > record->end.f);
+	SABR_THREADED_CASE(SABR_OP_FOR_UP_I): SABR_THREADED_FOR(i, v->i < record->end.i);
+	SABR_THREADED_CASE(SABR_OP_FOR_UP_U): SABR_THREADED_FOR(u, v->u < record->end.u);
+	SABR_THREADED_CASE(SABR_OP_FOR_UP_F): SABR_THREADED_FOR(f, v->f < record->end.f);
+	SABR_THREADED_CASE(SABR_OP_FOR_DOWN_I): SABR_THREADED_FOR(i, v->i > record->end.i);
+	SABR_THREADED_CASE(SABR_OP_FOR_DOWN_U): SABR_THREADED_FOR(u, v->u > record->end.u);
+	SABR_THREADED_CASE(SABR_OP_FOR_DOWN_F): SABR_THREADED_FOR(f, v->f > record->end.f);
+
+	SABR_THREADED_CASE(SABR_OP_RETURN): {
+		if (sabr_threaded_unlikely(!inter->call_stack.size)) SABR_THREADED_FAIL(SABR_OPERR_EXEC);
+		size_t pos = deque_back(sabr_cs_data_t, &inter->call_stack)->pos;
+		deque_pop_back(sabr_cs_data_t, &inter->call_stack);
+		SABR_THREADED_JUMP(pos);
+	}
+
+	SABR_THREADED_CASE(SABR_OP_CALL): {
+		sabr_cs_data_t csd;
+		csd.pos = ip - stream + 1;
+		if (sabr_threaded_unlikely(!deque_push_back(sabr_cs_data_t, &inter->call_stack, csd))) SABR_THREADED_FAIL(SABR_OPERR_WHAT);
+		SABR_THREADED_JUMP(ip->operand.u);
+	}
+
+	SABR_THREADED_CASE(SABR_OP_LOAD_LOCAL):
+		SABR_TOS_PUSH(inter->frame[ip->operand.u]);
+		SABR_THREADED_NEXT();
+
+	SABR_THREADED_CASE(SABR_OP_STORE_LOCAL):
+		inter->frame[ip->operand.u] = tos;
+		SABR_TOS_POP();
+		SABR_THREADED_NEXT();
+
+	SABR_THREADED_CASE(SABR_OP_ADDR_LOCAL):
+		SABR_TOS_PUSH((sabr_value_t) { .p = (uint64_t*) (inter->frame + ip->operand.u) });
+		SABR_THREADED_NEXT();
+
+	SABR_THREADED_CASE(SABR_OP_INC_LOCAL):
+		inter->frame[ip->operand.u].i++;
+		SABR_THREADED_NEXT();
+
+	SABR_THREADED_CASE(SABR_OP_DEC_LOCAL):
+		inter->frame[ip->operand.u].i--;
+		SABR_THREADED_NEXT();
+
+	SABR_THREADED_CASE(SABR_OP_ADD_LOCAL):
+		inter->frame[ip->operand.u].i += tos.i;
+		SABR_TOS_POP();
+		SABR_THREADED_NEXT();
+
+	SABR_THREADED_CASE(SABR_OP_FADD_LOCAL):
+		inter->frame[ip->operand.u].f += tos.f;
+		SABR_TOS_POP();
+		SABR_THREADED_NEXT();
+
+	SABR_THREADED_CASE(SABR_OP_LOAD_GLOBAL):
+		SABR_TOS_PUSH(inter->globals[ip->operand.u]);
+		SABR_THREADED_NEXT();
+
+	SABR_THREADED_CASE(SABR_OP_STORE_GLOBAL):
+		inter->globals[ip->operand.u] = tos;
+		SABR_TOS_POP();
+		SABR_THREADED_NEXT();
+
+	SABR_THREADED_CASE(SABR_OP_ADDR_GLOBAL):
+		SABR_TOS_PUSH((sabr_value_t) { .p = (uint64_t*) (inter->globals + ip->operand.u) });
+		SABR_THREADED_NEXT();
+
+	SABR_THREADED_CASE(SABR_OP_INC_GLOBAL):
+		inter->globals[ip->operand.u].i++;
+		SABR_THREADED_NEXT();
+
+	SABR_THREADED_CASE(SABR_OP_DEC_GLOBAL):
+		inter->globals[ip->operand.u].i--;
+		SABR_THREADED_NEXT();
+
+	SABR_THREADED_CASE(SABR_OP_ADD_GLOBAL):
+		inter->globals[ip->operand.u].i += tos.i;
+		SABR_TOS_POP();
+		SABR_THREADED_NEXT();
+
+	SABR_THREADED_CASE(SABR_OP_FADD_GLOBAL):
+		inter->globals[ip->operand.u].f += tos.f;
+		SABR_TOS_POP();
+		SABR_THREADED_NEXT();
+
+	SABR_THREADED_CASE(SABR_OP_ADD): SABR_TOS_BINARY(a.i = a.i + b.i);
+	SABR_THREADED_CASE(SABR_OP_SUB): SABR_TOS_BINARY(a.i = a.i - b.i);
+	SABR_THREADED_CASE(SABR_OP_MUL): SABR_TOS_BINARY(a.i = a.i * b.i);
+	SABR_THREADED_CASE(SABR_OP_DIV): SABR_TOS_DIVISION(b.i == 0, a.i = a.i / b.i);
+	SABR_THREADED_CASE(SABR_OP_MOD): SABR_TOS_DIVISION(b.i == 0, a.i = a.i % b.i);
+	SABR_THREADED_CASE(SABR_OP_UDIV): SABR_TOS_DIVISION(b.u == 0, a.u = a.u / b.u);
+	SABR_THREADED_CASE(SABR_OP_UMOD): SABR_TOS_DIVISION(b.u == 0, a.u = a.u % b.u);
+	SABR_THREADED_CASE(SABR_OP_NEG): SABR_TOS_UNARY(a.i = -a.i);
+	SABR_THREADED_CASE(SABR_OP_INC): SABR_TOS_UNARY(a.i++);
+	SABR_THREADED_CASE(SABR_OP_DEC): SABR_TOS_UNARY(a.i--);
+	SABR_THREADED_CASE(SABR_OP_ADD_IMM): SABR_TOS_UNARY(a.i = a.i + ip->operand.i);
+	SABR_THREADED_CASE(SABR_OP_MUL_IMM): SABR_TOS_UNARY(a.i = a.i * ip->operand.i);
+
+	SABR_THREADED_CASE(SABR_OP_EQU): SABR_TOS_BINARY(a.u = (a.i == b.i) ? -1 : 0);
+	SABR_THREADED_CASE(SABR_OP_NEQ): SABR_TOS_BINARY(a.u = (a.i != b.i) ? -1 : 0);
+	SABR_THREADED_CASE(SABR_OP_GRT): SABR_TOS_BINARY(a.u = (a.i > b.i) ? -1 : 0);
+	SABR_THREADED_CASE(SABR_OP_GEQ): SABR_TOS_BINARY(a.u = (a.i >= b.i) ? -1 : 0);
+	SABR_THREADED_CASE(SABR_OP_LST): SABR_TOS_BINARY(a.u = (a.i < b.i) ? -1 : 0);
+	SABR_THREADED_CASE(SABR_OP_LEQ): SABR_TOS_BINARY(a.u = (a.i <= b.i) ? -1 : 0);
+	SABR_THREADED_CASE(SABR_OP_UGRT): SABR_TOS_BINARY(a.u = (a.u > b.u) ? -1 : 0);
+	SABR_THREADED_CASE(SABR_OP_UGEQ): SABR_TOS_BINARY(a.u = (a.u >= b.u) ? -1 : 0);
+	SABR_THREADED_CASE(SABR_OP_ULST): SABR_TOS_BINARY(a.u = (a.u < b.u) ? -1 : 0);
+	SABR_THREADED_CASE(SABR_OP_ULEQ): SABR_TOS_BINARY(a.u = (a.u <= b.u) ? -1 : 0);
+
+	SABR_THREADED_CASE(SABR_OP_LST_IF): SABR_TOS_BRANCH(a.i < b.i);
+	SABR_THREADED_CASE(SABR_OP_EQU_IF): SABR_TOS_BRANCH(a.i == b.i);
+	SABR_THREADED_CASE(SABR_OP_NEQ_IF): SABR_TOS_BRANCH(a.i != b.i);
+	SABR_THREADED_CASE(SABR_OP_GRT_IF): SABR_TOS_BRANCH(a.i > b.i);
+	SABR_THREADED_CASE(SABR_OP_GEQ_IF): SABR_TOS_BRANCH(a.i >= b.i);
+	SABR_THREADED_CASE(SABR_OP_LEQ_IF): SABR_TOS_BRANCH(a.i <= b.i);
+	SABR_THREADED_CASE(SABR_OP_UGRT_IF): SABR_TOS_BRANCH(a.u > b.u);
+	SABR_THREADED_CASE(SABR_OP_UGEQ_IF): SABR_TOS_BRANCH(a.u >= b.u);
+	SABR_THREADED_CASE(SABR_OP_ULST_IF): SABR_TOS_BRANCH(a.u < b.u);
+	SABR_THREADED_CASE(SABR_OP_ULEQ_IF): SABR_TOS_BRANCH(a.u <= b.u);
+
+	SABR_THREADED_CASE(SABR_OP_EQU_IMM): SABR_TOS_UNARY(a.u = (a.i == ip->operand.i) ? -1 : 0);
+	SABR_THREADED_CASE(SABR_OP_NEQ_IMM): SABR_TOS_UNARY(a.u = (a.i != ip->operand.i) ? -1 : 0);
+	SABR_THREADED_CASE(SABR_OP_GRT_IMM): SABR_TOS_UNARY(a.u = (a.i > ip->operand.i) ? -1 : 0);
+	SABR_THREADED_CASE(SABR_OP_GEQ_IMM): SABR_TOS_UNARY(a.u = (a.i >= ip->operand.i) ? -1 : 0);
+	SABR_THREADED_CASE(SABR_OP_LST_IMM): SABR_TOS_UNARY(a.u = (a.i < ip->operand.i) ? -1 : 0);
+	SABR_THREADED_CASE(SABR_OP_LEQ_IMM): SABR_TOS_UNARY(a.u = (a.i <= ip->operand.i) ? -1 : 0);
+
+	SABR_THREADED_CASE(SABR_OP_FADD): SABR_TOS_BINARY(a.f = a.f + b.f);
+	SABR_THREADED_CASE(SABR_OP_FSUB): SABR_TOS_BINARY(a.f = a.f - b.f);
+	SABR_THREADED_CASE(SABR_OP_FMUL): SABR_TOS_BINARY(a.f = a.f * b.f);
+	SABR_THREADED_CASE(SABR_OP_FDIV): SABR_TOS_DIVISION(b.f == 0.0f, a.f = a.f / b.f);
+	SABR_THREADED_CASE(SABR_OP_FMOD): SABR_TOS_DIVISION(b.f == 0.0f, a.f = fmod(a.f, b.f));
+	SABR_THREADED_CASE(SABR_OP_FNEG): SABR_TOS_UNARY(a.u = a.u ^ (UINT64_C(1) << 63));
+
+	SABR_THREADED_CASE(SABR_OP_FEQU): SABR_TOS_BINARY(a.u = (a.f == b.f) ? -1 : 0);
+	SABR_THREADED_CASE(SABR_OP_FNEQ): SABR_TOS_BINARY(a.u = (a.f != b.f) ? -1 : 0);
+	SABR_THREADED_CASE(SABR_OP_FGRT): SABR_TOS_BINARY(a.u = (a.f > b.f) ? -1 : 0);
+	SABR_THREADED_CASE(SABR_OP_FGEQ): SABR_TOS_BINARY(a.u = (a.f >= b.f) ? -1 : 0);
+	SABR_THREADED_CASE(SABR_OP_FLST): SABR_TOS_BINARY(a.u = (a.f < b.f) ? -1 : 0);
+	SABR_THREADED_CASE(SABR_OP_FLEQ): SABR_TOS_BINARY(a.u = (a.f <= b.f) ? -1 : 0);
+	SABR_THREADED_CASE(SABR_OP_FEQU_IF): SABR_TOS_BRANCH(a.f == b.f);
+	SABR_THREADED_CASE(SABR_OP_FNEQ_IF): SABR_TOS_BRANCH(a.f != b.f);
+	SABR_THREADED_CASE(SABR_OP_FGRT_IF): SABR_TOS_BRANCH(a.f > b.f);
+	SABR_THREADED_CASE(SABR_OP_FGEQ_IF): SABR_TOS_BRANCH(a.f >= b.f);
+	SABR_THREADED_CASE(SABR_OP_FLST_IF): SABR_TOS_BRANCH(a.f < b.f);
+	SABR_THREADED_CASE(SABR_OP_FLEQ_IF): SABR_TOS_BRANCH(a.f <= b.f);
+
+	SABR_THREADED_CASE(SABR_OP_BAND): SABR_TOS_BINARY(a.u = a.u & b.u);
+	SABR_THREADED_CASE(SABR_OP_BOR): SABR_TOS_BINARY(a.u = a.u | b.u);
+	SABR_THREADED_CASE(SABR_OP_BXOR): SABR_TOS_BINARY(a.u = a.u ^ b.u);
+	SABR_THREADED_CASE(SABR_OP_BNOT): SABR_TOS_UNARY(a.u = ~a.u);
+	SABR_THREADED_CASE(SABR_OP_BLSFT): SABR_TOS_BINARY(a.u = a.u << b.u);
+	SABR_THREADED_CASE(SABR_OP_BRSFT): SABR_TOS_BINARY(a.u = a.u >> b.u);
+	SABR_THREADED_CASE(SABR_OP_BAND_IMM): SABR_TOS_UNARY(a.u = a.u & ip->operand.u);
+	SABR_THREADED_CASE(SABR_OP_BLSFT_IMM): SABR_TOS_UNARY(a.u = a.u << ip->operand.u);
+	SABR_THREADED_CASE(SABR_OP_BRSFT_IMM): SABR_TOS_UNARY(a.u = a.u >> ip->operand.u);
+
+	SABR_THREADED_CASE(SABR_OP_DROP):
+	SABR_THREADED_CASE(SABR_OP_NIP):
+		SABR_TOS_POP();
+		SABR_THREADED_NEXT();
+
+	SABR_THREADED_CASE(SABR_OP_DUP):
+		SABR_TOS_PUSH(tos);
+		SABR_THREADED_NEXT();
+
+	SABR_THREADED_CASE(SABR_OP_OVER):
+		SABR_TOS_PUSH(nos);
+		SABR_THREADED_NEXT();
+
+	SABR_THREADED_CASE(SABR_OP_TUCK):
+		sp[-2] = tos;
+		sp++;
+		SABR_THREADED_NEXT();
+
+	SABR_THREADED_CASE(SABR_OP_SWAP): {
+		sabr_value_t a = nos;
+		nos = tos;
+		tos = a;
+	} SABR_THREADED_NEXT();
+
+	SABR_THREADED_CASE(SABR_OP_ROT): {
+		sabr_value_t a = sp[-3];
+		sp[-3] = nos;
+		nos = tos;
+		tos = a;
+	} SABR_THREADED_NEXT();
+
+	SABR_THREADED_CASE(SABR_OP_FETCH): SABR_TOS_UNARY(a.u = *a.p);
+
+	SABR_THREADED_CASE(SABR_OP_STORE):
+		*tos.p = nos.u;
+		SABR_TOS_POP2();
+		SABR_THREADED_NEXT();
+
+	SABR_THREADED_CASE(SABR_OP_INC_MEM): SABR_TOS_MEMORY_UNARY(a.i++);
+	SABR_THREADED_CASE(SABR_OP_DEC_MEM): SABR_TOS_MEMORY_UNARY(a.i--);
+	SABR_THREADED_CASE(SABR_OP_ADD_MEM): SABR_TOS_MEMORY_BINARY(a.i = a.i + b.i);
+	SABR_THREADED_CASE(SABR_OP_SUB_MEM): SABR_TOS_MEMORY_BINARY(a.i = a.i - b.i);
+	SABR_THREADED_CASE(SABR_OP_MUL_MEM): SABR_TOS_MEMORY_BINARY(a.i = a.i * b.i);
+	SABR_THREADED_CASE(SABR_OP_DIV_MEM): SABR_TOS_MEMORY_DIVISION(b.i == 0, a.i = a.i / b.i);
+	SABR_THREADED_CASE(SABR_OP_MOD_MEM): SABR_TOS_MEMORY_DIVISION(b.i == 0, a.i = a.i % b.i);
+	SABR_THREADED_CASE(SABR_OP_FADD_MEM): SABR_TOS_MEMORY_BINARY(a.f = a.f + b.f);
+	SABR_THREADED_CASE(SABR_OP_FSUB_MEM): SABR_TOS_MEMORY_BINARY(a.f = a.f - b.f);
+	SABR_THREADED_CASE(SABR_OP_FMUL_MEM): SABR_TOS_MEMORY_BINARY(a.f = a.f * b.f);
+	SABR_THREADED_CASE(SABR_OP_FDIV_MEM): SABR_TOS_MEMORY_DIVISION(b.f == 0.0f, a.f = a.f / b.f);
+	SABR_THREADED_CASE(SABR_OP_FMOD_MEM): SABR_TOS_MEMORY_DIVISION(b.f == 0.0f, a.f = fmod(a.f, b.f));
+	SABR_THREADED_CASE(SABR_OP_BAND_MEM): SABR_TOS_MEMORY_BINARY(a.u = a.u & b.u);
+	SABR_THREADED_CASE(SABR_OP_BOR_MEM): SABR_TOS_MEMORY_BINARY(a.u = a.u | b.u);
+	SABR_THREADED_CASE(SABR_OP_BXOR_MEM): SABR_TOS_MEMORY_BINARY(a.u = a.u ^ b.u);
+	SABR_THREADED_CASE(SABR_OP_BNOT_MEM): SABR_TOS_MEMORY_UNARY(a.u = ~a.u);
+	SABR_THREADED_CASE(SABR_OP_BLSFT_MEM): SABR_TOS_MEMORY_BINARY(a.u = a.u << b.u);
+	SABR_THREADED_CASE(SABR_OP_BRSFT_MEM): SABR_TOS_MEMORY_BINARY(a.u = a.u >> b.u);
+
+	SABR_THREADED_CASE(SABR_OP_INDEX_CELL): SABR_TOS_BINARY(a.u = b.u + a.u * sizeof(sabr_value_t));
+	SABR_THREADED_CASE(SABR_OP_FETCH_IDX): SABR_TOS_BINARY(a.u = b.p[a.u]);
+
+	SABR_THREADED_CASE(SABR_OP_STORE_IDX):
+		tos.p[nos.u] = sp[-3].u;
+		tos = sp[-4];
+		nos = sp[-5];
+		sp -= 3;
+		SABR_THREADED_NEXT();
+
+	SABR_THREADED_CASE(SABR_OP_FETCH_OFF): SABR_TOS_UNARY(a.u = *(uint64_t*) (a.u + ip->operand.u));
+
+	SABR_THREADED_CASE(SABR_OP_STORE_OFF):
+		*(uint64_t*) (tos.u + ip->operand.u) = nos.u;
+		SABR_TOS_POP2();
+		SABR_THREADED_NEXT();
+
+	SABR_THREADED_CASE(SABR_OP_ITOF): SABR_TOS_UNARY(a.f = (double) a.i);
+	SABR_THREADED_CASE(SABR_OP_UTOF): SABR_TOS_UNARY(a.f = (double) a.u);
+	SABR_THREADED_CASE(SABR_OP_FTOI): SABR_TOS_UNARY(a.i = (int64_t) a.f);
+	SABR_THREADED_CASE(SABR_OP_FTOU): SABR_TOS_UNARY(a.u = (int64_t) a.f);
+
+	SABR_THREADED_DEFAULT: {
+		size_t index = ip - stream;
+		sabr_bcop_t bcop = *vector_at(sabr_bcop_t, &bc->bcop_vec, index);
+		SABR_TOS_SPILL();
+		result = sabr_interpreter_op_functions[bcop.oc - 1](inter, bcop, &index);
+		SABR_TOS_FILL();
+		if (sabr_threaded_unlikely(result)) {
+			fprintf(stderr, "result: %u, index: %zu\n", result, index);
+			goto FREE_ALL;
+		}
+		SABR_THREADED_JUMP(index + 1);
+	}
+
+#if !defined(SABR_THREADED_COMPUTED_GOTO)
+	}
+#endif
+
+CHECKED: {
+		size_t index = ip - stream;
+		size_t end = blocks[index].end;
+		SABR_TOS_SPILL();
+		while (index < end) {
+			sabr_bcop_t bcop = *vector_at(sabr_bcop_t, &bc->bcop_vec, index);
+			size_t current = index;
+			if (bcop.oc == SABR_OP_EXIT) {
+				SABR_TOS_FILL();
+				succeed = true;
+				goto FREE_ALL;
+			}
+			if (bcop.oc != SABR_OP_NONE) {
+				result = sabr_interpreter_op_functions[bcop.oc - 1](inter, bcop, &index);
+				if (result) {
+					SABR_TOS_FILL();
+					fprintf(stderr, "result: %u, index: %zu\n", result, index);
+					goto FREE_ALL;
+				}
+			}
+			index++;
+			if (index != current + 1) break;
+		}
+		SABR_TOS_FILL();
+		SABR_THREADED_JUMP(index);
+	}
+
+FAILURE:
+	fprintf(stderr, "result: %u, index: %zu\n", result, (size_t) (ip - stream));
+
+FREE_ALL:
+	SABR_TOS_SPILL();
+	free(stream);
+	free(blocks);
+	return succeed;
+}
\ No newline at end of file
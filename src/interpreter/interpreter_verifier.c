@@ -0,0 +1,71 @@
+#include "interpreter_verifier.h"
+
+bool sabr_interpreter_verify_bytecode(sabr_bytecode_t* bc, vector(sabr_block_data_t)* blocks) {
+	bool result = false;
+	size_t size = bc->bcop_vec.size;
+
+	bool* leaders = (bool*) calloc(size + 1, sizeof(bool));
+	if (!leaders) {
+		fputs(sabr_errmsg_alloc, stderr);
+		return false;
+	}
+
+	leaders[0] = true;
+	for (size_t i = 0; i < size; i++) {
+		sabr_bcop_t bcop = *vector_at(sabr_bcop_t, &bc->bcop_vec, i);
+		size_t pops, pushes;
+		if (sabr_opcode_has_index_operand(bcop.oc) && bcop.operand.u <= size)
+			leaders[bcop.operand.u] = true;
+		if (bcop.oc == SABR_OP_LAMBDA) leaders[i + 1] = true;
+		if (sabr_opcode_is_control(bcop.oc)) leaders[i + 1] = true;
+		if (!sabr_opcode_stack_effect(bcop.oc, &pops, &pushes)) {
+			leaders[i] = true;
+			leaders[i + 1] = true;
+		}
+	}
+
+	for (size_t i = 0; i < size; i++) {
+		if (!leaders[i]) continue;
+		sabr_block_data_t block;
+		if (!sabr_interpreter_verify_block(bc, leaders, i, &block)) continue;
+		if (!vector_push_back(sabr_block_data_t, blocks, block)) {
+			fputs(sabr_errmsg_alloc, stderr);
+			goto FREE_ALL;
+		}
+	}
+
+	result = true;
+
+FREE_ALL:
+	free(leaders);
+	return result;
+}
+
+bool sabr_interpreter_verify_block(sabr_bytecode_t* bc, bool* leaders, size_t begin, sabr_block_data_t* block) {
+	size_t size = bc->bcop_vec.size;
+	int64_t depth = 0;
+	int64_t need = 0;
+	int64_t grow = 0;
+	size_t i;
+
+	for (i = begin; i < size; i++) {
+		if (i != begin && leaders[i]) break;
+		sabr_bcop_t bcop = *vector_at(sabr_bcop_t, &bc->bcop_vec, i);
+		size_t pops, pushes;
+		if (!sabr_opcode_stack_effect(bcop.oc, &pops, &pushes)) break;
+		if ((int64_t) pops - depth > need) need = (int64_t) pops - depth;
+		depth += (int64_t) pushes - (int64_t) pops;
+		if (depth > grow) grow = depth;
+		if (sabr_opcode_is_control(bcop.oc)) {
+			i++;
+			break;
+		}
+	}
+	if (i == begin) return false;
+
+	block->begin = begin;
+	block->end = i;
+	block->need = (size_t) need;
+	block->grow = (size_t) grow;
+	return true;
+}
\ No newline at end of file
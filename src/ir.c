@@ -0,0 +1,762 @@
+#include "ir.h"
+#include "ir_pass.h"
+
+const sabr_ir_pass_t sabr_ir_passes[] = {
+	{ "copyprop", 2, sabr_ir_pass_copyprop },
+	{ "licm", 3, sabr_ir_pass_licm },
+	{ "cse", 2, sabr_ir_pass_cse },
+	{ "dse", 2, sabr_ir_pass_dse }
+};
+
+const size_t sabr_ir_pass_count = sizeof(sabr_ir_passes) / sizeof(sabr_ir_pass_t);
+
+bool sabr_ir_run(sabr_bytecode_t* bc, sabr_bytecode_options_t* options) {
+	for (size_t i = 0; i < sabr_ir_pass_count; i++) {
+		if (sabr_ir_passes[i].level > options->level) continue;
+		if (!sabr_ir_run_pass(bc, sabr_ir_passes + i)) return false;
+		if (!sabr_bytecode_print_after(bc, options, sabr_ir_passes[i].name)) return false;
+	}
+	return true;
+}
+
+bool sabr_ir_run_pass(sabr_bytecode_t* bc, const sabr_ir_pass_t* pass) {
+	bool succeed = false;
+	size_t size = bc->bcop_vec.size;
+	size_t* owners = NULL;
+	sabr_ir_edit_t edit;
+
+	owners = (size_t*) malloc(sizeof(size_t) * (size + 1));
+	if (!sabr_ir_edit_init(&edit, size) || !owners) {
+		fputs(sabr_errmsg_alloc, stderr);
+		goto FREE_ALL;
+	}
+	if (!sabr_bytecode_link_owners(bc, owners)) {
+		succeed = true;
+		goto FREE_ALL;
+	}
+
+	for (size_t l = 0; l < size; l++) {
+		sabr_ir_function_t fn;
+		if (!sabr_bytecode_link_is_function(bc, l)) continue;
+		if (!sabr_ir_function_init(&fn, bc, owners, l)) {
+			sabr_ir_function_free(&fn);
+			goto FREE_ALL;
+		}
+		bool result = !fn.block_count || pass->func(&fn, &edit);
+		sabr_ir_function_free(&fn);
+		if (!result) goto FREE_ALL;
+	}
+	if (!sabr_ir_edit_lower(&edit, bc)) goto FREE_ALL;
+
+	succeed = true;
+
+FREE_ALL:
+	free(owners);
+	sabr_ir_edit_free(&edit);
+	return succeed;
+}
+
+bool sabr_ir_print_bytecode(sabr_bytecode_t* bc) {
+	size_t size = bc->bcop_vec.size;
+	size_t* owners = (size_t*) malloc(sizeof(size_t) * (size + 1));
+	if (!owners) {
+		fputs(sabr_errmsg_alloc, stderr);
+		return false;
+	}
+	if (!sabr_bytecode_link_owners(bc, owners)) {
+		free(owners);
+		return true;
+	}
+
+	for (size_t l = 0; l < size; l++) {
+		sabr_ir_function_t fn;
+		if (!sabr_bytecode_link_is_function(bc, l)) continue;
+		if (!sabr_ir_function_init(&fn, bc, owners, l)) {
+			sabr_ir_function_free(&fn);
+			free(owners);
+			return false;
+		}
+		if (fn.block_count && sabr_ir_lift(&fn, NULL, NULL)) sabr_ir_print(&fn);
+		else printf("function %zu\n\tnot lifted\n", l);
+		sabr_ir_function_free(&fn);
+	}
+
+	free(owners);
+	return true;
+}
+
+bool sabr_ir_function_init(sabr_ir_function_t* fn, sabr_bytecode_t* bc, size_t* owners, size_t lambda) {
+	memset(fn, 0, sizeof(sabr_ir_function_t));
+	fn->bc = bc;
+	fn->owners = owners;
+	fn->lambda = lambda;
+	fn->begin = lambda + 2;
+	fn->end = sabr_ir_bcop(fn, lambda)->operand.u;
+	fn->slot_count = sabr_ir_bcop(fn, lambda + 1)->operand.u;
+	if (fn->end > bc->bcop_vec.size || fn->begin >= fn->end || fn->slot_count > SABR_IR_LIMIT) return true;
+
+	size_t length = fn->end - fn->begin;
+	fn->escaped = (bool*) calloc(fn->slot_count + 1, sizeof(bool));
+	fn->slots = (size_t*) malloc(sizeof(size_t) * (fn->slot_count + 1));
+	fn->blocks = (sabr_ir_block_t*) malloc(sizeof(sabr_ir_block_t) * (length + 1));
+	fn->block_of = (size_t*) malloc(sizeof(size_t) * (length + 1));
+	fn->insts = (sabr_ir_inst_t*) malloc(sizeof(sabr_ir_inst_t) * (length + 1));
+	fn->stack = (sabr_ir_entry_t*) malloc(sizeof(sabr_ir_entry_t) * (length * 6 + 8));
+	if (!fn->escaped || !fn->slots || !fn->blocks || !fn->block_of || !fn->insts || !fn->stack) {
+		fputs(sabr_errmsg_alloc, stderr);
+		return false;
+	}
+
+	for (size_t i = fn->begin; i < fn->end; i++) {
+		if (!sabr_ir_is_owned(fn, i)) continue;
+		sabr_bcop_t bcop = *sabr_ir_bcop(fn, i);
+		switch (bcop.oc) {
+			case SABR_OP_ADDR_LOCAL:
+				if (bcop.operand.u >= fn->slot_count) break;
+				if (i + 1 < fn->end && sabr_ir_is_owned(fn, i + 1) && sabr_ir_is_update(sabr_ir_bcop(fn, i + 1)->oc)) break;
+				fn->escaped[bcop.operand.u] = true;
+				break;
+			case SABR_OP_FOR_INIT:
+				for (size_t j = 0; j < SABR_OP_FOR_RECORD_SIZE && bcop.operand.u + j < fn->slot_count; j++) fn->escaped[bcop.operand.u + j] = true;
+				break;
+			case SABR_OP_LOAD_LOCAL:
+			case SABR_OP_STORE_LOCAL:
+			case SABR_OP_INC_LOCAL:
+			case SABR_OP_DEC_LOCAL:
+			case SABR_OP_ADD_LOCAL:
+			case SABR_OP_FADD_LOCAL:
+				if (bcop.operand.u >= fn->slot_count) return true;
+				break;
+			default: break;
+		}
+	}
+
+	if (!sabr_ir_function_blocks(fn)) return false;
+	if (fn->slot_count * (fn->block_count + 1) > SABR_IR_LIMIT) {
+		fn->block_count = 0;
+		return true;
+	}
+
+	fn->value_capacity = length * 16 + fn->slot_count * (fn->block_count + 1) + 16;
+	fn->values = (sabr_ir_value_t*) malloc(sizeof(sabr_ir_value_t) * fn->value_capacity);
+	if (!fn->values) {
+		fputs(sabr_errmsg_alloc, stderr);
+		return false;
+	}
+	return true;
+}
+
+void sabr_ir_function_free(sabr_ir_function_t* fn) {
+	free(fn->escaped);
+	free(fn->slots);
+	free(fn->blocks);
+	free(fn->block_of);
+	free(fn->insts);
+	free(fn->stack);
+	free(fn->values);
+	free(fn->facts);
+}
+
+bool sabr_ir_function_blocks(sabr_ir_function_t* fn) {
+	size_t length = fn->end - fn->begin;
+	size_t current = SIZE_MAX;
+	bool* leaders = (bool*) calloc(length + 1, sizeof(bool));
+	if (!leaders) {
+		fputs(sabr_errmsg_alloc, stderr);
+		return false;
+	}
+
+	for (size_t i = fn->begin; i < fn->end; i++) {
+		fn->block_of[i - fn->begin] = SIZE_MAX;
+		if (!sabr_ir_is_owned(fn, i)) continue;
+		sabr_bcop_t bcop = *sabr_ir_bcop(fn, i);
+		if (bcop.oc == SABR_OP_SWITCH_TABLE || bcop.oc == SABR_OP_SWITCH_SEARCH) goto BAIL;
+		if (!sabr_opcode_has_index_operand(bcop.oc)) continue;
+		if (bcop.operand.u >= fn->begin && bcop.operand.u < fn->end && sabr_ir_is_owned(fn, bcop.operand.u))
+			leaders[bcop.operand.u - fn->begin] = true;
+	}
+
+	fn->block_count = 0;
+	for (size_t i = fn->begin; i < fn->end; i++) {
+		if (!sabr_ir_is_owned(fn, i)) {
+			current = SIZE_MAX;
+			continue;
+		}
+		if (leaders[i - fn->begin] || current == SIZE_MAX) {
+			current = fn->block_count++;
+			fn->blocks[current].begin = i;
+		}
+		fn->blocks[current].end = i + 1;
+		fn->block_of[i - fn->begin] = current;
+		if (sabr_opcode_is_control(sabr_ir_bcop(fn, i)->oc)) current = SIZE_MAX;
+	}
+
+	for (size_t b = 0; b < fn->block_count; b++)
+		if (!sabr_ir_function_successors(fn, fn->blocks + b)) goto BAIL;
+
+	free(leaders);
+	return true;
+
+BAIL:
+	fn->block_count = 0;
+	free(leaders);
+	return true;
+}
+
+bool sabr_ir_function_successors(sabr_ir_function_t* fn, sabr_ir_block_t* block) {
+	sabr_bcop_t bcop = *sabr_ir_bcop(fn, block->end - 1);
+	size_t targets[2];
+	size_t count = 0;
+
+	switch (bcop.oc) {
+		case SABR_OP_EXIT:
+		case SABR_OP_RETURN:
+		case SABR_OP_TAILCALL:
+			break;
+		case SABR_OP_JUMP:
+		case SABR_OP_LAMBDA:
+			targets[count++] = bcop.operand.u;
+			break;
+		case SABR_OP_CALL:
+			targets[count++] = block->end;
+			break;
+		default:
+			if (sabr_ir_is_branch(bcop.oc)) targets[count++] = bcop.operand.u;
+			else if (sabr_opcode_is_control(bcop.oc)) return false;
+			targets[count++] = block->end;
+			break;
+	}
+
+	block->succ_count = 0;
+	for (size_t k = 0; k < count; k++) {
+		size_t target = targets[k];
+		if (target < fn->begin || target >= fn->end || !sabr_ir_is_owned(fn, target)) return false;
+		size_t succ = fn->block_of[target - fn->begin];
+		if (succ == SIZE_MAX || fn->blocks[succ].begin != target) return false;
+		block->succs[block->succ_count++] = succ;
+	}
+	return true;
+}
+
+bool sabr_ir_lift(sabr_ir_function_t* fn, sabr_ir_fact_t* in, sabr_ir_fact_t* out) {
+	fn->value_count = 0;
+	for (size_t b = 0; b < fn->block_count; b++) {
+		size_t offset = b * fn->slot_count;
+		if (!sabr_ir_lift_block(fn, b, in ? in + offset : NULL, out ? out + offset : NULL)) return false;
+	}
+	return true;
+}
+
+bool sabr_ir_lift_block(sabr_ir_function_t* fn, size_t block, sabr_ir_fact_t* in, sabr_ir_fact_t* out) {
+	sabr_ir_block_t* b = fn->blocks + block;
+	sabr_ir_entry_t* stack = fn->stack;
+	size_t top = 0;
+
+	for (uint64_t s = 0; s < fn->slot_count; s++) {
+		sabr_ir_fact_t fact = in ? in[s] : (sabr_ir_fact_t) { SABR_IR_FACT_NONE, { .u = 0 } };
+		fn->slots[s] = SIZE_MAX;
+		if (fn->escaped[s] || fact.kind == SABR_IR_FACT_COPY) continue;
+		if (fact.kind == SABR_IR_FACT_CONST) fn->slots[s] = sabr_ir_value_constant(fn, block, fact.value);
+		else fn->slots[s] = sabr_ir_value_new(fn, (sabr_ir_value_t) { SABR_OP_NONE, { .u = 0 }, { 0, 0 }, 0, SIZE_MAX, block, s });
+		if (fn->slots[s] == SIZE_MAX) return false;
+	}
+	for (uint64_t s = 0; s < fn->slot_count; s++) {
+		if (fn->escaped[s] || !in || in[s].kind != SABR_IR_FACT_COPY) continue;
+		uint64_t source = in[s].value.u;
+		if (source < fn->slot_count && fn->slots[source] != SIZE_MAX) fn->slots[s] = fn->slots[source];
+		else fn->slots[s] = sabr_ir_value_new(fn, (sabr_ir_value_t) { SABR_OP_NONE, { .u = 0 }, { 0, 0 }, 0, SIZE_MAX, block, s });
+		if (fn->slots[s] == SIZE_MAX) return false;
+	}
+
+	for (size_t i = b->begin; i < b->end; i++) {
+		sabr_ir_inst_t* inst = fn->insts + (i - fn->begin);
+		sabr_bcop_t bcop = *sabr_ir_bcop(fn, i);
+		uint64_t slot = bcop.operand.u;
+		bool tracked = slot < fn->slot_count && !fn->escaped[slot];
+		size_t pops, pushes;
+
+		*inst = (sabr_ir_inst_t) { SIZE_MAX, { SIZE_MAX, SIZE_MAX }, 0, SIZE_MAX, SIZE_MAX, UINT64_MAX };
+		switch (bcop.oc) {
+			case SABR_OP_NONE:
+				continue;
+			case SABR_OP_VALUE: {
+				sabr_ir_value_t value = { SABR_OP_VALUE, bcop.operand, { 0, 0 }, 0, i, block, UINT64_MAX };
+				inst->result = sabr_ir_value_find(fn, block, value);
+				if (inst->result == SIZE_MAX) inst->result = sabr_ir_value_new(fn, value);
+				if (inst->result == SIZE_MAX) return false;
+				inst->begin = i;
+				stack[top++] = (sabr_ir_entry_t) { inst->result, i };
+			} continue;
+			case SABR_OP_LOAD_LOCAL:
+				if (!tracked) break;
+				inst->result = fn->slots[slot];
+				inst->begin = i;
+				for (uint64_t s = 0; s < fn->slot_count && inst->alias == UINT64_MAX; s++)
+					if (!fn->escaped[s] && fn->slots[s] == inst->result) inst->alias = s;
+				stack[top++] = (sabr_ir_entry_t) { inst->result, i };
+				continue;
+			case SABR_OP_STORE_LOCAL:
+				if (!tracked) break;
+				if (!top) {
+					stack[top++] = (sabr_ir_entry_t) { sabr_ir_value_new(fn, (sabr_ir_value_t) { SABR_OP_NONE, { .u = 0 }, { 0, 0 }, 0, SIZE_MAX, block, UINT64_MAX }), SIZE_MAX };
+					if (stack[0].value == SIZE_MAX) return false;
+				}
+				top--;
+				inst->args[0] = stack[top].value;
+				inst->arg_count = 1;
+				inst->producer = stack[top].producer;
+				fn->slots[slot] = stack[top].value;
+				continue;
+			case SABR_OP_DROP:
+			case SABR_OP_NIP:
+			case SABR_OP_DUP:
+			case SABR_OP_OVER:
+			case SABR_OP_TUCK:
+			case SABR_OP_SWAP:
+			case SABR_OP_ROT: {
+				size_t needed = (bcop.oc == SABR_OP_DROP || bcop.oc == SABR_OP_DUP) ? 1 : (bcop.oc == SABR_OP_ROT) ? 3 : 2;
+				while (top < needed) {
+					size_t param = sabr_ir_value_new(fn, (sabr_ir_value_t) { SABR_OP_NONE, { .u = 0 }, { 0, 0 }, 0, SIZE_MAX, block, UINT64_MAX });
+					if (param == SIZE_MAX) return false;
+					memmove(stack + 1, stack, sizeof(sabr_ir_entry_t) * top);
+					stack[0] = (sabr_ir_entry_t) { param, SIZE_MAX };
+					top++;
+				}
+				sabr_ir_entry_t x = stack[top - 1];
+				sabr_ir_entry_t y = (top > 1) ? stack[top - 2] : x;
+				sabr_ir_entry_t z = (top > 2) ? stack[top - 3] : x;
+				switch (bcop.oc) {
+					case SABR_OP_DROP: top--; break;
+					case SABR_OP_NIP: stack[top - 2] = x; top--; break;
+					case SABR_OP_DUP: stack[top++] = x; break;
+					case SABR_OP_OVER: stack[top++] = y; break;
+					case SABR_OP_TUCK: stack[top - 2] = x; stack[top - 1] = y; stack[top++] = x; break;
+					case SABR_OP_SWAP: stack[top - 2] = x; stack[top - 1] = y; break;
+					case SABR_OP_ROT: stack[top - 3] = y; stack[top - 2] = x; stack[top - 1] = z; break;
+					default: break;
+				}
+			} continue;
+			default: break;
+		}
+
+		if (sabr_ir_is_barrier(bcop.oc) || !sabr_opcode_stack_effect(bcop.oc, &pops, &pushes)) {
+			top = 0;
+			continue;
+		}
+
+		sabr_ir_entry_t args[6];
+		for (size_t k = pops; k > 0; k--) {
+			if (top) args[k - 1] = stack[--top];
+			else {
+				args[k - 1].value = sabr_ir_value_new(fn, (sabr_ir_value_t) { SABR_OP_NONE, { .u = 0 }, { 0, 0 }, 0, SIZE_MAX, block, UINT64_MAX });
+				args[k - 1].producer = SIZE_MAX;
+				if (args[k - 1].value == SIZE_MAX) return false;
+			}
+		}
+		inst->arg_count = (pops < 2) ? pops : 2;
+		for (size_t k = 0; k < inst->arg_count; k++) inst->args[k] = args[k].value;
+
+		if (sabr_ir_is_pure(bcop.oc) && pushes == 1 && pops && pops <= 2) {
+			sabr_ir_value_t value = { bcop.oc, sabr_opcode_has_operand(bcop.oc) ? bcop.operand : (sabr_value_t) { .u = 0 }, { inst->args[0], inst->args[1] }, pops, i, block, UINT64_MAX };
+			if (pops == 1) value.args[1] = 0;
+			inst->result = sabr_ir_value_find(fn, block, value);
+			if (inst->result == SIZE_MAX) inst->result = sabr_ir_value_new(fn, value);
+			if (inst->result == SIZE_MAX) return false;
+
+			size_t expected = sabr_ir_prev(fn, i);
+			bool closed = true;
+			for (size_t k = pops; k > 0 && closed; k--) {
+				size_t producer = args[k - 1].producer;
+				if (producer == SIZE_MAX || producer != expected || fn->insts[producer - fn->begin].begin == SIZE_MAX) closed = false;
+				else expected = sabr_ir_prev(fn, fn->insts[producer - fn->begin].begin);
+			}
+			if (closed) inst->begin = fn->insts[args[0].producer - fn->begin].begin;
+			stack[top++] = (sabr_ir_entry_t) { inst->result, i };
+		}
+		else {
+			for (size_t k = 0; k < pushes; k++) {
+				size_t result = sabr_ir_value_new(fn, (sabr_ir_value_t) { bcop.oc, bcop.operand, { inst->args[0], inst->args[1] }, inst->arg_count, i, block, UINT64_MAX });
+				if (result == SIZE_MAX) return false;
+				stack[top++] = (sabr_ir_entry_t) { result, i };
+				inst->result = result;
+			}
+			if (pushes != 1) inst->result = SIZE_MAX;
+		}
+
+		uint64_t written;
+		if (sabr_ir_writes_slot(fn, i, &written) && written < fn->slot_count && !fn->escaped[written]) {
+			fn->slots[written] = sabr_ir_value_new(fn, (sabr_ir_value_t) { bcop.oc, bcop.operand, { 0, 0 }, 0, i, block, written });
+			if (fn->slots[written] == SIZE_MAX) return false;
+		}
+	}
+
+	if (!out) return true;
+	for (uint64_t s = 0; s < fn->slot_count; s++) {
+		out[s] = (sabr_ir_fact_t) { SABR_IR_FACT_NONE, { .u = 0 } };
+		if (fn->escaped[s]) continue;
+		sabr_ir_value_t value = fn->values[fn->slots[s]];
+		if (value.oc == SABR_OP_VALUE) {
+			out[s] = (sabr_ir_fact_t) { SABR_IR_FACT_CONST, value.operand };
+			continue;
+		}
+		for (uint64_t t = 0; t < s; t++) {
+			if (fn->escaped[t] || fn->slots[t] != fn->slots[s]) continue;
+			out[s] = (sabr_ir_fact_t) { SABR_IR_FACT_COPY, { .u = t } };
+			break;
+		}
+	}
+	return true;
+}
+
+bool sabr_ir_lift_facts(sabr_ir_function_t* fn, bool* converged) {
+	size_t count = fn->block_count * fn->slot_count;
+	bool* reached = NULL;
+	sabr_ir_fact_t* in = NULL;
+	sabr_ir_fact_t* out = NULL;
+	sabr_ir_fact_t* next = NULL;
+
+	*converged = false;
+	fn->facts = (sabr_ir_fact_t*) malloc(sizeof(sabr_ir_fact_t) * (count * 3 + 1));
+	reached = (bool*) calloc(fn->block_count + 1, sizeof(bool));
+	if (!fn->facts || !reached) {
+		fputs(sabr_errmsg_alloc, stderr);
+		free(reached);
+		return false;
+	}
+	in = fn->facts;
+	out = in + count;
+	next = out + count;
+	for (size_t k = 0; k < count; k++) out[k] = (sabr_ir_fact_t) { SABR_IR_FACT_NONE, { .u = 0 } };
+
+	for (size_t round = 0; round < SABR_IR_ROUNDS && !*converged; round++) {
+		for (size_t b = 0; b < fn->block_count; b++) reached[b] = false;
+		for (uint64_t s = 0; s < fn->slot_count; s++) in[s] = (sabr_ir_fact_t) { SABR_IR_FACT_CONST, { .u = 0 } };
+		reached[0] = true;
+		if (round) {
+			for (size_t p = 0; p < fn->block_count; p++) {
+				for (size_t k = 0; k < fn->blocks[p].succ_count; k++) {
+					size_t b = fn->blocks[p].succs[k];
+					sabr_ir_fact_t* dest = in + b * fn->slot_count;
+					sabr_ir_fact_t* src = out + p * fn->slot_count;
+					for (uint64_t s = 0; s < fn->slot_count; s++) {
+						if (!reached[b]) dest[s] = src[s];
+						else if (!sabr_ir_fact_equals(dest[s], src[s])) dest[s] = (sabr_ir_fact_t) { SABR_IR_FACT_NONE, { .u = 0 } };
+					}
+					reached[b] = true;
+				}
+			}
+		}
+		for (size_t b = 1; b < fn->block_count; b++) {
+			if (reached[b]) continue;
+			for (uint64_t s = 0; s < fn->slot_count; s++)
+				in[b * fn->slot_count + s] = (sabr_ir_fact_t) { round ? SABR_IR_FACT_NONE : SABR_IR_FACT_CONST, { .u = 0 } };
+		}
+
+		if (!sabr_ir_lift(fn, in, next)) break;
+		*converged = round > 0;
+		for (size_t k = 0; k < count; k++) {
+			if (!sabr_ir_fact_equals(out[k], next[k])) *converged = false;
+			out[k] = next[k];
+		}
+	}
+
+	free(reached);
+	return true;
+}
+
+bool sabr_ir_fact_equals(sabr_ir_fact_t a, sabr_ir_fact_t b) {
+	if (a.kind != b.kind) return false;
+	return a.kind == SABR_IR_FACT_NONE || a.value.u == b.value.u;
+}
+
+size_t sabr_ir_value_new(sabr_ir_function_t* fn, sabr_ir_value_t value) {
+	if (fn->value_count >= fn->value_capacity) return SIZE_MAX;
+	fn->values[fn->value_count] = value;
+	return fn->value_count++;
+}
+
+size_t sabr_ir_value_find(sabr_ir_function_t* fn, size_t block, sabr_ir_value_t value) {
+	for (size_t v = fn->value_count; v > 0; v--) {
+		sabr_ir_value_t* other = fn->values + v - 1;
+		if (other->block != block) break;
+		if (other->oc != value.oc || other->operand.u != value.operand.u || other->arg_count != value.arg_count || other->slot != value.slot) continue;
+		if (value.arg_count > 0 && other->args[0] != value.args[0]) continue;
+		if (value.arg_count > 1 && other->args[1] != value.args[1]) continue;
+		return v - 1;
+	}
+	return SIZE_MAX;
+}
+
+size_t sabr_ir_value_constant(sabr_ir_function_t* fn, size_t block, sabr_value_t v) {
+	sabr_ir_value_t value = { SABR_OP_VALUE, v, { 0, 0 }, 0, SIZE_MAX, block, UINT64_MAX };
+	size_t found = sabr_ir_value_find(fn, block, value);
+	return (found == SIZE_MAX) ? sabr_ir_value_new(fn, value) : found;
+}
+
+void sabr_ir_print(sabr_ir_function_t* fn) {
+	bool* printed = (bool*) calloc(fn->value_count + 1, sizeof(bool));
+	if (!printed) return;
+
+	printf("function %zu\n", fn->lambda);
+	for (size_t b = 0; b < fn->block_count; b++) {
+		sabr_ir_block_t* block = fn->blocks + b;
+		printf("  block %zu [%zu, %zu)", b, block->begin, block->end);
+		for (size_t k = 0; k < block->succ_count; k++) printf("%s%zu", k ? ", " : " -> ", block->succs[k]);
+		putchar('\n');
+		for (size_t i = block->begin; i < block->end; i++) {
+			sabr_bcop_t bcop = *sabr_ir_bcop(fn, i);
+			sabr_ir_inst_t inst = fn->insts[i - fn->begin];
+			if (bcop.oc == SABR_OP_NONE) continue;
+			for (size_t k = 0; k < inst.arg_count; k++) sabr_ir_print_value(fn, inst.args[k], printed);
+			if (inst.result != SIZE_MAX) sabr_ir_print_value(fn, inst.result, printed);
+			printf("%5zu\t", i);
+			if (inst.result != SIZE_MAX) printf("%%%zu = ", inst.result);
+			printf("%s", sabr_opcode_names[bcop.oc]);
+			if (sabr_opcode_has_operand(bcop.oc)) printf(" %zu", bcop.operand.u);
+			for (size_t k = 0; k < inst.arg_count; k++) printf(" %%%zu", inst.args[k]);
+			putchar('\n');
+		}
+	}
+	free(printed);
+}
+
+void sabr_ir_print_value(sabr_ir_function_t* fn, size_t value, bool* printed) {
+	sabr_ir_value_t v = fn->values[value];
+	if (printed[value] || v.def != SIZE_MAX) return;
+	printed[value] = true;
+	if (v.oc == SABR_OP_VALUE) printf("\t%%%zu = const %zu\n", value, v.operand.u);
+	else if (v.slot != UINT64_MAX) printf("\t%%%zu = param slot %zu\n", value, v.slot);
+	else printf("\t%%%zu = param stack\n", value);
+}
+
+sabr_bcop_t* sabr_ir_bcop(sabr_ir_function_t* fn, size_t index) {
+	return vector_at(sabr_bcop_t, &fn->bc->bcop_vec, index);
+}
+
+bool sabr_ir_is_owned(sabr_ir_function_t* fn, size_t index) {
+	return fn->owners[index] == fn->lambda;
+}
+
+size_t sabr_ir_prev(sabr_ir_function_t* fn, size_t index) {
+	size_t block = fn->block_of[index - fn->begin];
+	for (size_t i = index; i > fn->blocks[block].begin; i--)
+		if (sabr_ir_bcop(fn, i - 1)->oc != SABR_OP_NONE) return i - 1;
+	return SIZE_MAX;
+}
+
+size_t sabr_ir_range_length(sabr_ir_function_t* fn, size_t begin, size_t end) {
+	size_t length = 0;
+	for (size_t i = begin; i <= end; i++)
+		if (sabr_ir_bcop(fn, i)->oc != SABR_OP_NONE) length++;
+	return length;
+}
+
+bool sabr_ir_range_equals(sabr_ir_function_t* fn, size_t a_begin, size_t a_end, size_t b_begin, size_t b_end) {
+	size_t i = a_begin, j = b_begin;
+	while (true) {
+		while (i <= a_end && sabr_ir_bcop(fn, i)->oc == SABR_OP_NONE) i++;
+		while (j <= b_end && sabr_ir_bcop(fn, j)->oc == SABR_OP_NONE) j++;
+		if (i > a_end || j > b_end) return i > a_end && j > b_end;
+		sabr_bcop_t a = *sabr_ir_bcop(fn, i++);
+		sabr_bcop_t b = *sabr_ir_bcop(fn, j++);
+		if (a.oc != b.oc) return false;
+		if (sabr_opcode_has_operand(a.oc) && a.operand.u != b.operand.u) return false;
+	}
+}
+
+uint64_t sabr_ir_temp(sabr_ir_function_t* fn) {
+	return sabr_ir_bcop(fn, fn->lambda + 1)->operand.u++;
+}
+
+bool sabr_ir_is_pure(sabr_opcode_t oc) {
+	switch (oc) {
+		case SABR_OP_ADD: case SABR_OP_SUB: case SABR_OP_MUL: case SABR_OP_NEG: case SABR_OP_INC: case SABR_OP_DEC:
+		case SABR_OP_ADD_IMM: case SABR_OP_MUL_IMM:
+		case SABR_OP_EQU: case SABR_OP_NEQ: case SABR_OP_GRT: case SABR_OP_GEQ: case SABR_OP_LST: case SABR_OP_LEQ:
+		case SABR_OP_UGRT: case SABR_OP_UGEQ: case SABR_OP_ULST: case SABR_OP_ULEQ:
+		case SABR_OP_EQU_IMM: case SABR_OP_NEQ_IMM: case SABR_OP_GRT_IMM: case SABR_OP_GEQ_IMM: case SABR_OP_LST_IMM: case SABR_OP_LEQ_IMM:
+		case SABR_OP_FADD: case SABR_OP_FSUB: case SABR_OP_FMUL: case SABR_OP_FNEG:
+		case SABR_OP_FEQU: case SABR_OP_FNEQ: case SABR_OP_FGRT: case SABR_OP_FGEQ: case SABR_OP_FLST: case SABR_OP_FLEQ:
+		case SABR_OP_BAND: case SABR_OP_BOR: case SABR_OP_BXOR: case SABR_OP_BNOT: case SABR_OP_BLSFT: case SABR_OP_BRSFT:
+		case SABR_OP_BAND_IMM: case SABR_OP_BLSFT_IMM: case SABR_OP_BRSFT_IMM:
+		case SABR_OP_ITOF: case SABR_OP_UTOF: case SABR_OP_FTOI: case SABR_OP_FTOU:
+		case SABR_OP_INDEX_CELL:
+			return true;
+		default:
+			return false;
+	}
+}
+
+bool sabr_ir_is_barrier(sabr_opcode_t oc) {
+	switch (oc) {
+		case SABR_OP_EXIT:
+		case SABR_OP_FOR_CHECK:
+		case SABR_OP_FOR_NEXT:
+		case SABR_OP_FOR_END:
+		case SABR_OP_SWITCH_END:
+		case SABR_OP_RETURN:
+		case SABR_OP_LOCAL:
+		case SABR_OP_LOCAL_END:
+		case SABR_OP_DATAGROUP_END:
+		case SABR_OP_CALL:
+		case SABR_OP_TAILCALL:
+		case SABR_OP_ARRAY:
+		case SABR_OP_GETC:
+		case SABR_OP_GETS:
+		case SABR_OP_SHOW:
+			return true;
+		default:
+			return false;
+	}
+}
+
+bool sabr_ir_is_branch(sabr_opcode_t oc) {
+	switch (oc) {
+		case SABR_OP_IF:
+		case SABR_OP_CASE_IF:
+		case SABR_OP_LST_IF: case SABR_OP_EQU_IF: case SABR_OP_NEQ_IF: case SABR_OP_GRT_IF: case SABR_OP_GEQ_IF: case SABR_OP_LEQ_IF:
+		case SABR_OP_UGRT_IF: case SABR_OP_UGEQ_IF: case SABR_OP_ULST_IF: case SABR_OP_ULEQ_IF:
+		case SABR_OP_FEQU_IF: case SABR_OP_FNEQ_IF: case SABR_OP_FGRT_IF: case SABR_OP_FGEQ_IF: case SABR_OP_FLST_IF: case SABR_OP_FLEQ_IF:
+		case SABR_OP_FOR_CHECK:
+		case SABR_OP_FOR_NEXT:
+		case SABR_OP_FOR_ENTER_I: case SABR_OP_FOR_ENTER_U: case SABR_OP_FOR_ENTER_F:
+		case SABR_OP_FOR_LOOP_I: case SABR_OP_FOR_LOOP_U: case SABR_OP_FOR_LOOP_F:
+		case SABR_OP_FOR_UP_I: case SABR_OP_FOR_UP_U: case SABR_OP_FOR_UP_F:
+		case SABR_OP_FOR_DOWN_I: case SABR_OP_FOR_DOWN_U: case SABR_OP_FOR_DOWN_F:
+			return true;
+		default:
+			return false;
+	}
+}
+
+bool sabr_ir_is_update(sabr_opcode_t oc) {
+	return oc >= SABR_OP_INC_MEM && oc <= SABR_OP_BRSFT_MEM;
+}
+
+bool sabr_ir_reads_slot(sabr_ir_function_t* fn, size_t index, uint64_t* slot) {
+	sabr_bcop_t bcop = *sabr_ir_bcop(fn, index);
+	if (bcop.oc == SABR_OP_LOAD_LOCAL) {
+		*slot = bcop.operand.u;
+		return true;
+	}
+	return bcop.oc != SABR_OP_STORE_LOCAL && sabr_ir_writes_slot(fn, index, slot);
+}
+
+bool sabr_ir_writes_slot(sabr_ir_function_t* fn, size_t index, uint64_t* slot) {
+	sabr_bcop_t bcop = *sabr_ir_bcop(fn, index);
+	switch (bcop.oc) {
+		case SABR_OP_STORE_LOCAL:
+		case SABR_OP_INC_LOCAL:
+		case SABR_OP_DEC_LOCAL:
+		case SABR_OP_ADD_LOCAL:
+		case SABR_OP_FADD_LOCAL:
+			*slot = bcop.operand.u;
+			return true;
+		default:
+			if (!sabr_ir_is_update(bcop.oc) || index <= fn->begin || !sabr_ir_is_owned(fn, index - 1)) return false;
+			if (sabr_ir_bcop(fn, index - 1)->oc != SABR_OP_ADDR_LOCAL) return false;
+			*slot = sabr_ir_bcop(fn, index - 1)->operand.u;
+			return true;
+	}
+}
+
+bool sabr_ir_edit_init(sabr_ir_edit_t* edit, size_t size) {
+	edit->inserts = NULL;
+	edit->insert_count = 0;
+	edit->insert_capacity = 0;
+	edit->loops = (size_t*) malloc(sizeof(size_t) * (size + 1));
+	if (!edit->loops) return false;
+	for (size_t i = 0; i <= size; i++) edit->loops[i] = SIZE_MAX;
+	return true;
+}
+
+void sabr_ir_edit_free(sabr_ir_edit_t* edit) {
+	free(edit->inserts);
+	free(edit->loops);
+}
+
+bool sabr_ir_edit_insert(sabr_ir_edit_t* edit, size_t index, bool after, sabr_bcop_t bcop) {
+	if (edit->insert_count == edit->insert_capacity) {
+		size_t capacity = edit->insert_capacity ? edit->insert_capacity * 2 : 64;
+		sabr_ir_insert_t* inserts = (sabr_ir_insert_t*) realloc(edit->inserts, sizeof(sabr_ir_insert_t) * capacity);
+		if (!inserts) {
+			fputs(sabr_errmsg_alloc, stderr);
+			return false;
+		}
+		edit->inserts = inserts;
+		edit->insert_capacity = capacity;
+	}
+	edit->inserts[edit->insert_count] = (sabr_ir_insert_t) { index, after, edit->insert_count, bcop };
+	edit->insert_count++;
+	return true;
+}
+
+bool sabr_ir_edit_lower(sabr_ir_edit_t* edit, sabr_bytecode_t* bc) {
+	bool succeed = false;
+	size_t size = bc->bcop_vec.size;
+	size_t pos = 0, k = 0;
+	sabr_bcop_t* source = NULL;
+	size_t* pre = NULL;
+	size_t* map = NULL;
+
+	if (!edit->insert_count) return true;
+	qsort(edit->inserts, edit->insert_count, sizeof(sabr_ir_insert_t), sabr_ir_insert_compare);
+
+	source = (sabr_bcop_t*) malloc(sizeof(sabr_bcop_t) * (size + 1));
+	pre = (size_t*) malloc(sizeof(size_t) * (size + 1));
+	map = (size_t*) malloc(sizeof(size_t) * (size + 1));
+	if (!source || !pre || !map) {
+		fputs(sabr_errmsg_alloc, stderr);
+		goto FREE_ALL;
+	}
+
+	for (size_t i = 0; i < size; i++) {
+		source[i] = *vector_at(sabr_bcop_t, &bc->bcop_vec, i);
+		pre[i] = pos;
+		for (; k < edit->insert_count && edit->inserts[k].index == i && !edit->inserts[k].after; k++) pos++;
+		map[i] = pos++;
+		for (; k < edit->insert_count && edit->inserts[k].index == i && edit->inserts[k].after; k++) pos++;
+	}
+	pre[size] = map[size] = pos;
+
+	bc->bcop_vec.size = 0;
+	k = 0;
+	for (size_t i = 0; i < size; i++) {
+		sabr_bcop_t bcop = source[i];
+		for (; k < edit->insert_count && edit->inserts[k].index == i && !edit->inserts[k].after; k++)
+			if (!vector_push_back(sabr_bcop_t, &bc->bcop_vec, edit->inserts[k].bcop)) goto ALLOC_FAILURE;
+		if (sabr_opcode_has_index_operand(bcop.oc) && bcop.operand.u <= size) {
+			size_t target = bcop.operand.u;
+			bool inner = edit->loops[target] != SIZE_MAX && i >= target && i <= edit->loops[target];
+			bcop.operand.u = inner ? map[target] : pre[target];
+		}
+		if (!vector_push_back(sabr_bcop_t, &bc->bcop_vec, bcop)) goto ALLOC_FAILURE;
+		for (; k < edit->insert_count && edit->inserts[k].index == i && edit->inserts[k].after; k++)
+			if (!vector_push_back(sabr_bcop_t, &bc->bcop_vec, edit->inserts[k].bcop)) goto ALLOC_FAILURE;
+	}
+
+	bc->current_index = bc->bcop_vec.size;
+	bc->current_pos = 0;
+	for (size_t i = 0; i < bc->bcop_vec.size; i++)
+		bc->current_pos += sabr_opcode_has_operand(vector_at(sabr_bcop_t, &bc->bcop_vec, i)->oc) ? 9 : 1;
+
+	succeed = true;
+	goto FREE_ALL;
+
+ALLOC_FAILURE:
+	fputs(sabr_errmsg_alloc, stderr);
+
+FREE_ALL:
+	free(source);
+	free(pre);
+	free(map);
+	return succeed;
+}
+
+int sabr_ir_insert_compare(const void* a, const void* b) {
+	const sabr_ir_insert_t* x = (const sabr_ir_insert_t*) a;
+	const sabr_ir_insert_t* y = (const sabr_ir_insert_t*) b;
+	if (x->index != y->index) return (x->index > y->index) - (x->index < y->index);
+	if (x->after != y->after) return x->after - y->after;
+	return (x->order > y->order) - (x->order < y->order);
+}
\ No newline at end of file
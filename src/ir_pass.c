@@ -0,0 +1,307 @@
+#include "ir_pass.h"
+
+bool sabr_ir_pass_copyprop(sabr_ir_function_t* fn, sabr_ir_edit_t* edit) {
+	bool converged = false;
+	if (!sabr_ir_lift_facts(fn, &converged)) return false;
+	if (!converged) return true;
+
+	for (size_t i = fn->begin; i < fn->end; i++) {
+		if (!sabr_ir_is_owned(fn, i)) continue;
+		sabr_bcop_t* bcop = sabr_ir_bcop(fn, i);
+		sabr_ir_inst_t inst = fn->insts[i - fn->begin];
+		if (bcop->oc != SABR_OP_LOAD_LOCAL || inst.result == SIZE_MAX) continue;
+		sabr_ir_value_t value = fn->values[inst.result];
+		if (value.oc == SABR_OP_VALUE) *bcop = sabr_new_bcop_with_value(SABR_OP_VALUE, value.operand);
+		else if (inst.alias != UINT64_MAX && inst.alias != bcop->operand.u) bcop->operand.u = inst.alias;
+	}
+	return true;
+}
+
+bool sabr_ir_pass_licm(sabr_ir_function_t* fn, sabr_ir_edit_t* edit) {
+	bool succeed = false;
+	size_t length = fn->end - fn->begin;
+	size_t loop_count = 0;
+	sabr_ir_range_t* loops = NULL;
+	sabr_ir_range_t* hoists = NULL;
+	uint64_t* temps = NULL;
+	bool* written = NULL;
+	bool* deleted = NULL;
+
+	if (!sabr_ir_lift(fn, NULL, NULL)) return true;
+
+	loops = (sabr_ir_range_t*) malloc(sizeof(sabr_ir_range_t) * (length + 1));
+	hoists = (sabr_ir_range_t*) malloc(sizeof(sabr_ir_range_t) * (length + 1));
+	temps = (uint64_t*) malloc(sizeof(uint64_t) * (length + 1));
+	written = (bool*) malloc(sizeof(bool) * (fn->slot_count + 1));
+	deleted = (bool*) calloc(length + 1, sizeof(bool));
+	if (!loops || !hoists || !temps || !written || !deleted) {
+		fputs(sabr_errmsg_alloc, stderr);
+		goto FREE_ALL;
+	}
+
+	for (size_t i = fn->begin; i < fn->end; i++) {
+		if (!sabr_ir_is_owned(fn, i)) continue;
+		sabr_bcop_t bcop = *sabr_ir_bcop(fn, i);
+		if (bcop.oc != SABR_OP_JUMP && !sabr_ir_is_branch(bcop.oc)) continue;
+		size_t head = bcop.operand.u;
+		if (head < fn->begin || head > i || !sabr_ir_is_owned(fn, head)) continue;
+		size_t k = 0;
+		while (k < loop_count && loops[k].begin != head) k++;
+		if (k == loop_count) loops[loop_count++] = (sabr_ir_range_t) { head, i, 0 };
+		else if (loops[k].end < i) loops[k].end = i;
+	}
+	for (size_t k = 0; k < loop_count; k++) loops[k].length = loops[k].end - loops[k].begin;
+	qsort(loops, loop_count, sizeof(sabr_ir_range_t), sabr_ir_range_compare);
+
+	for (size_t k = 0; k < loop_count; k++)
+		if (!sabr_ir_pass_licm_loop(fn, edit, loops[k], written, deleted, hoists, temps)) goto FREE_ALL;
+
+	succeed = true;
+
+FREE_ALL:
+	free(loops);
+	free(hoists);
+	free(temps);
+	free(written);
+	free(deleted);
+	return succeed;
+}
+
+bool sabr_ir_pass_licm_loop(sabr_ir_function_t* fn, sabr_ir_edit_t* edit, sabr_ir_range_t loop, bool* written, bool* deleted, sabr_ir_range_t* hoists, uint64_t* temps) {
+	size_t hoist_count = 0;
+
+	for (size_t i = fn->begin; i < fn->end; i++) {
+		if (!sabr_ir_is_owned(fn, i) || (i >= loop.begin && i <= loop.end)) continue;
+		sabr_bcop_t bcop = *sabr_ir_bcop(fn, i);
+		if (sabr_opcode_has_index_operand(bcop.oc) && bcop.operand.u > loop.begin && bcop.operand.u <= loop.end) return true;
+	}
+
+	memset(written, 0, sizeof(bool) * (fn->slot_count + 1));
+	for (size_t i = loop.begin; i <= loop.end; i++) {
+		uint64_t slot;
+		if (sabr_ir_is_owned(fn, i) && sabr_ir_writes_slot(fn, i, &slot) && slot < fn->slot_count) written[slot] = true;
+	}
+
+	for (size_t i = loop.end + 1; i-- > loop.begin;) {
+		if (!sabr_ir_is_owned(fn, i) || !sabr_ir_is_pure(sabr_ir_bcop(fn, i)->oc)) continue;
+		sabr_ir_inst_t inst = fn->insts[i - fn->begin];
+		if (inst.result == SIZE_MAX || inst.begin == SIZE_MAX || inst.begin < loop.begin) continue;
+		sabr_ir_range_t range = { inst.begin, i, sabr_ir_range_length(fn, inst.begin, i) };
+		if (range.length < 2 || !sabr_ir_pass_licm_is_invariant(fn, range, written, deleted)) continue;
+
+		temps[hoist_count] = UINT64_MAX;
+		for (size_t k = 0; k < hoist_count && temps[hoist_count] == UINT64_MAX; k++)
+			if (sabr_ir_range_equals(fn, hoists[k].begin, hoists[k].end, range.begin, range.end)) temps[hoist_count] = temps[k];
+		if (temps[hoist_count] == UINT64_MAX) {
+			temps[hoist_count] = sabr_ir_temp(fn);
+			for (size_t j = range.begin; j <= range.end; j++) {
+				sabr_bcop_t bcop = *sabr_ir_bcop(fn, j);
+				if (bcop.oc != SABR_OP_NONE && !sabr_ir_edit_insert(edit, loop.begin, false, bcop)) return false;
+			}
+			if (!sabr_ir_edit_insert(edit, loop.begin, false, sabr_new_bcop_with_value(SABR_OP_STORE_LOCAL, (sabr_value_t) { .u = temps[hoist_count] }))) return false;
+		}
+		for (size_t j = range.begin; j <= range.end; j++) deleted[j - fn->begin] = true;
+		hoists[hoist_count++] = range;
+	}
+
+	for (size_t k = 0; k < hoist_count; k++) {
+		for (size_t j = hoists[k].begin; j < hoists[k].end; j++) *sabr_ir_bcop(fn, j) = sabr_new_bcop(SABR_OP_NONE);
+		*sabr_ir_bcop(fn, hoists[k].end) = sabr_new_bcop_with_value(SABR_OP_LOAD_LOCAL, (sabr_value_t) { .u = temps[k] });
+	}
+	if (hoist_count) edit->loops[loop.begin] = loop.end;
+	return true;
+}
+
+bool sabr_ir_pass_licm_is_invariant(sabr_ir_function_t* fn, sabr_ir_range_t range, bool* written, bool* deleted) {
+	for (size_t j = range.begin; j <= range.end; j++) {
+		sabr_bcop_t bcop = *sabr_ir_bcop(fn, j);
+		if (deleted[j - fn->begin]) return false;
+		switch (bcop.oc) {
+			case SABR_OP_NONE:
+			case SABR_OP_VALUE:
+				break;
+			case SABR_OP_LOAD_LOCAL:
+				if (bcop.operand.u >= fn->slot_count || fn->escaped[bcop.operand.u] || written[bcop.operand.u]) return false;
+				break;
+			default:
+				if (!sabr_ir_is_pure(bcop.oc)) return false;
+				break;
+		}
+	}
+	return true;
+}
+
+bool sabr_ir_pass_cse(sabr_ir_function_t* fn, sabr_ir_edit_t* edit) {
+	bool succeed = false;
+	size_t length = fn->end - fn->begin;
+	size_t count = 0;
+	sabr_ir_range_t* ranges = NULL;
+	size_t* counts = NULL;
+	uint64_t* temps = NULL;
+	bool* deleted = NULL;
+	bool* anchored = NULL;
+
+	if (!sabr_ir_lift(fn, NULL, NULL)) return true;
+
+	ranges = (sabr_ir_range_t*) malloc(sizeof(sabr_ir_range_t) * (length + 1));
+	counts = (size_t*) calloc(fn->value_count + 1, sizeof(size_t));
+	temps = (uint64_t*) malloc(sizeof(uint64_t) * (fn->value_count + 1));
+	deleted = (bool*) calloc(length + 1, sizeof(bool));
+	anchored = (bool*) calloc(length + 1, sizeof(bool));
+	if (!ranges || !counts || !temps || !deleted || !anchored) {
+		fputs(sabr_errmsg_alloc, stderr);
+		goto FREE_ALL;
+	}
+
+	for (size_t i = fn->begin; i < fn->end; i++) {
+		if (!sabr_ir_is_owned(fn, i) || !sabr_ir_is_pure(sabr_ir_bcop(fn, i)->oc)) continue;
+		sabr_ir_inst_t inst = fn->insts[i - fn->begin];
+		if (inst.result == SIZE_MAX || inst.begin == SIZE_MAX) continue;
+		size_t def = fn->values[inst.result].def;
+		if (def == SIZE_MAX || def == i) continue;
+		ranges[count++] = (sabr_ir_range_t) { inst.begin, i, sabr_ir_range_length(fn, inst.begin, i) };
+		counts[inst.result]++;
+	}
+	qsort(ranges, count, sizeof(sabr_ir_range_t), sabr_ir_range_compare);
+	for (size_t v = 0; v < fn->value_count; v++) temps[v] = UINT64_MAX;
+
+	for (size_t k = count; k-- > 0;) {
+		sabr_ir_range_t range = ranges[k];
+		size_t result = fn->insts[range.end - fn->begin].result;
+		size_t def = fn->values[result].def;
+		bool overlapped = deleted[def - fn->begin];
+		for (size_t j = range.begin; j <= range.end && !overlapped; j++)
+			overlapped = deleted[j - fn->begin] || anchored[j - fn->begin];
+		if (overlapped) continue;
+
+		if (temps[result] == UINT64_MAX) {
+			if (counts[result] * (range.length - 1) <= 2) continue;
+			temps[result] = sabr_ir_temp(fn);
+			anchored[def - fn->begin] = true;
+			if (!sabr_ir_edit_insert(edit, def, true, sabr_new_bcop(SABR_OP_DUP))) goto FREE_ALL;
+			if (!sabr_ir_edit_insert(edit, def, true, sabr_new_bcop_with_value(SABR_OP_STORE_LOCAL, (sabr_value_t) { .u = temps[result] }))) goto FREE_ALL;
+		}
+		for (size_t j = range.begin; j < range.end; j++) {
+			*sabr_ir_bcop(fn, j) = sabr_new_bcop(SABR_OP_NONE);
+			deleted[j - fn->begin] = true;
+		}
+		*sabr_ir_bcop(fn, range.end) = sabr_new_bcop_with_value(SABR_OP_LOAD_LOCAL, (sabr_value_t) { .u = temps[result] });
+		deleted[range.end - fn->begin] = true;
+	}
+
+	succeed = true;
+
+FREE_ALL:
+	free(ranges);
+	free(counts);
+	free(temps);
+	free(deleted);
+	free(anchored);
+	return succeed;
+}
+
+bool sabr_ir_pass_dse(sabr_ir_function_t* fn, sabr_ir_edit_t* edit) {
+	bool succeed = false;
+	bool changed = true;
+	size_t count = fn->block_count * fn->slot_count;
+	bool* live_in = NULL;
+	bool* live_out = NULL;
+	bool* live = NULL;
+
+	if (!sabr_ir_lift(fn, NULL, NULL)) return true;
+
+	live_in = (bool*) calloc(count + 1, sizeof(bool));
+	live_out = (bool*) calloc(count + 1, sizeof(bool));
+	live = (bool*) calloc(fn->slot_count + 1, sizeof(bool));
+	if (!live_in || !live_out || !live) {
+		fputs(sabr_errmsg_alloc, stderr);
+		goto FREE_ALL;
+	}
+
+	while (changed) {
+		changed = false;
+		for (size_t b = fn->block_count; b-- > 0;) {
+			sabr_ir_block_t* block = fn->blocks + b;
+			bool* out = live_out + b * fn->slot_count;
+			bool* in = live_in + b * fn->slot_count;
+			memset(out, 0, sizeof(bool) * fn->slot_count);
+			for (size_t k = 0; k < block->succ_count; k++)
+				for (uint64_t s = 0; s < fn->slot_count; s++)
+					out[s] |= live_in[block->succs[k] * fn->slot_count + s];
+			memcpy(live, out, sizeof(bool) * fn->slot_count);
+			sabr_ir_pass_dse_transfer(fn, b, live);
+			if (memcmp(live, in, sizeof(bool) * fn->slot_count)) {
+				memcpy(in, live, sizeof(bool) * fn->slot_count);
+				changed = true;
+			}
+		}
+	}
+
+	for (size_t b = 0; b < fn->block_count; b++) {
+		memcpy(live, live_out + b * fn->slot_count, sizeof(bool) * fn->slot_count);
+		sabr_ir_pass_dse_block(fn, b, live);
+	}
+
+	succeed = true;
+
+FREE_ALL:
+	free(live_in);
+	free(live_out);
+	free(live);
+	return succeed;
+}
+
+void sabr_ir_pass_dse_transfer(sabr_ir_function_t* fn, size_t block, bool* live) {
+	for (size_t i = fn->blocks[block].end; i-- > fn->blocks[block].begin;) {
+		uint64_t slot;
+		if (sabr_ir_reads_slot(fn, i, &slot)) {
+			if (slot < fn->slot_count) live[slot] = true;
+		}
+		else if (sabr_ir_writes_slot(fn, i, &slot) && slot < fn->slot_count) live[slot] = false;
+	}
+}
+
+void sabr_ir_pass_dse_block(sabr_ir_function_t* fn, size_t block, bool* live) {
+	for (size_t i = fn->blocks[block].end; i-- > fn->blocks[block].begin;) {
+		sabr_bcop_t* bcop = sabr_ir_bcop(fn, i);
+		uint64_t slot = bcop->operand.u;
+		if (slot >= fn->slot_count) continue;
+		switch (bcop->oc) {
+			case SABR_OP_LOAD_LOCAL:
+				live[slot] = true;
+				break;
+			case SABR_OP_STORE_LOCAL: {
+				if (live[slot] || fn->escaped[slot]) {
+					live[slot] = false;
+					break;
+				}
+				size_t producer = fn->insts[i - fn->begin].producer;
+				if (producer == SIZE_MAX || producer != sabr_ir_prev(fn, i) || fn->insts[producer - fn->begin].begin == SIZE_MAX) {
+					*bcop = sabr_new_bcop(SABR_OP_DROP);
+					break;
+				}
+				for (size_t j = fn->insts[producer - fn->begin].begin; j <= i; j++) *sabr_ir_bcop(fn, j) = sabr_new_bcop(SABR_OP_NONE);
+			} break;
+			case SABR_OP_INC_LOCAL:
+			case SABR_OP_DEC_LOCAL:
+				if (live[slot] || fn->escaped[slot]) live[slot] = true;
+				else *bcop = sabr_new_bcop(SABR_OP_NONE);
+				break;
+			case SABR_OP_ADD_LOCAL:
+			case SABR_OP_FADD_LOCAL:
+				if (live[slot] || fn->escaped[slot]) live[slot] = true;
+				else *bcop = sabr_new_bcop(SABR_OP_DROP);
+				break;
+			default:
+				if (sabr_ir_reads_slot(fn, i, &slot) && slot < fn->slot_count) live[slot] = true;
+				break;
+		}
+	}
+}
+
+int sabr_ir_range_compare(const void* a, const void* b) {
+	const sabr_ir_range_t* x = (const sabr_ir_range_t*) a;
+	const sabr_ir_range_t* y = (const sabr_ir_range_t*) b;
+	if (x->length != y->length) return (x->length > y->length) - (x->length < y->length);
+	return (x->begin < y->begin) - (x->begin > y->begin);
+}
\ No newline at end of file
@@ -0,0 +1,339 @@
+#include "layout.h"
+#include "inliner.h"
+#include "peephole.h"
+
+bool sabr_layout_run(sabr_bytecode_t* bc, sabr_profile_t* profile) {
+	bool succeed = false;
+	size_t size = bc->bcop_vec.size;
+	bool* hot = NULL;
+
+	if (!sabr_profile_matches(profile, bc)) {
+		fputs(sabr_errmsg_profile_mismatch, stderr);
+		return true;
+	}
+
+	hot = (bool*) calloc(size * 2 + 2, sizeof(bool));
+	if (!hot) {
+		fputs(sabr_errmsg_alloc, stderr);
+		goto FREE_ALL;
+	}
+
+	if (!sabr_layout_place(bc, profile, hot)) goto FREE_ALL;
+	if (!sabr_layout_inline(bc, hot)) goto FREE_ALL;
+	succeed = true;
+
+FREE_ALL:
+	free(hot);
+	return succeed;
+}
+
+bool sabr_layout_place(sabr_bytecode_t* bc, sabr_profile_t* profile, bool* hot) {
+	bool succeed = false;
+	bool moved = false;
+	size_t size = bc->bcop_vec.size;
+	size_t function_count = 0;
+	size_t len = 0;
+	size_t exit_pos = 0;
+	uint64_t total = 0;
+	uint64_t limit;
+	sabr_bcop_t* source = NULL;
+	size_t* owners = NULL;
+	size_t* table_begins = NULL;
+	size_t* table_ends = NULL;
+	size_t* sections = NULL;
+	size_t* resumes = NULL;
+	size_t* order = NULL;
+	size_t* map = NULL;
+	size_t* ends = NULL;
+	bool* targets = NULL;
+	bool* protect = NULL;
+	bool* cold = NULL;
+	bool* sites = NULL;
+	sabr_layout_function_t* functions = NULL;
+
+	source = (sabr_bcop_t*) malloc(sizeof(sabr_bcop_t) * (size + 1));
+	owners = (size_t*) malloc(sizeof(size_t) * (size + 1));
+	table_begins = (size_t*) malloc(sizeof(size_t) * (size + 1));
+	table_ends = (size_t*) malloc(sizeof(size_t) * (size + 1));
+	sections = (size_t*) calloc(size + 1, sizeof(size_t));
+	resumes = (size_t*) malloc(sizeof(size_t) * (size + 1));
+	order = (size_t*) malloc(sizeof(size_t) * (size * 2 + 2));
+	map = (size_t*) malloc(sizeof(size_t) * (size + 1));
+	ends = (size_t*) malloc(sizeof(size_t) * (size + 1));
+	targets = (bool*) calloc(size + 1, sizeof(bool));
+	protect = (bool*) calloc(size + 1, sizeof(bool));
+	cold = (bool*) calloc(size + 1, sizeof(bool));
+	sites = (bool*) calloc(size + 1, sizeof(bool));
+	functions = (sabr_layout_function_t*) malloc(sizeof(sabr_layout_function_t) * (size + 1));
+	if (!source || !owners || !table_begins || !table_ends || !sections || !resumes || !order || !map || !ends || !targets || !protect || !cold || !sites || !functions) {
+		fputs(sabr_errmsg_alloc, stderr);
+		goto FREE_ALL;
+	}
+
+	for (size_t i = 0; i < size; i++) {
+		source[i] = *vector_at(sabr_bcop_t, &bc->bcop_vec, i);
+		resumes[i] = SIZE_MAX;
+		total += profile->counts[i];
+		if (sabr_opcode_has_index_operand(source[i].oc) && source[i].operand.u <= size) targets[source[i].operand.u] = true;
+	}
+	if (!sabr_layout_owners(bc, owners)) goto FREE_ALL;
+	if (!sabr_layout_tables(bc, table_begins, table_ends)) {
+		succeed = true;
+		goto FREE_ALL;
+	}
+	limit = total / SABR_LAYOUT_HOT_SHARE;
+	if (!limit) limit = 1;
+
+	for (size_t i = 0; i < size; i++) {
+		size_t entry = source[i].operand.u;
+		if (source[i].oc != SABR_OP_CALL || profile->counts[i] < limit) continue;
+		if (!entry || entry >= size || owners[entry] != entry - 1) continue;
+		sites[i] = true;
+		protect[entry - 1] = true;
+	}
+
+	for (size_t i = 0; i + 1 < size; i++) {
+		if (source[i].oc != SABR_OP_JUMP || owners[i] != SIZE_MAX || owners[i + 1] != i) continue;
+		if (targets[i] || !profile->counts[i + 1]) continue;
+		if (!sabr_layout_is_movable(table_begins, table_ends, i, source[i].operand.u)) continue;
+		functions[function_count].head = i;
+		functions[function_count].end = source[i].operand.u;
+		functions[function_count].count = profile->counts[i + 1];
+		function_count++;
+	}
+	qsort(functions, function_count, sizeof(sabr_layout_function_t), sabr_layout_function_compare);
+	for (size_t k = 0; k < function_count; k++) {
+		for (size_t j = functions[k].head; j < functions[k].end; j++) sections[j] = k + 1;
+		moved = true;
+	}
+
+	for (size_t i = 0; i < size; i++) {
+		sabr_opcode_t inverse = sabr_layout_invert(source[i].oc);
+		size_t target = source[i].operand.u;
+		size_t owner = owners[i];
+		uint64_t count = profile->counts[i];
+		if (inverse == SABR_OP_NONE || target <= i + 1 || target > size || count < SABR_LAYOUT_MIN_COUNT) continue;
+		uint64_t taken = sabr_profile_edge(profile, i, target);
+		if (taken < count && (count - taken) * SABR_LAYOUT_COLD_RATIO > count) continue;
+		if (owner != SIZE_MAX && target >= source[owner].operand.u) continue;
+
+		bool movable = true;
+		for (size_t o = owner; movable && o != SIZE_MAX; o = owners[o]) movable = !protect[o];
+		for (size_t j = i + 1; movable && j < target; j++)
+			movable = owners[j] == owner && table_ends[j] == SIZE_MAX && source[j].oc != SABR_OP_LAMBDA;
+		if (!movable) continue;
+
+		for (size_t j = i + 1; j < target; j++) cold[j] = true;
+		if (!sabr_layout_is_terminal(source[target - 1].oc)) resumes[target - 1] = target;
+		source[i].oc = inverse;
+		source[i].operand.u = i + 1;
+		moved = true;
+		i = target - 1;
+	}
+
+	if (!moved) {
+		succeed = true;
+		goto FREE_ALL;
+	}
+
+	for (size_t j = 0; j < size; j++)
+		if (!sections[j] && !cold[j]) order[len++] = j;
+	exit_pos = len;
+	order[len++] = SIZE_MAX;
+	for (size_t k = 0; k < function_count; k++) {
+		for (size_t j = functions[k].head; j < functions[k].end; j++)
+			if (!cold[j]) order[len++] = j;
+		ends[k] = len;
+	}
+	for (size_t j = 0; j < size; j++) {
+		if (!cold[j]) continue;
+		order[len++] = j;
+		if (resumes[j] != SIZE_MAX) order[len++] = size + 1 + j;
+	}
+
+	for (size_t p = 0; p < len; p++)
+		if (order[p] < size) map[order[p]] = p;
+	map[size] = exit_pos;
+
+	bc->bcop_vec.size = 0;
+	bc->current_pos = 0;
+	for (size_t p = 0; p < len; p++) {
+		size_t j = order[p];
+		sabr_bcop_t bcop;
+		if (j == SIZE_MAX) bcop = sabr_new_bcop(SABR_OP_EXIT);
+		else if (j > size) bcop = sabr_new_bcop_with_value(SABR_OP_JUMP, (sabr_value_t) { .u = map[resumes[j - size - 1]] });
+		else {
+			bcop = source[j];
+			if (sabr_opcode_has_index_operand(bcop.oc) && bcop.operand.u <= size) bcop.operand.u = map[bcop.operand.u];
+		}
+		if (!vector_push_back(sabr_bcop_t, &bc->bcop_vec, bcop)) {
+			fputs(sabr_errmsg_alloc, stderr);
+			goto FREE_ALL;
+		}
+		bc->current_pos += sabr_opcode_has_operand(bcop.oc) ? 9 : 1;
+	}
+	bc->current_index = len;
+	for (size_t k = 0; k < function_count; k++)
+		vector_at(sabr_bcop_t, &bc->bcop_vec, map[functions[k].head])->operand.u = ends[k];
+
+	memset(hot, 0, sizeof(bool) * (size + 1));
+	for (size_t i = 0; i < size; i++)
+		if (sites[i]) hot[map[i]] = true;
+
+	succeed = true;
+
+FREE_ALL:
+	free(source);
+	free(owners);
+	free(table_begins);
+	free(table_ends);
+	free(sections);
+	free(resumes);
+	free(order);
+	free(map);
+	free(ends);
+	free(targets);
+	free(protect);
+	free(cold);
+	free(sites);
+	free(functions);
+	return succeed;
+}
+
+bool sabr_layout_inline(sabr_bytecode_t* bc, bool* hot) {
+	bool succeed = false;
+	bool any = false;
+	size_t size = bc->bcop_vec.size;
+	size_t* owners = NULL;
+
+	for (size_t i = 0; i < size; i++) any = any || hot[i];
+	if (!any) return true;
+
+	owners = (size_t*) malloc(sizeof(size_t) * (size + 1));
+	if (!owners) {
+		fputs(sabr_errmsg_alloc, stderr);
+		goto FREE_ALL;
+	}
+
+	if (!sabr_layout_owners(bc, owners)) goto FREE_ALL;
+	if (!sabr_inliner_run(bc, owners, hot)) goto FREE_ALL;
+	if (!sabr_peephole_run(bc)) goto FREE_ALL;
+	succeed = true;
+
+FREE_ALL:
+	free(owners);
+	return succeed;
+}
+
+bool sabr_layout_owners(sabr_bytecode_t* bc, size_t* owners) {
+	bool succeed = false;
+	size_t size = bc->bcop_vec.size;
+	size_t depth = 0;
+	size_t* heads = NULL;
+	bool* entries = NULL;
+
+	heads = (size_t*) malloc(sizeof(size_t) * (size + 1));
+	entries = (bool*) calloc(size + 1, sizeof(bool));
+	if (!heads || !entries) {
+		fputs(sabr_errmsg_alloc, stderr);
+		goto FREE_ALL;
+	}
+
+	for (size_t i = 0; i < size; i++) {
+		sabr_bcop_t bcop = *vector_at(sabr_bcop_t, &bc->bcop_vec, i);
+		if ((bcop.oc == SABR_OP_CALL || bcop.oc == SABR_OP_TAILCALL) && bcop.operand.u <= size) entries[bcop.operand.u] = true;
+	}
+
+	for (size_t i = 0; i < size; i++) {
+		sabr_bcop_t bcop = *vector_at(sabr_bcop_t, &bc->bcop_vec, i);
+		size_t end = bcop.operand.u;
+		while (depth && i >= vector_at(sabr_bcop_t, &bc->bcop_vec, heads[depth - 1])->operand.u) depth--;
+		owners[i] = depth ? heads[depth - 1] : SIZE_MAX;
+		if (bcop.oc == SABR_OP_LAMBDA) {
+			if (end <= i + 1 || end > size) continue;
+		}
+		else if (bcop.oc == SABR_OP_JUMP) {
+			if (end <= i + 2 || end > size || !entries[i + 1]) continue;
+			if (vector_at(sabr_bcop_t, &bc->bcop_vec, i + 1)->oc != SABR_OP_LOCAL) continue;
+			if (!sabr_layout_is_terminal(vector_at(sabr_bcop_t, &bc->bcop_vec, end - 1)->oc)) continue;
+		}
+		else continue;
+		if (depth && end > vector_at(sabr_bcop_t, &bc->bcop_vec, heads[depth - 1])->operand.u) continue;
+		heads[depth++] = i;
+	}
+	owners[size] = SIZE_MAX;
+	succeed = true;
+
+FREE_ALL:
+	free(heads);
+	free(entries);
+	return succeed;
+}
+
+bool sabr_layout_tables(sabr_bytecode_t* bc, size_t* table_begins, size_t* table_ends) {
+	size_t size = bc->bcop_vec.size;
+	for (size_t i = 0; i <= size; i++) {
+		table_begins[i] = SIZE_MAX;
+		table_ends[i] = SIZE_MAX;
+	}
+	for (size_t i = 0; i < size; i++) {
+		sabr_bcop_t bcop = *vector_at(sabr_bcop_t, &bc->bcop_vec, i);
+		size_t table = bcop.operand.u;
+		size_t end;
+		if (bcop.oc != SABR_OP_SWITCH_TABLE && bcop.oc != SABR_OP_SWITCH_SEARCH) continue;
+		if (!sabr_bytecode_check_switch(bc, bcop)) return false;
+		if (bcop.oc == SABR_OP_SWITCH_TABLE) end = table + 3 + vector_at(sabr_bcop_t, &bc->bcop_vec, table + 1)->operand.u;
+		else end = table + 2 + vector_at(sabr_bcop_t, &bc->bcop_vec, table)->operand.u * 2;
+		for (size_t j = table; j < end; j++) {
+			table_begins[j] = table;
+			table_ends[j] = end;
+		}
+	}
+	return true;
+}
+
+bool sabr_layout_is_movable(size_t* table_begins, size_t* table_ends, size_t begin, size_t end) {
+	for (size_t j = begin; j < end; j++) {
+		if (table_ends[j] != SIZE_MAX && (table_begins[j] < begin || table_ends[j] > end)) return false;
+	}
+	return true;
+}
+
+bool sabr_layout_is_terminal(sabr_opcode_t oc) {
+	switch (oc) {
+		case SABR_OP_EXIT:
+		case SABR_OP_JUMP:
+		case SABR_OP_RETURN:
+		case SABR_OP_TAILCALL:
+		case SABR_OP_SWITCH_TABLE:
+		case SABR_OP_SWITCH_SEARCH:
+			return true;
+		default:
+			return false;
+	}
+}
+
+sabr_opcode_t sabr_layout_invert(sabr_opcode_t oc) {
+	switch (oc) {
+		case SABR_OP_LST_IF: return SABR_OP_GEQ_IF;
+		case SABR_OP_GEQ_IF: return SABR_OP_LST_IF;
+		case SABR_OP_GRT_IF: return SABR_OP_LEQ_IF;
+		case SABR_OP_LEQ_IF: return SABR_OP_GRT_IF;
+		case SABR_OP_EQU_IF: return SABR_OP_NEQ_IF;
+		case SABR_OP_NEQ_IF: return SABR_OP_EQU_IF;
+		case SABR_OP_ULST_IF: return SABR_OP_UGEQ_IF;
+		case SABR_OP_UGEQ_IF: return SABR_OP_ULST_IF;
+		case SABR_OP_UGRT_IF: return SABR_OP_ULEQ_IF;
+		case SABR_OP_ULEQ_IF: return SABR_OP_UGRT_IF;
+		case SABR_OP_FEQU_IF: return SABR_OP_FNEQ_IF;
+		case SABR_OP_FNEQ_IF: return SABR_OP_FEQU_IF;
+		default: return SABR_OP_NONE;
+	}
+}
+
+int sabr_layout_function_compare(const void* a, const void* b) {
+	const sabr_layout_function_t* x = (const sabr_layout_function_t*) a;
+	const sabr_layout_function_t* y = (const sabr_layout_function_t*) b;
+	if (x->count != y->count) return (x->count < y->count) - (x->count > y->count);
+	return (x->head > y->head) - (x->head < y->head);
+}
\ No newline at end of file
@@ -10,22 +10,45 @@ const char* sabr_opcode_names[] = {
 	"OP_JUMP",
 
 	"OP_FOR",
+	"OP_FOR_ADDR",
 	"OP_FOR_FROM",
 	"OP_FOR_TO",
 	"OP_FOR_STEP",
 	"OP_FOR_CHECK",
 	"OP_FOR_NEXT",
 	"OP_FOR_END",
+	"OP_FOR_INIT",
+	"OP_FOR_TO_I",
+	"OP_FOR_TO_U",
+	"OP_FOR_TO_F",
+	"OP_FOR_ENTER_I",
+	"OP_FOR_ENTER_U",
+	"OP_FOR_ENTER_F",
+	"OP_FOR_LOOP_I",
+	"OP_FOR_LOOP_U",
+	"OP_FOR_LOOP_F",
+	"OP_FOR_UP_I",
+	"OP_FOR_UP_U",
+	"OP_FOR_UP_F",
+	"OP_FOR_DOWN_I",
+	"OP_FOR_DOWN_U",
+	"OP_FOR_DOWN_F",
+	"OP_FOR_LEAVE",
 
 	"OP_SWITCH",
 	"OP_SWITCH_CASE",
 	"OP_SWITCH_END",
+	"OP_CASE_IF",
+	"OP_SWITCH_TABLE",
+	"OP_SWITCH_SEARCH",
 
 	"OP_LAMBDA",
 	"OP_RETURN",
 	"OP_LOCAL",
 	"OP_LOCAL_END",
 	"OP_DEFINE",
+	"OP_INLINE",
+	"OP_NOINLINE",
 
 	"OP_DATAGROUP",
 	"OP_MEMBER",
@@ -34,9 +57,26 @@ const char* sabr_opcode_names[] = {
 	
 	"OP_SET",
 	"OP_EXEC",
+	"OP_CALL",
+	"OP_TAILCALL",
 	"OP_ADDR",
 	"OP_REF",
 
+	"OP_LOAD_LOCAL",
+	"OP_STORE_LOCAL",
+	"OP_ADDR_LOCAL",
+	"OP_INC_LOCAL",
+	"OP_DEC_LOCAL",
+	"OP_ADD_LOCAL",
+	"OP_FADD_LOCAL",
+	"OP_LOAD_GLOBAL",
+	"OP_STORE_GLOBAL",
+	"OP_ADDR_GLOBAL",
+	"OP_INC_GLOBAL",
+	"OP_DEC_GLOBAL",
+	"OP_ADD_GLOBAL",
+	"OP_FADD_GLOBAL",
+
 	"OP_CALL_BIF",
 
 	"OP_ADD",
@@ -49,6 +89,8 @@ const char* sabr_opcode_names[] = {
 	"OP_NEG",
 	"OP_INC",
 	"OP_DEC",
+	"OP_ADD_IMM",
+	"OP_MUL_IMM",
 
 	"OP_EQU",
 	"OP_NEQ",
@@ -60,6 +102,22 @@ const char* sabr_opcode_names[] = {
 	"OP_UGEQ",
 	"OP_ULST",
 	"OP_ULEQ",
+	"OP_LST_IF",
+	"OP_EQU_IF",
+	"OP_NEQ_IF",
+	"OP_GRT_IF",
+	"OP_GEQ_IF",
+	"OP_LEQ_IF",
+	"OP_UGRT_IF",
+	"OP_UGEQ_IF",
+	"OP_ULST_IF",
+	"OP_ULEQ_IF",
+	"OP_EQU_IMM",
+	"OP_NEQ_IMM",
+	"OP_GRT_IMM",
+	"OP_GEQ_IMM",
+	"OP_LST_IMM",
+	"OP_LEQ_IMM",
 
 	"OP_FADD",
 	"OP_FSUB",
@@ -74,6 +132,12 @@ const char* sabr_opcode_names[] = {
 	"OP_FGEQ",
 	"OP_FLST",
 	"OP_FLEQ",
+	"OP_FEQU_IF",
+	"OP_FNEQ_IF",
+	"OP_FGRT_IF",
+	"OP_FGEQ_IF",
+	"OP_FLST_IF",
+	"OP_FLEQ_IF",
 
 	"OP_BAND",
 	"OP_BOR",
@@ -81,6 +145,9 @@ const char* sabr_opcode_names[] = {
 	"OP_BNOT",
 	"OP_BLSFT",
 	"OP_BRSFT",
+	"OP_BAND_IMM",
+	"OP_BLSFT_IMM",
+	"OP_BRSFT_IMM",
 
 	"OP_DROP",
 	"OP_NIP",
@@ -106,6 +173,29 @@ const char* sabr_opcode_names[] = {
 	
 	"OP_FETCH",
 	"OP_STORE",
+	"OP_INC_MEM",
+	"OP_DEC_MEM",
+	"OP_ADD_MEM",
+	"OP_SUB_MEM",
+	"OP_MUL_MEM",
+	"OP_DIV_MEM",
+	"OP_MOD_MEM",
+	"OP_FADD_MEM",
+	"OP_FSUB_MEM",
+	"OP_FMUL_MEM",
+	"OP_FDIV_MEM",
+	"OP_FMOD_MEM",
+	"OP_BAND_MEM",
+	"OP_BOR_MEM",
+	"OP_BXOR_MEM",
+	"OP_BNOT_MEM",
+	"OP_BLSFT_MEM",
+	"OP_BRSFT_MEM",
+	"OP_INDEX_CELL",
+	"OP_FETCH_IDX",
+	"OP_STORE_IDX",
+	"OP_FETCH_OFF",
+	"OP_STORE_OFF",
 
 	"OP_ARRAY",
 	"OP_ARRAY_COMMA",
@@ -133,16 +223,81 @@ const char* sabr_opcode_names[] = {
 
 size_t sabr_opcode_names_len = sizeof(sabr_opcode_names) / sizeof(char*);
 
+_Static_assert(sizeof(sabr_opcode_names) / sizeof(char*) == SABR_OP_COUNT, "opcode names must match the opcodes");
+
 bool sabr_opcode_has_operand(sabr_opcode_t oc) {
 	switch (oc) {
 		case SABR_OP_VALUE:
 		case SABR_OP_IF:
 		case SABR_OP_JUMP:
+		case SABR_OP_CASE_IF:
+		case SABR_OP_SWITCH_TABLE:
+		case SABR_OP_SWITCH_SEARCH:
+		case SABR_OP_LST_IF:
+		case SABR_OP_ADD_IMM:
+		case SABR_OP_MUL_IMM:
+		case SABR_OP_FETCH_OFF:
+		case SABR_OP_STORE_OFF:
+		case SABR_OP_EQU_IF:
+		case SABR_OP_NEQ_IF:
+		case SABR_OP_GRT_IF:
+		case SABR_OP_GEQ_IF:
+		case SABR_OP_LEQ_IF:
+		case SABR_OP_UGRT_IF:
+		case SABR_OP_UGEQ_IF:
+		case SABR_OP_ULST_IF:
+		case SABR_OP_ULEQ_IF:
+		case SABR_OP_FEQU_IF:
+		case SABR_OP_FNEQ_IF:
+		case SABR_OP_FGRT_IF:
+		case SABR_OP_FGEQ_IF:
+		case SABR_OP_FLST_IF:
+		case SABR_OP_FLEQ_IF:
+		case SABR_OP_EQU_IMM:
+		case SABR_OP_NEQ_IMM:
+		case SABR_OP_GRT_IMM:
+		case SABR_OP_GEQ_IMM:
+		case SABR_OP_LST_IMM:
+		case SABR_OP_LEQ_IMM:
+		case SABR_OP_BAND_IMM:
+		case SABR_OP_BLSFT_IMM:
+		case SABR_OP_BRSFT_IMM:
 		case SABR_OP_FOR:
+		case SABR_OP_FOR_ADDR:
 		case SABR_OP_FOR_CHECK:
 		case SABR_OP_FOR_NEXT:
+		case SABR_OP_FOR_INIT:
+		case SABR_OP_FOR_ENTER_I:
+		case SABR_OP_FOR_ENTER_U:
+		case SABR_OP_FOR_ENTER_F:
+		case SABR_OP_FOR_LOOP_I:
+		case SABR_OP_FOR_LOOP_U:
+		case SABR_OP_FOR_LOOP_F:
+		case SABR_OP_FOR_UP_I:
+		case SABR_OP_FOR_UP_U:
+		case SABR_OP_FOR_UP_F:
+		case SABR_OP_FOR_DOWN_I:
+		case SABR_OP_FOR_DOWN_U:
+		case SABR_OP_FOR_DOWN_F:
 		case SABR_OP_LAMBDA:
+		case SABR_OP_LOCAL:
 		case SABR_OP_EXEC:
+		case SABR_OP_CALL:
+		case SABR_OP_TAILCALL:
+		case SABR_OP_LOAD_LOCAL:
+		case SABR_OP_STORE_LOCAL:
+		case SABR_OP_ADDR_LOCAL:
+		case SABR_OP_LOAD_GLOBAL:
+		case SABR_OP_STORE_GLOBAL:
+		case SABR_OP_ADDR_GLOBAL:
+		case SABR_OP_INC_LOCAL:
+		case SABR_OP_DEC_LOCAL:
+		case SABR_OP_ADD_LOCAL:
+		case SABR_OP_FADD_LOCAL:
+		case SABR_OP_INC_GLOBAL:
+		case SABR_OP_DEC_GLOBAL:
+		case SABR_OP_ADD_GLOBAL:
+		case SABR_OP_FADD_GLOBAL:
 		case SABR_OP_DATAGROUP:
 			return true;
 		default:
@@ -154,11 +309,332 @@ bool sabr_opcode_has_index_operand(sabr_opcode_t oc) {
 	switch (oc) {
 		case SABR_OP_IF:
 		case SABR_OP_JUMP:
+		case SABR_OP_CASE_IF:
+		case SABR_OP_SWITCH_TABLE:
+		case SABR_OP_SWITCH_SEARCH:
+		case SABR_OP_LST_IF:
+		case SABR_OP_EQU_IF:
+		case SABR_OP_NEQ_IF:
+		case SABR_OP_GRT_IF:
+		case SABR_OP_GEQ_IF:
+		case SABR_OP_LEQ_IF:
+		case SABR_OP_UGRT_IF:
+		case SABR_OP_UGEQ_IF:
+		case SABR_OP_ULST_IF:
+		case SABR_OP_ULEQ_IF:
+		case SABR_OP_FEQU_IF:
+		case SABR_OP_FNEQ_IF:
+		case SABR_OP_FGRT_IF:
+		case SABR_OP_FGEQ_IF:
+		case SABR_OP_FLST_IF:
+		case SABR_OP_FLEQ_IF:
 		case SABR_OP_FOR_CHECK:
 		case SABR_OP_FOR_NEXT:
+		case SABR_OP_FOR_ENTER_I:
+		case SABR_OP_FOR_ENTER_U:
+		case SABR_OP_FOR_ENTER_F:
+		case SABR_OP_FOR_LOOP_I:
+		case SABR_OP_FOR_LOOP_U:
+		case SABR_OP_FOR_LOOP_F:
+		case SABR_OP_FOR_UP_I:
+		case SABR_OP_FOR_UP_U:
+		case SABR_OP_FOR_UP_F:
+		case SABR_OP_FOR_DOWN_I:
+		case SABR_OP_FOR_DOWN_U:
+		case SABR_OP_FOR_DOWN_F:
 		case SABR_OP_LAMBDA:
+		case SABR_OP_CALL:
+		case SABR_OP_TAILCALL:
 			return true;
 		default:
 			return false;
 	}
+}
+
+bool sabr_opcode_is_control(sabr_opcode_t oc) {
+	switch (oc) {
+		case SABR_OP_EXIT:
+		case SABR_OP_IF:
+		case SABR_OP_JUMP:
+		case SABR_OP_CASE_IF:
+		case SABR_OP_SWITCH_TABLE:
+		case SABR_OP_SWITCH_SEARCH:
+		case SABR_OP_LST_IF:
+		case SABR_OP_EQU_IF:
+		case SABR_OP_NEQ_IF:
+		case SABR_OP_GRT_IF:
+		case SABR_OP_GEQ_IF:
+		case SABR_OP_LEQ_IF:
+		case SABR_OP_UGRT_IF:
+		case SABR_OP_UGEQ_IF:
+		case SABR_OP_ULST_IF:
+		case SABR_OP_ULEQ_IF:
+		case SABR_OP_FEQU_IF:
+		case SABR_OP_FNEQ_IF:
+		case SABR_OP_FGRT_IF:
+		case SABR_OP_FGEQ_IF:
+		case SABR_OP_FLST_IF:
+		case SABR_OP_FLEQ_IF:
+		case SABR_OP_FOR_CHECK:
+		case SABR_OP_FOR_NEXT:
+		case SABR_OP_FOR_ENTER_I:
+		case SABR_OP_FOR_ENTER_U:
+		case SABR_OP_FOR_ENTER_F:
+		case SABR_OP_FOR_LOOP_I:
+		case SABR_OP_FOR_LOOP_U:
+		case SABR_OP_FOR_LOOP_F:
+		case SABR_OP_FOR_UP_I:
+		case SABR_OP_FOR_UP_U:
+		case SABR_OP_FOR_UP_F:
+		case SABR_OP_FOR_DOWN_I:
+		case SABR_OP_FOR_DOWN_U:
+		case SABR_OP_FOR_DOWN_F:
+		case SABR_OP_LAMBDA:
+		case SABR_OP_RETURN:
+		case SABR_OP_CALL:
+		case SABR_OP_TAILCALL:
+			return true;
+		default:
+			return false;
+	}
+}
+
+bool sabr_opcode_is_global(sabr_opcode_t oc) {
+	switch (oc) {
+		case SABR_OP_LOAD_GLOBAL:
+		case SABR_OP_STORE_GLOBAL:
+		case SABR_OP_ADDR_GLOBAL:
+		case SABR_OP_INC_GLOBAL:
+		case SABR_OP_DEC_GLOBAL:
+		case SABR_OP_ADD_GLOBAL:
+		case SABR_OP_FADD_GLOBAL:
+			return true;
+		default:
+			return false;
+	}
+}
+
+bool sabr_opcode_stack_effect(sabr_opcode_t oc, size_t* pops, size_t* pushes) {
+	size_t i = 0, o = 0;
+	switch (oc) {
+		case SABR_OP_DATAGROUP_EXEC:
+		case SABR_OP_EXEC:
+		case SABR_OP_CALL_BIF:
+		case SABR_OP_SHOW:
+			return false;
+
+		case SABR_OP_NONE:
+		case SABR_OP_EXIT:
+		case SABR_OP_JUMP:
+		case SABR_OP_FOR_CHECK:
+		case SABR_OP_FOR_NEXT:
+		case SABR_OP_FOR_END:
+		case SABR_OP_FOR_ENTER_I:
+		case SABR_OP_FOR_ENTER_U:
+		case SABR_OP_FOR_ENTER_F:
+		case SABR_OP_FOR_LOOP_I:
+		case SABR_OP_FOR_LOOP_U:
+		case SABR_OP_FOR_LOOP_F:
+		case SABR_OP_FOR_UP_I:
+		case SABR_OP_FOR_UP_U:
+		case SABR_OP_FOR_UP_F:
+		case SABR_OP_FOR_DOWN_I:
+		case SABR_OP_FOR_DOWN_U:
+		case SABR_OP_FOR_DOWN_F:
+		case SABR_OP_FOR_LEAVE:
+		case SABR_OP_SWITCH_END:
+		case SABR_OP_RETURN:
+		case SABR_OP_LOCAL:
+		case SABR_OP_LOCAL_END:
+		case SABR_OP_INLINE:
+		case SABR_OP_NOINLINE:
+		case SABR_OP_DATAGROUP_END:
+		case SABR_OP_CALL:
+		case SABR_OP_TAILCALL:
+		case SABR_OP_INC_LOCAL:
+		case SABR_OP_DEC_LOCAL:
+		case SABR_OP_INC_GLOBAL:
+		case SABR_OP_DEC_GLOBAL:
+		case SABR_OP_ARRAY:
+		case SABR_OP_GETC:
+		case SABR_OP_GETS:
+			break;
+
+		case SABR_OP_VALUE:
+		case SABR_OP_SWITCH_CASE:
+		case SABR_OP_LAMBDA:
+		case SABR_OP_LOAD_LOCAL:
+		case SABR_OP_ADDR_LOCAL:
+		case SABR_OP_LOAD_GLOBAL:
+		case SABR_OP_ADDR_GLOBAL:
+		case SABR_OP_GETI:
+		case SABR_OP_GETU:
+		case SABR_OP_GETF:
+			o = 1;
+			break;
+
+		case SABR_OP_IF:
+		case SABR_OP_CASE_IF:
+		case SABR_OP_FOR:
+		case SABR_OP_FOR_ADDR:
+		case SABR_OP_FOR_FROM:
+		case SABR_OP_FOR_TO:
+		case SABR_OP_FOR_STEP:
+		case SABR_OP_FOR_INIT:
+		case SABR_OP_FOR_TO_I:
+		case SABR_OP_FOR_TO_U:
+		case SABR_OP_FOR_TO_F:
+		case SABR_OP_SWITCH:
+		case SABR_OP_SWITCH_TABLE:
+		case SABR_OP_SWITCH_SEARCH:
+		case SABR_OP_DATAGROUP:
+		case SABR_OP_MEMBER:
+		case SABR_OP_STORE_LOCAL:
+		case SABR_OP_STORE_GLOBAL:
+		case SABR_OP_DROP:
+		case SABR_OP_FREE:
+		case SABR_OP_ARRAY_COMMA:
+		case SABR_OP_PUTC:
+		case SABR_OP_PUTI:
+		case SABR_OP_PUTU:
+		case SABR_OP_PUTF:
+		case SABR_OP_PUTS:
+		case SABR_OP_ADD_LOCAL:
+		case SABR_OP_FADD_LOCAL:
+		case SABR_OP_ADD_GLOBAL:
+		case SABR_OP_FADD_GLOBAL:
+		case SABR_OP_INC_MEM:
+		case SABR_OP_DEC_MEM:
+		case SABR_OP_BNOT_MEM:
+			i = 1;
+			break;
+
+		case SABR_OP_LST_IF:
+		case SABR_OP_EQU_IF:
+		case SABR_OP_NEQ_IF:
+		case SABR_OP_GRT_IF:
+		case SABR_OP_GEQ_IF:
+		case SABR_OP_LEQ_IF:
+		case SABR_OP_UGRT_IF:
+		case SABR_OP_UGEQ_IF:
+		case SABR_OP_ULST_IF:
+		case SABR_OP_ULEQ_IF:
+		case SABR_OP_FEQU_IF:
+		case SABR_OP_FNEQ_IF:
+		case SABR_OP_FGRT_IF:
+		case SABR_OP_FGEQ_IF:
+		case SABR_OP_FLST_IF:
+		case SABR_OP_FLEQ_IF:
+		case SABR_OP_DEFINE:
+		case SABR_OP_SET:
+		case SABR_OP_REF:
+		case SABR_OP_TDROP:
+		case SABR_OP_STORE:
+		case SABR_OP_STORE_OFF:
+		case SABR_OP_ADD_MEM:
+		case SABR_OP_SUB_MEM:
+		case SABR_OP_MUL_MEM:
+		case SABR_OP_DIV_MEM:
+		case SABR_OP_MOD_MEM:
+		case SABR_OP_FADD_MEM:
+		case SABR_OP_FSUB_MEM:
+		case SABR_OP_FMUL_MEM:
+		case SABR_OP_FDIV_MEM:
+		case SABR_OP_FMOD_MEM:
+		case SABR_OP_BAND_MEM:
+		case SABR_OP_BOR_MEM:
+		case SABR_OP_BXOR_MEM:
+		case SABR_OP_BLSFT_MEM:
+		case SABR_OP_BRSFT_MEM:
+			i = 2;
+			break;
+
+		case SABR_OP_ADDR:
+		case SABR_OP_NEG:
+		case SABR_OP_INC:
+		case SABR_OP_DEC:
+		case SABR_OP_ADD_IMM:
+		case SABR_OP_MUL_IMM:
+		case SABR_OP_EQU_IMM:
+		case SABR_OP_NEQ_IMM:
+		case SABR_OP_GRT_IMM:
+		case SABR_OP_GEQ_IMM:
+		case SABR_OP_LST_IMM:
+		case SABR_OP_LEQ_IMM:
+		case SABR_OP_BAND_IMM:
+		case SABR_OP_BLSFT_IMM:
+		case SABR_OP_BRSFT_IMM:
+		case SABR_OP_FNEG:
+		case SABR_OP_BNOT:
+		case SABR_OP_ALLOC:
+		case SABR_OP_ALLOT:
+		case SABR_OP_FETCH:
+		case SABR_OP_FETCH_OFF:
+		case SABR_OP_ARRAY_END:
+		case SABR_OP_ITOF:
+		case SABR_OP_UTOF:
+		case SABR_OP_FTOI:
+		case SABR_OP_FTOU:
+			i = 1; o = 1;
+			break;
+
+		case SABR_OP_ADD:
+		case SABR_OP_SUB:
+		case SABR_OP_MUL:
+		case SABR_OP_DIV:
+		case SABR_OP_MOD:
+		case SABR_OP_UDIV:
+		case SABR_OP_UMOD:
+		case SABR_OP_EQU:
+		case SABR_OP_NEQ:
+		case SABR_OP_GRT:
+		case SABR_OP_GEQ:
+		case SABR_OP_LST:
+		case SABR_OP_LEQ:
+		case SABR_OP_UGRT:
+		case SABR_OP_UGEQ:
+		case SABR_OP_ULST:
+		case SABR_OP_ULEQ:
+		case SABR_OP_FADD:
+		case SABR_OP_FSUB:
+		case SABR_OP_FMUL:
+		case SABR_OP_FDIV:
+		case SABR_OP_FMOD:
+		case SABR_OP_FEQU:
+		case SABR_OP_FNEQ:
+		case SABR_OP_FGRT:
+		case SABR_OP_FGEQ:
+		case SABR_OP_FLST:
+		case SABR_OP_FLEQ:
+		case SABR_OP_BAND:
+		case SABR_OP_BOR:
+		case SABR_OP_BXOR:
+		case SABR_OP_BLSFT:
+		case SABR_OP_BRSFT:
+		case SABR_OP_NIP:
+		case SABR_OP_INDEX_CELL:
+		case SABR_OP_FETCH_IDX:
+		case SABR_OP_RESIZE:
+			i = 2; o = 1;
+			break;
+
+		case SABR_OP_DUP: i = 1; o = 2; break;
+		case SABR_OP_OVER: i = 2; o = 3; break;
+		case SABR_OP_TUCK: i = 2; o = 3; break;
+		case SABR_OP_SWAP: i = 2; o = 2; break;
+		case SABR_OP_ROT: i = 3; o = 3; break;
+		case SABR_OP_STORE_IDX: i = 3; o = 0; break;
+		case SABR_OP_TNIP: i = 4; o = 2; break;
+		case SABR_OP_TDUP: i = 2; o = 4; break;
+		case SABR_OP_TOVER: i = 4; o = 6; break;
+		case SABR_OP_TTUCK: i = 4; o = 6; break;
+		case SABR_OP_TSWAP: i = 4; o = 4; break;
+		case SABR_OP_TROT: i = 6; o = 6; break;
+
+		default:
+			return false;
+	}
+	*pops = i;
+	*pushes = o;
+	return true;
 }
\ No newline at end of file
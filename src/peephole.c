@@ -0,0 +1,194 @@
+#include "peephole.h"
+
+#define sabr_peephole_pattern(...) (const sabr_opcode_t[]) { __VA_ARGS__ }, sizeof((const sabr_opcode_t[]) { __VA_ARGS__ }) / sizeof(sabr_opcode_t)
+
+bool sabr_peephole_run(sabr_bytecode_t* bc) {
+	bool changed = true;
+	if (!sabr_peephole_compact(bc)) return false;
+	while (changed) {
+		bool* targets = sabr_peephole_targets(bc);
+		if (!targets) return false;
+		bool succeed = sabr_peephole_fuse(bc, targets, &changed);
+		free(targets);
+		if (!succeed) return false;
+		if (changed && !sabr_peephole_compact(bc)) return false;
+	}
+	return true;
+}
+
+bool sabr_peephole_fuse(sabr_bytecode_t* bc, bool* targets, bool* changed) {
+	size_t size = bc->bcop_vec.size;
+	*changed = false;
+
+	for (size_t i = 0; i < size; i++) {
+		sabr_bcop_t* bcop = vector_at(sabr_bcop_t, &bc->bcop_vec, i);
+		sabr_bcop_t* next = (i + 1 < size) ? vector_at(sabr_bcop_t, &bc->bcop_vec, i + 1) : NULL;
+		size_t len = 0;
+
+		if (sabr_peephole_match(bc, targets, i, sabr_peephole_pattern(SABR_OP_SWAP, SABR_OP_VALUE, SABR_OP_MUL, SABR_OP_ADD))
+			&& next->operand.u == sizeof(sabr_value_t)) {
+			*bcop = sabr_new_bcop(SABR_OP_INDEX_CELL);
+			len = 4;
+		}
+		else if (sabr_peephole_match(bc, targets, i, sabr_peephole_pattern(SABR_OP_INDEX_CELL, SABR_OP_FETCH))) {
+			*bcop = sabr_new_bcop(SABR_OP_FETCH_IDX);
+			len = 2;
+		}
+		else if (sabr_peephole_match(bc, targets, i, sabr_peephole_pattern(SABR_OP_INDEX_CELL, SABR_OP_STORE))) {
+			*bcop = sabr_new_bcop(SABR_OP_STORE_IDX);
+			len = 2;
+		}
+		else if (sabr_peephole_match(bc, targets, i, sabr_peephole_pattern(SABR_OP_ADD_IMM, SABR_OP_FETCH))) {
+			*bcop = sabr_new_bcop_with_value(SABR_OP_FETCH_OFF, bcop->operand);
+			len = 2;
+		}
+		else if (sabr_peephole_match(bc, targets, i, sabr_peephole_pattern(SABR_OP_ADD_IMM, SABR_OP_STORE))) {
+			*bcop = sabr_new_bcop_with_value(SABR_OP_STORE_OFF, bcop->operand);
+			len = 2;
+		}
+		else if (sabr_peephole_match(bc, targets, i, sabr_peephole_pattern(SABR_OP_VALUE, SABR_OP_ADD))) {
+			*bcop = sabr_new_bcop_with_value(SABR_OP_ADD_IMM, bcop->operand);
+			len = 2;
+		}
+		else if (sabr_peephole_match(bc, targets, i, sabr_peephole_pattern(SABR_OP_VALUE, SABR_OP_SUB))) {
+			*bcop = sabr_new_bcop_with_value(SABR_OP_ADD_IMM, (sabr_value_t) { .u = -bcop->operand.u });
+			len = 2;
+		}
+		else if (sabr_peephole_match(bc, targets, i, sabr_peephole_pattern(SABR_OP_VALUE, SABR_OP_MUL))) {
+			*bcop = sabr_new_bcop_with_value(SABR_OP_MUL_IMM, bcop->operand);
+			len = 2;
+		}
+		else if (bcop->oc == SABR_OP_VALUE && next && !targets[i + 1] && sabr_peephole_immediate(next->oc) != SABR_OP_NONE
+			&& !(sabr_peephole_branch(next->oc) != SABR_OP_NONE && sabr_peephole_match(bc, targets, i + 1, sabr_peephole_pattern(next->oc, SABR_OP_IF)))) {
+			*bcop = sabr_new_bcop_with_value(sabr_peephole_immediate(next->oc), bcop->operand);
+			len = 2;
+		}
+		else if (sabr_peephole_branch(bcop->oc) != SABR_OP_NONE && sabr_peephole_match(bc, targets, i, sabr_peephole_pattern(bcop->oc, SABR_OP_IF))) {
+			*bcop = sabr_new_bcop_with_value(sabr_peephole_branch(bcop->oc), next->operand);
+			len = 2;
+		}
+		else if (next && !targets[i + 1] && sabr_peephole_variable(bcop->oc, next->oc) != SABR_OP_NONE) {
+			*bcop = sabr_new_bcop_with_value(sabr_peephole_variable(bcop->oc, next->oc), bcop->operand);
+			len = 2;
+		}
+		else if (sabr_peephole_match(bc, targets, i, sabr_peephole_pattern(SABR_OP_SWITCH_CASE, SABR_OP_EQU, SABR_OP_IF))) {
+			*bcop = sabr_new_bcop_with_value(SABR_OP_CASE_IF, vector_at(sabr_bcop_t, &bc->bcop_vec, i + 2)->operand);
+			len = 3;
+		}
+		else if (sabr_peephole_match(bc, targets, i, sabr_peephole_pattern(SABR_OP_SWAP, SABR_OP_SWAP))
+			|| sabr_peephole_match(bc, targets, i, sabr_peephole_pattern(SABR_OP_DUP, SABR_OP_DROP))) {
+			*bcop = sabr_new_bcop(SABR_OP_NONE);
+			len = 2;
+		}
+		if (!len) continue;
+
+		for (size_t j = 1; j < len; j++)
+			*vector_at(sabr_bcop_t, &bc->bcop_vec, i + j) = sabr_new_bcop(SABR_OP_NONE);
+		i += len - 1;
+		*changed = true;
+	}
+	return true;
+}
+
+bool sabr_peephole_compact(sabr_bytecode_t* bc) {
+	size_t size = bc->bcop_vec.size;
+	size_t count = 0;
+	size_t* map = (size_t*) malloc(sizeof(size_t) * (size + 1));
+	if (!map) {
+		fputs(sabr_errmsg_alloc, stderr);
+		return false;
+	}
+
+	for (size_t i = 0; i < size; i++) {
+		map[i] = count;
+		if (vector_at(sabr_bcop_t, &bc->bcop_vec, i)->oc != SABR_OP_NONE) count++;
+	}
+	map[size] = count;
+
+	bc->current_pos = 0;
+	for (size_t i = 0; i < size; i++) {
+		sabr_bcop_t bcop = *vector_at(sabr_bcop_t, &bc->bcop_vec, i);
+		if (bcop.oc == SABR_OP_NONE) continue;
+		if (sabr_opcode_has_index_operand(bcop.oc) && bcop.operand.u <= size) bcop.operand.u = map[bcop.operand.u];
+		*vector_at(sabr_bcop_t, &bc->bcop_vec, map[i]) = bcop;
+		bc->current_pos += sabr_opcode_has_operand(bcop.oc) ? 9 : 1;
+	}
+	bc->bcop_vec.size = count;
+	bc->current_index = count;
+
+	free(map);
+	return true;
+}
+
+bool sabr_peephole_match(sabr_bytecode_t* bc, bool* targets, size_t index, const sabr_opcode_t* pattern, size_t len) {
+	if (index + len > bc->bcop_vec.size) return false;
+	for (size_t i = 0; i < len; i++) {
+		if (i && targets[index + i]) return false;
+		if (vector_at(sabr_bcop_t, &bc->bcop_vec, index + i)->oc != pattern[i]) return false;
+	}
+	return true;
+}
+
+sabr_opcode_t sabr_peephole_branch(sabr_opcode_t oc) {
+	switch (oc) {
+		case SABR_OP_EQU: return SABR_OP_EQU_IF;
+		case SABR_OP_NEQ: return SABR_OP_NEQ_IF;
+		case SABR_OP_GRT: return SABR_OP_GRT_IF;
+		case SABR_OP_GEQ: return SABR_OP_GEQ_IF;
+		case SABR_OP_LST: return SABR_OP_LST_IF;
+		case SABR_OP_LEQ: return SABR_OP_LEQ_IF;
+		case SABR_OP_UGRT: return SABR_OP_UGRT_IF;
+		case SABR_OP_UGEQ: return SABR_OP_UGEQ_IF;
+		case SABR_OP_ULST: return SABR_OP_ULST_IF;
+		case SABR_OP_ULEQ: return SABR_OP_ULEQ_IF;
+		case SABR_OP_FEQU: return SABR_OP_FEQU_IF;
+		case SABR_OP_FNEQ: return SABR_OP_FNEQ_IF;
+		case SABR_OP_FGRT: return SABR_OP_FGRT_IF;
+		case SABR_OP_FGEQ: return SABR_OP_FGEQ_IF;
+		case SABR_OP_FLST: return SABR_OP_FLST_IF;
+		case SABR_OP_FLEQ: return SABR_OP_FLEQ_IF;
+		default: return SABR_OP_NONE;
+	}
+}
+
+sabr_opcode_t sabr_peephole_immediate(sabr_opcode_t oc) {
+	switch (oc) {
+		case SABR_OP_EQU: return SABR_OP_EQU_IMM;
+		case SABR_OP_NEQ: return SABR_OP_NEQ_IMM;
+		case SABR_OP_GRT: return SABR_OP_GRT_IMM;
+		case SABR_OP_GEQ: return SABR_OP_GEQ_IMM;
+		case SABR_OP_LST: return SABR_OP_LST_IMM;
+		case SABR_OP_LEQ: return SABR_OP_LEQ_IMM;
+		case SABR_OP_BAND: return SABR_OP_BAND_IMM;
+		case SABR_OP_BLSFT: return SABR_OP_BLSFT_IMM;
+		case SABR_OP_BRSFT: return SABR_OP_BRSFT_IMM;
+		default: return SABR_OP_NONE;
+	}
+}
+
+sabr_opcode_t sabr_peephole_variable(sabr_opcode_t addr, sabr_opcode_t oc) {
+	bool local = addr == SABR_OP_ADDR_LOCAL;
+	if (!local && addr != SABR_OP_ADDR_GLOBAL) return SABR_OP_NONE;
+	switch (oc) {
+		case SABR_OP_INC_MEM: return local ? SABR_OP_INC_LOCAL : SABR_OP_INC_GLOBAL;
+		case SABR_OP_DEC_MEM: return local ? SABR_OP_DEC_LOCAL : SABR_OP_DEC_GLOBAL;
+		case SABR_OP_ADD_MEM: return local ? SABR_OP_ADD_LOCAL : SABR_OP_ADD_GLOBAL;
+		case SABR_OP_FADD_MEM: return local ? SABR_OP_FADD_LOCAL : SABR_OP_FADD_GLOBAL;
+		default: return SABR_OP_NONE;
+	}
+}
+
+bool* sabr_peephole_targets(sabr_bytecode_t* bc) {
+	size_t size = bc->bcop_vec.size;
+	bool* targets = (bool*) calloc(size + 1, sizeof(bool));
+	if (!targets) {
+		fputs(sabr_errmsg_alloc, stderr);
+		return NULL;
+	}
+	for (size_t i = 0; i < size; i++) {
+		sabr_bcop_t bcop = *vector_at(sabr_bcop_t, &bc->bcop_vec, i);
+		if (sabr_opcode_has_index_operand(bcop.oc) && bcop.operand.u <= size)
+			targets[bcop.operand.u] = true;
+	}
+	return targets;
+}
\ No newline at end of file
@@ -0,0 +1,139 @@
+#include "profile.h"
+
+bool sabr_profile_init(sabr_profile_t* profile, size_t size, uint64_t checksum) {
+	profile->size = size;
+	profile->checksum = checksum;
+	profile->edge_count = 0;
+	profile->edge_capacity = SABR_PROFILE_EDGE_CAPACITY;
+	profile->counts = (uint64_t*) calloc(size + 1, sizeof(uint64_t));
+	profile->edges = (sabr_profile_edge_t*) calloc(profile->edge_capacity, sizeof(sabr_profile_edge_t));
+	if (profile->counts && profile->edges) return true;
+	sabr_profile_del(profile);
+	fputs(sabr_errmsg_alloc, stderr);
+	return false;
+}
+
+void sabr_profile_del(sabr_profile_t* profile) {
+	free(profile->counts);
+	free(profile->edges);
+	profile->counts = NULL;
+	profile->edges = NULL;
+	profile->edge_count = 0;
+	profile->edge_capacity = 0;
+}
+
+bool sabr_profile_add_edge(sabr_profile_t* profile, size_t from, size_t to, uint64_t count) {
+	if ((profile->edge_count + 1) * 2 > profile->edge_capacity) {
+		size_t capacity = profile->edge_capacity * 2;
+		sabr_profile_edge_t* edges = (sabr_profile_edge_t*) calloc(capacity, sizeof(sabr_profile_edge_t));
+		if (!edges) {
+			fputs(sabr_errmsg_alloc, stderr);
+			return false;
+		}
+		for (size_t i = 0; i < profile->edge_capacity; i++) {
+			sabr_profile_edge_t edge = profile->edges[i];
+			if (edge.count) edges[sabr_profile_slot(edges, capacity, edge.from, edge.to)] = edge;
+		}
+		free(profile->edges);
+		profile->edges = edges;
+		profile->edge_capacity = capacity;
+	}
+
+	sabr_profile_edge_t* edge = profile->edges + sabr_profile_slot(profile->edges, profile->edge_capacity, from, to);
+	if (!edge->count) {
+		edge->from = from;
+		edge->to = to;
+		profile->edge_count++;
+	}
+	edge->count += count;
+	return true;
+}
+
+uint64_t sabr_profile_edge(sabr_profile_t* profile, size_t from, size_t to) {
+	return profile->edges[sabr_profile_slot(profile->edges, profile->edge_capacity, from, to)].count;
+}
+
+size_t sabr_profile_slot(sabr_profile_edge_t* edges, size_t capacity, size_t from, size_t to) {
+	size_t slot = (from * 0x9e3779b97f4a7c15ULL ^ to * 0xc2b2ae3d27d4eb4fULL) & (capacity - 1);
+	while (edges[slot].count && (edges[slot].from != from || edges[slot].to != to)) slot = (slot + 1) & (capacity - 1);
+	return slot;
+}
+
+bool sabr_profile_save(sabr_profile_t* profile, const char* filename) {
+	FILE* file = fopen(filename, "w");
+	if (!file) {
+		fputs(sabr_errmsg_open, stderr);
+		return false;
+	}
+
+	fprintf(file, "sabr-profile %zu %" PRIu64 "\n", profile->size, profile->checksum);
+	for (size_t i = 0; i <= profile->size; i++) {
+		if (profile->counts[i]) fprintf(file, "count %zu %" PRIu64 "\n", i, profile->counts[i]);
+	}
+	for (size_t i = 0; i < profile->edge_capacity; i++) {
+		sabr_profile_edge_t edge = profile->edges[i];
+		if (edge.count) fprintf(file, "edge %zu %zu %" PRIu64 "\n", edge.from, edge.to, edge.count);
+	}
+
+	bool succeed = !ferror(file);
+	if (fclose(file) || !succeed) {
+		fputs(sabr_errmsg_write, stderr);
+		return false;
+	}
+	return true;
+}
+
+bool sabr_profile_load(sabr_profile_t* profile, const char* filename) {
+	size_t size, from, to;
+	uint64_t checksum, count;
+	char kind[8];
+
+	profile->counts = NULL;
+	profile->edges = NULL;
+
+	FILE* file = fopen(filename, "r");
+	if (!file) {
+		fputs(sabr_errmsg_open, stderr);
+		return false;
+	}
+
+	if (fscanf(file, "sabr-profile %zu %" SCNu64, &size, &checksum) != 2) goto INVALID;
+	if (!sabr_profile_init(profile, size, checksum)) goto FAILURE;
+
+	while (fscanf(file, "%7s", kind) == 1) {
+		if (!strcmp(kind, "count")) {
+			if (fscanf(file, "%zu %" SCNu64, &from, &count) != 2 || from > size) goto INVALID;
+			profile->counts[from] = count;
+		}
+		else if (!strcmp(kind, "edge")) {
+			if (fscanf(file, "%zu %zu %" SCNu64, &from, &to, &count) != 3 || from > size || to > size) goto INVALID;
+			if (count && !sabr_profile_add_edge(profile, from, to, count)) goto FAILURE;
+		}
+		else goto INVALID;
+	}
+
+	fclose(file);
+	return true;
+
+INVALID:
+	fputs(sabr_errmsg_profile, stderr);
+FAILURE:
+	sabr_profile_del(profile);
+	fclose(file);
+	return false;
+}
+
+uint64_t sabr_profile_checksum(sabr_bytecode_t* bc) {
+	uint64_t hash = 0xcbf29ce484222325ULL;
+	for (size_t i = 0; i < bc->bcop_vec.size; i++) {
+		sabr_bcop_t bcop = *vector_at(sabr_bcop_t, &bc->bcop_vec, i);
+		hash = (hash ^ bcop.oc) * 0x100000001b3ULL;
+		if (!sabr_opcode_has_operand(bcop.oc)) continue;
+		for (size_t j = 0; j < 8; j++) hash = (hash ^ bcop.operand.bytes[j]) * 0x100000001b3ULL;
+	}
+	return hash;
+}
+
+bool sabr_profile_matches(sabr_profile_t* profile, sabr_bytecode_t* bc) {
+	return profile->size == bc->bcop_vec.size && profile->checksum == sabr_profile_checksum(bc);
+}
\ No newline at end of file
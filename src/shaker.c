@@ -0,0 +1,205 @@
+#include "shaker.h"
+
+bool sabr_shaker_run(sabr_bytecode_t* bc) {
+	bool succeed = false;
+	size_t size = bc->bcop_vec.size;
+	bool* droppable = NULL;
+	bool* reached = NULL;
+
+	for (size_t i = 0; i < size; i++) {
+		sabr_bcop_t bcop = *vector_at(sabr_bcop_t, &bc->bcop_vec, i);
+		if ((bcop.oc == SABR_OP_SWITCH_TABLE || bcop.oc == SABR_OP_SWITCH_SEARCH) && !sabr_bytecode_check_switch(bc, bcop)) return true;
+	}
+
+	droppable = (bool*) calloc(size + 1, sizeof(bool));
+	reached = (bool*) calloc(size + 1, sizeof(bool));
+	if (!droppable || !reached) {
+		fputs(sabr_errmsg_alloc, stderr);
+		goto FREE_ALL;
+	}
+
+	if (!sabr_shaker_droppables(bc, droppable)) goto FREE_ALL;
+	if (!sabr_shaker_mark(bc, droppable, reached)) goto FREE_ALL;
+
+	for (size_t i = 0; i < size; i++) {
+		sabr_bcop_t* bcop = vector_at(sabr_bcop_t, &bc->bcop_vec, i);
+		if (!reached[i] || !droppable[i]) continue;
+		size_t end = (bcop->oc == SABR_OP_LAMBDA) ? bcop->operand.u : sabr_shaker_group_end(bc, i);
+		if (bcop->oc == SABR_OP_LAMBDA && reached[i + 1]) {
+			*vector_at(sabr_bcop_t, &bc->bcop_vec, i - 1) = sabr_new_bcop(SABR_OP_NONE);
+			*vector_at(sabr_bcop_t, &bc->bcop_vec, end) = sabr_new_bcop(SABR_OP_NONE);
+			bcop->oc = SABR_OP_JUMP;
+			continue;
+		}
+		for (size_t j = i - 1; j <= end; j++) reached[j] = false;
+	}
+
+	for (size_t i = 0; i < size; i++)
+		if (!reached[i]) *vector_at(sabr_bcop_t, &bc->bcop_vec, i) = sabr_new_bcop(SABR_OP_NONE);
+
+	succeed = true;
+
+FREE_ALL:
+	free(droppable);
+	free(reached);
+	return succeed;
+}
+
+bool sabr_shaker_droppables(sabr_bytecode_t* bc, bool* droppable) {
+	bool succeed = false;
+	size_t size = bc->bcop_vec.size;
+	size_t count = 0;
+	sabr_bytecode_link_data_t* defs = NULL;
+
+	defs = (sabr_bytecode_link_data_t*) malloc(sizeof(sabr_bytecode_link_data_t) * (size + 1));
+	if (!defs) {
+		fputs(sabr_errmsg_alloc, stderr);
+		goto FREE_ALL;
+	}
+
+	for (size_t i = 1; i < size; i++) {
+		sabr_bcop_t bcop = *vector_at(sabr_bcop_t, &bc->bcop_vec, i);
+		sabr_bcop_t prev = *vector_at(sabr_bcop_t, &bc->bcop_vec, i - 1);
+		if (prev.oc != SABR_OP_VALUE) continue;
+		if (bcop.oc == SABR_OP_LAMBDA) {
+			if (bcop.operand.u <= i || bcop.operand.u >= size || vector_at(sabr_bcop_t, &bc->bcop_vec, bcop.operand.u)->oc != SABR_OP_DEFINE) continue;
+		}
+		else if (bcop.oc != SABR_OP_DATAGROUP || sabr_shaker_group_end(bc, i) >= size) continue;
+		defs[count].identifier = prev.operand.u;
+		defs[count].entry = i;
+		defs[count].bindable = true;
+		count++;
+	}
+	if (!count) {
+		succeed = true;
+		goto FREE_ALL;
+	}
+
+	qsort(defs, count, sizeof(sabr_bytecode_link_data_t), sabr_bytecode_link_data_compare);
+	for (size_t i = 1; i < count; i++) {
+		if (defs[i].identifier != defs[i - 1].identifier) continue;
+		defs[i].bindable = false;
+		defs[i - 1].bindable = false;
+	}
+
+	for (size_t i = 0; i < size; i++) {
+		sabr_bcop_t bcop = *vector_at(sabr_bcop_t, &bc->bcop_vec, i);
+		switch (bcop.oc) {
+			case SABR_OP_VALUE: {
+				sabr_opcode_t next = (i + 1 < size) ? vector_at(sabr_bcop_t, &bc->bcop_vec, i + 1)->oc : SABR_OP_NONE;
+				if (next == SABR_OP_LAMBDA || next == SABR_OP_DATAGROUP || sabr_shaker_is_numeric(next)) continue;
+			} break;
+			case SABR_OP_EXEC:
+			case SABR_OP_LOAD_GLOBAL:
+			case SABR_OP_STORE_GLOBAL:
+			case SABR_OP_ADDR_GLOBAL:
+				break;
+			default:
+				continue;
+		}
+		sabr_bytecode_link_data_t* def = sabr_bytecode_link_data_find(defs, count, bcop.operand.u);
+		if (def) def->bindable = false;
+	}
+
+	for (size_t i = 0; i < count; i++)
+		if (defs[i].bindable) droppable[defs[i].entry] = true;
+
+	succeed = true;
+
+FREE_ALL:
+	free(defs);
+	return succeed;
+}
+
+bool sabr_shaker_mark(sabr_bytecode_t* bc, bool* droppable, bool* reached) {
+	size_t size = bc->bcop_vec.size;
+	size_t top = 0;
+	size_t* work = (size_t*) malloc(sizeof(size_t) * (size * 3 + 2));
+	if (!work) {
+		fputs(sabr_errmsg_alloc, stderr);
+		return false;
+	}
+
+	work[top++] = 0;
+	while (top) {
+		size_t i = work[--top];
+		if (i >= size || reached[i]) continue;
+		reached[i] = true;
+		sabr_bcop_t bcop = *vector_at(sabr_bcop_t, &bc->bcop_vec, i);
+		switch (bcop.oc) {
+			case SABR_OP_EXIT:
+			case SABR_OP_RETURN:
+				break;
+			case SABR_OP_JUMP:
+			case SABR_OP_TAILCALL:
+				work[top++] = bcop.operand.u;
+				break;
+			case SABR_OP_LAMBDA:
+				work[top++] = bcop.operand.u;
+				if (!droppable[i]) work[top++] = i + 1;
+				break;
+			case SABR_OP_DATAGROUP:
+				work[top++] = droppable[i] ? sabr_shaker_group_end(bc, i) + 1 : i + 1;
+				break;
+			case SABR_OP_SWITCH_TABLE:
+			case SABR_OP_SWITCH_SEARCH: {
+				size_t table = bcop.operand.u;
+				size_t count, first, stride, length;
+				if (bcop.oc == SABR_OP_SWITCH_TABLE) {
+					count = vector_at(sabr_bcop_t, &bc->bcop_vec, table + 1)->operand.u;
+					first = table + 2;
+					stride = 1;
+					length = count + 3;
+				}
+				else {
+					count = vector_at(sabr_bcop_t, &bc->bcop_vec, table)->operand.u;
+					first = table + 1;
+					stride = 2;
+					length = count * 2 + 2;
+				}
+				for (size_t j = table; j < table + length; j++) reached[j] = true;
+				for (size_t j = 0; j <= count; j++)
+					work[top++] = vector_at(sabr_bcop_t, &bc->bcop_vec, first + j * stride)->operand.u;
+			} break;
+			default:
+				if (sabr_opcode_has_index_operand(bcop.oc)) work[top++] = bcop.operand.u;
+				work[top++] = i + 1;
+				break;
+		}
+	}
+
+	free(work);
+	return true;
+}
+
+size_t sabr_shaker_group_end(sabr_bytecode_t* bc, size_t index) {
+	size_t size = bc->bcop_vec.size;
+	for (size_t i = index + 1; i < size; i++) {
+		sabr_opcode_t oc = vector_at(sabr_bcop_t, &bc->bcop_vec, i)->oc;
+		if (oc == SABR_OP_DATAGROUP_END) return i;
+		if (oc != SABR_OP_VALUE && oc != SABR_OP_MEMBER && oc != SABR_OP_NONE) return size;
+	}
+	return size;
+}
+
+bool sabr_shaker_is_numeric(sabr_opcode_t oc) {
+	switch (oc) {
+		case SABR_OP_IF:
+		case SABR_OP_ADD: case SABR_OP_SUB: case SABR_OP_MUL: case SABR_OP_DIV: case SABR_OP_MOD:
+		case SABR_OP_UDIV: case SABR_OP_UMOD: case SABR_OP_NEG: case SABR_OP_INC: case SABR_OP_DEC:
+		case SABR_OP_ADD_IMM: case SABR_OP_MUL_IMM:
+		case SABR_OP_EQU: case SABR_OP_NEQ: case SABR_OP_GRT: case SABR_OP_GEQ: case SABR_OP_LST: case SABR_OP_LEQ:
+		case SABR_OP_UGRT: case SABR_OP_UGEQ: case SABR_OP_ULST: case SABR_OP_ULEQ:
+		case SABR_OP_EQU_IMM: case SABR_OP_NEQ_IMM: case SABR_OP_GRT_IMM: case SABR_OP_GEQ_IMM: case SABR_OP_LST_IMM: case SABR_OP_LEQ_IMM:
+		case SABR_OP_EQU_IF: case SABR_OP_NEQ_IF: case SABR_OP_GRT_IF: case SABR_OP_GEQ_IF: case SABR_OP_LST_IF: case SABR_OP_LEQ_IF:
+		case SABR_OP_UGRT_IF: case SABR_OP_UGEQ_IF: case SABR_OP_ULST_IF: case SABR_OP_ULEQ_IF:
+		case SABR_OP_BAND: case SABR_OP_BOR: case SABR_OP_BXOR: case SABR_OP_BNOT: case SABR_OP_BLSFT: case SABR_OP_BRSFT:
+		case SABR_OP_BAND_IMM: case SABR_OP_BLSFT_IMM: case SABR_OP_BRSFT_IMM:
+		case SABR_OP_ITOF: case SABR_OP_UTOF:
+		case SABR_OP_ALLOC: case SABR_OP_ALLOT:
+		case SABR_OP_PUTC: case SABR_OP_PUTI: case SABR_OP_PUTU:
+			return true;
+		default:
+			return false;
+	}
+}
\ No newline at end of file